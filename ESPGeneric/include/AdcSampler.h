@@ -0,0 +1,121 @@
+/*****************************************************************************************
+* FILENAME :        AdcSampler.h
+*
+* DESCRIPTION :
+*       Class header for the shared ADC sampling service
+*
+* NOTES :
+*       The ESP8266 has one ADC input, the sampler is its only user. Devices
+*       register as consumer with a burst length, a burst filter and an optional
+*       exponential moving average over the bursts. A device requests a burst,
+*       the main loop calls Process_u8() and the device takes the filtered value
+*       with its next step. Bursts of several consumers are served one per loop
+*       in turn, so they never overlap and WiFi gets the CPU in between. All
+*       filters use integer arithmetic.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef ADCSAMPLER_H_
+#define ADCSAMPLER_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+// number of devices using the ADC, the Temt6000 and the Sen0193
+#ifndef ADCSAMPLER_CONSUMERS
+#define ADCSAMPLER_CONSUMERS        2u
+#endif
+// maximum number of conversions of one burst
+#define ADCSAMPLER_BURST_MAX        16u
+#define ADCSAMPLER_INVALID          0xFFu
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef enum adcFilter_tag
+{
+    ADCSAMPLER_MEAN             = 0,    // decimation of the burst to its mean
+    ADCSAMPLER_MEDIAN                   // median of the burst, rejects single spikes
+}adcFilter_t;
+
+typedef struct adcConfig_tag
+{
+    uint8_t             burst_u8;       // conversions per burst, 1..ADCSAMPLER_BURST_MAX
+    adcFilter_t         filter_en;      // reduction of the burst to one value
+    uint8_t             emaShift_u8;    // weight 1/2^shift of a new burst, 0 disables
+}adcConfig_t;
+
+typedef struct adcConsumer_tag
+{
+    adcConfig_t         config_st;
+    int32_t             ema_s32;        // filter state in 1/256 digits
+    uint16_t            value_u16;
+    bool                pending_bol;
+    bool                ready_bol;
+    bool                valid_bol;
+}adcConsumer_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class AdcSampler
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        AdcSampler(uint8_t pin_u8);
+        uint8_t Register_u8(const adcConfig_t *config_p);
+        bool Request_bol(uint8_t id_u8);
+        uint8_t Process_u8(void);
+        bool Take_bol(uint8_t id_u8, uint16_t *value_pu16);
+        uint8_t GetSize_u8(void) const;
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        adcConsumer_t       consumers_sta[ADCSAMPLER_CONSUMERS];
+        uint8_t             pin_u8;
+        uint8_t             size_u8;
+        uint8_t             next_u8;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+        void Burst(adcConsumer_t *consumer_p);
+        static uint16_t Median_u16(uint16_t *samples_pu16, uint8_t count_u8);
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* ADCSAMPLER_H_ */
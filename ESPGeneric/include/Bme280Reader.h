@@ -0,0 +1,131 @@
+/*****************************************************************************************
+* FILENAME :        Bme280Reader.h
+*
+* DESCRIPTION :
+*       Class header for the forced mode BME280 reader
+*
+* NOTES :
+*       One sample is one forced measurement with 1x oversampling of pressure,
+*       temperature and humidity. The owner starts the measurement, waits
+*       BME280READER_MEAS_TIME and reads all 8 data registers in one burst. The
+*       raw values are compensated with the integer formulas of the Bosch
+*       datasheet, no float is involved.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef BME280READER_H_
+#define BME280READER_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+#define BME280READER_ADDRESS        0x76u
+#define BME280READER_CHIP_ID        0x60u
+// pressure, temperature and humidity registers 0xF7 to 0xFE
+#define BME280READER_DATA_BYTES     8u
+// calibration registers 0x88 to 0xA1 and 0xE1 to 0xE7
+#define BME280READER_CALIB_TP_BYTES 26u
+#define BME280READER_CALIB_H_BYTES  7u
+// start up time after power on and maximum time of a forced measurement in ms
+#define BME280READER_STARTUP_TIME   2u
+#define BME280READER_MEAS_TIME      10u
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef struct bme280Calib_tag
+{
+    uint16_t            t1_u16;
+    int16_t             t2_s16;
+    int16_t             t3_s16;
+    uint16_t            p1_u16;
+    int16_t             p2_s16;
+    int16_t             p3_s16;
+    int16_t             p4_s16;
+    int16_t             p5_s16;
+    int16_t             p6_s16;
+    int16_t             p7_s16;
+    int16_t             p8_s16;
+    int16_t             p9_s16;
+    uint8_t             h1_u8;
+    int16_t             h2_s16;
+    uint8_t             h3_u8;
+    int16_t             h4_s16;
+    int16_t             h5_s16;
+    int8_t              h6_s8;
+}bme280Calib_t;
+
+// compensated values of one forced measurement
+typedef struct bme280Sample_tag
+{
+    int32_t             temperature_s32;    // 0.01 degC
+    uint32_t            pressure_u32;       // Pa, Q24.8
+    uint32_t            humidity_u32;       // %RH, Q22.10
+}bme280Sample_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class Bme280Reader
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        Bme280Reader(uint8_t address_u8);
+        bool Begin_bol(void);
+        bool StartMeasurement_bol(void);
+        bool ReadSample_bol(bme280Sample_t *sample_p);
+        void SetCalibration(const uint8_t *tp_pu8, const uint8_t *h_pu8);
+        bool Compensate_bol(const uint8_t *data_pu8, bme280Sample_t *sample_p) const;
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        uint8_t             address_u8;
+        bool                calibrated_bol;
+        bme280Calib_t       calib_st;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+        bool Write_bol(uint8_t reg_u8, uint8_t value_u8);
+        bool Read_bol(uint8_t reg_u8, uint8_t *data_pu8, uint8_t length_u8);
+        int32_t Temperature_s32(int32_t adc_s32, int32_t *tFine_ps32) const;
+        uint32_t Pressure_u32(int32_t adc_s32, int32_t tFine_s32) const;
+        uint32_t Humidity_u32(int32_t adc_s32, int32_t tFine_s32) const;
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* BME280READER_H_ */
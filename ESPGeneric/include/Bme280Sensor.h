@@ -33,16 +33,18 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 /* Imported header files: */
 #include <ESP8266WiFi.h>         
 #include <PubSubClient.h>
-#include <Adafruit_Sensor.h>
-#include <Adafruit_BME280.h>
 
 #include "MqttDevice.h"
 #include "Trace.h"
 #include "PubSubClient.h"
 #include "GpioDevice.h"
+#include "Bme280Reader.h"
+#include "PublishPolicy.h"
 
 /****************************************************************************************/
 /* Global constant defines: */
+// published values with an own publish policy, temperature, humidity, pressure, altitude
+#define BME280SENSOR_VALUES         4u
 
 /****************************************************************************************/
 /* Global function like macro defines (to be avoided): */
@@ -57,7 +59,6 @@ class Bme280Sensor : public MqttDevice
     public:
         /********************************************************************************/
         /* Public data definitions */
-        Adafruit_BME280     *bme_p;
         float               humidity_f32        = 0.0;
         float               temperature_f32     = 0.0; 
         float               altitude_f32        = 40.00;
@@ -71,7 +72,8 @@ class Bme280Sensor : public MqttDevice
                                   uint16_t reportCycleSec_u16);
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         virtual
@@ -80,10 +82,13 @@ class Bme280Sensor : public MqttDevice
         /********************************************************************************/
         /* Private data definitions */
         uint32_t    publishData_u32;
-        char        buffer_ca[100];
         GpioDevice  *bmePwr_p;
         GpioDevice  *bmeStat_p;
+        Bme280Reader reader_st;
         uint32_t    reportCycleMSec_u32;
+        bool        reportRequest_bol;
+        bool        measRequest_bol;
+        PublishPolicy policies_sta[BME280SENSOR_VALUES];
 
         /********************************************************************************/
         /* Private function definitions: */
@@ -96,10 +101,15 @@ class Bme280Sensor : public MqttDevice
         /********************************************************************************/
         /* Protected function definitions: */
         char *f2s(float f, int p);
-        void TurnBmeOn();
+        bool TurnBmeOn();
         void TurnBmeOff();
+        void StartMeasurement(void);
+        boolean PublishData(PubSubClient *client);
+        bool PublishValue_bol(PubSubClient *client, uint8_t valueId_u8, float value_f32, 
+                                uint32_t now_u32);
         void TurnStatusOn();
         void TurnStatusOff(); 
+        void ProcessTimer(uint8_t timerId_u8);
 };
 
 #endif /* BME280SENSOR_H_ */
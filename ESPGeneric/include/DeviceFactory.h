@@ -31,21 +31,53 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 /* Imported header files: */
 
 #include "MqttDevice.h"
+#include "GpioDevice.h"
 #include "Trace.h"
 #include "PubSubClient.h"
 //#include "DhtSensor.h"
-#include "LinkedList.h"
+#include "DeviceRegistry.h"
 
 #include "SingleRelay.h"
 
 /****************************************************************************************/
 /* Global constant defines: */
+#define DEVICEFACTORY_PIN_UNUSED    0xFFu
 
 /****************************************************************************************/
 /* Global function like macro defines (to be avoided): */
 
 /****************************************************************************************/
 /* Global type definitions (enum, struct, union): */
+// device kinds of the capability tables, gpio devices are generated with their owner
+typedef enum deviceType_tag
+{
+    DEVICEFACTORY_RELAY_ESP = 0,
+    DEVICEFACTORY_RELAY_MCP,
+    DEVICEFACTORY_DHT,
+    DEVICEFACTORY_SONOFF,
+    DEVICEFACTORY_PIR,
+    DEVICEFACTORY_POWER_SAVE,
+    DEVICEFACTORY_SEN0193,
+    DEVICEFACTORY_BME,
+    DEVICEFACTORY_GEN_SENSOR,
+    DEVICEFACTORY_TEMT6000,
+    DEVICEFACTORY_NEOPIX,
+    DEVICEFACTORY_DIM_LIGHT,
+    DEVICEFACTORY_HEAP_MONITOR,
+    DEVICEFACTORY_TYPES
+}deviceType_t;
+
+// one device of a capability, the meaning of the parameters depends on the type
+typedef struct deviceEntry_tag
+{
+    uint8_t         type_u8;        // deviceType_t
+    uint8_t         pin_u8;         // output, data or input pin
+    uint8_t         auxPin_u8;      // power or led pin, DEVICEFACTORY_PIN_UNUSED if none
+    uint8_t         dir_u8;         // direction of the generated gpio
+    uint16_t        param_u16;      // invert, report cycle, max digits or power on time
+    uint16_t        param2_u16;     // dht id or deep sleep time
+    const char      *chan_ccp;      // mqtt channel
+}deviceEntry_t;
 
 /****************************************************************************************/
 /* Class definition: */
@@ -59,15 +91,22 @@ class DeviceFactory
         /* Public function definitions: */
         DeviceFactory(Trace *p_trace);
         void SelectTraceChannel(uint8_t chan_u8);
-        LinkedList<MqttDevice*> * GenerateDevice(uint8_t cap_u8);
+        bool GenerateDevice(uint8_t cap_u8, DeviceRegistry *registry_p);
+        uint16_t GetArenaUsed_u16(void) const;
+        static uint16_t GetArenaSize_u16(void);
         virtual
         ~DeviceFactory();
     private:
         /********************************************************************************/
         /* Private data definitions */
         Trace * trace_p;
+        uint16_t arenaUsed_u16;
         /********************************************************************************/
         /* Private function definitions: */
+        bool AddDevice(DeviceRegistry *registry_p, MqttDevice *device_p);
+        void* Reserve_p(uint16_t size_u16);
+        GpioDevice* GenerateGpio_p(uint8_t pin_u8, uint8_t dir_u8, bool mcp_bol);
+        MqttDevice* GenerateEntry_p(const deviceEntry_t *entry_p);
     protected:
         /********************************************************************************/
         /* Protected data definitions */
@@ -0,0 +1,96 @@
+/*****************************************************************************************
+* FILENAME :        DeviceRegistry.h
+*
+* DESCRIPTION :
+*       Class header for the fixed capacity registry of the generated devices
+*
+* NOTES :
+*       The device pointers are stored contiguous in a static array, the registry
+*       itself never allocates. The capacity is the device count of the largest
+*       capability profile, see DEVICEREGISTRY_SIZE.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef DEVICEREGISTRY_H_
+#define DEVICEREGISTRY_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+// maximum number of devices of one capability profile. The eight relay capability uses
+// the most with eight relays and the heap monitor, the H801 follows with seven dim
+// lights and the heap monitor. DeviceFactory.cpp checks it against the capability tables.
+#ifndef DEVICEREGISTRY_SIZE
+#define DEVICEREGISTRY_SIZE         9u
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+
+/****************************************************************************************/
+/* Class definition: */
+class MqttDevice;
+
+class DeviceRegistry
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        DeviceRegistry();
+        void Clear(void);
+        bool Add_bol(MqttDevice *device_p);
+        MqttDevice* Get_p(uint8_t idx_u8) const;
+        uint8_t IndexOf_u8(const MqttDevice *device_p) const;
+        uint8_t GetSize_u8(void) const;
+        uint8_t GetCapacity_u8(void) const;
+        // range based iteration: for(MqttDevice *device_p : registry)
+        MqttDevice* const* begin(void) const;
+        MqttDevice* const* end(void) const;
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        MqttDevice      *devices_pa[DEVICEREGISTRY_SIZE];
+        uint8_t         size_u8;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* DEVICEREGISTRY_H_ */
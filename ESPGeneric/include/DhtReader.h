@@ -0,0 +1,123 @@
+/*****************************************************************************************
+* FILENAME :        DhtReader.h
+*
+* DESCRIPTION :
+*       Class header for the interrupt driven DHT22 reader
+*
+* NOTES :
+*       The reader never waits for the sensor. The owner sends the start signal,
+*       releases the line after at least one millisecond and decodes the frame
+*       after the sensor finished it. In between an edge interrupt stores the
+*       time between the line changes, the 40 bit frame is decoded from these
+*       durations afterwards.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef DHTREADER_H_
+#define DHTREADER_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+// edges of one frame: response low and high, 40 bits a low and high phase and the
+// release at the end of the frame
+#define DHTREADER_EDGES             84u
+// number of readers capturing at the same time, one interrupt trampoline each
+#define DHTREADER_INSTANCES         2u
+#define DHTREADER_FRAME_BYTES       5u
+// minimum time of the start signal in ms and the time until the frame is complete
+#define DHTREADER_START_TIME        2u
+#define DHTREADER_FRAME_TIME        10u
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef enum dhtStatus_tag
+{
+    DHTREADER_OK                = 0,
+    DHTREADER_NO_RESPONSE,
+    DHTREADER_INCOMPLETE,
+    DHTREADER_CHECKSUM_ERROR
+}dhtStatus_t;
+
+// humidity and temperature of one DHT22 frame
+typedef struct dhtSample_tag
+{
+    float               humidity_f32;
+    float               temperature_f32;
+    uint32_t            time_u32;           // millis() at the start of the frame
+    dhtStatus_t         status_en;
+}dhtSample_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class DhtReader
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        DhtReader(uint8_t pin_u8);
+        void Begin(void);
+        void StartSignal(void);
+        bool StartCapture(void);
+        void StopCapture(void);
+        dhtStatus_t Decode_en(uint8_t *data_pu8) const;
+        dhtStatus_t Sample_en(dhtSample_t *sample_p) const;
+        uint8_t GetEdges_u8(void) const;
+        void Edge(uint32_t now_u32);
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        static DhtReader    *readers_spa[DHTREADER_INSTANCES];
+
+        uint8_t             pin_u8;
+        uint8_t             slot_u8;
+        volatile uint8_t    edges_u8;
+        uint32_t            lastEdge_u32;
+        uint32_t            captureTime_u32;
+        // time since the previous edge in us, saturated at 255
+        uint8_t             durations_u8a[DHTREADER_EDGES];
+
+        /********************************************************************************/
+        /* Private function definitions: */
+        static void EdgeIsrZero(void);
+        static void EdgeIsrOne(void);
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* DHTREADER_H_ */
@@ -33,15 +33,18 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 /* Imported header files: */
 #include <ESP8266WiFi.h>         
 #include <PubSubClient.h>
-#include <DHT.h>
 
 #include "MqttDevice.h"
 #include "Trace.h"
 #include "PubSubClient.h"
 #include "GpioDevice.h"
+#include "DhtReader.h"
+#include "PublishPolicy.h"
 
 /****************************************************************************************/
 /* Global constant defines: */
+// published values with an own publish policy, temperature and humidity
+#define DHTSENSOR_VALUES            2u
 
 /****************************************************************************************/
 /* Global function like macro defines (to be avoided): */
@@ -54,6 +57,8 @@ typedef enum state_tag
     DHTSENSOR_MEAS_REQ,
     DHTSENSOR_POWER_STARTED,
     DHTSENSOR_DRIVER_STARTED,
+    DHTSENSOR_START_SIGNAL,
+    DHTSENSOR_CAPTURING,
     DHTSENSOR_MEAS_COMPLETED,
     DHTSENSOR_MEAS_PUBLISHED,
     DHTSENSOR_UNKNOWN_STATE
@@ -77,7 +82,8 @@ class DhtSensor : public MqttDevice
                         uint16_t reportCycleSec_u16, uint8_t dhtId_u8);
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         virtual
@@ -86,19 +92,22 @@ class DhtSensor : public MqttDevice
         /********************************************************************************/
         /* Private data definitions */
         uint32_t        publishData_u32;
-        char            buffer_ca[100];
         uint8_t         dhtPin_u8;
         GpioDevice      *pwrPin_p;
-        DHT             *dht_p; 
-        float           humidity_f32 = 0.0;
-        float           temperature_f32 = 0.0; 
+        DhtReader       reader_st;
+        // last valid sample of the sensor, uncorrected
+        dhtSample_t     sample_st = { 0.0F, 0.0F, 0u, DHTREADER_NO_RESPONSE };
         uint32_t        prevTime_u32 = 0;
         uint32_t        reportCycleMSec_u32;
         uint8_t         dhtId_u8;
+        PublishPolicy   policies_sta[DHTSENSOR_VALUES];
 
         state_t         state_en = DHTSENSOR_OFF;
         const uint32_t  STATE_LOOP_CYCLE = 2000;
         uint32_t        lastReportTime_u32 = 0;
+        bool            stateLoopRequest_bol = false;
+        bool            measRequest_bol = false;
+        bool            captureStep_bol = false;
 
         uint8_t         readRetries_u8 = 0U;
         const uint8_t   MAX_READ_RETRIES = 3U;
@@ -118,9 +127,12 @@ class DhtSensor : public MqttDevice
         void TurnDHTOff(void);
         void CheckForMeasRequest(void);
         void StartDhtSensorDriver(void);
+        void StartMeasurement(void);
+        void StartCapture(void);
         void ReadDataFromSensor(void);
         boolean PublishData(PubSubClient *client);
         boolean ProcessSensorStateMachine(PubSubClient *client);
+        void ProcessTimer(uint8_t timerId_u8);
 
 };
 
@@ -64,7 +64,8 @@ class DimLight : public MqttDevice
                     uint16_t maxDigit_u16);
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         virtual
@@ -74,7 +75,6 @@ class DimLight : public MqttDevice
         /* Private data definitions */ 
         boolean     lightState_bol      = false;
         boolean     publishState_bol    = true;
-        char        topicBuff_ca[100];
         const char  *channel_p;
         GpioDevice  *gpio_p;
         uint8_t     brightness_u8       = 20;  
@@ -89,8 +89,8 @@ class DimLight : public MqttDevice
         void SetLight(void);
         void ToggleLight(void);
         char* BuildReceiveTopic(const char *topic);
-        boolean PublishMessage(PubSubClient *client_p, const char *message_cp, const char * payload_ccp);
-        void Subscribe(PubSubClient *client_p, const char *topic_ccp);
+        boolean PublishMessage(PubSubClient *client_p, uint8_t topicId_u8, const char * payload_ccp);
+        void Subscribe(PubSubClient *client_p, uint8_t topicId_u8, uint8_t handlerId_u8);
     protected:
         /********************************************************************************/
         /* Protected data definitions */
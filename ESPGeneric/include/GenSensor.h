@@ -68,7 +68,8 @@ class GenSensor : public MqttDevice
         
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         virtual
@@ -77,10 +78,10 @@ class GenSensor : public MqttDevice
         /********************************************************************************/
         /* Private data definitions */
         uint32_t    publishData_u32;
-        char        buffer_ca[100];
         char        mqttPayload[20];
         uint32_t    prevTime_u32 = 0;
         uint32_t    reportCycleMSec_u32;
+        bool        reportRequest_bol;
 
         uint16_t    healthTic_u16;
 
@@ -103,6 +104,7 @@ class GenSensor : public MqttDevice
         
         /********************************************************************************/
         /* Protected function definitions: */
+        void ProcessTimer(uint8_t timerId_u8);
 };
 
 #endif /* GENSENSOR_H_ */
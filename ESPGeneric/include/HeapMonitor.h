@@ -0,0 +1,133 @@
+/*****************************************************************************************
+* FILENAME :        HeapMonitor.h
+*
+* DESCRIPTION :
+*       Class header for the heap and fragmentation telemetry device
+*
+* NOTES :
+*       The device samples free heap, largest free block and fragmentation into a
+*       fixed size ring. After the ring was filled once per report cycle, the min
+*       and max watermarks of the ring are published. A configurable action trips,
+*       if the fragmentation stays above the threshold for several samples.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef HEAPMONITOR_H_
+#define HEAPMONITOR_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include "MqttDevice.h"
+#include "Trace.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+// samples in the ring, the watermarks are published after every full ring
+#define HEAPMON_SAMPLES             12u
+// time between two samples in ms
+#define HEAPMON_SAMPLE_CYCLE        5000u
+// default fragmentation threshold in percent
+#define HEAPMON_FRAG_THRESHOLD      50u
+// the threshold has to be exceeded by this number of samples in a row to trip
+#define HEAPMON_TRIP_SAMPLES        3u
+// the action is armed again, if the fragmentation falls this far below the threshold
+#define HEAPMON_FRAG_HYSTERESIS     5u
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef struct heapSample_tag
+{
+    uint32_t    free_u32;           // free heap in bytes
+    uint16_t    maxBlock_u16;       // largest free block in bytes
+    uint8_t     frag_u8;            // fragmentation in percent
+}heapSample_t;
+
+// source of the heap samples, the default reads the ESP heap
+typedef void (*heapSampler_t)(heapSample_t *sample_p);
+
+typedef enum
+{
+    HEAPMON_ACTION_REPORT = 0,      // publish the alarm only
+    HEAPMON_ACTION_RESTART,         // publish the alarm and restart the ESP
+    HEAPMON_ACTIONS
+}heapAction_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class HeapMonitor : public MqttDevice
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        HeapMonitor(Trace *p_trace);
+        HeapMonitor(Trace *p_trace, uint8_t fragThreshold_u8, heapAction_t action_en);
+        void SetSampler(heapSampler_t sampler_p);
+        void GetWatermarks(heapSample_t *min_p, heapSample_t *max_p) const;
+        uint16_t GetTrips_u16(void) const;
+
+        // virtual functions, implementation in derived classes
+        bool ProcessPublishRequests(PubSubClient *client);
+        void Initialize();
+        void Reconnect(PubSubClient *client_p, const char *dev_p);
+        virtual
+        ~HeapMonitor();
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        heapSampler_t   sampler_p;
+        heapSample_t    samples_sta[HEAPMON_SAMPLES];
+        uint8_t         next_u8;
+        uint8_t         count_u8;
+        uint8_t         fragThreshold_u8;
+        heapAction_t    action_en;
+        uint8_t         aboveThreshold_u8;
+        bool            tripped_bol;
+        uint16_t        trips_u16;
+        bool            reportRequest_bol;
+        bool            alarmRequest_bol;
+        uint8_t         alarmFrag_u8;
+        bool            restartRequest_bol;
+        char            payload_ca[24];
+
+        /********************************************************************************/
+        /* Private function definitions: */
+        void sample(void);
+        void checkThreshold(uint8_t frag_u8);
+        bool publishWatermarks(PubSubClient *client_p);
+        static void sampleEsp(heapSample_t *sample_p);
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+        void ProcessTimer(uint8_t timerId_u8);
+};
+
+#endif /* HEAPMONITOR_H_ */
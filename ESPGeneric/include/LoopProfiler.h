@@ -0,0 +1,112 @@
+/*****************************************************************************************
+* FILENAME :        LoopProfiler.h
+*
+* DESCRIPTION :
+*       Class header for the per device loop time profiler
+*
+* NOTES :
+*       The profiler keeps min, max, mean and a decade histogram of the execution
+*       time of every device operation called from the main loop. All counters
+*       are fixed size, recording is a micros() call and a few compares. The
+*       statistic is only formatted, when it is requested over MQTT.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef LOOPPROFILER_H_
+#define LOOPPROFILER_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <Arduino.h>
+#include <PubSubClient.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+// number of profiled devices, devices with a higher index are not recorded. The
+// eight relay capability uses the most with eight relays and the heap monitor.
+// DeviceFactory.cpp checks it against the capability tables.
+#ifndef LOOPPROFILER_DEVICES
+#define LOOPPROFILER_DEVICES        9u
+#endif
+// profiled device operations
+#define LOOPPROFILER_OP_PROCESS     0u  // ProcessPublishRequests
+#define LOOPPROFILER_OP_CALLBACK    1u  // CallbackMqtt and DispatchMqtt
+#define LOOPPROFILER_OP_RECONNECT   2u  // Reconnect
+#define LOOPPROFILER_OPS            3u
+// histogram buckets: <100us, <1ms, <10ms, <100ms, <1s, >=1s
+#define LOOPPROFILER_BUCKETS        6u
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef struct profStat_tag
+{
+    uint64_t    sum_u64;                            // sum of all durations in us
+    uint32_t    count_u32;                          // number of recorded calls
+    uint32_t    min_u32;                            // shortest duration in us
+    uint32_t    max_u32;                            // longest duration in us
+    uint16_t    hist_au16[LOOPPROFILER_BUCKETS];    // saturating bucket counters
+}profStat_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class LoopProfiler
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        LoopProfiler();
+        void Clear(void);
+        void Record(uint8_t device_u8, uint8_t op_u8, uint32_t start_u32);
+        void RecordLoop(uint32_t start_u32);
+        const profStat_t* GetStat_pst(uint8_t device_u8, uint8_t op_u8) const;
+        const profStat_t* GetLoopStat_pst(void) const;
+        bool Publish_bol(PubSubClient *client_p, const char *topic_ccp);
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        profStat_t      stats_sta[LOOPPROFILER_DEVICES][LOOPPROFILER_OPS];
+        profStat_t      loop_st;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+        static void clearStat(profStat_t *stat_p);
+        static void update(profStat_t *stat_p, uint32_t duration_u32);
+        static uint8_t formatStat_u8(char *line_pch, uint8_t size_u8, const char *name_ccp,
+                                        const profStat_t *stat_p);
+        uint16_t writeStats_u16(PubSubClient *client_p);
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* LOOPPROFILER_H_ */
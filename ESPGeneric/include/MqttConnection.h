@@ -0,0 +1,127 @@
+/*****************************************************************************************
+* FILENAME :        MqttConnection.h
+*
+* DESCRIPTION :
+*       Class header for the non blocking MQTT connection state machine
+*
+* NOTES :
+*       Process_u8() is called every main loop cycle. While the broker is not
+*       reachable, one connect attempt is made per call once the backoff time has
+*       expired. The backoff doubles with every failed attempt up to a maximum and
+*       a random jitter spreads the attempts of several devices after a broker
+*       restart. Between the attempts the main loop and all devices keep running.
+*       The configuration portal is only requested, if the broker was never
+*       reached since boot, a broker outage does not block the device.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef MQTTCONNECTION_H_
+#define MQTTCONNECTION_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+#include "PubSubClient.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+// backoff of the first retry and maximum backoff in milliseconds
+#define MQTTCONN_BACKOFF_MIN        1000u
+#define MQTTCONN_BACKOFF_MAX        60000u
+
+// connection states
+#define MQTTCONN_STATE_INIT         0u
+#define MQTTCONN_STATE_BACKOFF      1u
+#define MQTTCONN_STATE_CONNECTED    2u
+
+// events returned by Process_u8
+#define MQTTCONN_EVENT_NONE         0u
+#define MQTTCONN_EVENT_CONNECTED    1u
+#define MQTTCONN_EVENT_LOST         2u
+#define MQTTCONN_EVENT_FAILED       3u
+#define MQTTCONN_EVENT_PORTAL       4u
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+
+/****************************************************************************************/
+/* Class definition: */
+class MqttConnection
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        MqttConnection(PubSubClient *client_p, uint8_t portalRetries_u8);
+        void Configure(const char *id_ccp, const char *user_ccp, const char *pw_ccp);
+        void SetSeed(uint32_t seed_u32);
+        uint8_t Process_u8(uint32_t now_u32);
+        uint32_t GetIdleTime_u32(uint32_t now_u32, uint32_t maxIdle_u32) const;
+        uint8_t GetState_u8(void) const;
+        uint16_t GetFailures_u16(void) const;
+        uint32_t GetBackoff_u32(void) const;
+        uint32_t GetLatency_u32(void) const;
+        uint32_t GetMaxLatency_u32(void) const;
+        uint32_t GetAttemptTime_u32(void) const;
+        uint16_t GetReconnects_u16(void) const;
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        PubSubClient    *client_p;
+        const char      *id_ccp;
+        const char      *user_ccp;
+        const char      *pw_ccp;
+        uint8_t         state_u8;
+        uint8_t         portalRetries_u8;
+        bool            everConnected_bol;
+        uint16_t        failures_u16;
+        uint16_t        reconnects_u16;
+        uint32_t        backoff_u32;
+        uint32_t        nextAttempt_u32;
+        uint32_t        lostTime_u32;
+        uint32_t        latency_u32;
+        uint32_t        maxLatency_u32;
+        uint32_t        attemptTime_u32;
+        uint32_t        random_u32;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+        uint8_t Attempt_u8(uint32_t now_u32);
+        void ScheduleRetry(uint32_t now_u32);
+        uint32_t Random_u32(void);
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* MQTTCONNECTION_H_ */
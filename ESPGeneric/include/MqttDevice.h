@@ -34,9 +34,25 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #include <string>
 #include "Trace.h"
 #include "PubSubClient.h"
+#include "PubSubQueue.h"
+#include "PubSubSubscriber.h"
+#include "TopicRouter.h"
+#include "TopicPool.h"
+#include "MqttPayload.h"
+#include "Scheduler.h"
+#include "AdcSampler.h"
 
 /****************************************************************************************/
 /* Global constant defines: */
+// number of cached topics per device, NeoPix uses the most with 5 receive and 2 send
+#define MQTTDEVICE_TOPICS           8u
+// size of the buffer used to build a topic before it is cached
+#define MQTTDEVICE_TOPIC_LENGTH     100u
+// number of scheduler timers per device
+#define MQTTDEVICE_TIMERS           4u
+// quality of service levels for Publish_bol
+#define MQTTDEVICE_QOS_0            0u
+#define MQTTDEVICE_QOS_1            1u
 
 /****************************************************************************************/
 /* Global function like macro defines (to be avoided): */
@@ -59,13 +75,30 @@ class MqttDevice
         unsigned int GetPublications_u16();
 
         static bool GetReconfigRequest();
+        static void SetTopicRouter(TopicRouter *router_p);
+        static void SetTopicPool(TopicPool *pool_p);
+        static void SetScheduler(Scheduler *scheduler_p);
+        static void SetAdcSampler(AdcSampler *adc_p);
+        static void SetPublishQueue(PubSubQueue *queue_p);
+        static void SetSubscriber(PubSubSubscriber *subscriber_p);
+        static void SetWildcard(const char *filter_ccp);
 
         virtual ~MqttDevice();
         virtual bool ProcessPublishRequests(PubSubClient *client) = 0;
-        virtual void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload) = 0;
+        virtual void CallbackMqtt(PubSubClient *client_p, char* p_topic, 
+                                    const MqttPayload &payload);
+        virtual void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                                    char* p_topic, const MqttPayload &payload);
+        // deprecated, only called by the default CallbackMqtt for out of tree devices
+        virtual void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
         virtual void Initialize() = 0;
         virtual void Reconnect(PubSubClient *client_p, const char *dev_p) = 0;
-        
+
+    private:
+        /********************************************************************************/
+        /* Private function definitions: */
+        static void TimerCallback(void *context_p, uint8_t timerId_u8);
+
     protected:
         /********************************************************************************/
         /* Protected data definitions */
@@ -76,11 +109,34 @@ class MqttDevice
         Trace               *p_trace;
         const char          *dev_p;
         const char          *deviceName_ccp = "<<mqttDevice>>";
+        const char          *topics_ccpa[MQTTDEVICE_TOPICS];
+        uint8_t             timers_u8a[MQTTDEVICE_TIMERS];
         
         static bool         startWifiConfig_bol;
+        static TopicRouter  *router_p;
+        static TopicPool    *pool_p;
+        static Scheduler    *scheduler_p;
+        static AdcSampler   *adc_p;
+        static PubSubQueue  *queue_p;
+        static PubSubSubscriber *subscriber_p;
+        static const char   *wildcard_ccp;
+        static uint8_t      wildcardLength_u8;
+        static char         buildBuffer_ca[MQTTDEVICE_TOPIC_LENGTH];
 
         /********************************************************************************/
         /* Protected function definitions: */
+        bool RegisterTopic(const char *topic_ccp, uint8_t handlerId_u8);
+        bool CacheTopic(uint8_t topicId_u8, const char *topic_ccp);
+        const char* GetTopic_ccp(uint8_t topicId_u8) const;
+        bool Publish_bol(PubSubClient *client_p, const char *topic_ccp, 
+                            const char *payload_ccp, bool retained_bol);
+        bool Publish_bol(PubSubClient *client_p, const char *topic_ccp, 
+                            const char *payload_ccp, uint8_t qos_u8, bool retained_bol);
+        bool Subscribe_bol(PubSubClient *client_p, const char *topic_ccp);
+        bool StartTimer(uint8_t timerId_u8, uint32_t delay_u32, uint32_t period_u32);
+        void StopTimer(uint8_t timerId_u8);
+        virtual void ProcessTimer(uint8_t timerId_u8);
+        static void RequestWakeup(void);
         
 };
 
@@ -0,0 +1,87 @@
+/*****************************************************************************************
+* FILENAME :        MqttPayload.h
+*
+* DESCRIPTION :
+*       Class header for the non owning view on a received MQTT payload
+*
+* NOTES :
+*       The view points directly into the receive buffer of the PubSubClient. It is
+*       only valid during the callback and the payload is not zero terminated.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef MQTTPAYLOAD_H_
+#define MQTTPAYLOAD_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+#define MQTTPAYLOAD_NOT_FOUND       (-1)
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+
+/****************************************************************************************/
+/* Class definition: */
+class MqttPayload
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        MqttPayload(const uint8_t *data_pu8, uint16_t length_u16);
+        const uint8_t* GetData_pu8(void) const;
+        uint16_t GetLength_u16(void) const;
+        bool StartsWith_bol(const char *prefix_ccp) const;
+        int16_t IndexOf_s16(char char_c, uint16_t start_u16) const;
+        int16_t LastIndexOf_s16(char char_c) const;
+        int32_t ToInt_s32(uint16_t start_u16) const;
+        int32_t ToInt_s32(void) const;
+        uint16_t CopyTo_u16(char *buffer_pch, uint16_t size_u16) const;
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        const uint8_t   *data_pu8;
+        uint16_t        length_u16;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* MQTTPAYLOAD_H_ */
@@ -70,7 +70,8 @@ class NeoPix : public MqttDevice
         NeoPix(Trace *trace_pcl, GpioDevice  *gpio_pcl, const char* neoChan_pch);
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         virtual
@@ -82,7 +83,6 @@ class NeoPix : public MqttDevice
         neoPixMode_t        mode_en             = NEOPIX_NORMAL_MODE;
         boolean             neoStateChanged_bol = true;
         uint8_t             brightness_u8       = 20; 
-        char                topicBuff_cha[100];
         const char          *channel_pch;
         GpioDevice          *gpio_pcl;  
         char                mqttPayload_cha[20];    
@@ -99,6 +99,7 @@ class NeoPix : public MqttDevice
         const uint8_t       ALARM_RGB[2][3]     = {{213U, 0U, 0U},{48U, 79U, 254U}};
         uint8_t             alarmRgbIdx_u8      = 0U;
         const uint32_t      ALARM_TOGGLE_TIME   = 600;
+        bool                alarmToggleRequest_bol = false;
         const uint8_t       ALARM_BRIGHTNESS    = 90U;
         
         /********************************************************************************/
@@ -109,8 +110,8 @@ class NeoPix : public MqttDevice
         void Toggle_vd(void);
         char* BuildReceiveTopic_pch(const char *topic);
         char* BuildReceiveTopicBCast_pch(const char *topic);
-        boolean PublishMessage_bol(PubSubClient *client_p, const char *message_cp, const char * payload_ccp);
-        void Subscribe_vd(PubSubClient *client_p, const char *topic_ccp);
+        boolean PublishMessage_bol(PubSubClient *client_p, uint8_t topicId_u8, const char * payload_ccp);
+        void Subscribe_vd(PubSubClient *client_p, const char *topic_ccp, uint8_t handlerId_u8);
         void CheckModesForTimingEvents_vd();
         void ControlAlarmSignal_vd();
     protected:
@@ -119,6 +120,7 @@ class NeoPix : public MqttDevice
 
         /********************************************************************************/
         /* Protected function definitions: */
+        void ProcessTimer(uint8_t timerId_u8);
 
 };
 
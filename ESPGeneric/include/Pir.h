@@ -65,7 +65,8 @@ class Pir : public MqttDevice
         Pir(Trace *p_trace, uint8_t pirPin_u8, bool pollingMode_bol, uint8_t ledPin_u8);
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void CallbackMqtt(PubSubClient *client_p, char* p_topic, 
+                            const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         void PollPirState(void);
@@ -82,7 +83,6 @@ class Pir : public MqttDevice
         uint8_t pirPin_u8             = 0u;
         uint8_t ledPin_u8             = 0xffu;
         boolean pollingMode_bol       = false;
-        char buffer_ca[100];
         
         /********************************************************************************/
         /* Private function definitions: */
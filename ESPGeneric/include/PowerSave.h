@@ -63,7 +63,8 @@ class PowerSave : public MqttDevice
                         uint16_t pwrSaveTimeSec_u16);
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         virtual
@@ -71,13 +72,12 @@ class PowerSave : public MqttDevice
     private:
         /********************************************************************************/
         /* Private data definitions */
-        char buffer_ca[100];
         bool pwrSaveMode_bol;
         uint32_t             prevTime_u32 = 0;
         uint32_t pwrOnTimeMSec_u32;
         uint32_t pwrSaveTimeMSec_u32;
         uint8_t actualState_u8;
-        uint32_t timer_u32;
+        bool pwrOnTimeout_bol;
         /********************************************************************************/
         /* Private function definitions: */
         char* build_topic(const char *topic);
@@ -88,6 +88,7 @@ class PowerSave : public MqttDevice
         
         /********************************************************************************/
         /* Protected function definitions: */
+        void ProcessTimer(uint8_t timerId_u8);
 };
 
 #endif /* POWERSAVE_H_ */
@@ -0,0 +1,125 @@
+/*****************************************************************************************
+* FILENAME :        PublishPolicy.h
+*
+* DESCRIPTION :
+*       Class header for the report on change policy of a sensor value
+*
+* NOTES :
+*       A sensor keeps one policy per published value. A new measurement is 
+*       published, if it moved by the delta from the last published value, or if
+*       the value was silent for the heartbeat interval. The minimum interval 
+*       limits the rate of publications. The delta is absolute in the unit of the
+*       value or relative in percent of the last published value. The default
+*       policy publishes every measurement.
+*
+*       The policies of a device are configured with one receive topic, the
+*       payload "<value index>,<delta>[%],<min interval s>,<heartbeat s>", e.g.
+*       "0,0.5,0,900" or "1,2%,60,1800". A retained configuration is applied
+*       again after every reconnect.
+*
+*       The deep sleep of the battery capabilities clears the RAM. PowerSave saves
+*       the policies, the published values and their age to the RTC user memory
+*       before the sleep, setup() restores them after the wake up. The policies are
+*       matched by construction order, which is the same for every boot of a
+*       capability.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef PUBLISHPOLICY_H_
+#define PUBLISHPOLICY_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include "MqttPayload.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+// longest accepted configuration payload
+#define PUBLISHPOLICY_PAYLOAD_LENGTH    32u
+// policies kept across the deep sleep, the double DHT capability uses five
+#ifndef PUBLISHPOLICY_RTC_SLOTS
+#define PUBLISHPOLICY_RTC_SLOTS         8u
+#endif
+// first 4 byte block in the RTC user memory, the first 128 bytes belong to the OTA
+#ifndef PUBLISHPOLICY_RTC_OFFSET
+#define PUBLISHPOLICY_RTC_OFFSET        32u
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef struct publishPolicy_tag
+{
+    float               delta_f32;          // change of the value that is published
+    bool                relative_bol;       // delta in percent of the published value
+    uint32_t            minInterval_u32;    // milliseconds between publications, 0 = off
+    uint32_t            heartbeat_u32;      // milliseconds of silence at most, 0 = off
+}publishPolicy_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class PublishPolicy
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        PublishPolicy();
+        ~PublishPolicy();
+        void Configure(const publishPolicy_t *policy_p);
+        const publishPolicy_t* GetPolicy_cp(void) const;
+        bool IsDue_bol(float value_f32, uint32_t now_u32) const;
+        void SetPublished(float value_f32, uint32_t now_u32);
+        void Reset(void);
+        static bool Parse_bol(const MqttPayload &payload, uint8_t *index_pu8, 
+                                publishPolicy_t *policy_p);
+        static bool Apply_bol(PublishPolicy *policies_pa, uint8_t count_u8, 
+                                const MqttPayload &payload);
+        static void SaveToRtc(uint32_t sleep_u32);
+        static bool RestoreFromRtc_bol(void);
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        publishPolicy_t     policy_st;
+        float               published_f32;
+        uint32_t            publishedTime_u32;
+        bool                published_bol;
+        static PublishPolicy *instances_pa[PUBLISHPOLICY_RTC_SLOTS];
+
+        /********************************************************************************/
+        /* Private function definitions: */
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* PUBLISHPOLICY_H_ */
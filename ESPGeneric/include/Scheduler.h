@@ -0,0 +1,116 @@
+/*****************************************************************************************
+* FILENAME :        Scheduler.h
+*
+* DESCRIPTION :
+*       Class header for the cooperative timer scheduler
+*
+* NOTES :
+*       Hashed timer wheel with a fixed number of timers. Devices create their
+*       timers once and start them as one shot or periodic timers. The main loop
+*       calls Process() with the actual time and can sleep for GetIdleTime_u32()
+*       milliseconds. All time compares are done on the difference of two
+*       timestamps, so the millis() wraparound after 49 days is handled.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+// number of timers, the H801 uses 7 dim lights without timers, the multi sensor 
+// capability uses the most with ~8 timers
+#define SCHEDULER_TIMERS            24u
+// number of wheel slots, has to be a power of two
+#define SCHEDULER_SLOTS             16u
+// resolution of the wheel, one tick is 2^SCHEDULER_TICK_SHIFT milliseconds
+#define SCHEDULER_TICK_SHIFT        4u
+#define SCHEDULER_INVALID           0xFFu
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef void (*schedulerFunc_t)(void *context_p, uint8_t userId_u8);
+
+typedef struct schedulerTimer_tag
+{
+    schedulerFunc_t func_p;
+    void            *context_p;
+    uint32_t        deadline_u32;
+    uint32_t        period_u32;
+    uint8_t         userId_u8;
+    uint8_t         list_u8;
+    uint8_t         next_u8;
+}schedulerTimer_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class Scheduler
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        Scheduler();
+        uint8_t Create_u8(schedulerFunc_t func_p, void *context_p, uint8_t userId_u8);
+        bool Start(uint8_t timer_u8, uint32_t now_u32, uint32_t delay_u32, 
+                    uint32_t period_u32);
+        void Stop(uint8_t timer_u8);
+        bool IsActive_bol(uint8_t timer_u8) const;
+        uint8_t Process_u8(uint32_t now_u32);
+        uint32_t GetIdleTime_u32(uint32_t now_u32, uint32_t maxIdle_u32) const;
+        uint8_t GetSize_u8(void) const;
+        void Wakeup(void);
+        bool TakeWakeup_bol(void);
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        schedulerTimer_t    timers_sta[SCHEDULER_TIMERS];
+        uint8_t             slots_u8a[SCHEDULER_SLOTS];
+        uint8_t             size_u8;
+        uint32_t            lastTime_u32;
+        volatile bool       wakeup_bol;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+        void Link(uint8_t timer_u8);
+        void Unlink(uint8_t timer_u8);
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* SCHEDULER_H_ */
@@ -36,6 +36,7 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #include "Trace.h"
 #include "PubSubClient.h"
 #include "GpioDevice.h"
+#include "PublishPolicy.h"
 
 #include <ESP8266WiFi.h>         
 #include <PubSubClient.h>
@@ -67,7 +68,8 @@ class Sen0193 : public MqttDevice
 
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         virtual
@@ -76,7 +78,6 @@ class Sen0193 : public MqttDevice
         /********************************************************************************/
         /* Private data definitions */
         uint32_t    publishData_u32;
-        char        buffer_ca[100];
         GpioDevice *lowMoistPin_p;
         GpioDevice *medMoistPin_p; 
         GpioDevice *highMoistPin_p;
@@ -87,6 +88,13 @@ class Sen0193 : public MqttDevice
         uint16_t    rawData_u16;
         uint32_t    prevTime_u32;
         uint32_t    reportCycleMSec_u32;
+        bool        reportRequest_bol;
+        bool        sampleRequest_bol;
+        bool        sampling_bol;
+        uint8_t     adcId_u8;
+        uint8_t     lastLevel_u8;
+        const char  *lastStatus_chrp;
+        PublishPolicy policy_st;
         uint8_t     moistureId_u8;
         uint8_t     mode_u8;
         const char        *status_chrp;
@@ -113,9 +121,11 @@ class Sen0193 : public MqttDevice
         char *f2s(float f, int p);
         void PowerOn();
         void PowerOff();
-        void ReadData();
+        bool ReadData();
+        bool PublishData(PubSubClient *client);
         void ProcessMoisture(void);
         void SetMoistureLevelPins();
+        void ProcessTimer(uint8_t timerId_u8);
 
 
 };
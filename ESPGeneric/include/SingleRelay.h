@@ -62,7 +62,8 @@ class SingleRelay : public MqttDevice
         SingleRelay(Trace *p_trace, GpioDevice  *gpio_p, const char* relayChan_p, bool invert_bol);
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         void ToggleRelay(void);
@@ -73,7 +74,6 @@ class SingleRelay : public MqttDevice
         /* Private data definitions */ 
         boolean relayState_bol        = false;
         boolean publishState_bol      = true;
-        char buffer_ca[100];
         const char *channel_p;
         boolean invert_bol            = false;
         GpioDevice *gpio_p;
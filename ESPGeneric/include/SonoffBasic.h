@@ -65,7 +65,8 @@ class SonoffBasic : public MqttDevice
         SonoffBasic(Trace *p_trace, uint8_t ledPin_u8);
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         void ToggleRelay(void);
@@ -79,7 +80,6 @@ class SonoffBasic : public MqttDevice
         boolean relayState_bol        = false;
         boolean publishState_bol      = true;
         uint8_t ledPin_u8             = 0;
-        char buffer_ca[100];
         
         /********************************************************************************/
         /* Private function definitions: */
@@ -36,6 +36,7 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #include "Trace.h"
 #include "PubSubClient.h"
 #include "GpioDevice.h"
+#include "PublishPolicy.h"
 
 #include <ESP8266WiFi.h>         
 #include <PubSubClient.h>
@@ -53,6 +54,7 @@ typedef enum temt6000State_tag
     TEMT6000_OFF              = 0,
     TEMT6000_MEAS_REQ,
     TEMT6000_POWER_STARTED,
+    TEMT6000_SAMPLING,
     TEMT6000_SAMPLE_COMPLETED,
     TEMT6000_MEAS_COMPLETED,
     TEMT6000_MEAS_PUBLISHED,
@@ -76,7 +78,8 @@ class Temt6000 : public MqttDevice
 
         // virtual functions, implementation in derived classes
         bool ProcessPublishRequests(PubSubClient *client);
-        void CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload);
+        void DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload);
         void Initialize();
         void Reconnect(PubSubClient *client_p, const char *dev_p);
         virtual
@@ -85,13 +88,11 @@ class Temt6000 : public MqttDevice
         /********************************************************************************/
         /* Private data definitions */
         uint32_t            publishData_u32;
-        char                buffer_ca[100];
         GpioDevice          *brightPin_p;
         GpioDevice          *pwrPin_p;
         uint8_t             level_u8;
         const char          *level_chrp;
         uint8_t             lastLevel_u8;
-        float               lastBrightness_f32;
         uint16_t            rawData_u16;
         float               brightness_f32;
         uint32_t            prevTime_u32;
@@ -103,9 +104,10 @@ class Temt6000 : public MqttDevice
         temt6000State_t     state_en = TEMT6000_OFF;
         const uint32_t      STATE_LOOP_CYCLE = 500;
         uint32_t            lastReportTime_u32 = 0;
+        bool                stateLoopRequest_bol = false;
 
-        uint32_t            avgData_32;
-        uint16_t            avgCnt_u16;
+        uint8_t             adcId_u8;
+        PublishPolicy       policy_st;
 
         /********************************************************************************/
         /* Private function definitions: */
@@ -121,9 +123,11 @@ class Temt6000 : public MqttDevice
         void PowerOn();
         void PowerOff();
         void ReadData();
+        void TakeData();
         void ProcessBrightness(void);
         boolean PublishData(PubSubClient *client);
         boolean ProcessSensorStateMachine(PubSubClient *client);
+        void ProcessTimer(uint8_t timerId_u8);
 };
 /****************************************************************************************/
 #endif /* TEMT6000_H_ */
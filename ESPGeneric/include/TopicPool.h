@@ -0,0 +1,88 @@
+/*****************************************************************************************
+* FILENAME :        TopicPool.h
+*
+* DESCRIPTION :
+*       Class header for the interned MQTT topic string pool
+*
+* NOTES :
+*       All complete topics of the firmware are stored once in one static character
+*       pool. The pool is cleared before the devices reconnect and filled again by
+*       them, afterwards the topics are only read and never formatted again.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef TOPICPOOL_H_
+#define TOPICPOOL_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+// size of the pool in bytes including the string terminations. Worst case capability
+// is the H801 with 7 dim lights a 5 topics plus the generic topics, ~1.2KB.
+#define TOPICPOOL_SIZE              1536u
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+
+/****************************************************************************************/
+/* Class definition: */
+class TopicPool
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        TopicPool();
+        void Clear(void);
+        const char* Intern(const char *topic_ccp);
+        uint16_t GetUsed_u16(void) const;
+        uint16_t GetSize_u16(void) const;
+        uint8_t GetCount_u8(void) const;
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        char            pool_ca[TOPICPOOL_SIZE];
+        uint16_t        used_u16;
+        uint8_t         count_u8;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* TOPICPOOL_H_ */
@@ -0,0 +1,103 @@
+/*****************************************************************************************
+* FILENAME :        TopicRouter.h
+*
+* DESCRIPTION :
+*       Class header for the MQTT receive topic router
+*
+* NOTES :
+*       The router maps the hash of a subscribed receive topic to the device and
+*       the device local handler id. The table is filled by the devices during
+*       Reconnect() and is looked up for every received message without any heap
+*       allocation. The router keeps only the pointer to the topic, registered
+*       topics have to stay valid until Clear(), e.g. interned in the TopicPool.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef TOPICROUTER_H_
+#define TOPICROUTER_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+// number of routing slots, has to be a power of two. Worst case capability is the
+// H801 with 7 dim lights a 3 topics, the table should stay below 75% load.
+#ifndef TOPICROUTER_SLOTS
+#define TOPICROUTER_SLOTS           32u
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+class MqttDevice;
+
+typedef struct topicRoute_tag
+{
+    uint32_t    hash_u32;
+    const char  *topic_ccp;
+    MqttDevice  *device_p;
+    uint8_t     length_u8;
+    uint8_t     handlerId_u8;
+}topicRoute_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class TopicRouter
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        TopicRouter();
+        void Clear(void);
+        bool Register(const char *topic_ccp, MqttDevice *device_p, uint8_t handlerId_u8);
+        const topicRoute_t* Lookup(const char *topic_ccp) const;
+        uint8_t GetSize_u8(void) const;
+        uint8_t GetFailures_u8(void) const;
+        static uint32_t Hash_u32(const char *topic_ccp, uint8_t *length_pu8);
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        topicRoute_t    routes_sta[TOPICROUTER_SLOTS];
+        uint8_t         size_u8;
+        uint8_t         failures_u8;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* TOPICROUTER_H_ */
@@ -34,7 +34,9 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 /* Imported header files: */
 #include <ESP8266WiFi.h>
 #include <PubSubClient.h>
-#include <LinkedList.h>
+#include "MqttPayload.h"
+#include "TraceRing.h"
+#include "TraceFormat.h"
 
 /****************************************************************************************/
 /* Global constant defines: */
@@ -42,15 +44,65 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define trace_INFO_MSG  1u
 #define trace_WARN_MSG  2u
 #define trace_ERROR_MSG 3u
+// marks a binary record in the record buffer
+#define trace_BINARY_FLAG 0x80u
 
 #define trace_CHANNEL_OFF     0
 #define trace_CHANNEL_SERIAL  1
 #define trace_CHANNEL_MQTT    2
+
+#define trace_LEVEL_NONE      4u
+// lowest message type compiled into the firmware, selected per build environment
+// with -D TRACE_LEVEL=<type>, e.g. trace_WARN_MSG removes all info traces
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL           trace_INFO_MSG
+#endif
+
+#define trace_TOPIC_LENGTH    40
+#define trace_LINE_LENGTH     (TRACERING_MAX_TEXT + 1u)
+
+// record buffers, error messages have their own buffer, so an info flood 
+// never overwrites them. The sizes have to be a power of two.
+#ifndef trace_INFO_RING_SIZE
+#define trace_INFO_RING_SIZE  1024u
+#endif
+#ifndef trace_ERROR_RING_SIZE
+#define trace_ERROR_RING_SIZE 256u
+#endif
+// payload limit of one batched MQTT trace publish
+#ifndef trace_BATCH_SIZE
+#define trace_BATCH_SIZE      256u
+#endif
+// token bucket per level, records per second and burst size
+#define trace_INFO_RATE       10u
+#define trace_INFO_BURST      30u
+#define trace_ERROR_RATE      10u
+#define trace_ERROR_BURST     30u
 /****************************************************************************************/
 /* Global function like macro defines (to be avoided): */
+// The trace call is only compiled for enabled levels. Filtered calls are removed 
+// by the compiler including the evaluation of their arguments. Continuation parts 
+// with trace_PURE_MSG use the macro of the message they belong to.
+#define TRACE_INFO(...)       do { if(trace_IsEnabled(trace_INFO_MSG)) { __VA_ARGS__; } } while(0)
+#define TRACE_WARN(...)       do { if(trace_IsEnabled(trace_WARN_MSG)) { __VA_ARGS__; } } while(0)
+#define TRACE_ERROR(...)      do { if(trace_IsEnabled(trace_ERROR_MSG)) { __VA_ARGS__; } } while(0)
 
 /****************************************************************************************/
 /* Global type definitions (enum, struct, union): */
+typedef struct traceBucket_tag
+{
+    uint32_t    refill_u32;
+    uint16_t    tokens_u16;
+    uint16_t    rate_u16;
+    uint16_t    burst_u16;
+}traceBucket_t;
+
+/****************************************************************************************/
+/* Global function definitions: */
+constexpr bool trace_IsEnabled(uint8_t type_u8)
+{
+    return((trace_PURE_MSG == type_u8) || (TRACE_LEVEL <= type_u8));
+}
 
 /****************************************************************************************/
 /* Class definition: */
@@ -99,35 +151,55 @@ class Trace
         void println(uint8_t type_u8, uint8_t value_u8);
         void print(uint8_t type_u8, uint16_t value_u16);
         void println(uint8_t type_u8, uint16_t value_u16);
+        void print(uint8_t type_u8, const MqttPayload &payload);
+        void println(uint8_t type_u8, const MqttPayload &payload);
+        void PrintlnIsr(uint8_t type_u8, const char *msg_pc);
+        void Log(uint8_t type_u8, uint16_t format_u16);
+        void Log(uint8_t type_u8, uint16_t format_u16, uint32_t arg0_u32);
+        void Log(uint8_t type_u8, uint16_t format_u16, uint32_t arg0_u32, 
+                    uint32_t arg1_u32);
+        void Log(uint8_t type_u8, uint16_t format_u16, uint32_t arg0_u32, 
+                    uint32_t arg1_u32, uint32_t arg2_u32);
+        void Log(uint8_t type_u8, uint16_t format_u16, uint32_t arg0_u32, 
+                    uint32_t arg1_u32, uint32_t arg2_u32, uint32_t arg3_u32);
+        uint32_t GetDropped_u32(void) const;
 
     private:
         /********************************************************************************/
         /* Private data definitions */
-        class Message
-        {
-            public:
-                String msg;
-                uint8_t type_u8;
-        };
-        
         bool isActive_bol;
         uint8_t channel_u8;
-        String buffer_str;
         PubSubClient *client_p; 
         const char *dev_p;
-        LinkedList<Message*> *msgList_p;
-        Message *message_p;
+        uint8_t infBuffer_au8[trace_INFO_RING_SIZE];
+        uint8_t errBuffer_au8[trace_ERROR_RING_SIZE];
+        TraceRing infRing_st;
+        TraceRing errRing_st;
+        traceBucket_t infBucket_st;
+        traceBucket_t errBucket_st;
+        char line_ca[trace_LINE_LENGTH];
+        uint8_t lineLength_u8;
+        bool lineStarted_bol;
         uint8_t type_u8;
-        char buffer_ca[70];
-        char payload_ca[150];
+        uint32_t reportedDrops_u32;
+        char errTopic_ca[trace_TOPIC_LENGTH];
+        char infTopic_ca[trace_TOPIC_LENGTH];
+        char binTopic_ca[trace_TOPIC_LENGTH];
                
         /********************************************************************************/
         /* Private function definitions: */
-        void prepareMsg(uint8_t type_u8, String msg_str);
-        void printMsg(void);
+        void prepareMsg(uint8_t type_u8, const char *msg_pc, uint16_t length_u16);
         void printlnMsg(void);
         char* buildTopic(const char *topic, uint8_t type_u8) ;
-        char* buildPayload(String payload); 
+        const char* getTopic(uint8_t type_u8) const;
+        void publishMsg(uint8_t type_u8, const char *msg_pc, uint16_t length_u16);
+        TraceRing* getRing(uint8_t type_u8);
+        void pushRing(TraceRing *ring_p, traceBucket_t *bucket_p);
+        void publishBatch(TraceRing *ring_p, traceBucket_t *bucket_p);
+        bool takeToken(traceBucket_t *bucket_p, uint32_t now_u32);
+        void logRecord(uint8_t type_u8, uint16_t format_u16, const uint32_t *args_pu32, 
+                        uint8_t count_u8);
+        void reportDrops(void);
 };
 
 #endif /* TRACE_H_ */
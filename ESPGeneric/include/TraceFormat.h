@@ -0,0 +1,102 @@
+/*****************************************************************************************
+* FILENAME :        TraceFormat.h
+*
+* DESCRIPTION :
+*       Class header for the binary trace records with deferred formatting
+*
+* NOTES :
+*       A binary record stores the id of a format string, the time stamp and the
+*       raw argument values. The text is only built when the record is forwarded
+*       to the serial channel or offline by the host decoder, which is compiled
+*       from the same format table. New formats have to be appended at the end
+*       of the table, otherwise recorded traces are decoded with the wrong text.
+*       All arguments are passed as unsigned long, only %lu, %ld and %lx are
+*       allowed in the format strings.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef TRACEFORMAT_H_
+#define TRACEFORMAT_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <Arduino.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+#define TRACEFORMAT_MAX_ARGS        4u
+// format id, time stamp and the arguments as variable length integers
+#define TRACEFORMAT_MAX_BODY        (2u + 4u + (5u * TRACEFORMAT_MAX_ARGS))
+
+// format table, append only: id, format string
+#define TRACEFORMAT_TABLE(ENTRY)                                                    \
+    ENTRY(TRACEFMT_TRACE_DROPS,     "<<trace>> records dropped: %lu")               \
+    ENTRY(TRACEFMT_GPIO_STATE,      "<<espgpio>> Pin Status: %lu / %lu / %lu / %lu")\
+    ENTRY(TRACEFMT_PIR_MOTION,      "<<pir>>Motion interrupt, motion: %lu")
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+#define TRACEFORMAT_ID(id, format)  id,
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef enum traceFormat_tag
+{
+    TRACEFORMAT_TABLE(TRACEFORMAT_ID)
+    TRACEFMT_COUNT
+}traceFormat_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class TraceFormat
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        static uint8_t Encode_u8(uint8_t *body_pu8, uint16_t format_u16, uint32_t time_u32,
+                                    const uint32_t *args_pu32, uint8_t count_u8);
+        static bool Decode_bol(const uint8_t *body_pu8, uint8_t length_u8, 
+                                uint16_t *format_pu16, uint32_t *time_pu32, 
+                                uint32_t *args_pu32, uint8_t *count_pu8);
+        static uint16_t Format_u16(char *text_pch, uint16_t size_u16, 
+                                    const uint8_t *body_pu8, uint8_t length_u8);
+        static const char* GetFormat_ccp(uint16_t format_u16);
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+
+        /********************************************************************************/
+        /* Private function definitions: */
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* TRACEFORMAT_H_ */
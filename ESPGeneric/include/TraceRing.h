@@ -0,0 +1,95 @@
+/*****************************************************************************************
+* FILENAME :        TraceRing.h
+*
+* DESCRIPTION :
+*       Class header for the fixed size trace record ring buffer
+*
+* NOTES :
+*       Records are stored as length byte, type byte and text in a buffer provided
+*       by the owner. When the buffer is full, the oldest records are overwritten
+*       and counted as dropped. Write and read run inside a short critical
+*       section, so the buffer can be written from interrupt service routines.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef TRACERING_H_
+#define TRACERING_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <Arduino.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+// length and type byte in front of every record
+#define TRACERING_HEADER_SIZE       2u
+// longest text of a single record, longer texts are truncated
+#define TRACERING_MAX_TEXT          127u
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+
+/****************************************************************************************/
+/* Class definition: */
+class TraceRing
+{
+    public:
+        /********************************************************************************/
+        /* Public data definitions */
+
+        /********************************************************************************/
+        /* Public function definitions: */
+        TraceRing(uint8_t *buffer_pu8, uint16_t size_u16);
+        void Clear(void);
+        bool Write_bol(uint8_t type_u8, const char *text_ccp, uint8_t length_u8);
+        bool Read_bol(uint8_t *type_pu8, char *text_pch, uint8_t size_u8,
+                        uint8_t *length_pu8);
+        uint16_t GetUsed_u16(void) const;
+        uint16_t GetRecords_u16(void) const;
+        uint32_t GetDropped_u32(void) const;
+
+    private:
+        /********************************************************************************/
+        /* Private data definitions */
+        uint8_t             *buffer_pu8;
+        uint16_t            size_u16;
+        volatile uint16_t   head_u16;
+        volatile uint16_t   tail_u16;
+        volatile uint16_t   records_u16;
+        volatile uint32_t   dropped_u32;
+
+        /********************************************************************************/
+        /* Private function definitions: */
+        void dropOldest(void);
+
+    protected:
+        /********************************************************************************/
+        /* Protected data definitions */
+
+        /********************************************************************************/
+        /* Protected function definitions: */
+
+};
+
+#endif /* TRACERING_H_ */
@@ -34,7 +34,10 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 /* Global constant defines: */
 #define CONFIG_SSID               "ESP_V7_" // SSID of the configuration mode
 #define MAX_AP_TIME               300 // restart eps after 300 sec in config mode
-#define CONNECT_RETRIES           5 
+#define CONNECT_RETRIES           5 // failed attempts after boot until the AP is started
+// ms TCP connect timeout of the WiFi client, the CONNACK wait is limited by the
+// MQTT_SOCKET_TIMEOUT build flag, together they bound a blocking connect attempt
+#define CONNECT_TCP_TIMEOUT       2000
 
 //#define MSG_BUFFER_SIZE         60  // mqtt messages max char size
 #define MQTT_DEFAULT_DEVICE       "devXX" // default room device 
@@ -46,10 +49,13 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PUB_DEV_ROOM         "/s/gen/room" //firmware room
 #define MQTT_PUB_CAP              "/s/gen/cap"  // send capability
 #define MQTT_PUB_TRACE            "/s/gen/trac" // send trace channel
+#define MQTT_PUB_CONN             "/s/gen/conn" // latency of the last broker connect in ms
+#define MQTT_PUB_PROF             "/s/gen/prof" // loop time profile of the devices
 #define MQTT_PUB_PARAM            "/s/gen/par"  // send all parameter 
 #define MQTT_SUB_COMMAND          "/r/gen/cmd" // command message for generic read commands
 #define MQTT_SUB_CAP              "/r/gen/cap" // write message for capability
 #define MQTT_SUB_TRACE            "/r/gen/trac" // write message for trace 
+#define MQTT_SUB_WILDCARD         "/r/#" // all receive topics of the device
 #define MQTT_SUB_BCAST            "bcast/r/gen/cmd" // broadcast command message
 #define MQTT_CLIENT               MQTT_DEFAULT_DEVICE // just a name used to talk to MQTT broker
 #define MQTT_PAYLOAD_CMD_INFO     "INFO"
@@ -58,7 +64,14 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PAYLOAD_CMD_TRAC     "TRACE"
 #define MQTT_PAYLOAD_CMD_PAR      "PAR"
 #define MQTT_PAYLOAD_CMD_ROOM     "ROOM"
-#define PUBLISH_TIME_OFFSET       200     // ms timeout between two publishes
+#define MQTT_PAYLOAD_CMD_PROF     "PROF"
+// 1: subscribe once to std/<dev>/r/# instead of every receive topic, the received
+// topics are dispatched by the topic router as before
+#ifndef MQTT_USE_WILDCARD
+#define MQTT_USE_WILDCARD         0
+#endif
+#define LOOP_IDLE_MAX_TIME        200     // ms maximum idle time of the main loop
+#define LOOP_IDLE_SLICE_TIME      5       // ms idle slice, network data is checked in between
 
 /****************************************************************************************/
 /* Global function like macro defines (to be avoided): */
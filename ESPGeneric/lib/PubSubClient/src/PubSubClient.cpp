@@ -9,6 +9,9 @@
 
 PubSubClient::PubSubClient() {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     this->_client = NULL;
     this->stream = NULL;
     setCallback(NULL);
@@ -16,24 +19,36 @@ PubSubClient::PubSubClient() {
 
 PubSubClient::PubSubClient(Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setClient(client);
     this->stream = NULL;
 }
 
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(addr, port);
     setClient(client);
     this->stream = NULL;
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(addr,port);
     setClient(client);
     setStream(stream);
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(addr, port);
     setCallback(callback);
     setClient(client);
@@ -41,6 +56,9 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATUR
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(addr,port);
     setCallback(callback);
     setClient(client);
@@ -49,18 +67,27 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATUR
 
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(ip, port);
     setClient(client);
     this->stream = NULL;
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(ip,port);
     setClient(client);
     setStream(stream);
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(ip, port);
     setCallback(callback);
     setClient(client);
@@ -68,6 +95,9 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE,
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(ip,port);
     setCallback(callback);
     setClient(client);
@@ -76,18 +106,27 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE,
 
 PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(domain,port);
     setClient(client);
     this->stream = NULL;
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(domain,port);
     setClient(client);
     setStream(stream);
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(domain,port);
     setCallback(callback);
     setClient(client);
@@ -95,6 +134,9 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGN
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->streamValid = false;
+    this->streamRemaining = 0;
+    clearInflight();
     setServer(domain,port);
     setCallback(callback);
     setClient(client);
@@ -191,6 +233,12 @@ boolean PubSubClient::connect(const char *id, const char *user, const char *pass
                     lastInActivity = millis();
                     pingOutstanding = false;
                     _state = MQTT_CONNECTED;
+                    // Messages not acknowledged before the connection was lost
+                    for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+                        if (inflightMsgs[i].msgId != 0) {
+                            retransmit(&inflightMsgs[i]);
+                        }
+                    }
                     return true;
                 } else {
                     _state = buffer[3];
@@ -296,6 +344,7 @@ boolean PubSubClient::loop() {
                 pingOutstanding = true;
             }
         }
+        retransmitExpired(t);
         if (_client->available()) {
             uint8_t llen;
             uint16_t len = readPacket(&llen);
@@ -336,6 +385,15 @@ boolean PubSubClient::loop() {
                     _client->write(buffer,2);
                 } else if (type == MQTTPINGRESP) {
                     pingOutstanding = false;
+                } else if (type == MQTTPUBACK) {
+                    msgId = (buffer[llen+1]<<8)+buffer[llen+2];
+                    for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+                        if (msgId != 0 && inflightMsgs[i].msgId == msgId) {
+                            inflightMsgs[i].msgId = 0;
+                            inflightCount--;
+                            break;
+                        }
+                    }
                 }
             }
         }
@@ -378,6 +436,60 @@ boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigne
     return false;
 }
 
+boolean PubSubClient::publish(const char* topic, const char* payload, uint8_t qos, boolean retained) {
+    return publish(topic,(const uint8_t*)payload,strlen(payload),qos,retained);
+}
+
+boolean PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int plength, uint8_t qos, boolean retained) {
+    if (qos == 0) {
+        return publish(topic,payload,plength,retained);
+    }
+    if (qos > 1) {
+        // QoS 2 is not supported
+        return false;
+    }
+    if (connected()) {
+        if (MQTT_MAX_PACKET_SIZE < 5 + 2+strlen(topic) + 2 + plength) {
+            // Too long
+            return false;
+        }
+        MqttInflight* msg = NULL;
+        for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+            if (inflightMsgs[i].msgId == 0) {
+                msg = &inflightMsgs[i];
+                break;
+            }
+        }
+        if (msg == NULL) {
+            // In-flight window full
+            return false;
+        }
+        uint16_t msgId = allocMsgId();
+        uint16_t length = 5;
+        length = writeString(topic,buffer,length);
+        buffer[length++] = (msgId >> 8);
+        buffer[length++] = (msgId & 0xFF);
+        uint16_t i;
+        for (i=0;i<plength;i++) {
+            buffer[length++] = payload[i];
+        }
+        uint8_t header = MQTTPUBLISH|MQTTQOS1;
+        if (retained) {
+            header |= 1;
+        }
+        msg->msgId = msgId;
+        msg->header = header;
+        msg->length = length-5;
+        memcpy(msg->packet,buffer+5,msg->length);
+        msg->lastSent = millis();
+        inflightCount++;
+        // A failed write is repeated by the retransmission
+        write(header,buffer,length-5);
+        return true;
+    }
+    return false;
+}
+
 boolean PubSubClient::publish_P(const char* topic, const uint8_t* payload, unsigned int plength, boolean retained) {
     uint8_t llen = 0;
     uint8_t digit;
@@ -423,13 +535,80 @@ boolean PubSubClient::publish_P(const char* topic, const uint8_t* payload, unsig
     return rc == tlen + 4 + plength;
 }
 
-boolean PubSubClient::write(uint8_t header, uint8_t* buf, uint16_t length) {
+boolean PubSubClient::beginPublish(const char* topic, uint32_t plength, boolean retained) {
+    uint16_t length;
+    uint16_t rc;
+    size_t hlen;
+    uint8_t header;
+
+    streamValid = false;
+    streamRemaining = 0;
+    if (connected()) {
+        if (MQTT_MAX_PACKET_SIZE < MQTT_MAX_HEADER_SIZE + 2+strlen(topic)) {
+            // Topic too long
+            return false;
+        }
+        // Only the header and the topic use the buffer, the payload is streamed
+        length = writeString(topic,buffer,MQTT_MAX_HEADER_SIZE);
+        if (plength > MQTT_MAX_REMAINING_LENGTH - (length-MQTT_MAX_HEADER_SIZE)) {
+            // Remaining length does not fit into the 4 byte length field
+            return false;
+        }
+        header = MQTTPUBLISH;
+        if (retained) {
+            header |= 1;
+        }
+        hlen = buildHeader(header,buffer,plength+length-MQTT_MAX_HEADER_SIZE);
+        rc = _client->write(buffer+(MQTT_MAX_HEADER_SIZE-hlen),length-(MQTT_MAX_HEADER_SIZE-hlen));
+        lastOutActivity = millis();
+        streamValid = (rc == (length-(MQTT_MAX_HEADER_SIZE-hlen)));
+        streamRemaining = plength;
+    }
+    return streamValid;
+}
+
+size_t PubSubClient::write(uint8_t data) {
+    return write(&data,1);
+}
+
+size_t PubSubClient::write(const uint8_t *buffer, size_t size) {
+    size_t rc;
+
+    if (!streamValid) {
+        return 0;
+    }
+    // Never write more than announced in the header
+    if (size > streamRemaining) {
+        size = streamRemaining;
+    }
+    rc = _client->write(buffer,size);
+    streamRemaining -= rc;
+    if (rc != size) {
+        streamValid = false;
+    }
+    lastOutActivity = millis();
+    return rc;
+}
+
+int PubSubClient::endPublish() {
+    boolean result = streamValid && (streamRemaining == 0);
+
+    if (!result && connected()) {
+        // The broker still waits for payload bytes, the connection is unusable
+        _state = MQTT_CONNECTION_LOST;
+        _client->stop();
+    }
+    streamValid = false;
+    streamRemaining = 0;
+    return result ? 1 : 0;
+}
+
+size_t PubSubClient::buildHeader(uint8_t header, uint8_t* buf, uint32_t length) {
     uint8_t lenBuf[4];
     uint8_t llen = 0;
     uint8_t digit;
     uint8_t pos = 0;
-    uint16_t rc;
-    uint16_t len = length;
+    uint32_t len = length;
     do {
         digit = len % 128;
         len = len / 128;
@@ -438,16 +617,22 @@ boolean PubSubClient::write(uint8_t header, uint8_t* buf, uint16_t length) {
         }
         lenBuf[pos++] = digit;
         llen++;
-    } while(len>0);
+    } while((len>0) && (llen<4));
 
-    buf[4-llen] = header;
+    buf[MQTT_MAX_HEADER_SIZE-1-llen] = header;
     for (int i=0;i<llen;i++) {
-        buf[5-llen+i] = lenBuf[i];
+        buf[MQTT_MAX_HEADER_SIZE-llen+i] = lenBuf[i];
     }
+    return llen+1;
+}
+
+boolean PubSubClient::write(uint8_t header, uint8_t* buf, uint16_t length) {
+    uint16_t rc;
+    uint8_t hlen = buildHeader(header, buf, length);
 
 #ifdef MQTT_MAX_TRANSFER_SIZE
-    uint8_t* writeBuf = buf+(4-llen);
-    uint16_t bytesRemaining = length+1+llen;  //Match the length type
+    uint8_t* writeBuf = buf+(MQTT_MAX_HEADER_SIZE-hlen);
+    uint16_t bytesRemaining = length+hlen;  //Match the length type
     uint8_t bytesToWrite;
     boolean result = true;
     while((bytesRemaining > 0) && result) {
@@ -459,9 +644,9 @@ boolean PubSubClient::write(uint8_t header, uint8_t* buf, uint16_t length) {
     }
     return result;
 #else
-    rc = _client->write(buf+(4-llen),length+1+llen);
+    rc = _client->write(buf+(MQTT_MAX_HEADER_SIZE-hlen),length+hlen);
     lastOutActivity = millis();
-    return (rc == 1+llen+length);
+    return (rc == hlen+length);
 #endif
 }
 
@@ -480,12 +665,9 @@ boolean PubSubClient::subscribe(const char* topic, uint8_t qos) {
     if (connected()) {
         // Leave room in the buffer for header and variable length field
         uint16_t length = 5;
-        nextMsgId++;
-        if (nextMsgId == 0) {
-            nextMsgId = 1;
-        }
-        buffer[length++] = (nextMsgId >> 8);
-        buffer[length++] = (nextMsgId & 0xFF);
+        uint16_t msgId = allocMsgId();
+        buffer[length++] = (msgId >> 8);
+        buffer[length++] = (msgId & 0xFF);
         length = writeString((char*)topic, buffer,length);
         buffer[length++] = qos;
         return write(MQTTSUBSCRIBE|MQTTQOS1,buffer,length-5);
@@ -493,6 +675,38 @@ boolean PubSubClient::subscribe(const char* topic, uint8_t qos) {
     return false;
 }
 
+boolean PubSubClient::subscribe(const char* topics[], const uint8_t qos[], uint8_t count) {
+    uint32_t total = 5 + 2;
+    uint8_t i;
+
+    if (count == 0) {
+        return false;
+    }
+    for (i=0;i<count;i++) {
+        if (qos != NULL && qos[i] > 1) {
+            return false;
+        }
+        total += 2 + strlen(topics[i]) + 1;
+    }
+    if (MQTT_MAX_PACKET_SIZE < total) {
+        // Too long
+        return false;
+    }
+    if (connected()) {
+        // Leave room in the buffer for header and variable length field
+        uint16_t length = 5;
+        uint16_t msgId = allocMsgId();
+        buffer[length++] = (msgId >> 8);
+        buffer[length++] = (msgId & 0xFF);
+        for (i=0;i<count;i++) {
+            length = writeString(topics[i], buffer,length);
+            buffer[length++] = (qos != NULL) ? qos[i] : 0;
+        }
+        return write(MQTTSUBSCRIBE|MQTTQOS1,buffer,length-5);
+    }
+    return false;
+}
+
 boolean PubSubClient::unsubscribe(const char* topic) {
     if (MQTT_MAX_PACKET_SIZE < 9 + strlen(topic)) {
         // Too long
@@ -500,16 +714,59 @@ boolean PubSubClient::unsubscribe(const char* topic) {
     }
     if (connected()) {
         uint16_t length = 5;
+        uint16_t msgId = allocMsgId();
+        buffer[length++] = (msgId >> 8);
+        buffer[length++] = (msgId & 0xFF);
+        length = writeString(topic, buffer,length);
+        return write(MQTTUNSUBSCRIBE|MQTTQOS1,buffer,length-5);
+    }
+    return false;
+}
+
+uint8_t PubSubClient::inflight() {
+    return inflightCount;
+}
+
+void PubSubClient::clearInflight() {
+    for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+        inflightMsgs[i].msgId = 0;
+    }
+    inflightCount = 0;
+}
+
+uint16_t PubSubClient::allocMsgId() {
+    boolean used;
+    do {
         nextMsgId++;
         if (nextMsgId == 0) {
             nextMsgId = 1;
         }
-        buffer[length++] = (nextMsgId >> 8);
-        buffer[length++] = (nextMsgId & 0xFF);
-        length = writeString(topic, buffer,length);
-        return write(MQTTUNSUBSCRIBE|MQTTQOS1,buffer,length-5);
+        // Ids of unacknowledged messages survive a reconnect
+        used = false;
+        for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+            if (inflightMsgs[i].msgId == nextMsgId) {
+                used = true;
+            }
+        }
+    } while (used);
+    return nextMsgId;
+}
+
+boolean PubSubClient::retransmit(MqttInflight* msg) {
+    memcpy(buffer+5,msg->packet,msg->length);
+    msg->lastSent = millis();
+    return write(msg->header|MQTTDUP,buffer,msg->length);
+}
+
+void PubSubClient::retransmitExpired(unsigned long t) {
+    if (inflightCount == 0) {
+        return;
+    }
+    for (uint8_t i = 0;i<MQTT_MAX_INFLIGHT;i++) {
+        if (inflightMsgs[i].msgId != 0 && t - inflightMsgs[i].lastSent >= MQTT_RETRY_TIMEOUT) {
+            retransmit(&inflightMsgs[i]);
+        }
     }
-    return false;
 }
 
 void PubSubClient::disconnect() {
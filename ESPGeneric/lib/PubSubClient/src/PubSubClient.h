@@ -26,6 +26,12 @@
 #define MQTT_MAX_PACKET_SIZE 128
 #endif
 
+// MQTT_MAX_HEADER_SIZE : Fixed header plus the longest remaining length field
+#define MQTT_MAX_HEADER_SIZE 5
+
+// MQTT_MAX_REMAINING_LENGTH : Largest remaining length of the 4 byte length field
+#define MQTT_MAX_REMAINING_LENGTH 268435455UL
+
 // MQTT_KEEPALIVE : keepAlive interval in Seconds
 #ifndef MQTT_KEEPALIVE
 #define MQTT_KEEPALIVE 15
@@ -36,6 +42,18 @@
 #define MQTT_SOCKET_TIMEOUT 15
 #endif
 
+// MQTT_MAX_INFLIGHT : Number of QoS 1 messages waiting for a PUBACK. Each entry
+//  holds a copy of the packet, so it costs about MQTT_MAX_PACKET_SIZE bytes of RAM.
+#ifndef MQTT_MAX_INFLIGHT
+#define MQTT_MAX_INFLIGHT 4
+#endif
+
+// MQTT_RETRY_TIMEOUT : Time in milliseconds until an unacknowledged QoS 1 message
+//  is sent again with the DUP flag set
+#ifndef MQTT_RETRY_TIMEOUT
+#define MQTT_RETRY_TIMEOUT 5000
+#endif
+
 // MQTT_MAX_TRANSFER_SIZE : limit how much data is passed to the network client
 //  in each write call. Needed for the Arduino Wifi Shield. Leave undefined to
 //  pass the entire MQTT packet in each write call.
@@ -72,6 +90,7 @@
 #define MQTTQOS0        (0 << 1)
 #define MQTTQOS1        (1 << 1)
 #define MQTTQOS2        (2 << 1)
+#define MQTTDUP         (1 << 3)
 
 #ifdef ESP8266
 #include <functional>
@@ -80,6 +99,14 @@
 #define MQTT_CALLBACK_SIGNATURE void (*callback)(char*, uint8_t*, unsigned int)
 #endif
 
+typedef struct {
+   uint16_t msgId;
+   uint16_t length;
+   unsigned long lastSent;
+   uint8_t header;
+   uint8_t packet[MQTT_MAX_PACKET_SIZE-MQTT_MAX_HEADER_SIZE];
+} MqttInflight;
+
 class PubSubClient {
 private:
    Client* _client;
@@ -93,12 +120,20 @@ private:
    boolean readByte(uint8_t * result);
    boolean readByte(uint8_t * result, uint16_t * index);
    boolean write(uint8_t header, uint8_t* buf, uint16_t length);
+   size_t buildHeader(uint8_t header, uint8_t* buf, uint32_t length);
    uint16_t writeString(const char* string, uint8_t* buf, uint16_t pos);
    IPAddress ip;
    const char* domain;
    uint16_t port;
    Stream* stream;
    int _state;
+   uint32_t streamRemaining;
+   boolean streamValid;
+   MqttInflight inflightMsgs[MQTT_MAX_INFLIGHT];
+   uint8_t inflightCount;
+   uint16_t allocMsgId();
+   boolean retransmit(MqttInflight* msg);
+   void retransmitExpired(unsigned long t);
 public:
    PubSubClient();
    PubSubClient(Client& client);
@@ -131,10 +166,30 @@ public:
    boolean publish(const char* topic, const char* payload, boolean retained);
    boolean publish(const char* topic, const uint8_t * payload, unsigned int plength);
    boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
+   // Publish with QoS 0 or 1. A QoS 1 message is kept until the broker sends the
+   // PUBACK and is sent again with the DUP flag after MQTT_RETRY_TIMEOUT and after
+   // a reconnect. Returns false if all MQTT_MAX_INFLIGHT entries are in use.
+   boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, uint8_t qos, boolean retained);
+   boolean publish(const char* topic, const char* payload, uint8_t qos, boolean retained);
    boolean publish_P(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
+   // Start to publish a message. The payload of plength bytes is passed with
+   // write() straight to the client, so it can be larger than MQTT_MAX_PACKET_SIZE.
+   // No other packet must be sent until endPublish() is called. Fails if the topic
+   // and the payload exceed MQTT_MAX_REMAINING_LENGTH.
+   boolean beginPublish(const char* topic, uint32_t plength, boolean retained);
+   size_t write(uint8_t);
+   size_t write(const uint8_t *buffer, size_t size);
+   // Finish the publish, returns 1 if the complete payload was written. Otherwise
+   // the stream is corrupt and the connection is closed.
+   int endPublish();
    boolean subscribe(const char* topic);
    boolean subscribe(const char* topic, uint8_t qos);
+   // Subscribe to count topic filters with one SUBSCRIBE packet. qos may be NULL
+   // for QoS 0. Fails if the packet does not fit into MQTT_MAX_PACKET_SIZE.
+   boolean subscribe(const char* topics[], const uint8_t qos[], uint8_t count);
    boolean unsubscribe(const char* topic);
+   uint8_t inflight();
+   void clearInflight();
    boolean loop();
    boolean connected();
    int state();
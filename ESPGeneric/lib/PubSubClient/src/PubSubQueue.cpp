@@ -0,0 +1,131 @@
+/*
+  PubSubQueue.cpp - A bounded outbound publish queue for PubSubClient.
+*/
+
+#include "PubSubQueue.h"
+
+PubSubQueue::PubSubQueue(PubSubClient& client) {
+    this->_client = &client;
+    clear();
+    resetCounters();
+}
+
+boolean PubSubQueue::publish(const char* topic, const char* payload) {
+    return publish(topic,(const uint8_t*)payload,strlen(payload),false);
+}
+
+boolean PubSubQueue::publish(const char* topic, const char* payload, boolean retained) {
+    return publish(topic,(const uint8_t*)payload,strlen(payload),retained);
+}
+
+boolean PubSubQueue::publish(const char* topic, const uint8_t* payload, unsigned int plength, boolean retained) {
+    return publish(topic,payload,plength,0,retained);
+}
+
+boolean PubSubQueue::publish(const char* topic, const char* payload, uint8_t qos, boolean retained) {
+    return publish(topic,(const uint8_t*)payload,strlen(payload),qos,retained);
+}
+
+boolean PubSubQueue::publish(const char* topic, const uint8_t* payload, unsigned int plength, uint8_t qos, boolean retained) {
+    size_t tlength;
+    Entry* entry;
+
+    if (topic == NULL) {
+        return false;
+    }
+    tlength = strlen(topic);
+    // QoS 1 needs two more bytes in the packet for the message id
+    if ((qos > 1) || (tlength + 1 + plength + (qos ? 2 : 0) > MQTT_QUEUE_ENTRY_SIZE)) {
+        // Too long, publish() would reject it as well
+        dropped++;
+        return false;
+    }
+    if (retained) {
+        // Only the latest retained value of a topic is of interest
+        entry = find(topic,tlength);
+        if (entry != NULL) {
+            memcpy(entry->data+tlength+1,payload,plength);
+            entry->payloadLength = plength;
+            entry->qos = qos;
+            collapsed++;
+            return true;
+        }
+    }
+    if (count >= MQTT_QUEUE_SIZE) {
+        dropped++;
+        return false;
+    }
+    entry = &entries[(head+count)%MQTT_QUEUE_SIZE];
+    memcpy(entry->data,topic,tlength+1);
+    memcpy(entry->data+tlength+1,payload,plength);
+    entry->topicLength = tlength;
+    entry->payloadLength = plength;
+    entry->retained = retained;
+    entry->qos = qos;
+    count++;
+    if (count > highWater) {
+        highWater = count;
+    }
+    return true;
+}
+
+uint8_t PubSubQueue::flush() {
+    uint8_t sent = 0;
+    Entry* entry;
+
+    // Send until the queue is empty or the client refuses a message, the
+    // refused message stays at the head and is sent with the next flush. A QoS 1
+    // message is refused while the in-flight window of the client is full.
+    while (count > 0) {
+        entry = &entries[head];
+        if (!_client->publish((const char*)entry->data,entry->data+entry->topicLength+1,
+                              entry->payloadLength,entry->qos,entry->retained)) {
+            break;
+        }
+        head = (head+1)%MQTT_QUEUE_SIZE;
+        count--;
+        sent++;
+    }
+    return sent;
+}
+
+void PubSubQueue::clear() {
+    head = 0;
+    count = 0;
+}
+
+uint8_t PubSubQueue::depth() {
+    return count;
+}
+
+uint8_t PubSubQueue::maxDepth() {
+    return highWater;
+}
+
+uint16_t PubSubQueue::droppedCount() {
+    return dropped;
+}
+
+uint16_t PubSubQueue::collapsedCount() {
+    return collapsed;
+}
+
+void PubSubQueue::resetCounters() {
+    highWater = count;
+    dropped = 0;
+    collapsed = 0;
+}
+
+PubSubQueue::Entry* PubSubQueue::find(const char* topic, uint16_t tlength) {
+    uint8_t i;
+    Entry* entry;
+
+    for (i=0;i<count;i++) {
+        entry = &entries[(head+i)%MQTT_QUEUE_SIZE];
+        if (entry->retained && (entry->topicLength == tlength) &&
+            (memcmp(entry->data,topic,tlength) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,59 @@
+/*
+ PubSubQueue.h - A bounded outbound publish queue for PubSubClient.
+  The queue uses a fixed ring of entries and no heap. Retained messages
+  for a topic already in the queue replace the queued payload, so only
+  the latest value is sent.
+*/
+
+#ifndef PubSubQueue_h
+#define PubSubQueue_h
+
+#include "PubSubClient.h"
+
+// MQTT_QUEUE_SIZE : Maximum number of queued messages
+#ifndef MQTT_QUEUE_SIZE
+#define MQTT_QUEUE_SIZE 8
+#endif
+
+// MQTT_QUEUE_ENTRY_SIZE : Maximum size of topic, terminator and payload of a
+//  queued message. The default accepts every message publish() can send.
+#ifndef MQTT_QUEUE_ENTRY_SIZE
+#define MQTT_QUEUE_ENTRY_SIZE (MQTT_MAX_PACKET_SIZE - 6)
+#endif
+
+class PubSubQueue {
+private:
+   struct Entry {
+      uint16_t topicLength;
+      uint16_t payloadLength;
+      boolean retained;
+      uint8_t qos;
+      uint8_t data[MQTT_QUEUE_ENTRY_SIZE];
+   };
+   PubSubClient* _client;
+   Entry entries[MQTT_QUEUE_SIZE];
+   uint8_t head;
+   uint8_t count;
+   uint8_t highWater;
+   uint16_t dropped;
+   uint16_t collapsed;
+   Entry* find(const char* topic, uint16_t tlength);
+public:
+   PubSubQueue(PubSubClient& client);
+
+   boolean publish(const char* topic, const char* payload);
+   boolean publish(const char* topic, const char* payload, boolean retained);
+   boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
+   boolean publish(const char* topic, const char* payload, uint8_t qos, boolean retained);
+   boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, uint8_t qos, boolean retained);
+   uint8_t flush();
+   void clear();
+
+   uint8_t depth();
+   uint8_t maxDepth();
+   uint16_t droppedCount();
+   uint16_t collapsedCount();
+   void resetCounters();
+};
+
+#endif
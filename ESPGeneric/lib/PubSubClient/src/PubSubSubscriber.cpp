@@ -0,0 +1,93 @@
+/*
+  PubSubSubscriber.cpp - Collects subscriptions for PubSubClient.
+*/
+
+#include "PubSubSubscriber.h"
+
+PubSubSubscriber::PubSubSubscriber(PubSubClient& client) {
+    this->_client = &client;
+    clear();
+    resetCounters();
+}
+
+boolean PubSubSubscriber::subscribe(const char* topic) {
+    return subscribe(topic,0);
+}
+
+boolean PubSubSubscriber::subscribe(const char* topic, uint8_t qos) {
+    if (topic == NULL || qos > 1) {
+        return false;
+    }
+    if (count >= MQTT_SUBSCRIBE_BATCH) {
+        flush();
+    }
+    topics[count] = topic;
+    this->qos[count] = qos;
+    count++;
+    return true;
+}
+
+uint8_t PubSubSubscriber::flush() {
+    uint8_t packets = 0;
+    uint8_t start = 0;
+    uint8_t end;
+    uint32_t length;
+    uint32_t entry;
+
+    while (start < count) {
+        // Take as many topics as fit into one packet: header, msgId, and
+        // length, topic and qos of each filter
+        length = 5 + 2;
+        end = start;
+        while (end < count) {
+            entry = 2 + strlen(topics[end]) + 1;
+            if (length + entry > MQTT_MAX_PACKET_SIZE) {
+                break;
+            }
+            length += entry;
+            end++;
+        }
+        if (end == start) {
+            // A single topic does not fit, it can't be subscribed at all
+            failed++;
+            start++;
+            continue;
+        }
+        if (_client->subscribe(topics+start,qos+start,end-start)) {
+            packets++;
+            sentTopics += end-start;
+        } else {
+            failed += end-start;
+        }
+        start = end;
+    }
+    sentPackets += packets;
+    count = 0;
+    return packets;
+}
+
+void PubSubSubscriber::clear() {
+    count = 0;
+}
+
+uint8_t PubSubSubscriber::pending() {
+    return count;
+}
+
+uint16_t PubSubSubscriber::packetCount() {
+    return sentPackets;
+}
+
+uint16_t PubSubSubscriber::topicCount() {
+    return sentTopics;
+}
+
+uint16_t PubSubSubscriber::failedCount() {
+    return failed;
+}
+
+void PubSubSubscriber::resetCounters() {
+    sentPackets = 0;
+    sentTopics = 0;
+    failed = 0;
+}
@@ -0,0 +1,44 @@
+/*
+ PubSubSubscriber.h - Collects subscriptions for PubSubClient and sends
+  them with as few SUBSCRIBE packets as fit into MQTT_MAX_PACKET_SIZE.
+  Only the topic pointers are stored, the topics have to stay valid
+  until flush() is called.
+*/
+
+#ifndef PubSubSubscriber_h
+#define PubSubSubscriber_h
+
+#include "PubSubClient.h"
+
+// MQTT_SUBSCRIBE_BATCH : Maximum number of collected subscriptions
+#ifndef MQTT_SUBSCRIBE_BATCH
+#define MQTT_SUBSCRIBE_BATCH 24
+#endif
+
+class PubSubSubscriber {
+private:
+   PubSubClient* _client;
+   const char* topics[MQTT_SUBSCRIBE_BATCH];
+   uint8_t qos[MQTT_SUBSCRIBE_BATCH];
+   uint8_t count;
+   uint16_t sentPackets;
+   uint16_t sentTopics;
+   uint16_t failed;
+public:
+   PubSubSubscriber(PubSubClient& client);
+
+   // Add a subscription, a full collector is flushed first
+   boolean subscribe(const char* topic);
+   boolean subscribe(const char* topic, uint8_t qos);
+   // Send all collected subscriptions, returns the number of packets
+   uint8_t flush();
+   void clear();
+
+   uint8_t pending();
+   uint16_t packetCount();
+   uint16_t topicCount();
+   uint16_t failedCount();
+   void resetCounters();
+};
+
+#endif
@@ -15,6 +15,8 @@ extern "C"{
     extern void setup( void ) ;
     extern void loop( void ) ;
     uint32_t millis( void );
+    /* test clock, moves millis() forward */
+    void shimAdvanceMillis( uint32_t ms );
 }
 
 #define PROGMEM
@@ -4,9 +4,14 @@
 #include <Arduino.h>
 #include <ctime>
 
+static uint32_t millisOffset = 0;
+
 extern "C" {
     uint32_t millis(void) {
-       return time(0)*1000;
+       return time(0)*1000 + millisOffset;
+    }
+    void shimAdvanceMillis(uint32_t ms) {
+       millisOffset += ms;
     }
 }
 
@@ -18,7 +23,9 @@ ShimClient::ShimClient() {
     this->_error = false;
     this->expectAnything = true;
     this->_received = 0;
+    this->_writes = 0;
     this->_expectedPort = 0;
+    this->_writeCapacity = -1;
 }
 
 int ShimClient::connect(IPAddress ip, uint16_t port) {
@@ -55,6 +62,11 @@ int ShimClient::connect(const char *host, uint16_t port)  {
     return this->_connected;
 }
 size_t ShimClient::write(uint8_t b)  {
+    if (this->_writeCapacity == 0) {
+        return 0;
+    } else if (this->_writeCapacity > 0) {
+        this->_writeCapacity -= 1;
+    }
     this->_received += 1;
     TRACE(std::hex << (unsigned int)b);
     if (!this->expectAnything) {
@@ -72,7 +84,15 @@ size_t ShimClient::write(uint8_t b)  {
     return 1;
 }
 size_t ShimClient::write(const uint8_t *buf, size_t size)  {
+    if (this->_writeCapacity >= 0) {
+        // simulate a full socket buffer, nothing is written
+        if ((size_t)this->_writeCapacity < size) {
+            return 0;
+        }
+        this->_writeCapacity -= size;
+    }
     this->_received += size;
+    this->_writes++;
     TRACE( "[" << std::dec << (unsigned int)(size) << "] ");
     uint16_t i=0;
     for (;i<size;i++) {
@@ -130,6 +150,9 @@ ShimClient* ShimClient::expect(uint8_t *buf, size_t size) {
 void ShimClient::setConnected(bool b) {
     this->_connected = b;
 }
+void ShimClient::setWriteCapacity(int capacity) {
+    this->_writeCapacity = capacity;
+}
 void ShimClient::setAllowConnect(bool b) {
     this->_allowConnect = b;
 }
@@ -142,6 +165,10 @@ uint16_t ShimClient::received() {
     return this->_received;
 }
 
+uint16_t ShimClient::writes() {
+    return this->_writes;
+}
+
 void ShimClient::expectConnect(IPAddress ip, uint16_t port) {
     this->_expectedIP = ip;
     this->_expectedPort = port;
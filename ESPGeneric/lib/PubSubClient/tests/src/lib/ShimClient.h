@@ -16,6 +16,8 @@ private:
     bool expectAnything;
     bool _error;
     uint16_t _received;
+    uint16_t _writes;
+    int _writeCapacity;
     IPAddress _expectedIP;
     uint16_t _expectedPort;
     const char* _expectedHost;
@@ -42,10 +44,12 @@ public:
   virtual void expectConnect(const char *host, uint16_t port);
   
   virtual uint16_t received();
+  virtual uint16_t writes();
   virtual bool error();
   
   virtual void setAllowConnect(bool b);
   virtual void setConnected(bool b);
+  virtual void setWriteCapacity(int capacity);
 };
 
 #endif
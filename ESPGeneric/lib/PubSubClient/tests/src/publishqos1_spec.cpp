@@ -0,0 +1,280 @@
+#include "PubSubClient.h"
+#include "ShimClient.h"
+#include "Buffer.h"
+#include "BDDTest.h"
+#include "trace.h"
+
+
+byte server[] = { 172, 16, 0, 2 };
+
+void callback(char* topic, byte* payload, unsigned int length) {
+  // handle message arrived
+}
+
+int test_publish_qos1() {
+    IT("publishes a QoS 1 message and keeps it in flight");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+
+    rc = client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_qos1_retained() {
+    IT("publishes a retained QoS 1 message");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x33,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+
+    rc = client.publish((char*)"topic",(char*)"payload",1,true);
+    IS_TRUE(rc);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_qos1_puback() {
+    IT("releases the message on a matching PUBACK");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    rc = client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_TRUE(rc);
+    rc = client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), 2);
+
+    // unknown message id is ignored
+    byte pubackUnknown[] = { 0x40, 0x02, 0x00, 0x09 };
+    shimClient.respond(pubackUnknown,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), 2);
+
+    byte puback[] = { 0x40, 0x02, 0x00, 0x02 };
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), 1);
+
+    // a second PUBACK for the same id does not release another message
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), 1);
+
+    byte puback2[] = { 0x40, 0x02, 0x00, 0x03 };
+    shimClient.respond(puback2,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), 0);
+
+    END_IT
+}
+
+int test_publish_qos1_retransmit() {
+    IT("sends the message again with DUP set after the retry timeout");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    byte publishDup[] = {0x3a,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+    shimClient.expect(publishDup,18);
+
+    rc = client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_TRUE(rc);
+    uint16_t sent = shimClient.received();
+
+    // not yet expired
+    shimAdvanceMillis(MQTT_RETRY_TIMEOUT/4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_EQUAL(shimClient.received(), sent);
+
+    shimAdvanceMillis(MQTT_RETRY_TIMEOUT);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_EQUAL(shimClient.received(), sent+18);
+    IS_EQUAL(client.inflight(), 1);
+
+    byte puback[] = { 0x40, 0x02, 0x00, 0x02 };
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), 0);
+
+    // acknowledged messages are not sent again
+    shimAdvanceMillis(MQTT_RETRY_TIMEOUT);
+    rc = client.loop();
+    IS_TRUE(rc);
+    IS_EQUAL(shimClient.received(), sent+18);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_publish_qos1_window_full() {
+    IT("fails if the in-flight window is full");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    int i;
+    for (i=0;i<MQTT_MAX_INFLIGHT;i++) {
+        rc = client.publish((char*)"topic",(char*)"payload",1,false);
+        IS_TRUE(rc);
+    }
+    IS_EQUAL(client.inflight(), MQTT_MAX_INFLIGHT);
+
+    rc = client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_FALSE(rc);
+
+    // QoS 0 does not need an entry
+    rc = client.publish((char*)"topic",(char*)"payload",0,false);
+    IS_TRUE(rc);
+
+    byte puback[] = { 0x40, 0x02, 0x00, 0x03 };
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+
+    rc = client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), MQTT_MAX_INFLIGHT);
+
+    END_IT
+}
+
+int test_publish_qos1_reconnect() {
+    IT("sends unacknowledged messages again after a reconnect");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    byte connect[] = {0x10,0x18,0x0,0x4,0x4d,0x51,0x54,0x54,0x4,0x2,0x0,0xf,0x0,0xc,0x63,0x6c,0x69,0x65,0x6e,0x74,0x5f,0x74,0x65,0x73,0x74,0x31};
+    byte publishDup[] = {0x3a,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x2,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    // the new message must not reuse the id of the pending one
+    byte publish2[] = {0x32,0x10,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x3,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,18);
+    shimClient.expect(connect,26);
+    shimClient.expect(publishDup,18);
+    shimClient.expect(publish2,18);
+
+    rc = client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_TRUE(rc);
+
+    shimClient.setConnected(false);
+    IS_FALSE(client.connected());
+
+    shimClient.respond(connack,4);
+    rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    IS_EQUAL(client.inflight(), 1);
+
+    client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_FALSE(shimClient.error());
+    IS_EQUAL(client.inflight(), 2);
+
+    END_IT
+}
+
+int test_publish_qos2_unsupported() {
+    IT("rejects QoS 2");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    rc = client.publish((char*)"topic",(char*)"payload",2,false);
+    IS_FALSE(rc);
+    IS_EQUAL(client.inflight(), 0);
+
+    END_IT
+}
+
+int test_publish_qos1_not_connected() {
+    IT("publish fails when not connected");
+    ShimClient shimClient;
+
+    PubSubClient client(server, 1883, callback, shimClient);
+
+    int rc = client.publish((char*)"topic",(char*)"payload",1,false);
+    IS_FALSE(rc);
+    IS_EQUAL(client.inflight(), 0);
+
+    END_IT
+}
+
+int main()
+{
+    SUITE("Publish QoS 1");
+    test_publish_qos1();
+    test_publish_qos1_retained();
+    test_publish_qos1_puback();
+    test_publish_qos1_retransmit();
+    test_publish_qos1_window_full();
+    test_publish_qos1_reconnect();
+    test_publish_qos2_unsupported();
+    test_publish_qos1_not_connected();
+
+    FINISH
+}
@@ -0,0 +1,299 @@
+#include "PubSubClient.h"
+#include "PubSubQueue.h"
+#include "ShimClient.h"
+#include "Buffer.h"
+#include "BDDTest.h"
+#include "trace.h"
+
+
+byte server[] = { 172, 16, 0, 2 };
+
+void callback(char* topic, byte* payload, unsigned int length) {
+  // handle message arrived
+}
+
+int test_queue_flush_in_order() {
+    IT("sends queued messages in order on flush");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    rc = queue.publish((char*)"topic",(char*)"payload");
+    IS_TRUE(rc);
+    rc = queue.publish((char*)"topic",(char*)"p2");
+    IS_TRUE(rc);
+    IS_EQUAL(queue.depth(), 2);
+    IS_FALSE(shimClient.error());
+
+    byte publish1[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    byte publish2[] = {0x30,0x9,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x32};
+    shimClient.expect(publish1,16);
+    shimClient.expect(publish2,11);
+
+    IS_EQUAL(queue.flush(), 2);
+    IS_EQUAL(queue.depth(), 0);
+    IS_EQUAL(queue.maxDepth(), 2);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_queue_collapse_retained() {
+    IT("collapses retained updates of the same topic");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    IS_TRUE(queue.publish((char*)"topic",(char*)"1",true));
+    IS_TRUE(queue.publish((char*)"other",(char*)"x",true));
+    IS_TRUE(queue.publish((char*)"topic",(char*)"22",true));
+    IS_TRUE(queue.publish((char*)"topic",(char*)"3",true));
+    IS_EQUAL(queue.depth(), 2);
+    IS_EQUAL(queue.collapsedCount(), 2);
+
+    byte publish1[] = {0x31,0x8,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x33};
+    byte publish2[] = {0x31,0x8,0x0,0x5,0x6f,0x74,0x68,0x65,0x72,0x78};
+    shimClient.expect(publish1,10);
+    shimClient.expect(publish2,10);
+
+    IS_EQUAL(queue.flush(), 2);
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_queue_no_collapse_not_retained() {
+    IT("keeps every not retained message");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    IS_TRUE(queue.publish((char*)"topic",(char*)"1",true));
+    IS_TRUE(queue.publish((char*)"topic",(char*)"2",false));
+    IS_TRUE(queue.publish((char*)"topic",(char*)"3",false));
+    IS_EQUAL(queue.depth(), 3);
+    IS_EQUAL(queue.collapsedCount(), 0);
+
+    END_IT
+}
+
+int test_queue_drop_when_full() {
+    IT("drops and counts messages when full");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    int i;
+    for (i=0;i<MQTT_QUEUE_SIZE;i++) {
+        IS_TRUE(queue.publish((char*)"topic",(char*)"payload"));
+    }
+    IS_FALSE(queue.publish((char*)"topic",(char*)"payload"));
+    IS_EQUAL(queue.depth(), MQTT_QUEUE_SIZE);
+    IS_EQUAL(queue.droppedCount(), 1);
+
+    queue.resetCounters();
+    IS_EQUAL(queue.droppedCount(), 0);
+    IS_EQUAL(queue.maxDepth(), MQTT_QUEUE_SIZE);
+
+    END_IT
+}
+
+int test_queue_drop_too_long() {
+    IT("drops messages which do not fit into an entry");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // the largest message publish() accepts fits, one byte more does not
+    char topic[MQTT_MAX_PACKET_SIZE];
+    memset(topic,'t',sizeof(topic));
+    topic[MQTT_MAX_PACKET_SIZE-7] = 0;
+    IS_TRUE(queue.publish(topic,(char*)""));
+    topic[MQTT_MAX_PACKET_SIZE-7] = 't';
+    topic[MQTT_MAX_PACKET_SIZE-6] = 0;
+    IS_FALSE(queue.publish(topic,(char*)""));
+    IS_EQUAL(queue.depth(), 1);
+    IS_EQUAL(queue.droppedCount(), 1);
+
+    IS_EQUAL(queue.flush(), 1);
+
+    END_IT
+}
+
+int test_queue_backpressure() {
+    IT("stops draining when the client is full and resumes later");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    IS_TRUE(queue.publish((char*)"topic",(char*)"payload"));
+    IS_TRUE(queue.publish((char*)"topic",(char*)"p2"));
+    IS_TRUE(queue.publish((char*)"topic",(char*)"p3"));
+
+    byte publish1[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    byte publish2[] = {0x30,0x9,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x32};
+    byte publish3[] = {0x30,0x9,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x33};
+    shimClient.expect(publish1,16);
+    shimClient.expect(publish2,11);
+    shimClient.expect(publish3,11);
+
+    // room for the first message only
+    shimClient.setWriteCapacity(20);
+    IS_EQUAL(queue.flush(), 1);
+    IS_EQUAL(queue.depth(), 2);
+
+    shimClient.setWriteCapacity(0);
+    IS_EQUAL(queue.flush(), 0);
+    IS_EQUAL(queue.depth(), 2);
+
+    shimClient.setWriteCapacity(-1);
+    IS_EQUAL(queue.flush(), 2);
+    IS_EQUAL(queue.depth(), 0);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_queue_not_connected() {
+    IT("keeps messages while not connected");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+
+    IS_TRUE(queue.publish((char*)"topic",(char*)"payload"));
+    IS_EQUAL(queue.flush(), 0);
+    IS_EQUAL(queue.depth(), 1);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,16);
+
+    IS_EQUAL(queue.flush(), 1);
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_queue_wraparound() {
+    IT("reuses the ring entries");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    int i;
+    for (i=0;i<3*MQTT_QUEUE_SIZE;i++) {
+        IS_TRUE(queue.publish((char*)"topic",(char*)"payload"));
+        IS_TRUE(queue.publish((char*)"topic",(char*)"payload"));
+        IS_EQUAL(queue.flush(), 2);
+    }
+    IS_EQUAL(queue.depth(), 0);
+    IS_EQUAL(queue.droppedCount(), 0);
+
+    END_IT
+}
+
+int test_queue_qos1_window() {
+    IT("keeps QoS 1 messages queued while the in-flight window is full");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubQueue queue(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    int i;
+    for (i=0;i<MQTT_MAX_INFLIGHT+1;i++) {
+        IS_TRUE(queue.publish((char*)"topic",(char*)"payload",1,false));
+    }
+    IS_EQUAL(queue.flush(), MQTT_MAX_INFLIGHT);
+    IS_EQUAL(queue.depth(), 1);
+    IS_EQUAL(client.inflight(), MQTT_MAX_INFLIGHT);
+
+    byte puback[] = { 0x40, 0x02, 0x00, 0x02 };
+    shimClient.respond(puback,4);
+    rc = client.loop();
+    IS_TRUE(rc);
+
+    IS_EQUAL(queue.flush(), 1);
+    IS_EQUAL(queue.depth(), 0);
+    IS_EQUAL(client.inflight(), MQTT_MAX_INFLIGHT);
+
+    END_IT
+}
+
+int main()
+{
+    SUITE("PublishQueue");
+    test_queue_flush_in_order();
+    test_queue_collapse_retained();
+    test_queue_no_collapse_not_retained();
+    test_queue_drop_when_full();
+    test_queue_drop_too_long();
+    test_queue_backpressure();
+    test_queue_not_connected();
+    test_queue_wraparound();
+    test_queue_qos1_window();
+
+    FINISH
+}
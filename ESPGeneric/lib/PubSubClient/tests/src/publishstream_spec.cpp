@@ -0,0 +1,288 @@
+#include "PubSubClient.h"
+#include "ShimClient.h"
+#include "Buffer.h"
+#include "BDDTest.h"
+#include "trace.h"
+
+
+byte server[] = { 172, 16, 0, 2 };
+
+void callback(char* topic, byte* payload, unsigned int length) {
+  // handle message arrived
+}
+
+int test_stream_publish() {
+    IT("streams a payload written in pieces");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,16);
+
+    rc = client.beginPublish((char*)"topic",7,false);
+    IS_TRUE(rc);
+    IS_EQUAL(client.write((const uint8_t*)"pay",3), 3);
+    IS_EQUAL(client.write('l'), 1);
+    IS_EQUAL(client.write((const uint8_t*)"oad",3), 3);
+    IS_EQUAL(client.endPublish(), 1);
+
+    IS_FALSE(shimClient.error());
+    IS_TRUE(client.connected());
+
+    END_IT
+}
+
+int test_stream_publish_retained() {
+    IT("streams a retained payload");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x31,0xc,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x1,0x2,0x3,0x0,0x5};
+    shimClient.expect(publish,14);
+
+    byte payload[] = { 0x01,0x02,0x03,0x0,0x05 };
+    rc = client.beginPublish((char*)"topic",5,true);
+    IS_TRUE(rc);
+    IS_EQUAL(client.write(payload,5), 5);
+    IS_EQUAL(client.endPublish(), 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_stream_publish_multibyte_length() {
+    IT("encodes a multi byte remaining length");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    // 2 + 5 + 200 = 207 = 0xcf 0x01
+    byte publish[3+7+200] = {0x30,0xcf,0x1,0x0,0x5,0x74,0x6f,0x70,0x69,0x63};
+    byte payload[200];
+    int i;
+    for (i=0;i<200;i++) {
+        payload[i] = (byte)i;
+        publish[10+i] = (byte)i;
+    }
+    shimClient.expect(publish,210);
+
+    rc = client.beginPublish((char*)"topic",200,false);
+    IS_TRUE(rc);
+    IS_EQUAL(client.write(payload,200), 200);
+    IS_EQUAL(client.endPublish(), 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_stream_publish_larger_than_buffer() {
+    IT("streams payloads larger than MQTT_MAX_PACKET_SIZE");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    uint16_t connectLength = shimClient.received();
+
+    byte chunk[100];
+    memset(chunk,'x',sizeof(chunk));
+    // 2 + 5 + 20000 needs a 3 byte remaining length
+    rc = client.beginPublish((char*)"topic",20000,false);
+    IS_TRUE(rc);
+    int i;
+    for (i=0;i<200;i++) {
+        IS_EQUAL(client.write(chunk,100), 100);
+    }
+    IS_EQUAL(client.endPublish(), 1);
+
+    IS_EQUAL(shimClient.received() - connectLength, 1+3+2+5+20000);
+    IS_TRUE(client.connected());
+
+    END_IT
+}
+
+int test_stream_publish_truncates_extra_bytes() {
+    IT("does not write more than announced");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte publish[] = {0x30,0xe,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x70,0x61,0x79,0x6c,0x6f,0x61,0x64};
+    shimClient.expect(publish,16);
+
+    rc = client.beginPublish((char*)"topic",7,false);
+    IS_TRUE(rc);
+    IS_EQUAL(client.write((const uint8_t*)"payload-too-long",16), 7);
+    IS_EQUAL(client.write('x'), 0);
+    IS_EQUAL(client.endPublish(), 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_stream_publish_incomplete() {
+    IT("closes the connection if the payload is incomplete");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    rc = client.beginPublish((char*)"topic",7,false);
+    IS_TRUE(rc);
+    IS_EQUAL(client.write((const uint8_t*)"pay",3), 3);
+    IS_EQUAL(client.endPublish(), 0);
+
+    IS_FALSE(client.connected());
+    IS_EQUAL(client.state(), MQTT_CONNECTION_LOST);
+
+    END_IT
+}
+
+int test_stream_publish_write_failure() {
+    IT("fails if the client refuses the payload");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    rc = client.beginPublish((char*)"topic",7,false);
+    IS_TRUE(rc);
+    shimClient.setWriteCapacity(0);
+    IS_EQUAL(client.write((const uint8_t*)"payload",7), 0);
+    IS_EQUAL(client.write('x'), 0);
+    IS_EQUAL(client.endPublish(), 0);
+
+    IS_FALSE(client.connected());
+
+    END_IT
+}
+
+int test_stream_publish_not_connected() {
+    IT("publish fails when not connected");
+    ShimClient shimClient;
+
+    PubSubClient client(server, 1883, callback, shimClient);
+
+    int rc = client.beginPublish((char*)"topic",7,false);
+    IS_FALSE(rc);
+    IS_EQUAL(client.write((const uint8_t*)"payload",7), 0);
+    IS_EQUAL(client.endPublish(), 0);
+
+    END_IT
+}
+
+int test_stream_publish_topic_too_long() {
+    IT("publish fails when the topic does not fit into the buffer");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    char topic[MQTT_MAX_PACKET_SIZE];
+    memset(topic,'t',sizeof(topic));
+    topic[MQTT_MAX_PACKET_SIZE-1] = 0;
+
+    rc = client.beginPublish(topic,7,false);
+    IS_FALSE(rc);
+    IS_EQUAL(client.write((const uint8_t*)"payload",7), 0);
+    IS_TRUE(client.connected());
+
+    END_IT
+}
+
+int test_stream_publish_too_large() {
+    IT("publish fails when the remaining length exceeds the protocol limit");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    uint16_t connectLength = shimClient.received();
+
+    // 2 + 5 topic bytes plus the payload is one byte above 268435455
+    rc = client.beginPublish((char*)"topic",MQTT_MAX_REMAINING_LENGTH-6,false);
+    IS_FALSE(rc);
+    IS_EQUAL(client.write((const uint8_t*)"payload",7), 0);
+    IS_EQUAL(shimClient.received(), connectLength);
+    IS_TRUE(client.connected());
+
+    rc = client.beginPublish((char*)"topic",0xFFFFFFFF,false);
+    IS_FALSE(rc);
+    IS_EQUAL(shimClient.received(), connectLength);
+
+    // the largest payload still gets the 4 byte length field
+    rc = client.beginPublish((char*)"topic",MQTT_MAX_REMAINING_LENGTH-7,false);
+    IS_TRUE(rc);
+    IS_EQUAL(shimClient.received() - connectLength, 1+4+2+5);
+
+    END_IT
+}
+
+int main()
+{
+    SUITE("Publish Stream");
+    test_stream_publish();
+    test_stream_publish_retained();
+    test_stream_publish_multibyte_length();
+    test_stream_publish_larger_than_buffer();
+    test_stream_publish_truncates_extra_bytes();
+    test_stream_publish_incomplete();
+    test_stream_publish_write_failure();
+    test_stream_publish_not_connected();
+    test_stream_publish_topic_too_long();
+    test_stream_publish_too_large();
+
+    FINISH
+}
@@ -0,0 +1,273 @@
+#include "PubSubClient.h"
+#include "PubSubSubscriber.h"
+#include "ShimClient.h"
+#include "Buffer.h"
+#include "BDDTest.h"
+#include "trace.h"
+#include <stdio.h>
+
+
+byte server[] = { 172, 16, 0, 2 };
+
+void callback(char* topic, byte* payload, unsigned int length) {
+  // handle message arrived
+}
+
+// receive topics of an 8 channel relay board, two per relay
+static char relayTopics[16][32];
+
+static void buildRelayTopics() {
+    int i;
+    for (i=0;i<8;i++) {
+        sprintf(relayTopics[2*i],"std/dev05/r/relay%d/toggle",i);
+        sprintf(relayTopics[2*i+1],"std/dev05/r/relay%d/button",i);
+    }
+}
+
+int test_subscribe_multiple_topics() {
+    IT("subscribes multiple topics with one packet");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte subscribe[] = { 0x82,0x12,0x0,0x2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x0,0x5,0x6f,0x74,0x68,0x65,0x72,0x1 };
+    shimClient.expect(subscribe,20);
+
+    const char* topics[] = { "topic", "other" };
+    uint8_t qos[] = { 0, 1 };
+    rc = client.subscribe(topics,qos,2);
+    IS_TRUE(rc);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_subscribe_multiple_default_qos() {
+    IT("subscribes multiple topics with qos 0 if no qos is given");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte subscribe[] = { 0x82,0x12,0x0,0x2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x0,0x5,0x6f,0x74,0x68,0x65,0x72,0x0 };
+    shimClient.expect(subscribe,20);
+
+    const char* topics[] = { "topic", "other" };
+    rc = client.subscribe(topics,NULL,2);
+    IS_TRUE(rc);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_subscribe_multiple_invalid() {
+    IT("multiple subscribe fails if the packet is too long or a qos is invalid");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    buildRelayTopics();
+
+    const char* topics[16];
+    int i;
+    for (i=0;i<16;i++) {
+        topics[i] = relayTopics[i];
+    }
+    rc = client.subscribe(topics,NULL,16);
+    IS_FALSE(rc);
+
+    uint8_t qos[] = { 0, 2 };
+    rc = client.subscribe(topics,qos,2);
+    IS_FALSE(rc);
+
+    rc = client.subscribe(topics,NULL,0);
+    IS_FALSE(rc);
+
+    IS_EQUAL(shimClient.writes(), 1);
+
+    END_IT
+}
+
+int test_collector_packets() {
+    IT("sends the subscriptions of a relay board in less packets");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubSubscriber subscriber(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+    buildRelayTopics();
+
+    // one packet and SUBACK round trip per topic
+    uint16_t before = shimClient.writes();
+    int i;
+    for (i=0;i<16;i++) {
+        IS_TRUE(client.subscribe(relayTopics[i]));
+    }
+    uint16_t singlePackets = shimClient.writes() - before;
+    IS_EQUAL(singlePackets, 16);
+
+    // 25 byte topics take 28 bytes each, 4 fit into a 128 byte packet
+    before = shimClient.writes();
+    for (i=0;i<16;i++) {
+        IS_TRUE(subscriber.subscribe(relayTopics[i]));
+    }
+    IS_EQUAL(subscriber.pending(), 16);
+    IS_EQUAL(shimClient.writes(), before);
+
+    IS_EQUAL(subscriber.flush(), 4);
+    uint16_t batchPackets = shimClient.writes() - before;
+    IS_EQUAL(batchPackets, 4);
+    IS_EQUAL(subscriber.pending(), 0);
+    IS_EQUAL(subscriber.packetCount(), 4);
+    IS_EQUAL(subscriber.topicCount(), 16);
+    IS_EQUAL(subscriber.failedCount(), 0);
+
+    // every packet is acknowledged by one SUBACK
+    byte suback[] = { 0x90,0x6,0x0,0x12,0x0,0x0,0x0,0x0 };
+    for (i=0;i<4;i++) {
+        suback[3] = 0x12+i;
+        shimClient.respond(suback,8);
+    }
+    int roundTrips = 0;
+    while (shimClient.available()) {
+        IS_TRUE(client.loop());
+        roundTrips++;
+    }
+    IS_EQUAL(roundTrips, 4);
+
+    END_IT
+}
+
+int test_collector_packet_content() {
+    IT("packs the collected topics into one packet");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubSubscriber subscriber(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    byte subscribe[] = { 0x82,0x12,0x0,0x2,0x0,0x5,0x74,0x6f,0x70,0x69,0x63,0x0,0x0,0x5,0x6f,0x74,0x68,0x65,0x72,0x1 };
+    shimClient.expect(subscribe,20);
+
+    IS_TRUE(subscriber.subscribe("topic"));
+    IS_TRUE(subscriber.subscribe("other",1));
+    IS_FALSE(subscriber.subscribe("invalid",2));
+    IS_EQUAL(subscriber.flush(), 1);
+
+    IS_FALSE(shimClient.error());
+
+    END_IT
+}
+
+int test_collector_full() {
+    IT("flushes when the collector is full");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubSubscriber subscriber(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    int i;
+    for (i=0;i<MQTT_SUBSCRIBE_BATCH+1;i++) {
+        IS_TRUE(subscriber.subscribe("topic"));
+    }
+    IS_EQUAL(subscriber.pending(), 1);
+    IS_EQUAL(subscriber.topicCount(), MQTT_SUBSCRIBE_BATCH);
+
+    IS_EQUAL(subscriber.flush(), 1);
+    IS_EQUAL(subscriber.topicCount(), MQTT_SUBSCRIBE_BATCH+1);
+    IS_EQUAL(subscriber.flush(), 0);
+
+    END_IT
+}
+
+int test_collector_topic_too_long() {
+    IT("skips a topic that does not fit into a packet");
+    ShimClient shimClient;
+    shimClient.setAllowConnect(true);
+
+    byte connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    shimClient.respond(connack,4);
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubSubscriber subscriber(client);
+    int rc = client.connect((char*)"client_test1");
+    IS_TRUE(rc);
+
+    char topic[MQTT_MAX_PACKET_SIZE];
+    memset(topic,'t',sizeof(topic));
+    topic[MQTT_MAX_PACKET_SIZE-1] = 0;
+
+    IS_TRUE(subscriber.subscribe("topic"));
+    IS_TRUE(subscriber.subscribe(topic));
+    IS_TRUE(subscriber.subscribe("other"));
+    IS_EQUAL(subscriber.flush(), 2);
+    IS_EQUAL(subscriber.topicCount(), 2);
+    IS_EQUAL(subscriber.failedCount(), 1);
+
+    END_IT
+}
+
+int test_collector_not_connected() {
+    IT("counts the subscriptions as failed when not connected");
+    ShimClient shimClient;
+
+    PubSubClient client(server, 1883, callback, shimClient);
+    PubSubSubscriber subscriber(client);
+
+    IS_TRUE(subscriber.subscribe("topic"));
+    IS_TRUE(subscriber.subscribe("other"));
+    IS_EQUAL(subscriber.flush(), 0);
+    IS_EQUAL(subscriber.pending(), 0);
+    IS_EQUAL(subscriber.failedCount(), 2);
+
+    END_IT
+}
+
+int main()
+{
+    SUITE("Subscribe Batch");
+    test_subscribe_multiple_topics();
+    test_subscribe_multiple_default_qos();
+    test_subscribe_multiple_invalid();
+    test_collector_packets();
+    test_collector_packet_content();
+    test_collector_full();
+    test_collector_topic_too_long();
+    test_collector_not_connected();
+
+    FINISH
+}
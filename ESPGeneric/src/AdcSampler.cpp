@@ -0,0 +1,264 @@
+/*****************************************************************************************
+* FILENAME :        AdcSampler.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the shared ADC sampling service
+*
+* NOTES :
+*       The moving average keeps 8 fractional bits, a burst value x changes the
+*       state by (x * 256 - state) / 2^shift. The first burst initializes the 
+*       state, so the average does not start at zero. The median of an even 
+*       burst is the mean of the two middle conversions.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "AdcSampler.h"
+#include <Arduino.h>
+
+/****************************************************************************************/
+/* Local constant defines */
+#define EMA_FRACTION_BITS           8u
+#define EMA_ROUNDING                (1l << (EMA_FRACTION_BITS - 1u))
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the ADC sampler
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     pin_u8      analog input pin
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+AdcSampler::AdcSampler(uint8_t pin_u8)
+{
+    this->pin_u8 = pin_u8;
+    this->size_u8 = 0;
+    this->next_u8 = 0;
+    memset(this->consumers_sta, 0, sizeof(this->consumers_sta));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Adds a consumer of the ADC, has to be called once by the device 
+ *              initialization
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     config_p    burst, filter and report configuration of the consumer
+ * @return    consumer id or ADCSAMPLER_INVALID, if no consumer is left
+*//*-----------------------------------------------------------------------------------*/
+uint8_t AdcSampler::Register_u8(const adcConfig_t *config_p)
+{
+    adcConsumer_t *consumer_p;
+
+    if((NULL == config_p) || (ADCSAMPLER_CONSUMERS <= this->size_u8))
+    {
+        return(ADCSAMPLER_INVALID);
+    }
+
+    consumer_p = &this->consumers_sta[this->size_u8];
+    memset(consumer_p, 0, sizeof(adcConsumer_t));
+    consumer_p->config_st = *config_p;
+    consumer_p->config_st.burst_u8 = constrain(config_p->burst_u8, 1u, ADCSAMPLER_BURST_MAX);
+    return(this->size_u8++);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Requests one burst, the value is available with Take_bol after the next
+ *              Process_u8 call that serves the consumer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     id_u8       consumer id
+ * @return    true, if the request was queued
+*//*-----------------------------------------------------------------------------------*/
+bool AdcSampler::Request_bol(uint8_t id_u8)
+{
+    if(id_u8 >= this->size_u8)
+    {
+        return(false);
+    }
+    this->consumers_sta[id_u8].pending_bol = true;
+    this->consumers_sta[id_u8].ready_bol = false;
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Serves the next pending burst, the consumers are served in turn. Has to be
+ *              called once per loop.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of bursts still pending
+*//*-----------------------------------------------------------------------------------*/
+uint8_t AdcSampler::Process_u8(void)
+{
+    uint8_t idx_u8;
+    uint8_t pending_u8 = 0;
+    bool served_bol = false;
+
+    for(idx_u8 = 0; idx_u8 < this->size_u8; idx_u8++)
+    {
+        adcConsumer_t *consumer_p = &this->consumers_sta[this->next_u8];
+
+        this->next_u8 = (this->next_u8 + 1u) % this->size_u8;
+        if(true == consumer_p->pending_bol)
+        {
+            if(false == served_bol)
+            {
+                this->Burst(consumer_p);
+                served_bol = true;
+            }
+            else
+            {
+                pending_u8++;
+            }
+        }
+    }
+    return(pending_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Takes the filtered value of the requested burst
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     id_u8       consumer id
+ * @param     value_pu16  returns the filtered value in digits
+ * @return    true once after the requested burst was served
+*//*-----------------------------------------------------------------------------------*/
+bool AdcSampler::Take_bol(uint8_t id_u8, uint16_t *value_pu16)
+{
+    if((id_u8 >= this->size_u8) || (false == this->consumers_sta[id_u8].ready_bol))
+    {
+        return(false);
+    }
+    this->consumers_sta[id_u8].ready_bol = false;
+    *value_pu16 = this->consumers_sta[id_u8].value_u16;
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of registered consumers
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of consumers
+*//*-----------------------------------------------------------------------------------*/
+uint8_t AdcSampler::GetSize_u8(void) const
+{
+    return(this->size_u8);
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Converts one burst and filters it
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     consumer_p  consumer of the burst
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void AdcSampler::Burst(adcConsumer_t *consumer_p)
+{
+    uint16_t samples_u16a[ADCSAMPLER_BURST_MAX];
+    uint32_t sum_u32 = 0;
+    uint16_t value_u16;
+    uint8_t idx_u8;
+
+    for(idx_u8 = 0; idx_u8 < consumer_p->config_st.burst_u8; idx_u8++)
+    {
+        samples_u16a[idx_u8] = (uint16_t)analogRead(this->pin_u8);
+        sum_u32 += samples_u16a[idx_u8];
+    }
+
+    if(ADCSAMPLER_MEDIAN == consumer_p->config_st.filter_en)
+    {
+        value_u16 = Median_u16(samples_u16a, consumer_p->config_st.burst_u8);
+    }
+    else
+    {
+        value_u16 = (uint16_t)((sum_u32 + (consumer_p->config_st.burst_u8 / 2u)) 
+                                / consumer_p->config_st.burst_u8);
+    }
+
+    if(0u != consumer_p->config_st.emaShift_u8)
+    {
+        if(false == consumer_p->valid_bol)
+        {
+            consumer_p->ema_s32 = (int32_t)value_u16 << EMA_FRACTION_BITS;
+        }
+        else
+        {
+            consumer_p->ema_s32 += (((int32_t)value_u16 << EMA_FRACTION_BITS) 
+                                    - consumer_p->ema_s32) 
+                                    / (1l << consumer_p->config_st.emaShift_u8);
+        }
+        value_u16 = (uint16_t)((consumer_p->ema_s32 + EMA_ROUNDING) >> EMA_FRACTION_BITS);
+    }
+
+    consumer_p->value_u16 = value_u16;
+    consumer_p->valid_bol = true;
+    consumer_p->pending_bol = false;
+    consumer_p->ready_bol = true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Median of a burst, the samples are sorted in place
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     samples_pu16    conversions of the burst
+ * @param     count_u8        number of conversions
+ * @return    median
+*//*-----------------------------------------------------------------------------------*/
+uint16_t AdcSampler::Median_u16(uint16_t *samples_pu16, uint8_t count_u8)
+{
+    uint8_t idx_u8;
+    uint8_t pos_u8;
+    uint16_t sample_u16;
+
+    // insertion sort, a burst has at most ADCSAMPLER_BURST_MAX conversions
+    for(idx_u8 = 1u; idx_u8 < count_u8; idx_u8++)
+    {
+        sample_u16 = samples_pu16[idx_u8];
+        for(pos_u8 = idx_u8; (pos_u8 > 0u) && (samples_pu16[pos_u8 - 1u] > sample_u16); 
+                pos_u8--)
+        {
+            samples_pu16[pos_u8] = samples_pu16[pos_u8 - 1u];
+        }
+        samples_pu16[pos_u8] = sample_u16;
+    }
+
+    if(0u == (count_u8 & 1u))
+    {
+        return((uint16_t)(((uint32_t)samples_pu16[(count_u8 / 2u) - 1u] 
+                            + samples_pu16[count_u8 / 2u] + 1u) / 2u));
+    }
+    return(samples_pu16[count_u8 / 2u]);
+}
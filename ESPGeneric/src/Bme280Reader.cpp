@@ -0,0 +1,340 @@
+/*****************************************************************************************
+* FILENAME :        Bme280Reader.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the forced mode BME280 reader
+*
+* NOTES :
+*       The compensation follows chapter 4.2.3 of the BME280 datasheet: 32 bit
+*       integer for temperature and humidity, 64 bit integer for pressure. The
+*       calibration is read once after the first power up, it is stored in the
+*       NVM of the sensor and does not change. The control registers are reset
+*       by every power cycle, so every sample starts with both control writes.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "Bme280Reader.h"
+#include <Arduino.h>
+#include <Wire.h>
+
+/****************************************************************************************/
+/* Local constant defines */
+#define REG_CALIB_TP                0x88u
+#define REG_CHIP_ID                 0xD0u
+#define REG_CALIB_H                 0xE1u
+#define REG_CTRL_HUM                0xF2u
+#define REG_CTRL_MEAS               0xF4u
+#define REG_DATA                    0xF7u
+
+// humidity oversampling 1x, ctrl_hum is applied with the next ctrl_meas write
+#define CTRL_HUM_OSRS_1X            0x01u
+// temperature and pressure oversampling 1x, forced mode
+#define CTRL_MEAS_FORCED_1X         0x25u
+
+// value of a skipped measurement
+#define ADC_SKIPPED_20BIT           0x80000l
+
+#define HUMIDITY_MAX_Q22_10         419430400l
+
+/****************************************************************************************/
+/* Local function like makros */
+#define LE_U16(data_pu8, idx)       ((uint16_t)(((uint16_t)(data_pu8)[(idx) + 1u] << 8) \
+                                        | (data_pu8)[idx]))
+#define LE_S16(data_pu8, idx)       ((int16_t)LE_U16(data_pu8, idx))
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the BME280 reader
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     address_u8  I2C address of the sensor
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+Bme280Reader::Bme280Reader(uint8_t address_u8)
+{
+    this->address_u8 = address_u8;
+    this->calibrated_bol = false;
+    memset(&this->calib_st, 0, sizeof(this->calib_st));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Checks the chip id and reads the calibration, if not done before. Has to
+ *              be called after BME280READER_STARTUP_TIME after the power up.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    true, if a BME280 answered and the calibration is available
+*//*-----------------------------------------------------------------------------------*/
+bool Bme280Reader::Begin_bol(void)
+{
+    uint8_t chipId_u8 = 0;
+    uint8_t tp_u8a[BME280READER_CALIB_TP_BYTES];
+    uint8_t h_u8a[BME280READER_CALIB_H_BYTES];
+
+    Wire.begin();
+    if((false == this->Read_bol(REG_CHIP_ID, &chipId_u8, 1u)) 
+        || (BME280READER_CHIP_ID != chipId_u8))
+    {
+        return(false);
+    }
+
+    if(false == this->calibrated_bol)
+    {
+        if((false == this->Read_bol(REG_CALIB_TP, tp_u8a, sizeof(tp_u8a)))
+            || (false == this->Read_bol(REG_CALIB_H, h_u8a, sizeof(h_u8a))))
+        {
+            return(false);
+        }
+        this->SetCalibration(tp_u8a, h_u8a);
+    }
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Triggers one forced measurement, the result is available after 
+ *              BME280READER_MEAS_TIME
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    true, if the sensor acknowledged both control writes
+*//*-----------------------------------------------------------------------------------*/
+bool Bme280Reader::StartMeasurement_bol(void)
+{
+    return((true == this->Write_bol(REG_CTRL_HUM, CTRL_HUM_OSRS_1X))
+            && (true == this->Write_bol(REG_CTRL_MEAS, CTRL_MEAS_FORCED_1X)));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Reads the data registers of the last measurement in one burst and 
+ *              compensates them
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     sample_p    returns the compensated sample
+ * @return    true, if the sample is valid
+*//*-----------------------------------------------------------------------------------*/
+bool Bme280Reader::ReadSample_bol(bme280Sample_t *sample_p)
+{
+    uint8_t data_u8a[BME280READER_DATA_BYTES];
+
+    if((false == this->calibrated_bol) 
+        || (false == this->Read_bol(REG_DATA, data_u8a, sizeof(data_u8a))))
+    {
+        return(false);
+    }
+    return(this->Compensate_bol(data_u8a, sample_p));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the calibration from the raw calibration registers
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     tp_pu8      BME280READER_CALIB_TP_BYTES registers starting at 0x88
+ * @param     h_pu8       BME280READER_CALIB_H_BYTES registers starting at 0xE1
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Bme280Reader::SetCalibration(const uint8_t *tp_pu8, const uint8_t *h_pu8)
+{
+    this->calib_st.t1_u16 = LE_U16(tp_pu8, 0u);
+    this->calib_st.t2_s16 = LE_S16(tp_pu8, 2u);
+    this->calib_st.t3_s16 = LE_S16(tp_pu8, 4u);
+    this->calib_st.p1_u16 = LE_U16(tp_pu8, 6u);
+    this->calib_st.p2_s16 = LE_S16(tp_pu8, 8u);
+    this->calib_st.p3_s16 = LE_S16(tp_pu8, 10u);
+    this->calib_st.p4_s16 = LE_S16(tp_pu8, 12u);
+    this->calib_st.p5_s16 = LE_S16(tp_pu8, 14u);
+    this->calib_st.p6_s16 = LE_S16(tp_pu8, 16u);
+    this->calib_st.p7_s16 = LE_S16(tp_pu8, 18u);
+    this->calib_st.p8_s16 = LE_S16(tp_pu8, 20u);
+    this->calib_st.p9_s16 = LE_S16(tp_pu8, 22u);
+    // 0xA0 is not used
+    this->calib_st.h1_u8 = tp_pu8[25];
+    this->calib_st.h2_s16 = LE_S16(h_pu8, 0u);
+    this->calib_st.h3_u8 = h_pu8[2];
+    // dig_H4 and dig_H5 are 12 bit values sharing the nibbles of 0xE5
+    this->calib_st.h4_s16 = (int16_t)(((int16_t)(int8_t)h_pu8[3] * 16) | (h_pu8[4] & 0x0Fu));
+    this->calib_st.h5_s16 = (int16_t)(((int16_t)(int8_t)h_pu8[5] * 16) | (h_pu8[4] >> 4));
+    this->calib_st.h6_s8 = (int8_t)h_pu8[6];
+    this->calibrated_bol = true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Compensates the raw data registers of one measurement
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     data_pu8    BME280READER_DATA_BYTES registers starting at 0xF7
+ * @param     sample_p    returns the compensated sample
+ * @return    true, if temperature and pressure were measured
+*//*-----------------------------------------------------------------------------------*/
+bool Bme280Reader::Compensate_bol(const uint8_t *data_pu8, bme280Sample_t *sample_p) const
+{
+    int32_t tFine_s32;
+    int32_t adcP_s32 = ((int32_t)data_pu8[0] << 12) | ((int32_t)data_pu8[1] << 4) 
+                            | (data_pu8[2] >> 4);
+    int32_t adcT_s32 = ((int32_t)data_pu8[3] << 12) | ((int32_t)data_pu8[4] << 4) 
+                            | (data_pu8[5] >> 4);
+    int32_t adcH_s32 = ((int32_t)data_pu8[6] << 8) | data_pu8[7];
+
+    if((ADC_SKIPPED_20BIT == adcT_s32) || (ADC_SKIPPED_20BIT == adcP_s32))
+    {
+        return(false);
+    }
+    sample_p->temperature_s32 = this->Temperature_s32(adcT_s32, &tFine_s32);
+    sample_p->pressure_u32 = this->Pressure_u32(adcP_s32, tFine_s32);
+    sample_p->humidity_u32 = this->Humidity_u32(adcH_s32, tFine_s32);
+    return(0u != sample_p->pressure_u32);
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Writes one register in its own transaction
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     reg_u8      register address
+ * @param     value_u8    register value
+ * @return    true, if the sensor acknowledged the write
+*//*-----------------------------------------------------------------------------------*/
+bool Bme280Reader::Write_bol(uint8_t reg_u8, uint8_t value_u8)
+{
+    Wire.beginTransmission(this->address_u8);
+    Wire.write(reg_u8);
+    Wire.write(value_u8);
+    return(0u == Wire.endTransmission());
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Reads consecutive registers in one burst, the sensor increments the 
+ *              register address
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     reg_u8      first register address
+ * @param     data_pu8    returns the register values
+ * @param     length_u8   number of registers
+ * @return    true, if all registers were received
+*//*-----------------------------------------------------------------------------------*/
+bool Bme280Reader::Read_bol(uint8_t reg_u8, uint8_t *data_pu8, uint8_t length_u8)
+{
+    uint8_t idx_u8;
+
+    Wire.beginTransmission(this->address_u8);
+    Wire.write(reg_u8);
+    if((0u != Wire.endTransmission()) 
+        || (length_u8 != Wire.requestFrom(this->address_u8, length_u8)))
+    {
+        return(false);
+    }
+    for(idx_u8 = 0; idx_u8 < length_u8; idx_u8++)
+    {
+        data_pu8[idx_u8] = (uint8_t)Wire.read();
+    }
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Temperature compensation, BME280_compensate_T_int32 of the datasheet
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     adc_s32     raw temperature
+ * @param     tFine_ps32  returns the fine temperature for pressure and humidity
+ * @return    temperature in 0.01 degC
+*//*-----------------------------------------------------------------------------------*/
+int32_t Bme280Reader::Temperature_s32(int32_t adc_s32, int32_t *tFine_ps32) const
+{
+    int32_t var1_s32;
+    int32_t var2_s32;
+
+    var1_s32 = ((((adc_s32 >> 3) - ((int32_t)this->calib_st.t1_u16 << 1))) 
+                    * ((int32_t)this->calib_st.t2_s16)) >> 11;
+    var2_s32 = (((((adc_s32 >> 4) - ((int32_t)this->calib_st.t1_u16)) 
+                    * ((adc_s32 >> 4) - ((int32_t)this->calib_st.t1_u16))) >> 12) 
+                    * ((int32_t)this->calib_st.t3_s16)) >> 14;
+    *tFine_ps32 = var1_s32 + var2_s32;
+    return(((*tFine_ps32 * 5) + 128) >> 8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Pressure compensation, BME280_compensate_P_int64 of the datasheet
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     adc_s32     raw pressure
+ * @param     tFine_s32   fine temperature
+ * @return    pressure in Pa as Q24.8, 0 for an invalid calibration
+*//*-----------------------------------------------------------------------------------*/
+uint32_t Bme280Reader::Pressure_u32(int32_t adc_s32, int32_t tFine_s32) const
+{
+    int64_t var1_s64;
+    int64_t var2_s64;
+    int64_t p_s64;
+
+    var1_s64 = ((int64_t)tFine_s32) - 128000;
+    var2_s64 = var1_s64 * var1_s64 * (int64_t)this->calib_st.p6_s16;
+    var2_s64 = var2_s64 + ((var1_s64 * (int64_t)this->calib_st.p5_s16) * 131072);
+    var2_s64 = var2_s64 + (((int64_t)this->calib_st.p4_s16) * 34359738368ll);
+    var1_s64 = ((var1_s64 * var1_s64 * (int64_t)this->calib_st.p3_s16) >> 8) 
+                    + ((var1_s64 * (int64_t)this->calib_st.p2_s16) * 4096);
+    var1_s64 = ((((int64_t)1) << 47) + var1_s64) * ((int64_t)this->calib_st.p1_u16) >> 33;
+    if(0 == var1_s64)
+    {
+        // avoid the division by zero
+        return(0u);
+    }
+    p_s64 = 1048576 - adc_s32;
+    p_s64 = (((p_s64 << 31) - var2_s64) * 3125) / var1_s64;
+    var1_s64 = (((int64_t)this->calib_st.p9_s16) * (p_s64 >> 13) * (p_s64 >> 13)) >> 25;
+    var2_s64 = (((int64_t)this->calib_st.p8_s16) * p_s64) >> 19;
+    p_s64 = ((p_s64 + var1_s64 + var2_s64) >> 8) + (((int64_t)this->calib_st.p7_s16) * 16);
+    return((uint32_t)p_s64);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Humidity compensation, bme280_compensate_H_int32 of the datasheet
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     adc_s32     raw humidity
+ * @param     tFine_s32   fine temperature
+ * @return    humidity in %RH as Q22.10
+*//*-----------------------------------------------------------------------------------*/
+uint32_t Bme280Reader::Humidity_u32(int32_t adc_s32, int32_t tFine_s32) const
+{
+    int32_t x1_s32;
+
+    x1_s32 = tFine_s32 - ((int32_t)76800);
+    x1_s32 = (((((adc_s32 << 14) - (((int32_t)this->calib_st.h4_s16) * 1048576) 
+                - (((int32_t)this->calib_st.h5_s16) * x1_s32)) + ((int32_t)16384)) >> 15) 
+                * (((((((x1_s32 * ((int32_t)this->calib_st.h6_s8)) >> 10) 
+                * (((x1_s32 * ((int32_t)this->calib_st.h3_u8)) >> 11) + ((int32_t)32768))) >> 10) 
+                + ((int32_t)2097152)) * ((int32_t)this->calib_st.h2_s16) + 8192) >> 14));
+    x1_s32 = (x1_s32 - (((((x1_s32 >> 15) * (x1_s32 >> 15)) >> 7) 
+                * ((int32_t)this->calib_st.h1_u8)) >> 4));
+    x1_s32 = (x1_s32 < 0) ? 0 : x1_s32;
+    x1_s32 = (x1_s32 > HUMIDITY_MAX_Q22_10) ? HUMIDITY_MAX_Q22_10 : x1_s32;
+    return((uint32_t)(x1_s32 >> 12));
+}
@@ -34,8 +34,6 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 /* Include Interfaces */
 #include <PubSubClient.h>
 #include <ESP8266WiFi.h>
-#include <Adafruit_Sensor.h>
-#include <Adafruit_BME280.h>
 
 #include "MqttDevice.h"
 #include "Bme280Sensor.h"         
@@ -53,9 +51,31 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PUB_ALTITUDE         "/s/bme/alt" // altitude data
 #define MQTT_PUB_PRESSURE         "/s/bme/pres" // pressure data
 #define MQTT_PUB_BATTERY          "/s/bme/bat" // battery capacity data
+#define MQTT_SUB_POLICY           "/r/bme/policy" // publish policy of the values
 #define MQTT_REPORT_INTERVAL      5l * MILLISEC_IN_SEC// = 5 seconds between reports
 
+#define TOPIC_TEMPERATURE         0u
+#define TOPIC_HUMIDITY            1u
+#define TOPIC_PRESSURE            2u
+#define TOPIC_ALTITUDE            3u
+#define TOPIC_POLICY              4u
+
+#define HANDLER_POLICY            0u
+
+// the value index of a policy is the topic id of the value
+// published on a change of 0.2 degC, 1 %RH, 0.5 hPa or 4 m, at least every 15 minutes
+#define POLICY_DELTA_TEMPERATURE  0.2F
+#define POLICY_DELTA_HUMIDITY     1.0F
+#define POLICY_DELTA_PRESSURE     0.5F
+#define POLICY_DELTA_ALTITUDE     4.0F
+#define POLICY_MIN_INTERVAL       0ul
+#define POLICY_HEARTBEAT          (15ul * 60ul * MILLISEC_IN_SEC)
+
+#define TIMER_REPORT              0u
+#define TIMER_MEASUREMENT         1u
+
 #define SEALEVELPRESSURE_HPA      1013.25f
+#define ALTITUDE_EXPONENT         0.1903f
 
 #define HUMIDITY_CORR_FACTOR      1.0f
 #define TEMPERATURE_CORR_FACTOR   1.0f
@@ -81,12 +101,12 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
 Bme280Sensor::Bme280Sensor(Trace *p_trace, GpioDevice  *bmePwr_p, 
-                                        GpioDevice  *bmeStat_p) : MqttDevice(p_trace)
+                                        GpioDevice  *bmeStat_p) : MqttDevice(p_trace),
+                                        reader_st(BME280READER_ADDRESS)
 {
     this->prevTime_u32 = 0;
     this->bmePwr_p = bmePwr_p;
     this->bmeStat_p = bmeStat_p;
-    this->bme_p = new Adafruit_BME280();
     this->reportCycleMSec_u32 = MQTT_REPORT_INTERVAL;
 }
 
@@ -101,12 +121,12 @@ Bme280Sensor::Bme280Sensor(Trace *p_trace, GpioDevice  *bmePwr_p,
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
 Bme280Sensor::Bme280Sensor(Trace *p_trace, GpioDevice  *bmePwr_p, GpioDevice  *bmeStat_p, 
-                                  uint16_t reportCycleSec_u16) : MqttDevice(p_trace)
+                                  uint16_t reportCycleSec_u16) : MqttDevice(p_trace),
+                                  reader_st(BME280READER_ADDRESS)
 {
     this->prevTime_u32 = 0;
     this->bmePwr_p = bmePwr_p;
     this->bmeStat_p = bmeStat_p;
-    this->bme_p = new Adafruit_BME280();
     this->reportCycleMSec_u32 = reportCycleSec_u16 * MILLISEC_IN_SEC;
 }
 /**---------------------------------------------------------------------------------------
@@ -128,11 +148,25 @@ Bme280Sensor::~Bme280Sensor()
 *//*-----------------------------------------------------------------------------------*/
 void Bme280Sensor::Initialize()
 {    
+    const float deltas_f32a[BME280SENSOR_VALUES] = {POLICY_DELTA_TEMPERATURE, 
+                POLICY_DELTA_HUMIDITY, POLICY_DELTA_PRESSURE, POLICY_DELTA_ALTITUDE};
+    publishPolicy_t policy_st = {0.0F, false, POLICY_MIN_INTERVAL, POLICY_HEARTBEAT};
+    uint8_t idx_u8;
+
     // initialize pins and turn off bme
-    p_trace->println(trace_INFO_MSG, "<<bme>> BME sensor initialized");
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<bme>> BME sensor initialized"));
+    for(idx_u8 = 0; idx_u8 < BME280SENSOR_VALUES; idx_u8++)
+    {
+        policy_st.delta_f32 = deltas_f32a[idx_u8];
+        this->policies_sta[idx_u8].Configure(&policy_st);
+    }
     this->TurnStatusOff();
     this->TurnBmeOff();
     delay(500);   
+    // first report right after the connection, then every report cycle
+    this->reportRequest_bol = false;
+    this->measRequest_bol = false;
+    this->StartTimer(TIMER_REPORT, 0, this->reportCycleMSec_u32);
     this->isInitialized_bol = true;
 }
 
@@ -150,36 +184,50 @@ void Bme280Sensor::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "<<bme>> BME Sensor connected");
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_TEMPERATURE, build_topic(MQTT_PUB_TEMPERATURE));
+        this->CacheTopic(TOPIC_HUMIDITY, build_topic(MQTT_PUB_HUMIDITY));
+        this->CacheTopic(TOPIC_PRESSURE, build_topic(MQTT_PUB_PRESSURE));
+        this->CacheTopic(TOPIC_ALTITUDE, build_topic(MQTT_PUB_ALTITUDE));
+        this->CacheTopic(TOPIC_POLICY, build_topic(MQTT_SUB_POLICY));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<bme>> BME Sensor connected"));
+        // ... and resubscribe the retained publish policies
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_POLICY));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_POLICY), HANDLER_POLICY);
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, 
-                                "<<bme>> uninizialized MQTT client in bme sensor detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                                "<<bme>> uninizialized MQTT client in bme sensor detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void Bme280Sensor::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void Bme280Sensor::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                                char* p_topic, const MqttPayload &payload)
 {
-    if(true == this->isConnected_bol)
+    if(true != this->isConnected_bol)
     {
-        p_trace->print(trace_ERROR_MSG, "<<bme>> unexpected payload: "); 
-        p_trace->println(trace_PURE_MSG, p_payload);
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<bme>> connection failure in BME CallbackMqtt ")); 
     }
-    else
+    else if(    (HANDLER_POLICY != handlerId_u8) 
+             || (false == PublishPolicy::Apply_bol(this->policies_sta, 
+                                                    BME280SENSOR_VALUES, payload)))
     {
-        p_trace->println(trace_ERROR_MSG, "<<bme>> connection failure in BME CallbackMqtt "); 
+        TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "<<bme>> unexpected payload: ")); 
+        TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
     }
 }
 
@@ -192,82 +240,32 @@ void Bme280Sensor::CallbackMqtt(PubSubClient *client, char* p_topic, String p_pa
 *//*-----------------------------------------------------------------------------------*/
 bool Bme280Sensor::ProcessPublishRequests(PubSubClient *client)
 {
-    String tPayload;
     boolean ret = false;
 
-    if(this->prevTime_u32 + this->reportCycleMSec_u32 < millis() || this->prevTime_u32 == 0)
+    if(true == this->reportRequest_bol)
     {      
         // the sensor data publication is time interval based
         if(true == this->isConnected_bol)
         {
-            p_trace->println(trace_INFO_MSG, "<<bme>> bme Sensor processes publish request");
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, 
+                            "<<bme>> bme Sensor processes publish request"));
+            this->reportRequest_bol = false;
             this->prevTime_u32 = millis();
-            p_trace->println(trace_INFO_MSG, "<<bme>> reading sensor data from BME280");
-
-            // check the internal ADC
-            //out = (unsigned int) analogRead(A0);
-
-            // checking the bme values
-            this->TurnBmeOn();
-            this->humidity_f32      = bme_p->readHumidity();
-            this->temperature_f32   = bme_p->readTemperature();
-            this->pressure_f32      = bme_p->readPressure() / 100.0F;
-            this->altitude_f32      = bme_p->readAltitude(SEALEVELPRESSURE_HPA);
-            this->TurnBmeOff();
-
-            // apply correction factor to measurements
-            this->humidity_f32      = this->humidity_f32 * HUMIDITY_CORR_FACTOR;
-            this->temperature_f32   = this->temperature_f32 * TEMPERATURE_CORR_FACTOR;
-            this->pressure_f32      = this->pressure_f32 * PRESSURE_CORR_FACTOR;
-            this->altitude_f32      = this->altitude_f32 * ALTITUDE_CORR_FACTOR;
-            
-            // Check if any reads failed and exit
-            if (    (isnan(this->humidity_f32)) 
-                ||  (isnan(this->temperature_f32))
-                ||  (isnan(this->pressure_f32))
-                ||  (isnan(this->altitude_f32))
-                ) 
-            {
-                p_trace->println(trace_ERROR_MSG, "<<bme>> Failed to read from BME sensor!");
-            }
-            else
-            {      
-                p_trace->print(trace_INFO_MSG, "<<bme>> publish temperature: ");
-                p_trace->print(trace_PURE_MSG, MQTT_PUB_TEMPERATURE);
-                p_trace->print(trace_PURE_MSG, "  :  ");
-                ret = client->publish(build_topic(MQTT_PUB_TEMPERATURE), 
-                                        f2s(this->temperature_f32, 2), true);
-                p_trace->println(trace_PURE_MSG, f2s(this->temperature_f32, 2));
-                
-                p_trace->print(trace_INFO_MSG, "<<bme>> publish humidity: ");
-                p_trace->print(trace_PURE_MSG, MQTT_PUB_HUMIDITY);
-                p_trace->print(trace_PURE_MSG, "  :  ");
-                ret = client->publish(build_topic(MQTT_PUB_HUMIDITY), 
-                                        f2s(this->humidity_f32, 2), true);
-                p_trace->println(trace_PURE_MSG, f2s(this->humidity_f32, 2));  
-
-                p_trace->print(trace_INFO_MSG, "<<bme>> publish pressure: ");
-                p_trace->print(trace_PURE_MSG, MQTT_PUB_PRESSURE);
-                p_trace->print(trace_PURE_MSG, "  :  ");
-                ret = client->publish(build_topic(MQTT_PUB_PRESSURE), 
-                                        f2s(this->pressure_f32, 2), true);
-                p_trace->println(trace_PURE_MSG, f2s(this->pressure_f32, 2)); 
-
-                p_trace->print(trace_INFO_MSG, "<<bme>> publish altitude: ");
-                p_trace->print(trace_PURE_MSG, MQTT_PUB_ALTITUDE);
-                p_trace->print(trace_PURE_MSG, "  :  ");
-                ret = client->publish(build_topic(MQTT_PUB_ALTITUDE), 
-                                        f2s(this->altitude_f32, 2), true);
-                p_trace->println(trace_PURE_MSG, f2s(this->altitude_f32, 2)); 
-            }
+            this->StartMeasurement();
         } 
         else
         {
-            p_trace->println(trace_ERROR_MSG, 
-                                  "connection failure in dht ProcessPublishRequests "); 
+            TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                                  "connection failure in dht ProcessPublishRequests ")); 
         }
     }
 
+    if(true == this->measRequest_bol)
+    {
+        this->measRequest_bol = false;
+        ret = this->PublishData(client);
+    }
+
     return ret;  
 }
 
@@ -276,6 +274,26 @@ bool Bme280Sensor::ProcessPublishRequests(PubSubClient *client)
 
 /****************************************************************************************/
 /* Protected functions: */
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for the expired device timers, requests the next measurement or
+ *              the publication of the finished measurement
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Bme280Sensor::ProcessTimer(uint8_t timerId_u8)
+{
+    if(TIMER_REPORT == timerId_u8)
+    {
+        this->reportRequest_bol = true;
+    }
+    else if(TIMER_MEASUREMENT == timerId_u8)
+    {
+        this->measRequest_bol = true;
+    }
+}
+
 /**---------------------------------------------------------------------------------------
  * @brief     This function converts a float value to a string
  * @author    winkste
@@ -303,23 +321,118 @@ char* Bme280Sensor::f2s(float f, int p)
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     This function turns on the Bme power pin and waits for a dedicated time.
+ * @brief     This function powers the sensor and triggers one forced measurement, the
+ *              result is read by the measurement timer
  * @author    winkste
- * @date      20 Okt. 2017
+ * @date      17 Okt. 2026
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void Bme280Sensor::TurnBmeOn() 
+void Bme280Sensor::StartMeasurement(void)
+{
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, 
+                    "<<bme>> reading sensor data from BME280"));
+    if((true == this->TurnBmeOn()) && (true == this->reader_st.StartMeasurement_bol()))
+    {
+        this->StartTimer(TIMER_MEASUREMENT, BME280READER_MEAS_TIME, 0);
+    }
+    else
+    {
+        this->TurnBmeOff();
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<bme>> Failed to read from BME sensor!"));
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     This function reads the finished measurement in one burst and publishes 
+ *              temperature, humidity, pressure and the altitude calculated from it, if 
+ *              their publish policies request it
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client     mqtt client object
+ * @return    true if transmission was successful
+*//*-----------------------------------------------------------------------------------*/
+boolean Bme280Sensor::PublishData(PubSubClient *client)
+{
+    bme280Sample_t sample_st;
+    boolean ret = false;
+    uint32_t now_u32;
+    bool valid_bol = this->reader_st.ReadSample_bol(&sample_st);
+
+    this->TurnBmeOff();
+    if(false == valid_bol)
+    {
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<bme>> Failed to read from BME sensor!"));
+        return(false);
+    }
+
+    // apply correction factor to measurements
+    this->temperature_f32   = ((float)sample_st.temperature_s32 / 100.0F) 
+                                * TEMPERATURE_CORR_FACTOR;
+    this->humidity_f32      = ((float)sample_st.humidity_u32 / 1024.0F) 
+                                * HUMIDITY_CORR_FACTOR;
+    this->pressure_f32      = ((float)sample_st.pressure_u32 / 25600.0F) 
+                                * PRESSURE_CORR_FACTOR;
+    this->altitude_f32      = 44330.0F * (1.0F - powf(((float)sample_st.pressure_u32 
+                                / 25600.0F) / SEALEVELPRESSURE_HPA, ALTITUDE_EXPONENT));
+    this->altitude_f32      = this->altitude_f32 * ALTITUDE_CORR_FACTOR;
+
+    // every value is published on its own, when its policy requests it
+    now_u32 = millis();
+    ret = PublishValue_bol(client, TOPIC_TEMPERATURE, this->temperature_f32, now_u32);
+    ret = PublishValue_bol(client, TOPIC_HUMIDITY, this->humidity_f32, now_u32) && ret;
+    ret = PublishValue_bol(client, TOPIC_PRESSURE, this->pressure_f32, now_u32) && ret;
+    ret = PublishValue_bol(client, TOPIC_ALTITUDE, this->altitude_f32, now_u32) && ret;
+
+    return(ret);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     This function publishes one value, if it moved by the delta of its publish
+ *              policy or reached the heartbeat
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client        mqtt client object
+ * @param     valueId_u8    value index, equal to the topic id of the value
+ * @param     value_f32     measured value
+ * @param     now_u32       time of the measurement in milliseconds
+ * @return    true if transmission was successful or not needed
+*//*-----------------------------------------------------------------------------------*/
+bool Bme280Sensor::PublishValue_bol(PubSubClient *client, uint8_t valueId_u8, 
+                                    float value_f32, uint32_t now_u32)
+{
+    bool ret_bol = true;
+
+    if(true == this->policies_sta[valueId_u8].IsDue_bol(value_f32, now_u32))
+    {
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<bme>> publish: "));
+        TRACE_INFO(p_trace->print(trace_PURE_MSG, GetTopic_ccp(valueId_u8)));
+        TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+        ret_bol = Publish_bol(client, GetTopic_ccp(valueId_u8), f2s(value_f32, 2), true);
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, f2s(value_f32, 2)));
+        this->policies_sta[valueId_u8].SetPublished(value_f32, now_u32);
+    }
+    return(ret_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     This function turns on the Bme power pin and waits for the start up of
+ *              the sensor.
+ * @author    winkste
+ * @date      20 Okt. 2017
+ * @return    true, if the sensor answered
+*//*-----------------------------------------------------------------------------------*/
+bool Bme280Sensor::TurnBmeOn() 
 { 
   if(NULL != this->bmePwr_p)
   {
       bmePwr_p->DigitalWrite(HIGH);
-      delay(500);
+      delay(BME280READER_STARTUP_TIME);
   }
 
-  // start dht
-  bme_p->begin(); 
-
-  delay(500);
+  // start bme, the calibration is only read after the first power up
+  return(this->reader_st.Begin_bol());
 }
 
 /**---------------------------------------------------------------------------------------
@@ -370,10 +483,10 @@ void Bme280Sensor::TurnStatusOff()
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* Bme280Sensor::build_topic(const char *topic) 
 {
-  sprintf(buffer_ca, "std/%s%s", this->dev_p, topic);
-  return buffer_ca;
+  sprintf(buildBuffer_ca, "std/%s%s", this->dev_p, topic);
+  return buildBuffer_ca;
 }
@@ -38,7 +38,9 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #include "GpioDevice.h"
 #include "Trace.h"
 #include "PubSubClient.h"
-#include <LinkedList.h>
+#include "DeviceRegistry.h"
+#include "LoopProfiler.h"
+#include <new>
 
 #include "DhtSensor.h"
 #include "SingleRelay.h"
@@ -53,6 +55,7 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #include "DimLight.h"
 #include "NeoPix.h"
 #include "GenSensor.h"
+#include "HeapMonitor.h"
 
 /****************************************************************************************/
 /* Local constant defines */
@@ -218,9 +221,408 @@ GPIO17	    User
 
 /****************************************************************************************/
 /* Local function like makros */
+// every object in the arena starts at the alignment of the strictest member type
+#define ARENA_ALIGN                     (sizeof(arenaCell_t))
+#define ARENA_ALIGNED(size)             ((uint16_t)((((size) + ARENA_ALIGN - 1u) \
+                                                / ARENA_ALIGN) * ARENA_ALIGN))
+#define PROFILE(cap, entries)           { cap, entries, \
+                                            (uint8_t)(sizeof(entries) / sizeof(deviceEntry_t)) }
 
 /****************************************************************************************/
 /* Local type definitions (enum, struct, union) */
+typedef union arenaCell_tag
+{
+    void        *ptr_p;
+    uint32_t    u32;
+    double      f64;
+}arenaCell_t;
+
+typedef struct capProfile_tag
+{
+    uint8_t             cap_u8;
+    const deviceEntry_t *entries_pst;
+    uint8_t             size_u8;
+}capProfile_t;
+
+/****************************************************************************************/
+/* Local data definitions */
+// arena size of the device objects, the gpio devices of an entry are generated with it
+static constexpr uint16_t deviceSize_stcu16a[DEVICEFACTORY_TYPES] =
+{
+    ARENA_ALIGNED(sizeof(SingleRelay)),         // DEVICEFACTORY_RELAY_ESP
+    ARENA_ALIGNED(sizeof(SingleRelay)),         // DEVICEFACTORY_RELAY_MCP
+    ARENA_ALIGNED(sizeof(DhtSensor)),           // DEVICEFACTORY_DHT
+    ARENA_ALIGNED(sizeof(SonoffBasic)),         // DEVICEFACTORY_SONOFF
+    ARENA_ALIGNED(sizeof(Pir)),                 // DEVICEFACTORY_PIR
+    ARENA_ALIGNED(sizeof(PowerSave)),           // DEVICEFACTORY_POWER_SAVE
+    ARENA_ALIGNED(sizeof(Sen0193)),             // DEVICEFACTORY_SEN0193
+    ARENA_ALIGNED(sizeof(Bme280Sensor)),        // DEVICEFACTORY_BME
+    ARENA_ALIGNED(sizeof(GenSensor)),           // DEVICEFACTORY_GEN_SENSOR
+    ARENA_ALIGNED(sizeof(Temt6000)),            // DEVICEFACTORY_TEMT6000
+    ARENA_ALIGNED(sizeof(NeoPix)),              // DEVICEFACTORY_NEOPIX
+    ARENA_ALIGNED(sizeof(DimLight)),            // DEVICEFACTORY_DIM_LIGHT
+    ARENA_ALIGNED(sizeof(HeapMonitor))          // DEVICEFACTORY_HEAP_MONITOR
+};
+
+static constexpr uint16_t gpioSize_stcu16a[DEVICEFACTORY_TYPES] =
+{
+    ARENA_ALIGNED(sizeof(EspGpio)),             // DEVICEFACTORY_RELAY_ESP
+    ARENA_ALIGNED(sizeof(McpGpio)),             // DEVICEFACTORY_RELAY_MCP
+    ARENA_ALIGNED(sizeof(EspGpio)),             // DEVICEFACTORY_DHT, power pin
+    0u,                                         // DEVICEFACTORY_SONOFF
+    0u,                                         // DEVICEFACTORY_PIR
+    0u,                                         // DEVICEFACTORY_POWER_SAVE
+    0u,                                         // DEVICEFACTORY_SEN0193
+    2u * ARENA_ALIGNED(sizeof(EspGpio)),        // DEVICEFACTORY_BME, power and led pin
+    0u,                                         // DEVICEFACTORY_GEN_SENSOR
+    ARENA_ALIGNED(sizeof(EspGpio)),             // DEVICEFACTORY_TEMT6000, power pin
+    ARENA_ALIGNED(sizeof(EspGpio)),             // DEVICEFACTORY_NEOPIX
+    ARENA_ALIGNED(sizeof(EspGpio)),             // DEVICEFACTORY_DIM_LIGHT
+    0u                                          // DEVICEFACTORY_HEAP_MONITOR
+};
+
+static const char * const deviceName_stccpa[DEVICEFACTORY_TYPES] =
+{
+    "single relay",
+    "mcp relay",
+    "dht",
+    "sonoff basic",
+    "pir",
+    "power save",
+    "moisture sensor 0193",
+    "bme",
+    "generic sensor",
+    "temt6000",
+    "neopixels",
+    "dim light",
+    "heap monitor"
+};
+
+// capability tables: type, pin, auxiliary pin, gpio direction, param, param2, channel
+static constexpr deviceEntry_t singleRelay_stca[] =
+{
+    { DEVICEFACTORY_RELAY_ESP, RELAY_PIN_ONE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_ONE }
+};
+
+static constexpr deviceEntry_t dhtSensor_stca[] =
+{
+    { DEVICEFACTORY_DHT, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        NULL }
+};
+
+static constexpr deviceEntry_t sonoffBasic_stca[] =
+{
+    { DEVICEFACTORY_SONOFF, DEVICEFACTORY_PIN_UNUSED, SONOFF_LED, OUTPUT, 0u, 0u, NULL }
+};
+
+static constexpr deviceEntry_t pir_stca[] =
+{
+    { DEVICEFACTORY_PIR, PIR_INPUT_PIN, PIR_LED_PIN, INPUT, 0u, 0u, NULL }
+};
+
+static constexpr deviceEntry_t dhtSensorBat_stca[] =
+{
+    { DEVICEFACTORY_DHT, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        NULL },
+    { DEVICEFACTORY_POWER_SAVE, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        DHT_POWER_ON_TIME, DHT_DEEPSLEEP_TIME, NULL }
+};
+
+static constexpr deviceEntry_t fourRelay_stca[] =
+{
+    { DEVICEFACTORY_RELAY_ESP, RELAY_PIN_ONE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_ONE },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_PIN_TWO, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_TWO },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_PIN_THREE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_THREE },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_PIN_FOUR, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_FOUR }
+};
+
+static constexpr deviceEntry_t pirRelay_stca[] =
+{
+    { DEVICEFACTORY_RELAY_ESP, RELAY_PIN_ONE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_ONE },
+    { DEVICEFACTORY_PIR, PIR_INPUT_PIN, PIR_LED_PIN, INPUT, 0u, 0u, NULL }
+};
+
+static constexpr deviceEntry_t fourRelayMcp_stca[] =
+{
+    { DEVICEFACTORY_RELAY_MCP, RELAY_MCP_PIN_ONE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_ONE },
+    { DEVICEFACTORY_RELAY_MCP, RELAY_MCP_PIN_TWO, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_TWO },
+    { DEVICEFACTORY_RELAY_MCP, RELAY_MCP_PIN_THREE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_THREE },
+    { DEVICEFACTORY_RELAY_MCP, RELAY_MCP_PIN_FOUR, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_FOUR }
+};
+
+static constexpr deviceEntry_t doubleDht_stca[] =
+{
+    { DEVICEFACTORY_DHT, DHT_R8_OUT_DATA_PIN, DHT_R8_OUT_PWR_PIN, OUTPUT, 
+        DHT_R8_REPORT_CYCLE_TIME, 0u, NULL },
+    { DEVICEFACTORY_DHT, DHT_R8_IN_DATA_PIN, DHT_R8_IN_PWR_PIN, OUTPUT, 
+        DHT_R8_REPORT_CYCLE_TIME, 1u, NULL },
+    { DEVICEFACTORY_SEN0193, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        0u, 0u, NULL }
+};
+
+static constexpr deviceEntry_t eightRelayEsp_stca[] =
+{
+    { DEVICEFACTORY_RELAY_ESP, RELAY_ESP_PIN_ONE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_ONE },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_ESP_PIN_TWO, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_TWO },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_ESP_PIN_THREE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_THREE },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_ESP_PIN_FOUR, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_FOUR },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_ESP_PIN_FIVE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_FIVE },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_ESP_PIN_SIX, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_SIX },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_ESP_PIN_SEVEN, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_SEVEN },
+    { DEVICEFACTORY_RELAY_ESP, RELAY_ESP_PIN_EIGHT, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_CHAN_EIGHT }
+};
+
+static constexpr deviceEntry_t bmeSensor_stca[] =
+{
+    { DEVICEFACTORY_BME, BME_PWR_PIN, BME_LED_PIN, OUTPUT, BME_REPORT_CYCLE_TIME, 0u, NULL },
+    { DEVICEFACTORY_POWER_SAVE, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        BME_POWER_ON_TIME, BME_DEEPSLEEP_TIME, NULL }
+};
+
+static constexpr deviceEntry_t sonoffPir_stca[] =
+{
+    { DEVICEFACTORY_SONOFF, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        0u, 0u, NULL },
+    { DEVICEFACTORY_PIR, PIR_SONOFF_INPUT_PIN, PIR_SONOFF_OUTPUT_LED, INPUT, 0u, 0u, NULL }
+};
+
+static constexpr deviceEntry_t moistureOnly_stca[] =
+{
+    { DEVICEFACTORY_SEN0193, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        0u, 0u, NULL }
+};
+
+static constexpr deviceEntry_t multiSense_stca[] =
+{
+    { DEVICEFACTORY_GEN_SENSOR, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        0u, 0u, NULL },
+    { DEVICEFACTORY_DHT, MS_DHT_OUT_DATA_PIN, MS_DHT_OUT_PWR_PIN, OUTPUT, 
+        MS_DHT_REPORT_CYCLE_TIME, 0u, NULL },
+    { DEVICEFACTORY_PIR, MS_PIR_INPUT_PIN, DEVICEFACTORY_PIN_UNUSED, INPUT, 0u, 0u, NULL },
+    { DEVICEFACTORY_TEMT6000, DEVICEFACTORY_PIN_UNUSED, MS_TEMT6000_OUT_PWR_PIN, OUTPUT, 
+        0u, 0u, NULL },
+    { DEVICEFACTORY_NEOPIX, NEOPIXELS_PIN, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_NEOPIXELS }
+};
+
+static constexpr deviceEntry_t multiSenseRelay_stca[] =
+{
+    { DEVICEFACTORY_GEN_SENSOR, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        0u, 0u, NULL },
+    { DEVICEFACTORY_DHT, MS_DHT_OUT_DATA_PIN, MS_DHT_OUT_PWR_PIN, OUTPUT, 
+        MS_DHT_REPORT_CYCLE_TIME, 0u, NULL },
+    { DEVICEFACTORY_PIR, MS_PIR_INPUT_PIN, DEVICEFACTORY_PIN_UNUSED, INPUT, 0u, 0u, NULL },
+    { DEVICEFACTORY_TEMT6000, DEVICEFACTORY_PIN_UNUSED, MS_TEMT6000_OUT_PWR_PIN, OUTPUT, 
+        0u, 0u, NULL },
+    { DEVICEFACTORY_NEOPIX, NEOPIXELS_PIN, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_NEOPIXELS },
+    { DEVICEFACTORY_RELAY_ESP, MS_RELAY_PIN_ONE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        MQTT_CHAN_ONE }
+};
+
+static constexpr deviceEntry_t dimLight_stca[] =
+{
+    { DEVICEFACTORY_DIM_LIGHT, DIM_LIGHT_1, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_DIM_LIGHT_1 }
+};
+
+static constexpr deviceEntry_t h801_stca[] =
+{
+    { DEVICEFACTORY_DIM_LIGHT, H801_PIN_RED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        MAX_DIM_DIGITS, 0u, MQTT_H801_LIGHT_RED },
+    { DEVICEFACTORY_DIM_LIGHT, H801_PIN_GREEN, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        MAX_DIM_DIGITS, 0u, MQTT_H801_LIGHT_GREEN },
+    { DEVICEFACTORY_DIM_LIGHT, H801_PIN_BLUE, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        MAX_DIM_DIGITS, 0u, MQTT_H801_LIGHT_BLUE },
+    { DEVICEFACTORY_DIM_LIGHT, H801_PIN_W1, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_H801_LIGHT_W1 },
+    { DEVICEFACTORY_DIM_LIGHT, H801_PIN_W2, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_H801_LIGHT_W2 },
+    { DEVICEFACTORY_DIM_LIGHT, H801_PIN_LED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_H801_LIGHT_LED },
+    { DEVICEFACTORY_DIM_LIGHT, H801_PIN_LED2, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_H801_LIGHT_LED2 }
+};
+
+static constexpr deviceEntry_t neoPixels_stca[] =
+{
+    { DEVICEFACTORY_NEOPIX, NEOPIXELS_PIN, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_NEOPIXELS }
+};
+
+// the dim light gpios of the 3d printer keep the default input direction
+static constexpr deviceEntry_t printer3D_stca[] =
+{
+    { DEVICEFACTORY_DIM_LIGHT, PRT_3D_CTRL_DIM_1, DEVICEFACTORY_PIN_UNUSED, gpioDevice_INPUT, 
+        0u, 0u, PRT_3D_CTRL_MQTT_DIM_1 },
+    { DEVICEFACTORY_DIM_LIGHT, PRT_3D_CTRL_DIM_2, DEVICEFACTORY_PIN_UNUSED, gpioDevice_INPUT, 
+        0u, 0u, PRT_3D_CTRL_MQTT_DIM_2 },
+    { DEVICEFACTORY_RELAY_ESP, PRT_3D_CTRL_REL_1, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        PRT_3D_CTRL_MQTT_REL_1 },
+    { DEVICEFACTORY_RELAY_ESP, PRT_3D_CTRL_REL_2, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 1u, 0u, 
+        PRT_3D_CTRL_MQTT_REL_2 },
+    { DEVICEFACTORY_DHT, PRT_3D_CTRL_DHT_DATA_1, PRT_3D_CTRL_DHT_PWR_1, OUTPUT, 
+        MS_DHT_REPORT_CYCLE_TIME, 0u, NULL },
+    { DEVICEFACTORY_DHT, PRT_3D_CTRL_DHT_DATA_2, PRT_3D_CTRL_DHT_PWR_2, OUTPUT, 
+        MS_DHT_REPORT_CYCLE_TIME, 1u, NULL }
+};
+
+static constexpr deviceEntry_t singleRelPir_stca[] =
+{
+    { DEVICEFACTORY_RELAY_ESP, SINGLE_RELAY_OUTPUT_PIN, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        0u, 0u, MQTT_CHAN_ONE },
+    { DEVICEFACTORY_PIR, SINGLE_RELAY_PIR_INPUT_PIN, SINGLE_RELAY_PIR_OUTPUT_LED, INPUT, 
+        0u, 0u, NULL }
+};
+
+static constexpr deviceEntry_t testDevice_stca[] =
+{
+    { DEVICEFACTORY_GEN_SENSOR, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+        1u, 0u, NULL },
+    { DEVICEFACTORY_NEOPIX, NEOPIXELS_PIN, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 0u, 0u, 
+        MQTT_NEOPIXELS }
+};
+
+// the heap telemetry runs with every capability
+static constexpr deviceEntry_t heapMonitor_stc =
+{
+    DEVICEFACTORY_HEAP_MONITOR, DEVICEFACTORY_PIN_UNUSED, DEVICEFACTORY_PIN_UNUSED, OUTPUT, 
+    0u, 0u, NULL
+};
+
+// the test device is the last entry, it is used for all unknown capabilities
+static constexpr capProfile_t profiles_stca[] =
+{
+    PROFILE(CAPABILITY_SINGLE_RELAY,        singleRelay_stca),
+    PROFILE(CAPABILITY_DHT_SENSOR,          dhtSensor_stca),
+    PROFILE(CAPABILITY_SONOFF_BASIC,        sonoffBasic_stca),
+    PROFILE(CAPABILITY_PIR,                 pir_stca),
+    PROFILE(CAPABILITY_DHT_SENSOR_BAT,      dhtSensorBat_stca),
+    PROFILE(CAPABILITY_FOUR_RELAY,          fourRelay_stca),
+    PROFILE(CAPABILITY_PIR_RELAY,           pirRelay_stca),
+    PROFILE(CAPABILITY_FOUR_RELAY_MCP,      fourRelayMcp_stca),
+    PROFILE(CAPABILITY_DOUBLE_DHT,          doubleDht_stca),
+    PROFILE(CAPABILITY_EIGHT_RELAY_ESP,     eightRelayEsp_stca),
+    PROFILE(CAPABILITY_BME_SENSOR,          bmeSensor_stca),
+    PROFILE(CAPABILITY_SONOFF_PIR,          sonoffPir_stca),
+    PROFILE(CAPABILITY_MOISTURE_ONLY,       moistureOnly_stca),
+    PROFILE(CAPABILITY_MULTI_SENSE,         multiSense_stca),
+    PROFILE(CAPABILITY_MULTI_SENSE_RELAY,   multiSenseRelay_stca),
+    PROFILE(CAPABILITY_DIM_LIGHT,           dimLight_stca),
+    PROFILE(CAPABILITY_H801,                h801_stca),
+    PROFILE(CAPABILITY_NEOPIXELS,           neoPixels_stca),
+    PROFILE(CAPABILITY_3D_PRINTER,          printer3D_stca),
+    PROFILE(CAPABILITY_SINGLE_REL_PIR,      singleRelPir_stca),
+    PROFILE(CAPABILITY_TEST_DEVICE,         testDevice_stca)
+};
+#define PROFILES            (sizeof(profiles_stca) / sizeof(capProfile_t))
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Build time maximum of two sizes
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     a_u16       first size
+ * @param     b_u16       second size
+ * @return    larger size
+*//*-----------------------------------------------------------------------------------*/
+static constexpr uint16_t Max_u16(uint16_t a_u16, uint16_t b_u16)
+{
+    return((a_u16 > b_u16) ? a_u16 : b_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Calculates the arena bytes of one table entry including its gpio devices
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     entry_p     table entry
+ * @return    arena bytes
+*//*-----------------------------------------------------------------------------------*/
+static constexpr uint16_t EntrySize_u16(const deviceEntry_t *entry_p)
+{
+    return(deviceSize_stcu16a[entry_p->type_u8]
+            + (((DEVICEFACTORY_DHT == entry_p->type_u8) 
+                    && (DEVICEFACTORY_PIN_UNUSED == entry_p->pin_u8)) 
+                ? 0u : gpioSize_stcu16a[entry_p->type_u8]));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Calculates the arena bytes of a capability table without the heap monitor
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     entries_p   first table entry
+ * @param     size_u8     number of table entries
+ * @return    arena bytes
+*//*-----------------------------------------------------------------------------------*/
+static constexpr uint16_t ProfileSize_u16(const deviceEntry_t *entries_p, uint8_t size_u8)
+{
+    return((0u == size_u8) ? 0u 
+            : (EntrySize_u16(entries_p) + ProfileSize_u16(entries_p + 1, size_u8 - 1u)));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Searches the largest capability table
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     profiles_p  first capability
+ * @param     size_u8     number of capabilities
+ * @return    arena bytes of the largest capability
+*//*-----------------------------------------------------------------------------------*/
+static constexpr uint16_t MaxProfileSize_u16(const capProfile_t *profiles_p, uint8_t size_u8)
+{
+    return((0u == size_u8) ? 0u
+            : Max_u16(ProfileSize_u16(profiles_p->entries_pst, profiles_p->size_u8), 
+                        MaxProfileSize_u16(profiles_p + 1, size_u8 - 1u)));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Searches the capability table with the most devices
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     profiles_p  first capability
+ * @param     size_u8     number of capabilities
+ * @return    number of devices of the largest capability without the heap monitor
+*//*-----------------------------------------------------------------------------------*/
+static constexpr uint8_t MaxProfileDevices_u8(const capProfile_t *profiles_p, 
+                                                uint8_t size_u8)
+{
+    return((0u == size_u8) ? 0u
+            : (uint8_t)Max_u16(profiles_p->size_u8, 
+                                MaxProfileDevices_u8(profiles_p + 1, size_u8 - 1u)));
+}
+
+// worst case RAM of all device objects, known at build time
+static constexpr uint16_t arenaSize_stcu16 = 
+                                    MaxProfileSize_u16(profiles_stca, (uint8_t)PROFILES)
+                                    + EntrySize_u16(&heapMonitor_stc);
+static arenaCell_t arena_sta[arenaSize_stcu16 / ARENA_ALIGN];
+
+// worst case device count of all capabilities including the heap monitor, the registry
+// and the loop profiler have to cover every generated device
+static constexpr uint8_t devicesMax_stcu8 = 
+                                    MaxProfileDevices_u8(profiles_stca, (uint8_t)PROFILES)
+                                    + 1u;
+static_assert(DEVICEREGISTRY_SIZE >= devicesMax_stcu8,
+                "DEVICEREGISTRY_SIZE is below the devices of the largest capability");
+static_assert(LOOPPROFILER_DEVICES >= devicesMax_stcu8,
+                "LOOPPROFILER_DEVICES is below the devices of the largest capability");
 
 /****************************************************************************************/
 /* Public functions (unlimited visibility) */
@@ -235,6 +637,7 @@ GPIO17	    User
 DeviceFactory::DeviceFactory(Trace * p_trace)
 {
     this->trace_p = p_trace;
+    this->arenaUsed_u16 = 0u;
 }
 
 /**---------------------------------------------------------------------------------------
@@ -250,329 +653,257 @@ void DeviceFactory::SelectTraceChannel(uint8_t chan_u8)
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Method to generate devices based on the specified type
+ * @brief     Method to generate devices based on the specified type. The devices are
+ *              constructed in the static arena, nothing is allocated from the heap.
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     type_u8     type of device
- * @return    a MqttDevice if successful, else NULL
+ * @param     cap_u8        capability of the device
+ * @param     registry_p    registry receiving the generated devices
+ * @return    true, if all devices of the capability fit into the registry
 *//*-----------------------------------------------------------------------------------*/
-LinkedList<MqttDevice*> * DeviceFactory::GenerateDevice(uint8_t cap_u8)
+bool DeviceFactory::GenerateDevice(uint8_t cap_u8, DeviceRegistry *registry_p)
 {
-    LinkedList<MqttDevice*> *deviceList_p = new LinkedList<MqttDevice*>();
-    
-    MqttDevice * device_p = NULL;
-    SonoffBasic *sonoffDevice_p = NULL;
-    Pir *pirDevice_p = NULL;
+    bool ret_bol = true;
+    const capProfile_t *profile_p = &profiles_stca[PROFILES - 1u];
+    uint8_t idx_u8;
+
+    for(idx_u8 = 0; idx_u8 < PROFILES; idx_u8++)
+    {
+        if(cap_u8 == profiles_stca[idx_u8].cap_u8)
+        {
+            profile_p = &profiles_stca[idx_u8];
+            break;
+        }
+    }
+
+    // the arena is sized for the largest capability, it only runs short on a second call
+    if((this->arenaUsed_u16 + ProfileSize_u16(profile_p->entries_pst, profile_p->size_u8)
+            + EntrySize_u16(&heapMonitor_stc)) > arenaSize_stcu16)
+    {
+        TRACE_ERROR(trace_p->println(trace_ERROR_MSG, 
+                                        "<<devMgr>> device arena exhausted"));
+        return(false);
+    }
+
+    for(idx_u8 = 0; idx_u8 < profile_p->size_u8; idx_u8++)
+    {
+        ret_bol = this->AddDevice(registry_p, 
+                            this->GenerateEntry_p(&profile_p->entries_pst[idx_u8])) && ret_bol;
+    }
+    ret_bol = this->AddDevice(registry_p, this->GenerateEntry_p(&heapMonitor_stc)) && ret_bol;
+
+    return(ret_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the bytes of the device arena in use
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    used bytes
+*//*-----------------------------------------------------------------------------------*/
+uint16_t DeviceFactory::GetArenaUsed_u16(void) const
+{
+    return(this->arenaUsed_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the size of the device arena, the worst case device RAM of all
+ *              capabilities
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    arena size in bytes
+*//*-----------------------------------------------------------------------------------*/
+uint16_t DeviceFactory::GetArenaSize_u16(void)
+{
+    return(arenaSize_stcu16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Default destructor
+ * @author    winkste
+ * @date      20 Okt. 2017
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+DeviceFactory::~DeviceFactory()
+{
+    // TODO Auto-generated destructor stub
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Adds a generated device to the registry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     registry_p    registry receiving the device
+ * @param     device_p      generated device
+ * @return    true, if the device was stored
+*//*-----------------------------------------------------------------------------------*/
+bool DeviceFactory::AddDevice(DeviceRegistry *registry_p, MqttDevice *device_p)
+{
+    if(false == registry_p->Add_bol(device_p))
+    {
+        TRACE_ERROR(trace_p->println(trace_ERROR_MSG, 
+                                        "<<devMgr>> device registry full, device dropped"));
+        return(false);
+    }
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Reserves memory for one object in the device arena
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     size_u16      object size
+ * @return    memory for the object
+*//*-----------------------------------------------------------------------------------*/
+void* DeviceFactory::Reserve_p(uint16_t size_u16)
+{
+    void *mem_p = &((uint8_t *)arena_sta)[this->arenaUsed_u16];
+
+    this->arenaUsed_u16 += ARENA_ALIGNED(size_u16);
+    return(mem_p);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Generates a gpio device in the device arena
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     pin_u8        pin of the gpio
+ * @param     dir_u8        direction of the gpio
+ * @param     mcp_bol       true for a MCP23017 gpio, false for an ESP gpio
+ * @return    generated gpio device
+*//*-----------------------------------------------------------------------------------*/
+GpioDevice* DeviceFactory::GenerateGpio_p(uint8_t pin_u8, uint8_t dir_u8, bool mcp_bol)
+{
+    if(true == mcp_bol)
+    {
+        return(new (this->Reserve_p(sizeof(McpGpio))) McpGpio(trace_p, pin_u8, dir_u8));
+    }
+    return(new (this->Reserve_p(sizeof(EspGpio))) EspGpio(trace_p, pin_u8, dir_u8));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Generates the device of a capability table entry in the device arena
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     entry_p       capability table entry
+ * @return    generated device
+*//*-----------------------------------------------------------------------------------*/
+MqttDevice* DeviceFactory::GenerateEntry_p(const deviceEntry_t *entry_p)
+{
+    MqttDevice *device_p = NULL;
     GpioDevice *gpio_p = NULL;
     GpioDevice *gpio2_p = NULL;
+    SonoffBasic *sonoffDevice_p = NULL;
+    Pir *pirDevice_p = NULL;
 
-    switch(cap_u8)
+    switch(entry_p->type_u8)
     {
-        case CAPABILITY_SINGLE_RELAY:
-            gpio_p   = new EspGpio(trace_p, RELAY_PIN_ONE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_ONE, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_RELAY_ESP:
+        case DEVICEFACTORY_RELAY_MCP:
+            gpio_p   = this->GenerateGpio_p(entry_p->pin_u8, entry_p->dir_u8, 
+                                            (DEVICEFACTORY_RELAY_MCP == entry_p->type_u8));
+            device_p = new (this->Reserve_p(sizeof(SingleRelay))) 
+                            SingleRelay(trace_p, gpio_p, entry_p->chan_ccp, 
+                                        (0u != entry_p->param_u16));
             break;
-        case CAPABILITY_DHT_SENSOR:
-            device_p = new DhtSensor(trace_p);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated dht device");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_DHT:
+            if(DEVICEFACTORY_PIN_UNUSED == entry_p->pin_u8)
+            {
+                device_p = new (this->Reserve_p(sizeof(DhtSensor))) DhtSensor(trace_p);
+            }
+            else
+            {
+                gpio_p   = this->GenerateGpio_p(entry_p->auxPin_u8, entry_p->dir_u8, false);
+                device_p = new (this->Reserve_p(sizeof(DhtSensor))) 
+                                DhtSensor(trace_p, entry_p->pin_u8, gpio_p, 
+                                            entry_p->param_u16, (uint8_t)entry_p->param2_u16);
+            }
             break;
-        case CAPABILITY_SONOFF_BASIC:
-            sonoffDevice_p = new SonoffBasic(trace_p, SONOFF_LED);
+        case DEVICEFACTORY_SONOFF:
+            if(DEVICEFACTORY_PIN_UNUSED == entry_p->auxPin_u8)
+            {
+                sonoffDevice_p = new (this->Reserve_p(sizeof(SonoffBasic))) 
+                                    SonoffBasic(trace_p);
+            }
+            else
+            {
+                sonoffDevice_p = new (this->Reserve_p(sizeof(SonoffBasic))) 
+                                    SonoffBasic(trace_p, entry_p->auxPin_u8);
+            }
             sonoffDevice_p->SetSelf(sonoffDevice_p);
             device_p = sonoffDevice_p;
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated sonoff basic device");
-            deviceList_p->add(device_p);
             break;
-        case CAPABILITY_PIR:
-            //pirDevice_p = new Pir(trace_p);
-            pirDevice_p = new Pir(trace_p, PIR_INPUT_PIN, false, PIR_LED_PIN);
+        case DEVICEFACTORY_PIR:
+            if(DEVICEFACTORY_PIN_UNUSED == entry_p->auxPin_u8)
+            {
+                pirDevice_p = new (this->Reserve_p(sizeof(Pir))) 
+                                    Pir(trace_p, entry_p->pin_u8, false);
+            }
+            else
+            {
+                pirDevice_p = new (this->Reserve_p(sizeof(Pir))) 
+                                    Pir(trace_p, entry_p->pin_u8, false, entry_p->auxPin_u8);
+            }
             pirDevice_p->SetSelf(pirDevice_p);
             device_p = pirDevice_p;
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated pir device");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_DHT_SENSOR_BAT:
-            device_p = new DhtSensor(trace_p);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated dht device");
-            deviceList_p->add(device_p);
-            device_p = new PowerSave(trace_p, true, DHT_POWER_ON_TIME, DHT_DEEPSLEEP_TIME);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated power save device");
-            deviceList_p->add(device_p);
             break;
-        case CAPABILITY_FOUR_RELAY:
-            gpio_p   = new EspGpio(trace_p, RELAY_PIN_ONE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_ONE, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device one");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_PIN_TWO, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_TWO, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device two");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_PIN_THREE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_THREE, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device three");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_PIN_FOUR, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_FOUR, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device four");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_PIR_RELAY:
-            gpio_p   = new EspGpio(trace_p, RELAY_PIN_ONE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_ONE, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device");
-            deviceList_p->add(device_p);
-            pirDevice_p = new Pir(trace_p, PIR_INPUT_PIN, false, PIR_LED_PIN);
-            pirDevice_p->SetSelf(pirDevice_p);
-            device_p = pirDevice_p;
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated pir device");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_POWER_SAVE:
+            device_p = new (this->Reserve_p(sizeof(PowerSave))) 
+                            PowerSave(trace_p, true, entry_p->param_u16, entry_p->param2_u16);
             break;
-        case CAPABILITY_FOUR_RELAY_MCP:
-            gpio_p   = new McpGpio(trace_p, RELAY_MCP_PIN_ONE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_ONE, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device one");
-            deviceList_p->add(device_p);
-            gpio_p   = new McpGpio(trace_p, RELAY_MCP_PIN_TWO, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_TWO, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device two");
-            deviceList_p->add(device_p);
-            gpio_p   = new McpGpio(trace_p, RELAY_MCP_PIN_THREE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_THREE, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device three");
-            deviceList_p->add(device_p);
-            gpio_p   = new McpGpio(trace_p, RELAY_MCP_PIN_FOUR, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_FOUR, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device four");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_SEN0193:
+            device_p = new (this->Reserve_p(sizeof(Sen0193))) Sen0193(trace_p);
             break;
-        case CAPABILITY_DOUBLE_DHT:
-            gpio_p   = new EspGpio(trace_p, DHT_R8_OUT_PWR_PIN, OUTPUT);
-            device_p = new DhtSensor(trace_p, DHT_R8_OUT_DATA_PIN, gpio_p, DHT_R8_REPORT_CYCLE_TIME);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated outside dht device");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, DHT_R8_IN_PWR_PIN, OUTPUT);
-            device_p = new DhtSensor(trace_p, DHT_R8_IN_DATA_PIN, gpio_p, DHT_R8_REPORT_CYCLE_TIME, 1);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated inside dht device");
-            deviceList_p->add(device_p);
-            device_p = new Sen0193(trace_p);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated moisture sensor 0193 device");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_BME:
+            gpio_p   = this->GenerateGpio_p(entry_p->pin_u8, entry_p->dir_u8, false);
+            gpio2_p  = this->GenerateGpio_p(entry_p->auxPin_u8, entry_p->dir_u8, false);
+            device_p = new (this->Reserve_p(sizeof(Bme280Sensor))) 
+                            Bme280Sensor(trace_p, gpio_p, gpio2_p, entry_p->param_u16);
             break;
-        case CAPABILITY_EIGHT_RELAY_ESP:
-            gpio_p   = new EspGpio(trace_p, RELAY_ESP_PIN_ONE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_ONE, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device one");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_ESP_PIN_TWO, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_TWO, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device two");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_ESP_PIN_THREE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_THREE, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device three");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_ESP_PIN_FOUR, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_FOUR, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device four");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_ESP_PIN_FIVE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_FIVE, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device five");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_ESP_PIN_SIX, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_SIX, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device six");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_ESP_PIN_SEVEN, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_SEVEN, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device seven");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, RELAY_ESP_PIN_EIGHT, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_EIGHT, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device eight");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_GEN_SENSOR:
+            device_p = new (this->Reserve_p(sizeof(GenSensor))) 
+                            GenSensor(trace_p, (0u != entry_p->param_u16));
             break;
-        case CAPABILITY_BME_SENSOR:
-            gpio_p   = new EspGpio(trace_p, BME_PWR_PIN, OUTPUT);
-            gpio2_p   = new EspGpio(trace_p, BME_LED_PIN, OUTPUT);
-            device_p = new Bme280Sensor(trace_p, gpio_p, gpio2_p, BME_REPORT_CYCLE_TIME);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated bme device");
-            deviceList_p->add(device_p);
-            device_p = new PowerSave(trace_p, true, BME_POWER_ON_TIME, BME_DEEPSLEEP_TIME);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated power save device");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_TEMT6000:
+            gpio_p   = this->GenerateGpio_p(entry_p->auxPin_u8, entry_p->dir_u8, false);
+            device_p = new (this->Reserve_p(sizeof(Temt6000))) Temt6000(trace_p, gpio_p);
             break;
-        case CAPABILITY_SONOFF_PIR:
-            sonoffDevice_p = new SonoffBasic(trace_p);
-            sonoffDevice_p->SetSelf(sonoffDevice_p);
-            device_p = sonoffDevice_p;
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated sonoff basic device");
-            deviceList_p->add(device_p);
-            pirDevice_p = new Pir(trace_p, PIR_SONOFF_INPUT_PIN, false, PIR_SONOFF_OUTPUT_LED);
-            pirDevice_p->SetSelf(pirDevice_p);
-            device_p = pirDevice_p;
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated pir device");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_MOISTURE_ONLY:
-            device_p = new Sen0193(trace_p);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated moisture sensor 0193 device");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_MULTI_SENSE:
-            device_p = new GenSensor(trace_p);
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, MS_DHT_OUT_PWR_PIN, OUTPUT);
-            device_p = new DhtSensor(trace_p, MS_DHT_OUT_DATA_PIN, gpio_p, MS_DHT_REPORT_CYCLE_TIME);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated dht device");
-            deviceList_p->add(device_p);
-            pirDevice_p = new Pir(trace_p, MS_PIR_INPUT_PIN, false);
-            pirDevice_p->SetSelf(pirDevice_p);
-            device_p = pirDevice_p;
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated pir device");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, MS_TEMT6000_OUT_PWR_PIN, OUTPUT);
-            device_p = new Temt6000(trace_p, gpio_p);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated temt6000 device");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, NEOPIXELS_PIN, OUTPUT);
-            device_p = new NeoPix(trace_p, gpio_p, MQTT_NEOPIXELS);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated neopixels object");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_MULTI_SENSE_RELAY:
-            device_p = new GenSensor(trace_p);
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, MS_DHT_OUT_PWR_PIN, OUTPUT);
-            device_p = new DhtSensor(trace_p, MS_DHT_OUT_DATA_PIN, gpio_p, MS_DHT_REPORT_CYCLE_TIME);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated dht device");
-            deviceList_p->add(device_p);
-            pirDevice_p = new Pir(trace_p, MS_PIR_INPUT_PIN, false);
-            pirDevice_p->SetSelf(pirDevice_p);
-            device_p = pirDevice_p;
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated pir device");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, MS_TEMT6000_OUT_PWR_PIN, OUTPUT);
-            device_p = new Temt6000(trace_p, gpio_p);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated temt6000 device");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, NEOPIXELS_PIN, OUTPUT);
-            device_p = new NeoPix(trace_p, gpio_p, MQTT_NEOPIXELS);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated neopixels object");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, MS_RELAY_PIN_ONE, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_ONE, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_NEOPIX:
+            gpio_p   = this->GenerateGpio_p(entry_p->pin_u8, entry_p->dir_u8, false);
+            device_p = new (this->Reserve_p(sizeof(NeoPix))) 
+                            NeoPix(trace_p, gpio_p, entry_p->chan_ccp);
             break;
-        case CAPABILITY_DIM_LIGHT:
-            gpio_p   = new EspGpio(trace_p, DIM_LIGHT_1, OUTPUT);
-            device_p = new DimLight(trace_p, gpio_p, MQTT_DIM_LIGHT_1);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated dim light one");
-            deviceList_p->add(device_p);
+        case DEVICEFACTORY_DIM_LIGHT:
+            gpio_p   = this->GenerateGpio_p(entry_p->pin_u8, entry_p->dir_u8, false);
+            if(0u == entry_p->param_u16)
+            {
+                device_p = new (this->Reserve_p(sizeof(DimLight))) 
+                                DimLight(trace_p, gpio_p, entry_p->chan_ccp);
+            }
+            else
+            {
+                device_p = new (this->Reserve_p(sizeof(DimLight))) 
+                                DimLight(trace_p, gpio_p, entry_p->chan_ccp, 
+                                            entry_p->param_u16);
+            }
             break;
-        case CAPABILITY_H801:
-            gpio_p   = new EspGpio(trace_p, H801_PIN_RED, OUTPUT);
-            device_p = new DimLight(trace_p, gpio_p, MQTT_H801_LIGHT_RED, MAX_DIM_DIGITS);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 red chan");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, H801_PIN_GREEN, OUTPUT);
-            device_p = new DimLight(trace_p, gpio_p, MQTT_H801_LIGHT_GREEN, MAX_DIM_DIGITS);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 green chan");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, H801_PIN_BLUE, OUTPUT);
-            device_p = new DimLight(trace_p, gpio_p, MQTT_H801_LIGHT_BLUE, MAX_DIM_DIGITS);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 blue chan");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, H801_PIN_W1, OUTPUT);
-            device_p = new DimLight(trace_p, gpio_p, MQTT_H801_LIGHT_W1);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 W1 chan");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, H801_PIN_W2, OUTPUT);
-            device_p = new DimLight(trace_p, gpio_p, MQTT_H801_LIGHT_W2);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 W2 chan");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, H801_PIN_LED, OUTPUT);
-            device_p = new DimLight(trace_p, gpio_p, MQTT_H801_LIGHT_LED);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 led");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, H801_PIN_LED2, OUTPUT);
-            device_p = new DimLight(trace_p, gpio_p, MQTT_H801_LIGHT_LED2);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 led2");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_NEOPIXELS:
-            gpio_p   = new EspGpio(trace_p, NEOPIXELS_PIN, OUTPUT);
-            device_p = new NeoPix(trace_p, gpio_p, MQTT_NEOPIXELS);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated neopixels object");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_3D_PRINTER:
-            gpio_p   = new EspGpio(trace_p, PRT_3D_CTRL_DIM_1);
-            device_p = new DimLight(trace_p, gpio_p, PRT_3D_CTRL_MQTT_DIM_1);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 red chan");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, PRT_3D_CTRL_DIM_2);
-            device_p = new DimLight(trace_p, gpio_p, PRT_3D_CTRL_MQTT_DIM_2);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated h801 red chan");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, PRT_3D_CTRL_REL_1, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, PRT_3D_CTRL_MQTT_REL_1, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device one");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, PRT_3D_CTRL_REL_2, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, PRT_3D_CTRL_MQTT_REL_2, true);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay device one");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, PRT_3D_CTRL_DHT_PWR_1, OUTPUT);
-            device_p = new DhtSensor(trace_p, PRT_3D_CTRL_DHT_DATA_1, gpio_p, MS_DHT_REPORT_CYCLE_TIME);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated dht device");
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, PRT_3D_CTRL_DHT_PWR_2, OUTPUT);
-            device_p = new DhtSensor(trace_p, PRT_3D_CTRL_DHT_DATA_2, gpio_p, MS_DHT_REPORT_CYCLE_TIME, 1);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated dht device");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_SINGLE_REL_PIR:
-            gpio_p   = new EspGpio(trace_p, SINGLE_RELAY_OUTPUT_PIN, OUTPUT);
-            device_p = new SingleRelay(trace_p, gpio_p, MQTT_CHAN_ONE, false);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated single relay object");
-            deviceList_p->add(device_p);
-            pirDevice_p = new Pir(trace_p, SINGLE_RELAY_PIR_INPUT_PIN, false, SINGLE_RELAY_PIR_OUTPUT_LED);
-            pirDevice_p->SetSelf(pirDevice_p);
-            device_p = pirDevice_p;
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated pir device");
-            deviceList_p->add(device_p);
-            break;
-        case CAPABILITY_TEST_DEVICE:
+        case DEVICEFACTORY_HEAP_MONITOR:
         default:
-            device_p = new GenSensor(trace_p, true);
-            deviceList_p->add(device_p);
-            gpio_p   = new EspGpio(trace_p, NEOPIXELS_PIN, OUTPUT);
-            device_p = new NeoPix(trace_p, gpio_p, MQTT_NEOPIXELS);
-            trace_p->println(trace_INFO_MSG, "<<devMgr>> generated neopixels object");
-            deviceList_p->add(device_p);
+            device_p = new (this->Reserve_p(sizeof(HeapMonitor))) HeapMonitor(trace_p);
             break;
     }
 
-    return(deviceList_p);
-}
-
-/**---------------------------------------------------------------------------------------
- * @brief     Default destructor
- * @author    winkste
- * @date      20 Okt. 2017
- * @return    n/a
-*//*-----------------------------------------------------------------------------------*/
-DeviceFactory::~DeviceFactory()
-{
-    // TODO Auto-generated destructor stub
+    TRACE_INFO(trace_p->print(trace_INFO_MSG, "<<devMgr>> generated "));
+    TRACE_INFO(trace_p->print(trace_PURE_MSG, deviceName_stccpa[entry_p->type_u8]));
+    if(NULL != entry_p->chan_ccp)
+    {
+        TRACE_INFO(trace_p->print(trace_PURE_MSG, " "));
+        TRACE_INFO(trace_p->print(trace_PURE_MSG, entry_p->chan_ccp));
+    }
+    TRACE_INFO(trace_p->println(trace_PURE_MSG, " device"));
+    return(device_p);
 }
 
-/****************************************************************************************/
-/* Private functions: */
-
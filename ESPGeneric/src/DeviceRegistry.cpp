@@ -0,0 +1,173 @@
+/*****************************************************************************************
+* FILENAME :        DeviceRegistry.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the fixed capacity registry of the generated devices
+*
+* NOTES :
+*       The devices are only added during setup, afterwards the registry is only
+*       read. All accesses are linear scans or direct index accesses on the array.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "DeviceRegistry.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the device registry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+DeviceRegistry::DeviceRegistry()
+{
+    this->Clear();
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Removes all devices, the devices itself are not deleted
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void DeviceRegistry::Clear(void)
+{
+    uint8_t idx_u8;
+
+    for(idx_u8 = 0; idx_u8 < DEVICEREGISTRY_SIZE; idx_u8++)
+    {
+        this->devices_pa[idx_u8] = NULL;
+    }
+    this->size_u8 = 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Appends a device to the registry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     device_p        device to add
+ * @return    true, if the device was added, false if the registry is full
+*//*-----------------------------------------------------------------------------------*/
+bool DeviceRegistry::Add_bol(MqttDevice *device_p)
+{
+    if((NULL == device_p) || (DEVICEREGISTRY_SIZE <= this->size_u8))
+    {
+        return(false);
+    }
+    this->devices_pa[this->size_u8] = device_p;
+    this->size_u8++;
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for a device by its index
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     idx_u8          index of the device
+ * @return    pointer to the device or NULL, if the index is out of range
+*//*-----------------------------------------------------------------------------------*/
+MqttDevice* DeviceRegistry::Get_p(uint8_t idx_u8) const
+{
+    return((idx_u8 < this->size_u8) ? this->devices_pa[idx_u8] : NULL);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Searches the index of a device, the index identifies the device in the
+ *              loop profile
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     device_p        pointer to the device
+ * @return    index of the device or the size of the registry, if it is not found
+*//*-----------------------------------------------------------------------------------*/
+uint8_t DeviceRegistry::IndexOf_u8(const MqttDevice *device_p) const
+{
+    uint8_t idx_u8 = 0;
+
+    while((idx_u8 < this->size_u8) && (device_p != this->devices_pa[idx_u8]))
+    {
+        idx_u8++;
+    }
+    return(idx_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of registered devices
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of devices
+*//*-----------------------------------------------------------------------------------*/
+uint8_t DeviceRegistry::GetSize_u8(void) const
+{
+    return(this->size_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the maximum number of devices
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    capacity of the registry
+*//*-----------------------------------------------------------------------------------*/
+uint8_t DeviceRegistry::GetCapacity_u8(void) const
+{
+    return((uint8_t)DEVICEREGISTRY_SIZE);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Iterator to the first device
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    pointer to the first device pointer
+*//*-----------------------------------------------------------------------------------*/
+MqttDevice* const* DeviceRegistry::begin(void) const
+{
+    return(&this->devices_pa[0]);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Iterator behind the last device
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    pointer behind the last device pointer
+*//*-----------------------------------------------------------------------------------*/
+MqttDevice* const* DeviceRegistry::end(void) const
+{
+    return(&this->devices_pa[this->size_u8]);
+}
+
+/****************************************************************************************/
+/* Private functions: */
@@ -0,0 +1,309 @@
+/*****************************************************************************************
+* FILENAME :        DhtReader.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the interrupt driven DHT22 reader
+*
+* NOTES :
+*       Frame of the DHT22 after the line was released: the sensor pulls the line
+*       low for 80us and high for 80us, then every bit starts with a low phase of
+*       50us followed by a high phase of 26us for a 0 or 70us for a 1. After the
+*       last bit the sensor pulls the line low for 50us and releases it. Like the
+*       Adafruit library a bit is 1, if its high phase is longer than its low
+*       phase, so the decoding does not depend on the clock of the controller.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "DhtReader.h"
+#include <Arduino.h>
+
+/****************************************************************************************/
+/* Local constant defines */
+#define MAX_DURATION                255u
+// limits of the response phases in us
+#define RESPONSE_MIN                40u
+#define RESPONSE_MAX                120u
+// index of the first bit low phase, the first duration is the time until the response
+#define EDGE_RESPONSE_LOW           1u
+#define EDGE_RESPONSE_HIGH          2u
+#define EDGE_FIRST_BIT              3u
+#define FRAME_BITS                  (DHTREADER_FRAME_BYTES * 8u)
+#define SLOT_FREE                   0xFFu
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Static Data instantiation */
+DhtReader *DhtReader::readers_spa[DHTREADER_INSTANCES] = { NULL };
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the DHT reader
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     pin_u8      data pin of the sensor
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+DhtReader::DhtReader(uint8_t pin_u8)
+{
+    this->pin_u8 = pin_u8;
+    this->slot_u8 = SLOT_FREE;
+    this->edges_u8 = 0;
+    this->lastEdge_u32 = 0;
+    this->captureTime_u32 = 0;
+    memset(this->durations_u8a, 0, sizeof(this->durations_u8a));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the data line to the idle state, has to be called after power up
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void DhtReader::Begin(void)
+{
+    pinMode(this->pin_u8, INPUT_PULLUP);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Pulls the data line low to request a frame. The line has to stay low for
+ *              at least DHTREADER_START_TIME before StartCapture is called.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void DhtReader::StartSignal(void)
+{
+    pinMode(this->pin_u8, OUTPUT);
+    digitalWrite(this->pin_u8, LOW);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Releases the data line and records the edges of the frame. The frame is
+ *              complete DHTREADER_FRAME_TIME after this call.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    true, if an interrupt slot was free
+*//*-----------------------------------------------------------------------------------*/
+bool DhtReader::StartCapture(void)
+{
+    uint8_t idx_u8;
+
+    if(SLOT_FREE == this->slot_u8)
+    {
+        for(idx_u8 = 0; idx_u8 < DHTREADER_INSTANCES; idx_u8++)
+        {
+            if(NULL == DhtReader::readers_spa[idx_u8])
+            {
+                DhtReader::readers_spa[idx_u8] = this;
+                this->slot_u8 = idx_u8;
+                break;
+            }
+        }
+    }
+    if(SLOT_FREE == this->slot_u8)
+    {
+        this->Begin();
+        return(false);
+    }
+
+    this->edges_u8 = 0;
+    this->captureTime_u32 = millis();
+    this->lastEdge_u32 = micros();
+    pinMode(this->pin_u8, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(this->pin_u8), 
+                    (0u == this->slot_u8) ? DhtReader::EdgeIsrZero : DhtReader::EdgeIsrOne, 
+                    CHANGE);
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Ends the recording of the edges and frees the interrupt slot
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void DhtReader::StopCapture(void)
+{
+    if(SLOT_FREE != this->slot_u8)
+    {
+        detachInterrupt(digitalPinToInterrupt(this->pin_u8));
+        DhtReader::readers_spa[this->slot_u8] = NULL;
+        this->slot_u8 = SLOT_FREE;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Decodes the recorded frame
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     data_pu8    returns the DHTREADER_FRAME_BYTES bytes of the frame
+ * @return    DHTREADER_OK, if the frame is complete and the checksum matches
+*//*-----------------------------------------------------------------------------------*/
+dhtStatus_t DhtReader::Decode_en(uint8_t *data_pu8) const
+{
+    uint8_t bit_u8;
+    uint8_t low_u8;
+    uint8_t high_u8;
+
+    memset(data_pu8, 0, DHTREADER_FRAME_BYTES);
+    if((this->edges_u8 <= EDGE_RESPONSE_HIGH)
+        || (this->durations_u8a[EDGE_RESPONSE_LOW] < RESPONSE_MIN) 
+        || (this->durations_u8a[EDGE_RESPONSE_LOW] > RESPONSE_MAX)
+        || (this->durations_u8a[EDGE_RESPONSE_HIGH] < RESPONSE_MIN)
+        || (this->durations_u8a[EDGE_RESPONSE_HIGH] > RESPONSE_MAX))
+    {
+        return(DHTREADER_NO_RESPONSE);
+    }
+    if(this->edges_u8 < (EDGE_FIRST_BIT + (2u * FRAME_BITS)))
+    {
+        return(DHTREADER_INCOMPLETE);
+    }
+
+    for(bit_u8 = 0; bit_u8 < FRAME_BITS; bit_u8++)
+    {
+        low_u8 = this->durations_u8a[EDGE_FIRST_BIT + (2u * bit_u8)];
+        high_u8 = this->durations_u8a[EDGE_FIRST_BIT + (2u * bit_u8) + 1u];
+        if((MAX_DURATION == low_u8) || (MAX_DURATION == high_u8))
+        {
+            return(DHTREADER_INCOMPLETE);
+        }
+        data_pu8[bit_u8 / 8u] <<= 1;
+        if(high_u8 > low_u8)
+        {
+            data_pu8[bit_u8 / 8u] |= 1u;
+        }
+    }
+
+    if(data_pu8[4] != (uint8_t)(data_pu8[0] + data_pu8[1] + data_pu8[2] + data_pu8[3]))
+    {
+        return(DHTREADER_CHECKSUM_ERROR);
+    }
+    return(DHTREADER_OK);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Converts the recorded DHT22 frame to humidity and temperature. Both values
+ *              are taken from the same frame and are only written, if it is valid.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     sample_p    returns the sample, the status and the time of the frame
+ * @return    status of the frame
+*//*-----------------------------------------------------------------------------------*/
+dhtStatus_t DhtReader::Sample_en(dhtSample_t *sample_p) const
+{
+    uint8_t data_u8a[DHTREADER_FRAME_BYTES];
+    dhtStatus_t status_en = this->Decode_en(data_u8a);
+
+    sample_p->status_en = status_en;
+    sample_p->time_u32 = this->captureTime_u32;
+    if(DHTREADER_OK == status_en)
+    {
+        // humidity and temperature in 0.1 units, temperature sign in bit 15
+        sample_p->humidity_f32 = (float)(((uint16_t)data_u8a[0] << 8) | data_u8a[1]) * 0.1F;
+        sample_p->temperature_f32 = (float)(((uint16_t)(data_u8a[2] & 0x7Fu) << 8) 
+                                                | data_u8a[3]) * 0.1F;
+        if(0u != (data_u8a[2] & 0x80u))
+        {
+            sample_p->temperature_f32 = -sample_p->temperature_f32;
+        }
+    }
+    return(status_en);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of recorded edges
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    recorded edges
+*//*-----------------------------------------------------------------------------------*/
+uint8_t DhtReader::GetEdges_u8(void) const
+{
+    return(this->edges_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Records one edge of the data line, called from the interrupt. A rising 
+ *              edge before the response is the release of the line and is skipped.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     now_u32     time of the edge in us
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void DhtReader::Edge(uint32_t now_u32)
+{
+    uint32_t duration_u32 = now_u32 - this->lastEdge_u32;
+
+    if((0u == this->edges_u8) && (HIGH == digitalRead(this->pin_u8)))
+    {
+        return;
+    }
+    if(this->edges_u8 < DHTREADER_EDGES)
+    {
+        this->durations_u8a[this->edges_u8] = (duration_u32 > MAX_DURATION) 
+                                                ? MAX_DURATION : (uint8_t)duration_u32;
+        this->edges_u8++;
+    }
+    this->lastEdge_u32 = now_u32;
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Edge interrupt of the reader in slot 0
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void DhtReader::EdgeIsrZero(void)
+{
+    if(NULL != DhtReader::readers_spa[0])
+    {
+        DhtReader::readers_spa[0]->Edge(micros());
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Edge interrupt of the reader in slot 1
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void DhtReader::EdgeIsrOne(void)
+{
+    if(NULL != DhtReader::readers_spa[1])
+    {
+        DhtReader::readers_spa[1]->Edge(micros());
+    }
+}
@@ -35,7 +35,6 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #include "DhtSensor.h" 
 
 #include <PubSubClient.h>
-#include <DHT.h>
 #include <ESP8266WiFi.h>
 
 #include "MqttDevice.h"        
@@ -48,7 +47,6 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 
 #define TEMPERATURE_CORR_FACTOR   1.00f
 #define HUMIDITY_CORR_FACTOR      1.23f
-#define DHTTYPE                   DHT22 // DHT11 or DHT22
 
 #define MICROSEC_IN_SEC           1000000l // microseconds in seconds
 #define MILLISEC_IN_SEC           1000l // milliseconds in seconds
@@ -56,7 +54,27 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PUB_TEMPERATURE      "/s/temp_hum/temp" // temperature data
 #define MQTT_PUB_HUMIDITY         "/s/temp_hum/hum" // humidity data
 #define MQTT_PUB_BATTERY          "/s/temp_hum/bat" // battery capacity data
+#define MQTT_SUB_POLICY           "/r/temp_hum/policy" // publish policy of the values
 #define MQTT_REPORT_INTERVAL      (30l * MILLISEC_IN_SEC) // 30 seconds between reports
+
+#define TOPIC_TEMPERATURE         0u
+#define TOPIC_HUMIDITY            1u
+#define TOPIC_POLICY              2u
+
+#define HANDLER_POLICY            0u
+
+#define VALUE_TEMPERATURE         0u
+#define VALUE_HUMIDITY            1u
+
+// published on a change of 0.2 degC or 1 %RH, at least every 15 minutes
+#define POLICY_DELTA_TEMPERATURE  0.2F
+#define POLICY_DELTA_HUMIDITY     1.0F
+#define POLICY_MIN_INTERVAL       0ul
+#define POLICY_HEARTBEAT          (15ul * 60ul * MILLISEC_IN_SEC)
+
+#define TIMER_STATE_LOOP          0u
+#define TIMER_REPORT              1u
+#define TIMER_CAPTURE             2u
 /****************************************************************************************/
 /* Local function like makros */
 
@@ -73,12 +91,15 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
  * @param     p_trace     trace object for info and error messages
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-DhtSensor::DhtSensor(Trace *p_trace) : MqttDevice(p_trace)
+DhtSensor::DhtSensor(Trace *p_trace) : MqttDevice(p_trace), 
+                                        reader_st(DEFAULT_DHTPIN)
 {
     this->prevTime_u32 = 0;
+    this->dhtPin_u8 = DEFAULT_DHTPIN;
     this->pwrPin_p = NULL;
     this->dhtId_u8 = 0;
-    dht_p = new DHT(DEFAULT_DHTPIN, DHTTYPE, 11);
+    this->reportCycleMSec_u32 = MQTT_REPORT_INTERVAL;
+    this->readRetries_u8 = 0U;
 }
 
 /**---------------------------------------------------------------------------------------
@@ -91,13 +112,13 @@ DhtSensor::DhtSensor(Trace *p_trace) : MqttDevice(p_trace)
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
 DhtSensor::DhtSensor(Trace *p_trace, uint8_t dhtPin_u8, 
-                                            GpioDevice *pwrPin_p) : MqttDevice(p_trace)
+                                            GpioDevice *pwrPin_p) : MqttDevice(p_trace), 
+                                            reader_st(dhtPin_u8)
 {
     this->prevTime_u32 = 0;
     this->dhtPin_u8 = dhtPin_u8;
     this->pwrPin_p = pwrPin_p;
     this->dhtId_u8 = 0;
-    this->dht_p = new DHT(this->dhtPin_u8, DHTTYPE, 11);
     this->reportCycleMSec_u32 = MQTT_REPORT_INTERVAL;
     this->readRetries_u8 = 0U;
 }
@@ -113,13 +134,13 @@ DhtSensor::DhtSensor(Trace *p_trace, uint8_t dhtPin_u8,
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
 DhtSensor::DhtSensor(Trace *p_trace, uint8_t dhtPin_u8, GpioDevice *pwrPin_p, 
-                        uint16_t reportCycleSec_u16) : MqttDevice(p_trace)
+                        uint16_t reportCycleSec_u16) : MqttDevice(p_trace), 
+                        reader_st(dhtPin_u8)
 {
     this->prevTime_u32 = 0;
     this->dhtId_u8 = 0;
     this->dhtPin_u8 = dhtPin_u8;
     this->pwrPin_p = pwrPin_p;
-    this->dht_p = new DHT(this->dhtPin_u8, DHTTYPE, 11);
     this->reportCycleMSec_u32 = reportCycleSec_u16 * MILLISEC_IN_SEC;
     this->readRetries_u8 = 0U;
 }
@@ -136,13 +157,13 @@ DhtSensor::DhtSensor(Trace *p_trace, uint8_t dhtPin_u8, GpioDevice *pwrPin_p,
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
 DhtSensor::DhtSensor(Trace *p_trace, uint8_t dhtPin_u8, GpioDevice *pwrPin_p, 
-                        uint16_t reportCycleSec_u16, uint8_t dhtId_u8) : MqttDevice(p_trace)
+                        uint16_t reportCycleSec_u16, uint8_t dhtId_u8) : MqttDevice(p_trace), 
+                        reader_st(dhtPin_u8)
 {
     this->prevTime_u32 = 0;
     this->dhtId_u8 = dhtId_u8;
     this->dhtPin_u8 = dhtPin_u8;
     this->pwrPin_p = pwrPin_p;
-    this->dht_p = new DHT(this->dhtPin_u8, DHTTYPE, 11);
     this->reportCycleMSec_u32 = reportCycleSec_u16 * MILLISEC_IN_SEC;
     this->readRetries_u8 = 0U;
 }
@@ -166,9 +187,21 @@ DhtSensor::~DhtSensor()
 *//*-----------------------------------------------------------------------------------*/
 void DhtSensor::Initialize()
 {
+    const publishPolicy_t temperaturePolicy_st = {POLICY_DELTA_TEMPERATURE, false, 
+                                            POLICY_MIN_INTERVAL, POLICY_HEARTBEAT};
+    const publishPolicy_t humidityPolicy_st = {POLICY_DELTA_HUMIDITY, false, 
+                                            POLICY_MIN_INTERVAL, POLICY_HEARTBEAT};
+
     // ensure DHT is powered down
-    p_trace->println(trace_INFO_MSG, "<<dht>> initialize");
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<dht>> initialize"));
+    this->policies_sta[VALUE_TEMPERATURE].Configure(&temperaturePolicy_st);
+    this->policies_sta[VALUE_HUMIDITY].Configure(&humidityPolicy_st);
     this->TurnDHTOff();   
+    // the state machine steps every loop cycle, a measurement starts every report cycle
+    this->stateLoopRequest_bol = false;
+    this->measRequest_bol = false;
+    this->StartTimer(TIMER_STATE_LOOP, 0, this->STATE_LOOP_CYCLE);
+    this->StartTimer(TIMER_REPORT, 0, this->reportCycleMSec_u32);
     this->isInitialized_bol = true;
 }
 
@@ -186,31 +219,50 @@ void DhtSensor::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "DHT Sensor connected");
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_TEMPERATURE, build_topic(MQTT_PUB_TEMPERATURE));
+        this->CacheTopic(TOPIC_HUMIDITY, build_topic(MQTT_PUB_HUMIDITY));
+        this->CacheTopic(TOPIC_POLICY, build_topic(MQTT_SUB_POLICY));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "DHT Sensor connected"));
+        // ... and resubscribe the retained publish policies
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_POLICY));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_POLICY), HANDLER_POLICY);
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, 
-                                "uninizialized MQTT client in single relay detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                                "uninizialized MQTT client in single relay detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void DhtSensor::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void DhtSensor::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                             char* p_topic, const MqttPayload &payload)
 {
     if(true != this->isConnected_bol)
     {
-        p_trace->println(trace_ERROR_MSG, "<<dht>> connection failure in DHT CallbackMqtt "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<dht>> connection failure in DHT CallbackMqtt ")); 
+    }
+    else if(HANDLER_POLICY == handlerId_u8)
+    {
+        if(false == PublishPolicy::Apply_bol(this->policies_sta, DHTSENSOR_VALUES, 
+                                                payload))
+        {
+            TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "<<dht>> invalid policy: ")); 
+            TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
+        }
     }
 }
 
@@ -224,12 +276,11 @@ void DhtSensor::CallbackMqtt(PubSubClient *client, char* p_topic, String p_paylo
 bool DhtSensor::ProcessPublishRequests(PubSubClient *client)
 {
     boolean ret_bol = true;
-    uint32_t actualTime_u32 = millis();
 
-    if(    (this->prevTime_u32 + this->STATE_LOOP_CYCLE < actualTime_u32) 
-        || (0 == this->prevTime_u32))
+    if(true == this->stateLoopRequest_bol)
     {
-        this->prevTime_u32 = actualTime_u32;
+        this->stateLoopRequest_bol = false;
+        this->prevTime_u32 = millis();
         ret_bol = ret_bol && ProcessSensorStateMachine(client);
     }
 
@@ -241,6 +292,31 @@ bool DhtSensor::ProcessPublishRequests(PubSubClient *client)
 
 /****************************************************************************************/
 /* Protected functions: */
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for the expired device timers, requests the next state machine step
+ *              or the next measurement
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void DhtSensor::ProcessTimer(uint8_t timerId_u8)
+{
+    if(TIMER_STATE_LOOP == timerId_u8)
+    {
+        this->stateLoopRequest_bol = true;
+    }
+    else if(TIMER_REPORT == timerId_u8)
+    {
+        this->measRequest_bol = true;
+    }
+    else if(TIMER_CAPTURE == timerId_u8)
+    {
+        this->captureStep_bol = true;
+        this->stateLoopRequest_bol = true;
+    }
+}
+
 /**---------------------------------------------------------------------------------------
  * @brief     This function converts a float value to a string
  * @author    winkste
@@ -278,7 +354,7 @@ void DhtSensor::TurnDHTOn()
     if(NULL != pwrPin_p)
     {
         this->pwrPin_p->DigitalWrite(HIGH);
-        p_trace->println(trace_INFO_MSG, "<<dht>>dht turned on");
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<dht>>dht turned on"));
     }
 }
 
@@ -293,7 +369,7 @@ void DhtSensor::TurnDHTOff()
     if(NULL != pwrPin_p)
     {
         this->pwrPin_p->DigitalWrite(LOW);
-        p_trace->println(trace_INFO_MSG, "<<dht>>dht turned off");
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<dht>>dht turned off"));
     }
 }
 
@@ -305,12 +381,10 @@ void DhtSensor::TurnDHTOff()
 *//*-----------------------------------------------------------------------------------*/
 void DhtSensor::CheckForMeasRequest(void)
 {
-    uint32_t actualTime_u32 = millis();
-
-    if(    (this->lastReportTime_u32 + this->reportCycleMSec_u32 < actualTime_u32) 
-        || (0 == this->lastReportTime_u32))
+    if(true == this->measRequest_bol)
     {
-        this->lastReportTime_u32 = actualTime_u32;
+        this->measRequest_bol = false;
+        this->lastReportTime_u32 = millis();
         this->state_en = DHTSENSOR_MEAS_REQ;    
         this->readRetries_u8 = 0U;
     } 
@@ -324,43 +398,73 @@ void DhtSensor::CheckForMeasRequest(void)
 *//*-----------------------------------------------------------------------------------*/
 void DhtSensor::StartDhtSensorDriver(void)
 {
-    dht_p->begin();    
+    this->reader_st.Begin();
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     This function reads the data from the sensor
+ * @brief     This function sends the start signal to the sensor, the line is released
+ *              by the capture timer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void DhtSensor::StartMeasurement(void)
+{
+    this->captureStep_bol = false;
+    this->reader_st.StartSignal();
+    this->StartTimer(TIMER_CAPTURE, DHTREADER_START_TIME, 0);
+    this->state_en = DHTSENSOR_START_SIGNAL;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     This function releases the line and records the frame of the sensor until
+ *              the capture timer expires again
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void DhtSensor::StartCapture(void)
+{
+    this->captureStep_bol = false;
+    if(false == this->reader_st.StartCapture())
+    {
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, "<<dht>> no edge interrupt left"));
+    }
+    this->StartTimer(TIMER_CAPTURE, DHTREADER_FRAME_TIME, 0);
+    this->state_en = DHTSENSOR_CAPTURING;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     This function takes humidity and temperature from the captured frame in
+ *              one sample, a failed frame counts as one read retry
  * @author    winkste
  * @date      13 Jul. 2020
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
 void DhtSensor::ReadDataFromSensor(void)
 {
-    float localTem_f32 = 0.0F;
-    float localHum_f32 = 0.0F;
+    dhtSample_t sample_st;
 
-    localHum_f32 = dht_p->readHumidity();
-    localTem_f32 = dht_p->readTemperature();
+    this->captureStep_bol = false;
+    this->reader_st.StopCapture();
     this->readRetries_u8++;  
 
-    // Check if any reads failed and exit
-    if (!isnan(localHum_f32) && !isnan(localTem_f32)) 
+    if(DHTREADER_OK == this->reader_st.Sample_en(&sample_st))
     { 
-            // apply correction factor to both measurements
-        localHum_f32 = localHum_f32 * HUMIDITY_CORR_FACTOR;
-        localTem_f32 = localTem_f32 * TEMPERATURE_CORR_FACTOR;
-        
-        this->humidity_f32 = localHum_f32;
-        this->temperature_f32 = localTem_f32;
-
+        this->sample_st = sample_st;
         this->state_en = DHTSENSOR_MEAS_COMPLETED;
         TurnDHTOff();
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, "Failed to read from DHT sensor!");
+        TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "Failed to read from DHT sensor: "));
+        TRACE_ERROR(p_trace->println(trace_PURE_MSG, (uint8_t)sample_st.status_en));
+        // the sensor needs two seconds between two frames, retry with the next step
+        this->state_en = DHTSENSOR_DRIVER_STARTED;
         if(this->MAX_READ_RETRIES <= this->readRetries_u8)
         {
-            p_trace->println(trace_ERROR_MSG, "Read timeout in DHT sensor driver!");  
+            TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                            "Read timeout in DHT sensor driver!"));  
             this->readRetries_u8 = 0U;  
             this->state_en = DHTSENSOR_OFF; // reset state machine to start
         }
@@ -369,7 +473,8 @@ void DhtSensor::ReadDataFromSensor(void)
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     This function publishes the data to the broker
+ * @brief     This function publishes the values to the broker, that moved by the delta
+ *              of their publish policy or reached the heartbeat
  * @author    winkste
  * @date      13 Jul. 2020
  * @param     client     mqtt client object
@@ -379,28 +484,42 @@ boolean DhtSensor::PublishData(PubSubClient *client)
 {
     String tPayload;
     boolean ret_bol = true;
+    // apply correction factor to both measurements
+    float temperature_f32 = this->sample_st.temperature_f32 * TEMPERATURE_CORR_FACTOR;
+    float humidity_f32 = this->sample_st.humidity_f32 * HUMIDITY_CORR_FACTOR;
+    uint32_t now_u32 = millis();
 
     if(true == this->isConnected_bol)
     {
-        p_trace->print(trace_INFO_MSG, "<<mqtt>> publish temperature: ");
-        p_trace->print(trace_PURE_MSG, MQTT_PUB_TEMPERATURE);
-        p_trace->print(trace_PURE_MSG, "  :  ");
-        ret_bol = ret_bol && client->publish(build_topic(MQTT_PUB_TEMPERATURE), 
-                            f2s(this->temperature_f32, 2), true);
-        p_trace->println(trace_PURE_MSG, f2s(this->temperature_f32, 2));
-
-        p_trace->print(trace_INFO_MSG, "<<mqtt>> publish humidity: ");
-        p_trace->print(trace_PURE_MSG, MQTT_PUB_HUMIDITY);
-        p_trace->print(trace_PURE_MSG, "  :  ");
-        ret_bol = ret_bol && client->publish(build_topic(MQTT_PUB_HUMIDITY), 
-                            f2s(this->humidity_f32, 2), true);
-        p_trace->println(trace_PURE_MSG, f2s(this->humidity_f32, 2)); 
+        // every value is published on its own, when its policy requests it
+        if(true == this->policies_sta[VALUE_TEMPERATURE].IsDue_bol(temperature_f32, 
+                                                                    now_u32))
+        {
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<mqtt>> publish temperature: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, MQTT_PUB_TEMPERATURE));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+            ret_bol = ret_bol && Publish_bol(client, GetTopic_ccp(TOPIC_TEMPERATURE), 
+                                f2s(temperature_f32, 2), true);
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, f2s(temperature_f32, 2)));
+            this->policies_sta[VALUE_TEMPERATURE].SetPublished(temperature_f32, now_u32);
+        }
+
+        if(true == this->policies_sta[VALUE_HUMIDITY].IsDue_bol(humidity_f32, now_u32))
+        {
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<mqtt>> publish humidity: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, MQTT_PUB_HUMIDITY));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+            ret_bol = ret_bol && Publish_bol(client, GetTopic_ccp(TOPIC_HUMIDITY), 
+                                f2s(humidity_f32, 2), true);
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, f2s(humidity_f32, 2))); 
+            this->policies_sta[VALUE_HUMIDITY].SetPublished(humidity_f32, now_u32);
+        }
     }
     else
     {
         ret_bol = false;
-        p_trace->println(trace_ERROR_MSG, 
-                            "connection failure in dht ProcessPublishRequests "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                            "connection failure in dht ProcessPublishRequests ")); 
     }
     this->state_en = DHTSENSOR_MEAS_PUBLISHED;
 
@@ -433,7 +552,19 @@ boolean DhtSensor::ProcessSensorStateMachine(PubSubClient *client)
             this->state_en = DHTSENSOR_DRIVER_STARTED;
             break;
         case DHTSENSOR_DRIVER_STARTED:
-            ReadDataFromSensor();
+            StartMeasurement();
+            break;
+        case DHTSENSOR_START_SIGNAL:
+            if(true == this->captureStep_bol)
+            {
+                StartCapture();
+            }
+            break;
+        case DHTSENSOR_CAPTURING:
+            if(true == this->captureStep_bol)
+            {
+                ReadDataFromSensor();
+            }
             break;
         case DHTSENSOR_MEAS_COMPLETED:
             ret_bol = ret_bol && PublishData(client);
@@ -444,7 +575,7 @@ boolean DhtSensor::ProcessSensorStateMachine(PubSubClient *client)
         case DHTSENSOR_UNKNOWN_STATE:
         default:
             this->state_en = DHTSENSOR_OFF;
-            p_trace->println(trace_ERROR_MSG, "<<dht>> DHTSENSOR_UNKNOWN_STATE ");
+            TRACE_ERROR(p_trace->println(trace_ERROR_MSG, "<<dht>> DHTSENSOR_UNKNOWN_STATE "));
             break;
     }
 
@@ -457,17 +588,17 @@ boolean DhtSensor::ProcessSensorStateMachine(PubSubClient *client)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* DhtSensor::build_topic(const char *topic) 
 {
   if(0 == this->dhtId_u8)
   {
-      sprintf(buffer_ca, "std/%s%s", this->dev_p, topic);
+      sprintf(buildBuffer_ca, "std/%s%s", this->dev_p, topic);
   }
   else
   {
-      sprintf(buffer_ca, "std/%s%s%d", this->dev_p, topic, this->dhtId_u8);  
+      sprintf(buildBuffer_ca, "std/%s%s%d", this->dev_p, topic, this->dhtId_u8);  
   }
-  return buffer_ca;
+  return buildBuffer_ca;
 }
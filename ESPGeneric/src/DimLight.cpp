@@ -53,6 +53,16 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PAYLOAD_CMD_ON       "ON"
 #define MQTT_PAYLOAD_CMD_OFF      "OFF"
 
+#define HANDLER_TOGGLE            0u
+#define HANDLER_SWITCH            1u
+#define HANDLER_BRIGHTNESS        2u
+
+#define TOPIC_TOGGLE              0u
+#define TOPIC_SWITCH              1u
+#define TOPIC_BRIGHTNESS_CMD      2u
+#define TOPIC_LIGHT_STATE         3u
+#define TOPIC_BRIGHTNESS_STATE    4u
+
 /****************************************************************************************/
 /* Local function like makros */
 
@@ -121,8 +131,8 @@ DimLight::~DimLight()
 void DimLight::Initialize()
 {
     this->isInitialized_bol = true;
-    p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-    p_trace->println(trace_PURE_MSG, " initialized");
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, " initialized"));
     this->TurnLightOff();
 }
 
@@ -140,82 +150,92 @@ void DimLight::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, " reconnected");
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, " reconnected"));
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_TOGGLE, BuildReceiveTopic(MQTT_SUB_TOGGLE));
+        this->CacheTopic(TOPIC_SWITCH, BuildReceiveTopic(MQTT_SUB_SWITCH));
+        this->CacheTopic(TOPIC_BRIGHTNESS_CMD, BuildReceiveTopic(MQTT_SUB_BRIGHTNESS));
+        this->CacheTopic(TOPIC_LIGHT_STATE, Utils::BuildSendTopic(this->dev_p, 
+                            this->channel_p, MQTT_PUB_LIGHT_STATE, buildBuffer_ca));
+        this->CacheTopic(TOPIC_BRIGHTNESS_STATE, Utils::BuildSendTopic(this->dev_p, 
+                            this->channel_p, MQTT_PUB_BRIGHTNESS, buildBuffer_ca));
         // ... and resubscribe
         // toggle light 
-        this->Subscribe(client_p, MQTT_SUB_TOGGLE);
+        this->Subscribe(client_p, TOPIC_TOGGLE, HANDLER_TOGGLE);
         // change light state digital with payload
-        this->Subscribe(client_p, MQTT_SUB_SWITCH);  
+        this->Subscribe(client_p, TOPIC_SWITCH, HANDLER_SWITCH);  
         // command to set brightness of light 
-        this->Subscribe(client_p, MQTT_SUB_BRIGHTNESS); 
+        this->Subscribe(client_p, TOPIC_BRIGHTNESS_CMD, HANDLER_BRIGHTNESS); 
     }
     else
     {
         // failure, not connected
-        p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, " uninizialized MQTT client detected");
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, " uninizialized MQTT client detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void DimLight::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void DimLight::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload)
 {
     if(true == this->isConnected_bol)
     {
         // received toggle light mqtt topic
-        if (String(BuildReceiveTopic(MQTT_SUB_TOGGLE)).equals(p_topic)) 
+        if (HANDLER_TOGGLE == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->print(trace_PURE_MSG, "<<dimLight>> mqtt callback: ");
-            p_trace->println(trace_PURE_MSG, p_topic);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "<<dimLight>> mqtt callback: "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, p_topic));
             this->ToggleLight();
         }
         // execute command to switch on/off the light
-        else if (String(BuildReceiveTopic(MQTT_SUB_SWITCH)).equals(p_topic)) 
+        else if (HANDLER_SWITCH == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->println(trace_PURE_MSG, " mqtt callback: ");
-            p_trace->print(trace_PURE_MSG, p_topic);
-            p_trace->print(trace_PURE_MSG, " : ");
-            p_trace->println(trace_PURE_MSG, p_payload);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, " mqtt callback: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, p_topic));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, " : "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, payload));
             // test if the payload is equal to "ON" or "OFF"
-            if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_ON))) 
+            if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_ON)) 
             {
                 this->lightState_bol = true;
                 this->SetLight();  
             }
-            else if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_OFF)))
+            else if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_OFF))
             {
                 this->lightState_bol = false;
                 this->SetLight();
             }
             else
             {
-                p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-                p_trace->println(trace_PURE_MSG, " unexpected payload: "); 
-                p_trace->println(trace_PURE_MSG, p_payload);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, " unexpected payload: ")); 
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
             }   
         } 
                 // execute command to change brightness of light
-        else if (String(BuildReceiveTopic(MQTT_SUB_BRIGHTNESS)).equals(p_topic)) 
+        else if (HANDLER_BRIGHTNESS == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->println(trace_PURE_MSG, " mqtt callback: ");
-            p_trace->print(trace_PURE_MSG, p_topic);
-            p_trace->print(trace_PURE_MSG, " : ");
-            p_trace->println(trace_PURE_MSG, p_payload);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, " mqtt callback: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, p_topic));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, " : "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, payload));
 
-            uint32_t payLoad_u32 = p_payload.toInt(); 
+            uint32_t payLoad_u32 = payload.ToInt_s32(); 
             // test if the payload is integer and in range
             if(payLoad_u32 < 100 && payLoad_u32 >= 0)
             {
@@ -224,16 +244,16 @@ void DimLight::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payloa
             }
             else
             {
-                p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-                p_trace->println(trace_PURE_MSG, " unexpected payload: "); 
-                p_trace->println(trace_PURE_MSG, p_payload);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, " unexpected payload: ")); 
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
             }   
         } 
     }
     else
     {
-        p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, "connection failure in CallbackMqtt "); 
+        TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+        TRACE_ERROR(p_trace->println(trace_PURE_MSG, "connection failure in CallbackMqtt ")); 
     }
 }
 
@@ -256,14 +276,14 @@ bool DimLight::ProcessPublishRequests(PubSubClient *client)
         {
             if(true == this->lightState_bol)
             {
-              ret = PublishMessage(client, MQTT_PUB_LIGHT_STATE, MQTT_PAYLOAD_CMD_ON);
+              ret = PublishMessage(client, TOPIC_LIGHT_STATE, MQTT_PAYLOAD_CMD_ON);
             }
             else
             {
-              ret = PublishMessage(client, MQTT_PUB_LIGHT_STATE, MQTT_PAYLOAD_CMD_OFF); 
+              ret = PublishMessage(client, TOPIC_LIGHT_STATE, MQTT_PAYLOAD_CMD_OFF); 
             } 
 
-            ret = PublishMessage(client, MQTT_PUB_BRIGHTNESS, 
+            ret = PublishMessage(client, TOPIC_BRIGHTNESS_STATE, 
                                     Utils::IntegerToDecString(this->brightness_u8, 
                                                                 &this->mqttPayload[0]));
             if(ret)
@@ -274,8 +294,9 @@ bool DimLight::ProcessPublishRequests(PubSubClient *client)
     }
     else
     {
-        p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, " connection failure in ProcessPublishRequests "); 
+        TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+        TRACE_ERROR(p_trace->println(trace_PURE_MSG, 
+                        " connection failure in ProcessPublishRequests ")); 
     }
     return ret; 
 };
@@ -312,8 +333,8 @@ void DimLight::TurnLightOff(void)
     {
         this->lightState_bol = false;
         this->gpio_p->AnalogWrite(0);    
-        p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, "light turned off");
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, "light turned off"));
         this->publishState_bol = true;
     }
 }
@@ -333,8 +354,8 @@ void DimLight::TurnLightOn(void)
             (uint16_t)(((float)this->brightness_u8 * (1023.0F/100.0F)) + 0.5F));*/
         this->gpio_p->AnalogWrite(Utils::CalcLogDigitsFromPercent(this->brightness_u8, 
                                                                     this->maxDigit_u16));
-        p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, "light turned on");
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, "light turned on"));
         this->publishState_bol = true;
     }
 }
@@ -363,12 +384,12 @@ void DimLight::ToggleLight(void)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* DimLight::BuildReceiveTopic(const char *topic) 
 {
     return (Utils::BuildReceiveTopic(this->dev_p, this->channel_p, 
-                                      topic, this->topicBuff_ca));
+                                      topic, buildBuffer_ca));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -376,45 +397,43 @@ char* DimLight::BuildReceiveTopic(const char *topic)
  * @author    winkste
  * @date      24 Sep. 2018
  * @param     client_p       pointer to pub sub client
- * @param     message_cp       pointer to topic string
+ * @param     topicId_u8       cached send topic id
  * @param     payload_ccp       pointer to topic payload string
  * @return    true, if message was successful send
 *//*-----------------------------------------------------------------------------------*/
-boolean DimLight::PublishMessage(PubSubClient *client_p, const char *message_cp, 
+boolean DimLight::PublishMessage(PubSubClient *client_p, uint8_t topicId_u8, 
                                   const char * payload_ccp)
 {
     boolean ret_bol = false;
 
-    p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-    p_trace->print(trace_PURE_MSG, "publish message: ");
-    p_trace->print(trace_PURE_MSG, 
-                    Utils::BuildSendTopic(this->dev_p, this->channel_p, 
-                                          message_cp, this->topicBuff_ca));
-    p_trace->print(trace_PURE_MSG, "  :  ");
-    ret_bol = client_p->publish(Utils::BuildSendTopic(this->dev_p, this->channel_p, 
-                                          message_cp, this->topicBuff_ca), 
-                                  payload_ccp, true);
-    p_trace->println(trace_PURE_MSG, payload_ccp);
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "publish message: "));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, GetTopic_ccp(topicId_u8)));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+    ret_bol = Publish_bol(client_p, GetTopic_ccp(topicId_u8), payload_ccp, true);
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, payload_ccp));
     
     return(ret_bol);
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     This function publishes a message
+ * @brief     This function subscribes a message and registers its route
  * @author    winkste
  * @date      24 Sep. 2018
  * @param     client_p       pointer to pub sub client
- * @param     topic_ccp      topic fragment
+ * @param     topicId_u8     cached receive topic id
+ * @param     handlerId_u8   handler id passed to DispatchMqtt
  * @return    N/A
 *//*-----------------------------------------------------------------------------------*/
-void DimLight::Subscribe(PubSubClient *client_p, const char *topic_ccp)
+void DimLight::Subscribe(PubSubClient *client_p, uint8_t topicId_u8, 
+                          uint8_t handlerId_u8)
 {
-    const char *localTopic_ccp = BuildReceiveTopic(topic_ccp);
+    const char *localTopic_ccp = GetTopic_ccp(topicId_u8);
 
-    client_p->subscribe(localTopic_ccp);  
-    client_p->loop();
-    p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-    p_trace->print(trace_PURE_MSG, "subscribe message: ");
-    p_trace->println(trace_PURE_MSG, localTopic_ccp);
+    this->Subscribe_bol(client_p, localTopic_ccp);
+    this->RegisterTopic(localTopic_ccp, handlerId_u8);
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "subscribe message: "));
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, localTopic_ccp));
 }
 
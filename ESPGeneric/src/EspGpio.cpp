@@ -57,7 +57,8 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 *//*-----------------------------------------------------------------------------------*/
 EspGpio::EspGpio(Trace *p_trace) : GpioDevice(p_trace)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<espGpio>> Constructor of ESPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<espGpio>> Constructor of ESPDevice called"));
     this->stat_u8 = 0;
     this->value_u16 = 0;
     this->Initialize();
@@ -74,7 +75,8 @@ EspGpio::EspGpio(Trace *p_trace) : GpioDevice(p_trace)
 *//*-----------------------------------------------------------------------------------*/
 EspGpio::EspGpio(Trace *p_trace, uint8_t pin_u8) : GpioDevice(p_trace, pin_u8)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<espGpio>> Constructor of ESPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<espGpio>> Constructor of ESPDevice called"));
     this->stat_u8 = 0;
     this->value_u16 = 0;
     this->Initialize();
@@ -93,7 +95,8 @@ EspGpio::EspGpio(Trace *p_trace, uint8_t pin_u8) : GpioDevice(p_trace, pin_u8)
 *//*-----------------------------------------------------------------------------------*/
 EspGpio::EspGpio(Trace *p_trace, uint8_t pin_u8, uint8_t dir_u8) : GpioDevice(p_trace, pin_u8, dir_u8)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<espGpio>> Constructor of ESPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<espGpio>> Constructor of ESPDevice called"));
     this->stat_u8 = 0;
     this->value_u16 = 0;
     this->Initialize();
@@ -197,14 +200,9 @@ uint16_t EspGpio::AnalogRead()
 *//*-----------------------------------------------------------------------------------*/
 void EspGpio::PrintPinStat()
 {
-    /*this->p_trace->print(trace_INFO_MSG, "<<espgpio>> Pin Status: ");
-    this->p_trace->print(trace_PURE_MSG, this->pin_u8);
-    this->p_trace->print(trace_PURE_MSG, " / ");
-    this->p_trace->print(trace_PURE_MSG, this->dir_u8);
-    this->p_trace->print(trace_PURE_MSG, " / ");
-    this->p_trace->print(trace_PURE_MSG, this->stat_u8);
-    this->p_trace->print(trace_PURE_MSG, " / ");
-    this->p_trace->println(trace_PURE_MSG, this->value_u16);*/
+    // binary record, the text is only built when the trace channel consumes it
+    TRACE_INFO(this->p_trace->Log(trace_INFO_MSG, TRACEFMT_GPIO_STATE, this->pin_u8, 
+                                    this->dir_u8, this->stat_u8, this->value_u16));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -215,7 +213,7 @@ void EspGpio::PrintPinStat()
 *//*-----------------------------------------------------------------------------------*/
 void EspGpio::Initialize()
 {
-    this->p_trace->println(trace_INFO_MSG, "<<espgpio>> initialized");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, "<<espgpio>> initialized"));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -227,6 +225,6 @@ void EspGpio::Initialize()
 void EspGpio::PinMode()
 {
     pinMode(this->pin_u8, this->dir_u8);
-    this->p_trace->println(trace_INFO_MSG, "<<espgpio>> pin mode changed");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, "<<espgpio>> pin mode changed"));
 }
 
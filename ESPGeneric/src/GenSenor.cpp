@@ -46,7 +46,11 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 
 #define MQTT_PUB_HEALTH_TIC         "/s/health/tic"   // health counter
 #define MQTT_SUB_HEALTH_TIC         MQTT_PUB_HEALTH_TIC
+#define HANDLER_HEALTH_TIC          0u
+
+#define TOPIC_HEALTH_TIC          0u
 #define MQTT_REPORT_INTERVAL        (30l * MILLISEC_IN_SEC) // 30 seconds between reports
+#define TIMER_REPORT                0u
 
 #define SOFTWARE_WDOG_TIMEOUT       (5l * MILLISEC_IN_SEC) // 5 seconds before reset  
 #define MAX_MQTT_ERRORS             3
@@ -133,7 +137,7 @@ GenSensor::~GenSensor()
 void GenSensor::Initialize()
 {
     // ensure DHT is powered down
-    p_trace->println(trace_INFO_MSG, "<<genSensor>> initialize");
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<genSensor>> initialize"));
     this->healthTic_u16 = 0;  
     this->isInitialized_bol = true;
 
@@ -142,6 +146,10 @@ void GenSensor::Initialize()
     this->mqttGoodCommsCounter_u16 = 0U;
     this->waitForFeedback_bol = false;
 
+    // first health tic right after the connection, then every report cycle
+    this->reportRequest_bol = false;
+    this->StartTimer(TIMER_REPORT, 0, this->reportCycleMSec_u32);
+
     ESP.wdtEnable(SOFTWARE_WDOG_TIMEOUT);
     
 }
@@ -160,63 +168,67 @@ void GenSensor::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "<<genSensor>> connected");
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_HEALTH_TIC, build_topic(MQTT_SUB_HEALTH_TIC));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<genSensor>> connected"));
 
         // ... and resubscribe
         // same helth message to see that we have a loop connection to the broker
-        client_p->subscribe(build_topic(MQTT_SUB_HEALTH_TIC));  
-        client_p->loop();
-        p_trace->print(trace_INFO_MSG, "<<genSensor>> subscribed 1: ");
-        p_trace->println(trace_PURE_MSG, build_topic(MQTT_SUB_HEALTH_TIC));
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_HEALTH_TIC));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_HEALTH_TIC), HANDLER_HEALTH_TIC);
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<genSensor>> subscribed 1: "));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, GetTopic_ccp(TOPIC_HEALTH_TIC)));
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, 
-                                "<<genSensor>> uninizialized MQTT client detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                                "<<genSensor>> uninizialized MQTT client detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      02 Jan. 2020
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void GenSensor::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void GenSensor::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                             char* p_topic, const MqttPayload &payload)
 {
     if(true == this->isConnected_bol)
     {
         // received own published health indicator
-        if (String(build_topic(MQTT_SUB_HEALTH_TIC)).equals(p_topic)) 
+        if (HANDLER_HEALTH_TIC == handlerId_u8) 
         {
             this->waitForFeedback_bol = false;
-            p_trace->print(trace_INFO_MSG, "<<genSensor>>mqtt callback: ");
-            p_trace->print(trace_PURE_MSG, p_topic);
-            p_trace->print(trace_PURE_MSG, " : ");
-            p_trace->println(trace_PURE_MSG, p_payload);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<genSensor>>mqtt callback: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, p_topic));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, " : "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, payload));
 
-            feedbackHealthTic_u16 = (uint16_t)p_payload.toInt();
+            feedbackHealthTic_u16 = (uint16_t)payload.ToInt_s32();
             if((this->healthTic_u16 - 1U) == this->feedbackHealthTic_u16)
             {
-                p_trace->println(trace_INFO_MSG, "<<genSensor>>heatbeat match");
+                TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<genSensor>>heatbeat match"));
                 ObserveCommunication(GOOD_COMM);
             }
             else
             {
-                p_trace->println(trace_WARN_MSG, "<<genSensor>>heatbeat missmatch");
+                TRACE_WARN(p_trace->println(trace_WARN_MSG, "<<genSensor>>heatbeat missmatch"));
                 ObserveCommunication(FEEDBACK_ERROR);
             }
         }
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, 
-                            "<<genSensor>> connection failure in CallbackMqtt "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                            "<<genSensor>> connection failure in CallbackMqtt ")); 
     }
 }
 
@@ -237,39 +249,56 @@ bool GenSensor::ProcessPublishRequests(PubSubClient *client)
 
     ESP.wdtFeed();
 
-    if(this->prevTime_u32 + this->reportCycleMSec_u32 < millis() || this->prevTime_u32 == 0)
+    if(true == this->reportRequest_bol)
     {     
         // the health tic publication is time interval based
         if(true == this->isConnected_bol)
         {
+            this->reportRequest_bol = false;
             if(true == this->waitForFeedback_bol)
             {
                 // no feedback from last sent received, no communication?
                 ObserveCommunication(NO_COMMUNICATION);
             }
-            p_trace->println(trace_INFO_MSG, "<<genSensor>> processes publish request");
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, 
+                            "<<genSensor>> processes publish request"));
             this->prevTime_u32 = millis();
 
-            p_trace->print(trace_INFO_MSG, "<<genSensor>> publish health tic: ");
-            p_trace->print(trace_PURE_MSG, MQTT_PUB_HEALTH_TIC);
-            p_trace->print(trace_PURE_MSG, "  :  ");
-            ret = client->publish(build_topic(MQTT_PUB_HEALTH_TIC), 
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<genSensor>> publish health tic: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, MQTT_PUB_HEALTH_TIC));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+            ret = Publish_bol(client, GetTopic_ccp(TOPIC_HEALTH_TIC), 
                                     Utils::IntegerToDecString(this->healthTic_u16, 
                                                     &this->mqttPayload[0]), false);
-            p_trace->println(trace_PURE_MSG, &this->mqttPayload[0]);
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, &this->mqttPayload[0]));
             this->healthTic_u16++;
             this->waitForFeedback_bol = true;
         } 
         else
         {
-            p_trace->println(trace_ERROR_MSG, 
-                "<<genSensor>> connection failure in ProcessPublishRequests "); 
+            TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                "<<genSensor>> connection failure in ProcessPublishRequests ")); 
         }
     }
 
     return ret;  
 }
 
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for the expired report timer, requests the next health tic
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void GenSensor::ProcessTimer(uint8_t timerId_u8)
+{
+    if(TIMER_REPORT == timerId_u8)
+    {
+        this->reportRequest_bol = true;
+    }
+}
+
 /****************************************************************************************/
 /* Private functions: */
 
@@ -292,15 +321,15 @@ void GenSensor::ObserveCommunication(comEvent_t comEvent_en)
                     this->mqttComErrorCounter_u16 = 0U;
                     this->mqttGoodCommsCounter_u16 = 0U;
 
-                    p_trace->println(trace_INFO_MSG, 
-                    "<<genSensor>> communication counter resetted"); 
+                    TRACE_INFO(p_trace->println(trace_INFO_MSG, 
+                    "<<genSensor>> communication counter resetted")); 
                 }
             break;
             case FEEDBACK_ERROR:
             case NO_COMMUNICATION:
-                p_trace->print(trace_ERROR_MSG, 
-                    "<<genSensor>> mqtt observer detects error: ");
-                p_trace->println(trace_PURE_MSG, (uint16_t)comEvent_en);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, 
+                    "<<genSensor>> mqtt observer detects error: "));
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, (uint16_t)comEvent_en));
 
                 this->mqttComErrorCounter_u16++;
                 this->mqttGoodCommsCounter_u16 = 0U;
@@ -322,8 +351,8 @@ void GenSensor::ObserveCommunication(comEvent_t comEvent_en)
 *//*-----------------------------------------------------------------------------------*/
 void GenSensor::ForceWatchDogReset(void)
 {
-    p_trace->println(trace_ERROR_MSG, 
-    "<<genSensor>> jump to endless loop to force a watchdog reset");
+    TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+    "<<genSensor>> jump to endless loop to force a watchdog reset"));
     // maximum error counter reached, time for a reset
     for(;;);    
 }
@@ -338,11 +367,11 @@ void GenSensor::ForceWatchDogReset(void)
  * @author    winkste
  * @date      02 Jan. 2020
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* GenSensor::build_topic(const char *topic) 
 {
-  sprintf(buffer_ca, "std/%s%s", this->dev_p, topic);
+  sprintf(buildBuffer_ca, "std/%s%s", this->dev_p, topic);
 
-  return buffer_ca;
+  return buildBuffer_ca;
 }
@@ -0,0 +1,408 @@
+/*****************************************************************************************
+* FILENAME :        HeapMonitor.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the heap and fragmentation telemetry device
+*
+* NOTES :
+*       The watermarks are published as "min,max" on s/heap/free, s/heap/block and
+*       s/heap/frag. A tripped fragmentation threshold is published with the 
+*       current fragmentation on s/heap/alarm. The restart action is executed in
+*       the loop after the alarm was published, so the alarm leaves the queue.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <Arduino.h>
+#include "MqttDevice.h"
+#include "Trace.h"
+#include "Utils.h"
+
+#include "HeapMonitor.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define MQTT_PUB_HEAP_FREE          "s/heap/free"   // free heap watermarks in bytes
+#define MQTT_PUB_HEAP_BLOCK         "s/heap/block"  // largest free block watermarks
+#define MQTT_PUB_HEAP_FRAG          "s/heap/frag"   // fragmentation watermarks in percent
+#define MQTT_PUB_HEAP_ALARM         "s/heap/alarm"  // fragmentation threshold exceeded
+
+#define TOPIC_HEAP_FREE             0u
+#define TOPIC_HEAP_BLOCK            1u
+#define TOPIC_HEAP_FRAG             2u
+#define TOPIC_HEAP_ALARM            3u
+
+#define TIMER_SAMPLE                0u
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the heap monitor with the default threshold, which only
+ *              reports the alarm
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     p_trace     trace object for info and error messages
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+HeapMonitor::HeapMonitor(Trace *p_trace) 
+                : HeapMonitor(p_trace, HEAPMON_FRAG_THRESHOLD, HEAPMON_ACTION_REPORT)
+{
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the heap monitor
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     p_trace           trace object for info and error messages
+ * @param     fragThreshold_u8  fragmentation threshold in percent
+ * @param     action_en         action executed when the threshold trips
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+HeapMonitor::HeapMonitor(Trace *p_trace, uint8_t fragThreshold_u8, heapAction_t action_en)
+                : MqttDevice(p_trace)
+{
+    this->deviceName_ccp = "<<heapMon>>";
+    this->sampler_p = HeapMonitor::sampleEsp;
+    this->fragThreshold_u8 = fragThreshold_u8;
+    this->action_en = action_en;
+    this->next_u8 = 0;
+    this->count_u8 = 0;
+    this->aboveThreshold_u8 = 0;
+    this->tripped_bol = false;
+    this->trips_u16 = 0;
+    this->reportRequest_bol = false;
+    this->alarmRequest_bol = false;
+    this->alarmFrag_u8 = 0;
+    this->restartRequest_bol = false;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Replaces the source of the heap samples, used by the host build to
+ *              sample a simulated allocator
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     sampler_p   sample function, NULL selects the ESP heap again
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void HeapMonitor::SetSampler(heapSampler_t sampler_p)
+{
+    this->sampler_p = (NULL == sampler_p) ? HeapMonitor::sampleEsp : sampler_p;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Calculates the watermarks of all samples in the ring
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     min_p     returns the minimum of every value
+ * @param     max_p     returns the maximum of every value
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void HeapMonitor::GetWatermarks(heapSample_t *min_p, heapSample_t *max_p) const
+{
+    uint8_t idx_u8;
+
+    min_p->free_u32 = 0xFFFFFFFFu;
+    min_p->maxBlock_u16 = 0xFFFFu;
+    min_p->frag_u8 = 0xFFu;
+    max_p->free_u32 = 0;
+    max_p->maxBlock_u16 = 0;
+    max_p->frag_u8 = 0;
+    for(idx_u8 = 0; idx_u8 < this->count_u8; idx_u8++)
+    {
+        const heapSample_t *sample_p = &this->samples_sta[idx_u8];
+
+        min_p->free_u32 = min(min_p->free_u32, sample_p->free_u32);
+        max_p->free_u32 = max(max_p->free_u32, sample_p->free_u32);
+        min_p->maxBlock_u16 = min(min_p->maxBlock_u16, sample_p->maxBlock_u16);
+        max_p->maxBlock_u16 = max(max_p->maxBlock_u16, sample_p->maxBlock_u16);
+        min_p->frag_u8 = min(min_p->frag_u8, sample_p->frag_u8);
+        max_p->frag_u8 = max(max_p->frag_u8, sample_p->frag_u8);
+    }
+    if(0 == this->count_u8)
+    {
+        *min_p = *max_p;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of tripped fragmentation alarms since boot
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of alarms
+*//*-----------------------------------------------------------------------------------*/
+uint16_t HeapMonitor::GetTrips_u16(void) const
+{
+    return(this->trips_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Default destructor
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+HeapMonitor::~HeapMonitor()
+{
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Initialization of the heap monitor, the first sample is taken at once
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void HeapMonitor::Initialize()
+{
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<heapMon>> initialize"));
+    this->next_u8 = 0;
+    this->count_u8 = 0;
+    this->aboveThreshold_u8 = 0;
+    this->reportRequest_bol = false;
+    this->StartTimer(TIMER_SAMPLE, 0, HEAPMON_SAMPLE_CYCLE);
+    this->isInitialized_bol = true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Function call to initialize the MQTT interface for this device
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p  MQTT object for message transfer
+ * @param     dev_p     string identifier of the MQTT device id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void HeapMonitor::Reconnect(PubSubClient *client_p, const char *dev_p)
+{
+    if(NULL != client_p)
+    {
+        this->dev_p = dev_p;
+        this->isConnected_bol = true;
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_HEAP_FREE, Utils::BuildSendTopic(this->dev_p, 
+                                            MQTT_PUB_HEAP_FREE, buildBuffer_ca));
+        this->CacheTopic(TOPIC_HEAP_BLOCK, Utils::BuildSendTopic(this->dev_p, 
+                                            MQTT_PUB_HEAP_BLOCK, buildBuffer_ca));
+        this->CacheTopic(TOPIC_HEAP_FRAG, Utils::BuildSendTopic(this->dev_p, 
+                                            MQTT_PUB_HEAP_FRAG, buildBuffer_ca));
+        this->CacheTopic(TOPIC_HEAP_ALARM, Utils::BuildSendTopic(this->dev_p, 
+                                            MQTT_PUB_HEAP_ALARM, buildBuffer_ca));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<heapMon>> connected"));
+    }
+    else
+    {
+        // failure, not connected
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                    "<<heapMon>> uninizialized MQTT client detected"));
+        this->isConnected_bol = false;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sending generated publications and executing the tripped action
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client     mqtt client object
+ * @return    true, if a message was published
+*//*-----------------------------------------------------------------------------------*/
+bool HeapMonitor::ProcessPublishRequests(PubSubClient *client)
+{
+    bool ret_bol = false;
+
+    if(true == this->restartRequest_bol)
+    {
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<heapMon>> restart because of heap fragmentation"));
+        this->restartRequest_bol = false;
+        ESP.restart();
+    }
+
+    if(true == this->alarmRequest_bol)
+    {
+        if(true == this->isConnected_bol)
+        {
+            ret_bol = this->Publish_bol(client, GetTopic_ccp(TOPIC_HEAP_ALARM), 
+                                Utils::IntegerToDecString(this->alarmFrag_u8, 
+                                                            &this->payload_ca[0]), false);
+            this->alarmRequest_bol = !ret_bol;
+        }
+        else
+        {
+            // without broker the alarm is only traced
+            this->alarmRequest_bol = false;
+        }
+        if((false == this->alarmRequest_bol) && (HEAPMON_ACTION_RESTART == this->action_en))
+        {
+            // executed in the next loop, after the publish queue was flushed
+            this->restartRequest_bol = true;
+        }
+    }
+    else if((true == this->reportRequest_bol) && (true == this->isConnected_bol))
+    {
+        ret_bol = this->publishWatermarks(client);
+        this->reportRequest_bol = !ret_bol;
+    }
+    return(ret_bol);
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Takes a sample and stores it in the ring, the report is requested after
+ *              every full ring
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void HeapMonitor::sample(void)
+{
+    heapSample_t *sample_p = &this->samples_sta[this->next_u8];
+
+    this->sampler_p(sample_p);
+    this->next_u8++;
+    if(HEAPMON_SAMPLES <= this->next_u8)
+    {
+        this->next_u8 = 0;
+        this->reportRequest_bol = true;
+    }
+    if(HEAPMON_SAMPLES > this->count_u8)
+    {
+        this->count_u8++;
+    }
+    this->checkThreshold(sample_p->frag_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Trips the alarm, if the fragmentation exceeded the threshold for 
+ *              HEAPMON_TRIP_SAMPLES samples in a row. The alarm is armed again after
+ *              the fragmentation fell below the threshold minus the hysteresis.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     frag_u8     sampled fragmentation in percent
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void HeapMonitor::checkThreshold(uint8_t frag_u8)
+{
+    if(frag_u8 >= this->fragThreshold_u8)
+    {
+        if(HEAPMON_TRIP_SAMPLES > this->aboveThreshold_u8)
+        {
+            this->aboveThreshold_u8++;
+        }
+        if((HEAPMON_TRIP_SAMPLES <= this->aboveThreshold_u8) && (false == this->tripped_bol))
+        {
+            this->tripped_bol = true;
+            this->trips_u16++;
+            this->alarmRequest_bol = true;
+            this->alarmFrag_u8 = frag_u8;
+            TRACE_ERROR(p_trace->print(trace_ERROR_MSG, 
+                            "<<heapMon>> fragmentation threshold exceeded: "));
+            TRACE_ERROR(p_trace->println(trace_PURE_MSG, frag_u8));
+        }
+    }
+    else
+    {
+        this->aboveThreshold_u8 = 0;
+        if((uint16_t)frag_u8 + HEAPMON_FRAG_HYSTERESIS <= this->fragThreshold_u8)
+        {
+            this->tripped_bol = false;
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Publishes the watermarks of the ring
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p      mqtt client object
+ * @return    true, if all messages were published
+*//*-----------------------------------------------------------------------------------*/
+bool HeapMonitor::publishWatermarks(PubSubClient *client_p)
+{
+    heapSample_t min_st;
+    heapSample_t max_st;
+    bool ret_bol;
+
+    this->GetWatermarks(&min_st, &max_st);
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<heapMon>> free heap min: "));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, String(min_st.free_u32)));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, " max block min: "));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, min_st.maxBlock_u16));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, " frag max: "));
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, max_st.frag_u8));
+
+    snprintf(this->payload_ca, sizeof(this->payload_ca), "%lu,%lu", 
+                (unsigned long)min_st.free_u32, (unsigned long)max_st.free_u32);
+    ret_bol = this->Publish_bol(client_p, GetTopic_ccp(TOPIC_HEAP_FREE), 
+                                this->payload_ca, false);
+    snprintf(this->payload_ca, sizeof(this->payload_ca), "%u,%u", 
+                min_st.maxBlock_u16, max_st.maxBlock_u16);
+    ret_bol &= this->Publish_bol(client_p, GetTopic_ccp(TOPIC_HEAP_BLOCK), 
+                                this->payload_ca, false);
+    snprintf(this->payload_ca, sizeof(this->payload_ca), "%u,%u", 
+                min_st.frag_u8, max_st.frag_u8);
+    ret_bol &= this->Publish_bol(client_p, GetTopic_ccp(TOPIC_HEAP_FRAG), 
+                                this->payload_ca, false);
+    return(ret_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Default sampler, reads the heap state of the ESP
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     sample_p      returns the sample
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void HeapMonitor::sampleEsp(heapSample_t *sample_p)
+{
+    sample_p->free_u32 = ESP.getFreeHeap();
+    sample_p->maxBlock_u16 = (uint16_t)ESP.getMaxFreeBlockSize();
+    sample_p->frag_u8 = ESP.getHeapFragmentation();
+}
+
+/****************************************************************************************/
+/* Protected functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for the expired sample timer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void HeapMonitor::ProcessTimer(uint8_t timerId_u8)
+{
+    if(TIMER_SAMPLE == timerId_u8)
+    {
+        this->sample();
+    }
+}
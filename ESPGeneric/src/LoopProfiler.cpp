@@ -0,0 +1,321 @@
+/*****************************************************************************************
+* FILENAME :        LoopProfiler.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the per device loop time profiler
+*
+* NOTES :
+*       The statistic is published as one text line per recorded device operation,
+*       "<name> <op> n=<calls> min=<us> avg=<us> max=<us> h=<histogram>". It is
+*       streamed with beginPublish(), so the payload is not limited by the
+*       MQTT_MAX_PACKET_SIZE and no publish buffer is needed.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "LoopProfiler.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define LINE_LENGTH                 96u
+#define NAME_LENGTH                 12u
+#define HIST_SATURATED              0xFFFFu
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Local data definitions */
+// upper bounds of the histogram buckets in us, the last bucket is open
+static const uint32_t bucketLimits_stau32[LOOPPROFILER_BUCKETS - 1u] = 
+                                                {100u, 1000u, 10000u, 100000u, 1000000u};
+static const char * const opNames_stccpa[LOOPPROFILER_OPS] = {"pub", "cb", "rec"};
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the loop profiler
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+LoopProfiler::LoopProfiler()
+{
+    this->Clear();
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Resets all statistics, a new measurement interval starts
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void LoopProfiler::Clear(void)
+{
+    uint8_t device_u8;
+    uint8_t op_u8;
+
+    for(device_u8 = 0; device_u8 < LOOPPROFILER_DEVICES; device_u8++)
+    {
+        for(op_u8 = 0; op_u8 < LOOPPROFILER_OPS; op_u8++)
+        {
+            clearStat(&this->stats_sta[device_u8][op_u8]);
+        }
+    }
+    clearStat(&this->loop_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Records the duration of a device operation
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     device_u8     index of the device in the device list
+ * @param     op_u8         profiled operation, LOOPPROFILER_OP_*
+ * @param     start_u32     micros() taken before the operation was called
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void LoopProfiler::Record(uint8_t device_u8, uint8_t op_u8, uint32_t start_u32)
+{
+    uint32_t duration_u32 = micros() - start_u32;
+
+    if((device_u8 < LOOPPROFILER_DEVICES) && (op_u8 < LOOPPROFILER_OPS))
+    {
+        update(&this->stats_sta[device_u8][op_u8], duration_u32);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Records the busy time of one main loop cycle, without the idle time
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     start_u32     micros() taken at the start of the loop cycle
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void LoopProfiler::RecordLoop(uint32_t start_u32)
+{
+    update(&this->loop_st, micros() - start_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the statistic of a device operation
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     device_u8     index of the device in the device list
+ * @param     op_u8         profiled operation, LOOPPROFILER_OP_*
+ * @return    pointer to the statistic or NULL, if it is not profiled
+*//*-----------------------------------------------------------------------------------*/
+const profStat_t* LoopProfiler::GetStat_pst(uint8_t device_u8, uint8_t op_u8) const
+{
+    if((device_u8 < LOOPPROFILER_DEVICES) && (op_u8 < LOOPPROFILER_OPS))
+    {
+        return(&this->stats_sta[device_u8][op_u8]);
+    }
+    return(NULL);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the statistic of the main loop busy time
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    pointer to the statistic
+*//*-----------------------------------------------------------------------------------*/
+const profStat_t* LoopProfiler::GetLoopStat_pst(void) const
+{
+    return(&this->loop_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Publishes all recorded statistics in one message and starts a new 
+ *              measurement interval
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p      connected MQTT client
+ * @param     topic_ccp     complete publish topic
+ * @return    true, if the message was sent
+*//*-----------------------------------------------------------------------------------*/
+bool LoopProfiler::Publish_bol(PubSubClient *client_p, const char *topic_ccp)
+{
+    uint16_t length_u16;
+
+    if((NULL == client_p) || (NULL == topic_ccp))
+    {
+        return(false);
+    }
+
+    // the first pass only counts the payload length
+    length_u16 = this->writeStats_u16(NULL);
+    if(false == client_p->beginPublish(topic_ccp, length_u16, false))
+    {
+        return(false);
+    }
+    (void)this->writeStats_u16(client_p);
+    if(0 == client_p->endPublish())
+    {
+        return(false);
+    }
+    this->Clear();
+    return(true);
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Resets a single statistic
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     stat_p        statistic to reset
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void LoopProfiler::clearStat(profStat_t *stat_p)
+{
+    uint8_t idx_u8;
+
+    stat_p->sum_u64 = 0;
+    stat_p->count_u32 = 0;
+    stat_p->min_u32 = 0xFFFFFFFFu;
+    stat_p->max_u32 = 0;
+    for(idx_u8 = 0; idx_u8 < LOOPPROFILER_BUCKETS; idx_u8++)
+    {
+        stat_p->hist_au16[idx_u8] = 0;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Adds a duration to a statistic
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     stat_p        statistic to update
+ * @param     duration_u32  measured duration in us
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void LoopProfiler::update(profStat_t *stat_p, uint32_t duration_u32)
+{
+    uint8_t bucket_u8 = 0;
+
+    stat_p->sum_u64 += duration_u32;
+    stat_p->count_u32++;
+    if(duration_u32 < stat_p->min_u32)
+    {
+        stat_p->min_u32 = duration_u32;
+    }
+    if(duration_u32 > stat_p->max_u32)
+    {
+        stat_p->max_u32 = duration_u32;
+    }
+    while((bucket_u8 < (LOOPPROFILER_BUCKETS - 1u)) 
+            && (duration_u32 >= bucketLimits_stau32[bucket_u8]))
+    {
+        bucket_u8++;
+    }
+    if(HIST_SATURATED != stat_p->hist_au16[bucket_u8])
+    {
+        stat_p->hist_au16[bucket_u8]++;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Formats a statistic as one text line including the line feed
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     line_pch      destination buffer
+ * @param     size_u8       size of the destination buffer
+ * @param     name_ccp      name of the statistic, device and operation
+ * @param     stat_p        statistic to format
+ * @return    length of the line without termination
+*//*-----------------------------------------------------------------------------------*/
+uint8_t LoopProfiler::formatStat_u8(char *line_pch, uint8_t size_u8, const char *name_ccp,
+                                        const profStat_t *stat_p)
+{
+    int length_s32;
+
+    length_s32 = snprintf(line_pch, size_u8, 
+                            "%s n=%lu min=%lu avg=%lu max=%lu h=%u,%u,%u,%u,%u,%u\n",
+                            name_ccp, (unsigned long)stat_p->count_u32,
+                            (unsigned long)stat_p->min_u32,
+                            (unsigned long)(stat_p->sum_u64 / stat_p->count_u32),
+                            (unsigned long)stat_p->max_u32,
+                            stat_p->hist_au16[0], stat_p->hist_au16[1],
+                            stat_p->hist_au16[2], stat_p->hist_au16[3],
+                            stat_p->hist_au16[4], stat_p->hist_au16[5]);
+    if(length_s32 < 0)
+    {
+        return(0);
+    }
+    return((length_s32 >= size_u8) ? (uint8_t)(size_u8 - 1u) : (uint8_t)length_s32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Formats all recorded statistics line by line, operations without 
+ *              calls are skipped
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p      client to write the lines to, NULL to count only
+ * @return    number of formatted bytes
+*//*-----------------------------------------------------------------------------------*/
+uint16_t LoopProfiler::writeStats_u16(PubSubClient *client_p)
+{
+    char line_ca[LINE_LENGTH];
+    char name_ca[NAME_LENGTH];
+    uint16_t total_u16 = 0;
+    uint8_t length_u8;
+    uint8_t device_u8;
+    uint8_t op_u8;
+
+    if(0 != this->loop_st.count_u32)
+    {
+        length_u8 = formatStat_u8(line_ca, sizeof(line_ca), "loop", &this->loop_st);
+        if(NULL != client_p)
+        {
+            (void)client_p->write((const uint8_t*)line_ca, length_u8);
+        }
+        total_u16 += length_u8;
+    }
+    for(device_u8 = 0; device_u8 < LOOPPROFILER_DEVICES; device_u8++)
+    {
+        for(op_u8 = 0; op_u8 < LOOPPROFILER_OPS; op_u8++)
+        {
+            if(0 == this->stats_sta[device_u8][op_u8].count_u32)
+            {
+                continue;
+            }
+            (void)snprintf(name_ca, sizeof(name_ca), "d%u %s", device_u8, 
+                            opNames_stccpa[op_u8]);
+            length_u8 = formatStat_u8(line_ca, sizeof(line_ca), name_ca, 
+                                        &this->stats_sta[device_u8][op_u8]);
+            if(NULL != client_p)
+            {
+                (void)client_p->write((const uint8_t*)line_ca, length_u8);
+            }
+            total_u16 += length_u8;
+        }
+    }
+    return(total_u16);
+}
@@ -63,7 +63,9 @@ Adafruit_MCP23017 McpGpio::mcp;
 *//*-----------------------------------------------------------------------------------*/
 McpGpio::McpGpio(Trace *p_trace) : GpioDevice(p_trace)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpGpio>> Constructor of MCPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<mcpGpio>> Constructor of MCPDevice called"));
+    this->nReset_p = NULL;
     this->stat_u8 = 0;
     this->value_u16 = 0;
     this->Initialize();
@@ -80,7 +82,9 @@ McpGpio::McpGpio(Trace *p_trace) : GpioDevice(p_trace)
 *//*-----------------------------------------------------------------------------------*/
 McpGpio::McpGpio(Trace *p_trace, uint8_t pin_u8) : GpioDevice(p_trace, pin_u8)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpGpio>> Constructor of MCPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<mcpGpio>> Constructor of MCPDevice called"));
+    this->nReset_p = NULL;
     this->stat_u8 = 0;
     this->value_u16 = 0;
     this->Initialize();
@@ -98,7 +102,9 @@ McpGpio::McpGpio(Trace *p_trace, uint8_t pin_u8) : GpioDevice(p_trace, pin_u8)
 *//*-----------------------------------------------------------------------------------*/
 McpGpio::McpGpio(Trace *p_trace, uint8_t pin_u8, uint8_t dir_u8) : GpioDevice(p_trace, pin_u8, dir_u8)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpGpio>> Constructor of MCPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<mcpGpio>> Constructor of MCPDevice called"));
+    this->nReset_p = NULL;
     this->stat_u8 = 0;
     this->value_u16 = 0;
     this->Initialize();
@@ -116,7 +122,8 @@ McpGpio::McpGpio(Trace *p_trace, uint8_t pin_u8, uint8_t dir_u8) : GpioDevice(p_
 *//*-----------------------------------------------------------------------------------*/
 McpGpio::McpGpio(Trace *p_trace, uint8_t pin_u8, uint8_t dir_u8, GpioDevice *nReset_p) : GpioDevice(p_trace, pin_u8, dir_u8)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpGpio>> Constructor of MCPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<mcpGpio>> Constructor of MCPDevice called"));
     this->nReset_p = nReset_p;
     this->stat_u8 = 0;
     this->value_u16 = 0;
@@ -144,7 +151,7 @@ McpGpio::~McpGpio()
 *//*-----------------------------------------------------------------------------------*/
 void McpGpio::PinMode(uint8_t dir_u8)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> pinMode called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> pinMode called"));
     this->PrintPinStat();
     this->dir_u8 = dir_u8;
     this->PinMode();
@@ -159,7 +166,8 @@ void McpGpio::PinMode(uint8_t dir_u8)
 *//*-----------------------------------------------------------------------------------*/
 void McpGpio::DigitalWrite(uint8_t state_u8)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> digitalWrite of MCPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<mcpgpio>> digitalWrite of MCPDevice called"));
     this->stat_u8 = state_u8;
     this->mcp.digitalWrite(this->pin_u8, this->stat_u8);
     this->value_u16 = 1023 * this->stat_u8;
@@ -175,7 +183,8 @@ void McpGpio::DigitalWrite(uint8_t state_u8)
 *//*-----------------------------------------------------------------------------------*/
 uint8_t McpGpio::DigitalRead()
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> digitalRead of MCPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<mcpgpio>> digitalRead of MCPDevice called"));
     this->stat_u8 = this->mcp.digitalRead(this->pin_u8);
     this->value_u16 = 1023 * this->stat_u8;
     this->PrintPinStat();
@@ -191,7 +200,8 @@ uint8_t McpGpio::DigitalRead()
 *//*-----------------------------------------------------------------------------------*/
 void McpGpio::AnalogWrite(uint16_t value_u16)
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> analogWrite of MCPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<mcpgpio>> analogWrite of MCPDevice called"));
     // convert analog value to digital expression
     if(value_u16 > 512)
     {
@@ -216,7 +226,8 @@ void McpGpio::AnalogWrite(uint16_t value_u16)
 *//*-----------------------------------------------------------------------------------*/
 uint16_t McpGpio::AnalogRead()
 {
-    this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> analogRead of ESPDevice called");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                    "<<mcpgpio>> analogRead of ESPDevice called"));
     this->stat_u8 = this->mcp.digitalRead(this->pin_u8);
     this->value_u16 = 1023 * this->stat_u8;
     this->PrintPinStat();
@@ -233,14 +244,14 @@ uint16_t McpGpio::AnalogRead()
 *//*-----------------------------------------------------------------------------------*/
 void McpGpio::PrintPinStat()
 {
-    this->p_trace->print(trace_INFO_MSG, "<<mcpgpio>> Pin Status: ");
-    this->p_trace->print(trace_PURE_MSG, this->pin_u8);
-    this->p_trace->print(trace_PURE_MSG, " / ");
-    this->p_trace->print(trace_PURE_MSG, this->dir_u8);
-    this->p_trace->print(trace_PURE_MSG, " / ");
-    this->p_trace->println(trace_PURE_MSG, this->stat_u8);
-    this->p_trace->print(trace_PURE_MSG, " / ");
-    this->p_trace->print(trace_PURE_MSG, this->value_u16);
+    TRACE_INFO(this->p_trace->print(trace_INFO_MSG, "<<mcpgpio>> Pin Status: "));
+    TRACE_INFO(this->p_trace->print(trace_PURE_MSG, this->pin_u8));
+    TRACE_INFO(this->p_trace->print(trace_PURE_MSG, " / "));
+    TRACE_INFO(this->p_trace->print(trace_PURE_MSG, this->dir_u8));
+    TRACE_INFO(this->p_trace->print(trace_PURE_MSG, " / "));
+    TRACE_INFO(this->p_trace->println(trace_PURE_MSG, this->stat_u8));
+    TRACE_INFO(this->p_trace->print(trace_PURE_MSG, " / "));
+    TRACE_INFO(this->p_trace->print(trace_PURE_MSG, this->value_u16));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -260,7 +271,7 @@ void McpGpio::Initialize()
         }
         this->mcp.begin();      // use default address 0
         this->mcpInitialized_bol = true;
-        this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> MCP initialized");
+        TRACE_INFO(this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> MCP initialized"));
     }
     else
     {
@@ -277,6 +288,6 @@ void McpGpio::Initialize()
 void McpGpio::PinMode()
 {
     this->mcp.pinMode(this->pin_u8, this->dir_u8);
-    this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> pin mode changed");
+    TRACE_INFO(this->p_trace->println(trace_INFO_MSG, "<<mcpgpio>> pin mode changed"));
 }
 
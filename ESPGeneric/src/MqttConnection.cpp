@@ -0,0 +1,351 @@
+/*****************************************************************************************
+* FILENAME :        MqttConnection.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the non blocking MQTT connection state machine
+*
+* NOTES :
+*       The connect call of the PubSubClient itself is still synchronous, it blocks
+*       until the TCP connect fails or the CONNACK arrives. The firmware limits this
+*       with the TCP timeout of the WiFi client and the MQTT_SOCKET_TIMEOUT build
+*       flag to about 2 s each. The duration of the last attempt is measured, so
+*       this remaining blocking time is visible.
+*       The reconnect latency is the time from the detection of the lost connection
+*       (or the first call after boot) to the end of the successful attempt.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <Arduino.h>
+#include "MqttConnection.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define RANDOM_DEFAULT_SEED         0x2545F491u
+
+/****************************************************************************************/
+/* Local function like makros */
+// wraparound safe check if timestamp a is before timestamp b
+#define TIME_BEFORE(a, b)           ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the connection state machine
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p          mqtt client object
+ * @param     portalRetries_u8  failed attempts without any connection since boot,
+ *                                until the configuration portal is requested, 
+ *                                0 disables the request
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+MqttConnection::MqttConnection(PubSubClient *client_p, uint8_t portalRetries_u8)
+{
+    this->client_p = client_p;
+    this->id_ccp = NULL;
+    this->user_ccp = NULL;
+    this->pw_ccp = NULL;
+    this->state_u8 = MQTTCONN_STATE_INIT;
+    this->portalRetries_u8 = portalRetries_u8;
+    this->everConnected_bol = false;
+    this->failures_u16 = 0;
+    this->reconnects_u16 = 0;
+    this->backoff_u32 = 0;
+    this->nextAttempt_u32 = 0;
+    this->lostTime_u32 = 0;
+    this->latency_u32 = 0;
+    this->maxLatency_u32 = 0;
+    this->attemptTime_u32 = 0;
+    this->random_u32 = RANDOM_DEFAULT_SEED;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the login data, the strings have to stay valid
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     id_ccp        client id
+ * @param     user_ccp      user name or NULL
+ * @param     pw_ccp        password or NULL
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttConnection::Configure(const char *id_ccp, const char *user_ccp, const char *pw_ccp)
+{
+    this->id_ccp = id_ccp;
+    this->user_ccp = user_ccp;
+    this->pw_ccp = pw_ccp;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Seeds the jitter generator, devices with a different seed spread their
+ *              connect attempts
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     seed_u32      seed value, e.g. the chip id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttConnection::SetSeed(uint32_t seed_u32)
+{
+    this->random_u32 = (0 == seed_u32) ? RANDOM_DEFAULT_SEED : seed_u32;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Runs the state machine, has to be called every main loop cycle. At most
+ *              one connect attempt is made per call.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     now_u32       actual time in milliseconds
+ * @return    MQTTCONN_EVENT_CONNECTED, if the connection was just established and
+ *              the subscriptions have to be done, else one of the other events
+*//*-----------------------------------------------------------------------------------*/
+uint8_t MqttConnection::Process_u8(uint32_t now_u32)
+{
+    if(MQTTCONN_STATE_INIT == this->state_u8)
+    {
+        // the first attempt after boot is done right away
+        this->state_u8 = MQTTCONN_STATE_BACKOFF;
+        this->lostTime_u32 = now_u32;
+        this->nextAttempt_u32 = now_u32;
+    }
+
+    if(MQTTCONN_STATE_CONNECTED == this->state_u8)
+    {
+        if(true == this->client_p->connected())
+        {
+            return(MQTTCONN_EVENT_NONE);
+        }
+        // the first attempt after a lost connection is done with the next call
+        this->state_u8 = MQTTCONN_STATE_BACKOFF;
+        this->lostTime_u32 = now_u32;
+        this->nextAttempt_u32 = now_u32;
+        this->failures_u16 = 0;
+        this->backoff_u32 = 0;
+        return(MQTTCONN_EVENT_LOST);
+    }
+
+    if(TIME_BEFORE(now_u32, this->nextAttempt_u32))
+    {
+        return(MQTTCONN_EVENT_NONE);
+    }
+    return(this->Attempt_u8(now_u32));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Calculates the time the main loop can sleep until the next connect 
+ *              attempt is due
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     now_u32       actual time in milliseconds
+ * @param     maxIdle_u32   upper limit of the returned time
+ * @return    time in milliseconds until the next attempt
+*//*-----------------------------------------------------------------------------------*/
+uint32_t MqttConnection::GetIdleTime_u32(uint32_t now_u32, uint32_t maxIdle_u32) const
+{
+    uint32_t idle_u32;
+
+    if(MQTTCONN_STATE_CONNECTED == this->state_u8)
+    {
+        return(maxIdle_u32);
+    }
+    if((MQTTCONN_STATE_INIT == this->state_u8)
+        || (false == TIME_BEFORE(now_u32, this->nextAttempt_u32)))
+    {
+        return(0);
+    }
+    idle_u32 = this->nextAttempt_u32 - now_u32;
+    return((idle_u32 < maxIdle_u32) ? idle_u32 : maxIdle_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the connection state
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    MQTTCONN_STATE_x
+*//*-----------------------------------------------------------------------------------*/
+uint8_t MqttConnection::GetState_u8(void) const
+{
+    return(this->state_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the failed attempts of the actual or last outage
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of failed attempts
+*//*-----------------------------------------------------------------------------------*/
+uint16_t MqttConnection::GetFailures_u16(void) const
+{
+    return(this->failures_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the actual backoff time without jitter
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    backoff time in milliseconds
+*//*-----------------------------------------------------------------------------------*/
+uint32_t MqttConnection::GetBackoff_u32(void) const
+{
+    return(this->backoff_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the latency of the last successful connect
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    latency in milliseconds
+*//*-----------------------------------------------------------------------------------*/
+uint32_t MqttConnection::GetLatency_u32(void) const
+{
+    return(this->latency_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the maximum reconnect latency since boot
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    latency in milliseconds
+*//*-----------------------------------------------------------------------------------*/
+uint32_t MqttConnection::GetMaxLatency_u32(void) const
+{
+    return(this->maxLatency_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the duration of the last connect attempt, this is the time
+ *              the main loop was blocked by the client
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    duration in milliseconds
+*//*-----------------------------------------------------------------------------------*/
+uint32_t MqttConnection::GetAttemptTime_u32(void) const
+{
+    return(this->attemptTime_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of reconnects after a lost connection
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of reconnects since boot
+*//*-----------------------------------------------------------------------------------*/
+uint16_t MqttConnection::GetReconnects_u16(void) const
+{
+    return(this->reconnects_u16);
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Executes one connect attempt
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     now_u32       actual time in milliseconds
+ * @return    resulting event
+*//*-----------------------------------------------------------------------------------*/
+uint8_t MqttConnection::Attempt_u8(uint32_t now_u32)
+{
+    uint32_t start_u32 = millis();
+    bool connected_bol;
+
+    connected_bol = this->client_p->connect(this->id_ccp, this->user_ccp, this->pw_ccp);
+    this->attemptTime_u32 = millis() - start_u32;
+
+    if(true == connected_bol)
+    {
+        this->state_u8 = MQTTCONN_STATE_CONNECTED;
+        this->latency_u32 = (now_u32 - this->lostTime_u32) + this->attemptTime_u32;
+        if(this->latency_u32 > this->maxLatency_u32)
+        {
+            this->maxLatency_u32 = this->latency_u32;
+        }
+        if(true == this->everConnected_bol)
+        {
+            this->reconnects_u16++;
+        }
+        this->everConnected_bol = true;
+        this->backoff_u32 = 0;
+        return(MQTTCONN_EVENT_CONNECTED);
+    }
+
+    this->failures_u16++;
+    this->ScheduleRetry(now_u32 + this->attemptTime_u32);
+    if((false == this->everConnected_bol) && (0 != this->portalRetries_u8)
+        && (0 == (this->failures_u16 % this->portalRetries_u8)))
+    {
+        // broker was never reached, the configuration is probably wrong
+        return(MQTTCONN_EVENT_PORTAL);
+    }
+    return(MQTTCONN_EVENT_FAILED);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Doubles the backoff and sets the time of the next attempt. The delay is 
+ *              randomly chosen between half and the full backoff.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     now_u32       time of the failed attempt in milliseconds
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttConnection::ScheduleRetry(uint32_t now_u32)
+{
+    uint32_t half_u32;
+
+    if(0 == this->backoff_u32)
+    {
+        this->backoff_u32 = MQTTCONN_BACKOFF_MIN;
+    }
+    else if(this->backoff_u32 < (MQTTCONN_BACKOFF_MAX / 2u))
+    {
+        this->backoff_u32 *= 2u;
+    }
+    else
+    {
+        this->backoff_u32 = MQTTCONN_BACKOFF_MAX;
+    }
+
+    half_u32 = this->backoff_u32 / 2u;
+    this->nextAttempt_u32 = now_u32 + half_u32 + (this->Random_u32() % (half_u32 + 1u));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     32 bit xorshift generator used for the jitter
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    next random value
+*//*-----------------------------------------------------------------------------------*/
+uint32_t MqttConnection::Random_u32(void)
+{
+    this->random_u32 ^= this->random_u32 << 13;
+    this->random_u32 ^= this->random_u32 >> 17;
+    this->random_u32 ^= this->random_u32 << 5;
+    return(this->random_u32);
+}
@@ -37,6 +37,7 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 
 /****************************************************************************************/
 /* Local constant defines */
+#define EMPTY_TOPIC                 ""
 
 /****************************************************************************************/
 /* Local function like makros */
@@ -47,6 +48,15 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 /****************************************************************************************/
 /* Static Data instantiation */
 bool MqttDevice::startWifiConfig_bol = false;
+TopicRouter *MqttDevice::router_p = NULL;
+TopicPool *MqttDevice::pool_p = NULL;
+Scheduler *MqttDevice::scheduler_p = NULL;
+AdcSampler *MqttDevice::adc_p = NULL;
+PubSubQueue *MqttDevice::queue_p = NULL;
+PubSubSubscriber *MqttDevice::subscriber_p = NULL;
+const char *MqttDevice::wildcard_ccp = NULL;
+uint8_t MqttDevice::wildcardLength_u8 = 0;
+char MqttDevice::buildBuffer_ca[MQTTDEVICE_TOPIC_LENGTH];
 
 /****************************************************************************************/
 /* Public functions (unlimited visibility) */
@@ -60,11 +70,21 @@ bool MqttDevice::startWifiConfig_bol = false;
 *//*-----------------------------------------------------------------------------------*/
 MqttDevice::MqttDevice(Trace *p_trace)
 {
+    uint8_t idx_u8;
+
     this->prevTime_u32 = 0;
     this->publications_u16 = 0;
     this->p_trace = p_trace;
     this->isInitialized_bol = false;
     this->isConnected_bol = false;
+    for(idx_u8 = 0; idx_u8 < MQTTDEVICE_TOPICS; idx_u8++)
+    {
+        this->topics_ccpa[idx_u8] = EMPTY_TOPIC;
+    }
+    for(idx_u8 = 0; idx_u8 < MQTTDEVICE_TIMERS; idx_u8++)
+    {
+        this->timers_u8a[idx_u8] = SCHEDULER_INVALID;
+    }
 }
 
 /**---------------------------------------------------------------------------------------
@@ -114,5 +134,400 @@ bool MqttDevice::GetReconfigRequest()
     return(ret_bol);
 }
 
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the router used by all devices to register their receive topics
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     router_p    topic router object
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::SetTopicRouter(TopicRouter *router_p)
+{
+    MqttDevice::router_p = router_p;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the pool used by all devices to store their cached topics
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     pool_p      topic pool object
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::SetTopicPool(TopicPool *pool_p)
+{
+    MqttDevice::pool_p = pool_p;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the scheduler used by all devices for their cyclic and delayed work,
+ *              has to be called before the devices are initialized
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     scheduler_p     scheduler object
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::SetScheduler(Scheduler *scheduler_p)
+{
+    MqttDevice::scheduler_p = scheduler_p;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the sampler shared by all devices reading the analog input, has to 
+ *              be called before the devices are initialized
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     adc_p       ADC sampler object
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::SetAdcSampler(AdcSampler *adc_p)
+{
+    MqttDevice::adc_p = adc_p;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the outbound queue used by all devices for their publications, 
+ *              without queue the devices publish directly
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     queue_p     publish queue object
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::SetPublishQueue(PubSubQueue *queue_p)
+{
+    MqttDevice::queue_p = queue_p;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the collector for the subscriptions done during Reconnect(), the
+ *              main loop flushes it with as few SUBSCRIBE packets as possible. 
+ *              Without collector the devices subscribe directly.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     subscriber_p  subscription collector object
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::SetSubscriber(PubSubSubscriber *subscriber_p)
+{
+    MqttDevice::subscriber_p = subscriber_p;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets the wildcard filter subscribed by the main module, e.g. 
+ *              std/<dev>/r/#. Device topics below this filter are not subscribed
+ *              again, they are only registered at the topic router.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     filter_ccp    cached filter ending with '#', NULL disables the mode
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::SetWildcard(const char *filter_ccp)
+{
+    size_t length_u32 = (NULL == filter_ccp) ? 0 : strlen(filter_ccp);
+
+    if((0 == length_u32) || ('#' != filter_ccp[length_u32 - 1]))
+    {
+        MqttDevice::wildcard_ccp = NULL;
+        MqttDevice::wildcardLength_u8 = 0;
+        return;
+    }
+    MqttDevice::wildcard_ccp = filter_ccp;
+    // the prefix without the '#'
+    MqttDevice::wildcardLength_u8 = (uint8_t)(length_u32 - 1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Callback for received topics which are not registered at the topic
+ *              router. The default implementation is the compatibility shim for 
+ *              devices implementing the String based callback only, it copies the
+ *              payload to the heap.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p   mqtt client object
+ * @param     p_topic    received topic
+ * @param     payload    view on the received payload, valid during the call only
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::CallbackMqtt(PubSubClient *client_p, char* p_topic, 
+                                const MqttPayload &payload)
+{
+    String payload_str;
+    uint16_t idx_u16;
+
+    payload_str.reserve(payload.GetLength_u16());
+    for(idx_u16 = 0; idx_u16 < payload.GetLength_u16(); idx_u16++)
+    {
+        payload_str.concat((char)payload.GetData_pu8()[idx_u16]);
+    }
+    this->CallbackMqtt(client_p, p_topic, payload_str);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for a received topic routed to this device. The default
+ *              implementation falls back to the topic based CallbackMqtt.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id given at RegisterTopic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload, valid during the call only
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                                char* p_topic, const MqttPayload &payload)
+{
+    this->CallbackMqtt(client_p, p_topic, payload);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Deprecated String based callback, kept for devices not migrated to the
+ *              payload view.
+ * @author    winkste
+ * @date      20 Okt. 2017
+ * @param     client     mqtt client object
+ * @param     p_topic    received topic
+ * @param     p_payload  attached payload message
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+{
+}
+
+/****************************************************************************************/
+/* Protected functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Registers a complete receive topic of this device at the topic router,
+ *              shall be called for every subscription during Reconnect. The topic 
+ *              is interned in the topic pool, the router only stores the pointer.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp     complete receive topic
+ * @param     handlerId_u8  device local id passed back to DispatchMqtt
+ * @return    true, if the topic was registered
+*//*-----------------------------------------------------------------------------------*/
+bool MqttDevice::RegisterTopic(const char *topic_ccp, uint8_t handlerId_u8)
+{
+    bool ret_bol = false;
+    const char *route_ccp = topic_ccp;
+
+    // the router keeps the pointer, the topic may be built in a temporary buffer
+    if(NULL != MqttDevice::pool_p)
+    {
+        route_ccp = MqttDevice::pool_p->Intern(topic_ccp);
+    }
+    if(NULL != MqttDevice::router_p)
+    {
+        ret_bol = MqttDevice::router_p->Register(route_ccp, this, handlerId_u8);
+    }
+    if(false == ret_bol)
+    {
+        TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "<<mqttDevice>> topic not routed: "));
+        TRACE_ERROR(p_trace->println(trace_PURE_MSG, topic_ccp));
+    }
+    return(ret_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Stores a complete topic of this device in the topic pool, shall be 
+ *              called for every used topic during Reconnect. The topic may be built 
+ *              in buildBuffer_ca.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topicId_u8    device local topic id, smaller than MQTTDEVICE_TOPICS
+ * @param     topic_ccp     complete topic
+ * @return    true, if the topic was cached
+*//*-----------------------------------------------------------------------------------*/
+bool MqttDevice::CacheTopic(uint8_t topicId_u8, const char *topic_ccp)
+{
+    const char *pooled_ccp = NULL;
+
+    if(topicId_u8 >= MQTTDEVICE_TOPICS)
+    {
+        return(false);
+    }
+    if(NULL != MqttDevice::pool_p)
+    {
+        pooled_ccp = MqttDevice::pool_p->Intern(topic_ccp);
+    }
+    if(NULL == pooled_ccp)
+    {
+        this->topics_ccpa[topicId_u8] = EMPTY_TOPIC;
+        TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "<<mqttDevice>> topic not cached: "));
+        TRACE_ERROR(p_trace->println(trace_PURE_MSG, topic_ccp));
+        return(false);
+    }
+    this->topics_ccpa[topicId_u8] = pooled_ccp;
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for a cached topic, used on the publish and subscribe path
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topicId_u8    device local topic id
+ * @return    cached topic, empty string if the topic is not cached
+*//*-----------------------------------------------------------------------------------*/
+const char* MqttDevice::GetTopic_ccp(uint8_t topicId_u8) const
+{
+    if(topicId_u8 >= MQTTDEVICE_TOPICS)
+    {
+        return(EMPTY_TOPIC);
+    }
+    return(this->topics_ccpa[topicId_u8]);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Publishes a message of this device. The message is added to the publish
+ *              queue, which is drained by the main loop.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p      mqtt client object, used if no queue is set
+ * @param     topic_ccp     complete topic
+ * @param     payload_ccp   zero terminated payload
+ * @param     retained_bol  true, if the broker shall retain the message
+ * @return    true, if the message was queued or sent
+*//*-----------------------------------------------------------------------------------*/
+bool MqttDevice::Publish_bol(PubSubClient *client_p, const char *topic_ccp, 
+                                const char *payload_ccp, bool retained_bol)
+{
+    return(this->Publish_bol(client_p, topic_ccp, payload_ccp, MQTTDEVICE_QOS_0, 
+                                retained_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Publishes a message of this device with the given quality of service. A
+ *              QoS 1 message is repeated by the client until the broker acknowledged
+ *              it, also across a reconnect.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p      mqtt client object, used if no queue is set
+ * @param     topic_ccp     complete topic
+ * @param     payload_ccp   zero terminated payload
+ * @param     qos_u8        MQTTDEVICE_QOS_0 or MQTTDEVICE_QOS_1
+ * @param     retained_bol  true, if the broker shall retain the message
+ * @return    true, if the message was queued or sent
+*//*-----------------------------------------------------------------------------------*/
+bool MqttDevice::Publish_bol(PubSubClient *client_p, const char *topic_ccp, 
+                                const char *payload_ccp, uint8_t qos_u8, bool retained_bol)
+{
+    if(NULL != MqttDevice::queue_p)
+    {
+        return(MqttDevice::queue_p->publish(topic_ccp, payload_ccp, qos_u8, retained_bol));
+    }
+    return(client_p->publish(topic_ccp, payload_ccp, qos_u8, retained_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Subscribes a topic of this device. The topic is added to the 
+ *              subscription collector, it has to stay valid until the collector is
+ *              flushed, which is given for cached topics. Topics covered by the
+ *              wildcard filter are skipped.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client_p      mqtt client object, used if no collector is set
+ * @param     topic_ccp     complete topic
+ * @return    true, if the subscription was collected or sent
+*//*-----------------------------------------------------------------------------------*/
+bool MqttDevice::Subscribe_bol(PubSubClient *client_p, const char *topic_ccp)
+{
+    if((NULL != MqttDevice::wildcard_ccp) 
+        && (0 == strncmp(topic_ccp, MqttDevice::wildcard_ccp, MqttDevice::wildcardLength_u8)))
+    {
+        // already covered by the wildcard subscription
+        return(true);
+    }
+    if(NULL != MqttDevice::subscriber_p)
+    {
+        return(MqttDevice::subscriber_p->subscribe(topic_ccp));
+    }
+    return(client_p->subscribe(topic_ccp));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Starts or restarts a device timer, the scheduler timer is created with the
+ *              first start. ProcessTimer is called when the timer expires.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id, smaller than MQTTDEVICE_TIMERS
+ * @param     delay_u32     time until the first expiry in milliseconds
+ * @param     period_u32    period in milliseconds, 0 for a one shot timer
+ * @return    true, if the timer was started
+*//*-----------------------------------------------------------------------------------*/
+bool MqttDevice::StartTimer(uint8_t timerId_u8, uint32_t delay_u32, uint32_t period_u32)
+{
+    if((timerId_u8 >= MQTTDEVICE_TIMERS) || (NULL == MqttDevice::scheduler_p))
+    {
+        return(false);
+    }
+    if(SCHEDULER_INVALID == this->timers_u8a[timerId_u8])
+    {
+        this->timers_u8a[timerId_u8] = MqttDevice::scheduler_p->Create_u8(
+                                            MqttDevice::TimerCallback, this, timerId_u8);
+        if(SCHEDULER_INVALID == this->timers_u8a[timerId_u8])
+        {
+            TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                            "<<mqttDevice>> no scheduler timer left"));
+            return(false);
+        }
+    }
+    return(MqttDevice::scheduler_p->Start(this->timers_u8a[timerId_u8], millis(), 
+                                            delay_u32, period_u32));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Stops a device timer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::StopTimer(uint8_t timerId_u8)
+{
+    if((timerId_u8 < MQTTDEVICE_TIMERS) && (NULL != MqttDevice::scheduler_p))
+    {
+        MqttDevice::scheduler_p->Stop(this->timers_u8a[timerId_u8]);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for an expired device timer, called from the main loop. The
+ *              default implementation does nothing.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id given at StartTimer
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::ProcessTimer(uint8_t timerId_u8)
+{
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Ends the idle time of the main loop, shall be called by device interrupt
+ *              routines which need a fast publication
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void MqttDevice::RequestWakeup(void)
+{
+    if(NULL != MqttDevice::scheduler_p)
+    {
+        MqttDevice::scheduler_p->Wakeup();
+    }
+}
+
 /****************************************************************************************/
 /* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Scheduler callback, forwards the timer expiry to the device
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     context_p     device object
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void MqttDevice::TimerCallback(void *context_p, uint8_t timerId_u8)
+{
+    static_cast<MqttDevice*>(context_p)->ProcessTimer(timerId_u8);
+}
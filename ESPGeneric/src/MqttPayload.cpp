@@ -0,0 +1,227 @@
+/*****************************************************************************************
+* FILENAME :        MqttPayload.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the non owning view on a received MQTT payload
+*
+* NOTES :
+*       All functions work on the given length and never allocate memory. The
+*       integer conversion follows String::toInt(), leading white spaces and a
+*       sign are accepted, the conversion stops at the first non digit.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "MqttPayload.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the payload view
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     data_pu8      pointer to the first payload byte
+ * @param     length_u16    number of payload bytes
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+MqttPayload::MqttPayload(const uint8_t *data_pu8, uint16_t length_u16)
+{
+    this->data_pu8 = data_pu8;
+    this->length_u16 = (NULL == data_pu8) ? 0 : length_u16;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the payload data, the data is not zero terminated
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    pointer to the payload bytes
+*//*-----------------------------------------------------------------------------------*/
+const uint8_t* MqttPayload::GetData_pu8(void) const
+{
+    return(this->data_pu8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the payload length
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of payload bytes
+*//*-----------------------------------------------------------------------------------*/
+uint16_t MqttPayload::GetLength_u16(void) const
+{
+    return(this->length_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Checks if the payload starts with the given string, replacement for
+ *              0 == String::indexOf()
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     prefix_ccp    zero terminated compare string
+ * @return    true, if the payload starts with the prefix
+*//*-----------------------------------------------------------------------------------*/
+bool MqttPayload::StartsWith_bol(const char *prefix_ccp) const
+{
+    uint16_t idx_u16 = 0;
+
+    while('\0' != prefix_ccp[idx_u16])
+    {
+        if((idx_u16 >= this->length_u16)
+            || ((uint8_t)prefix_ccp[idx_u16] != this->data_pu8[idx_u16]))
+        {
+            return(false);
+        }
+        idx_u16++;
+    }
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Searches the first position of a character
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     char_c        character to search for
+ * @param     start_u16     first index to check
+ * @return    index of the character or MQTTPAYLOAD_NOT_FOUND
+*//*-----------------------------------------------------------------------------------*/
+int16_t MqttPayload::IndexOf_s16(char char_c, uint16_t start_u16) const
+{
+    uint16_t idx_u16;
+
+    for(idx_u16 = start_u16; idx_u16 < this->length_u16; idx_u16++)
+    {
+        if((uint8_t)char_c == this->data_pu8[idx_u16])
+        {
+            return((int16_t)idx_u16);
+        }
+    }
+    return(MQTTPAYLOAD_NOT_FOUND);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Searches the last position of a character
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     char_c        character to search for
+ * @return    index of the character or MQTTPAYLOAD_NOT_FOUND
+*//*-----------------------------------------------------------------------------------*/
+int16_t MqttPayload::LastIndexOf_s16(char char_c) const
+{
+    uint16_t idx_u16 = this->length_u16;
+
+    while(idx_u16 > 0)
+    {
+        idx_u16--;
+        if((uint8_t)char_c == this->data_pu8[idx_u16])
+        {
+            return((int16_t)idx_u16);
+        }
+    }
+    return(MQTTPAYLOAD_NOT_FOUND);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Converts the decimal number starting at the given index
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     start_u16     index of the first character
+ * @return    converted value, 0 if there is no number
+*//*-----------------------------------------------------------------------------------*/
+int32_t MqttPayload::ToInt_s32(uint16_t start_u16) const
+{
+    uint16_t idx_u16 = start_u16;
+    int32_t value_s32 = 0;
+    bool negative_bol = false;
+
+    while((idx_u16 < this->length_u16)
+            && ((' ' == this->data_pu8[idx_u16]) || ('\t' == this->data_pu8[idx_u16])))
+    {
+        idx_u16++;
+    }
+    if((idx_u16 < this->length_u16)
+        && (('-' == this->data_pu8[idx_u16]) || ('+' == this->data_pu8[idx_u16])))
+    {
+        negative_bol = ('-' == this->data_pu8[idx_u16]);
+        idx_u16++;
+    }
+    while((idx_u16 < this->length_u16)
+            && ('0' <= this->data_pu8[idx_u16]) && ('9' >= this->data_pu8[idx_u16]))
+    {
+        value_s32 = (value_s32 * 10) + (int32_t)(this->data_pu8[idx_u16] - '0');
+        idx_u16++;
+    }
+    return((true == negative_bol) ? -value_s32 : value_s32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Converts the payload to a decimal number, replacement for String::toInt()
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    converted value, 0 if there is no number
+*//*-----------------------------------------------------------------------------------*/
+int32_t MqttPayload::ToInt_s32(void) const
+{
+    return(this->ToInt_s32(0));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Copies the payload into a zero terminated buffer, the payload is
+ *              truncated if the buffer is too small
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     buffer_pch    destination buffer
+ * @param     size_u16      size of the destination buffer including termination
+ * @return    number of copied payload bytes
+*//*-----------------------------------------------------------------------------------*/
+uint16_t MqttPayload::CopyTo_u16(char *buffer_pch, uint16_t size_u16) const
+{
+    uint16_t idx_u16 = 0;
+
+    if((NULL == buffer_pch) || (0 == size_u16))
+    {
+        return(0);
+    }
+    while((idx_u16 < this->length_u16) && (idx_u16 < (size_u16 - 1u)))
+    {
+        buffer_pch[idx_u16] = (char)this->data_pu8[idx_u16];
+        idx_u16++;
+    }
+    buffer_pch[idx_u16] = '\0';
+    return(idx_u16);
+}
+
+/****************************************************************************************/
+/* Private functions: */
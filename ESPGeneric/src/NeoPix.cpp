@@ -59,6 +59,22 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PAYLOAD_CMD_ON       "ON"
 #define MQTT_PAYLOAD_CMD_OFF      "OFF"
 
+#define HANDLER_TOGGLE            0u
+#define HANDLER_SWITCH            1u
+#define HANDLER_BRIGHTNESS        2u
+#define HANDLER_RGB               3u
+#define HANDLER_ALARM             4u
+
+#define TOPIC_TOGGLE              0u
+#define TOPIC_SWITCH              1u
+#define TOPIC_BRIGHTNESS          2u
+#define TOPIC_RGB_CMD             3u
+#define TOPIC_ALARM               4u
+#define TOPIC_LIGHT_STATE         5u
+#define TOPIC_RGB_STATE           6u
+
+#define TIMER_ALARM               0u
+
 /****************************************************************************************/
 /* Local function like makros */
 
@@ -120,8 +136,8 @@ void NeoPix::Initialize()
                                     gpio_pcl->GetPinNumber_u8(), NEO_GRB + NEO_KHZ800);
     this->pixels_pcl->begin(); // This initializes the NeoPixel library.
 
-    p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-    p_trace->println(trace_PURE_MSG, " initialized");
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, " initialized"));
     this->TurnOff_vd();
 }
 
@@ -139,63 +155,75 @@ void NeoPix::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, " reconnected");
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, " reconnected"));
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_TOGGLE, BuildReceiveTopic_pch(MQTT_SUB_TOGGLE));
+        this->CacheTopic(TOPIC_SWITCH, BuildReceiveTopic_pch(MQTT_SUB_SWITCH));
+        this->CacheTopic(TOPIC_BRIGHTNESS, BuildReceiveTopic_pch(MQTT_SUB_BRIGHTNESS));
+        this->CacheTopic(TOPIC_RGB_CMD, BuildReceiveTopic_pch(MQTT_SUB_RGB));
+        this->CacheTopic(TOPIC_ALARM, BuildReceiveTopicBCast_pch(MQTT_SUB_ALARM));
+        this->CacheTopic(TOPIC_LIGHT_STATE, Utils::BuildSendTopic(this->dev_p, 
+                            this->channel_pch, MQTT_PUB_LIGHT_STATE, buildBuffer_ca));
+        this->CacheTopic(TOPIC_RGB_STATE, Utils::BuildSendTopic(this->dev_p, 
+                            this->channel_pch, MQTT_PUB_RGB, buildBuffer_ca));
         // ... and resubscribe
         // toggle light 
-        this->Subscribe_vd(client_p, BuildReceiveTopic_pch(MQTT_SUB_TOGGLE));
+        this->Subscribe_vd(client_p, GetTopic_ccp(TOPIC_TOGGLE), HANDLER_TOGGLE);
         // change light state digital with payload
-        this->Subscribe_vd(client_p, BuildReceiveTopic_pch(MQTT_SUB_SWITCH));  
+        this->Subscribe_vd(client_p, GetTopic_ccp(TOPIC_SWITCH), HANDLER_SWITCH);  
         // command to set brightness of light 
-        this->Subscribe_vd(client_p, BuildReceiveTopic_pch(MQTT_SUB_BRIGHTNESS)); 
+        this->Subscribe_vd(client_p, GetTopic_ccp(TOPIC_BRIGHTNESS), HANDLER_BRIGHTNESS); 
         // command to set RGB of light 
-        this->Subscribe_vd(client_p, BuildReceiveTopic_pch(MQTT_SUB_RGB));
+        this->Subscribe_vd(client_p, GetTopic_ccp(TOPIC_RGB_CMD), HANDLER_RGB);
         // command to activate the alarm mode
-        this->Subscribe_vd(client_p, BuildReceiveTopicBCast_pch(MQTT_SUB_ALARM));
+        this->Subscribe_vd(client_p, GetTopic_ccp(TOPIC_ALARM), HANDLER_ALARM);
     }
     else
     {
         // failure, not connected
-        p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, " uninizialized MQTT client detected");
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, " uninizialized MQTT client detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void NeoPix::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void NeoPix::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                          char* p_topic, const MqttPayload &payload)
 {
     if(true == this->isConnected_bol)
     {
         // received toggle light mqtt topic
-        if (String(BuildReceiveTopic_pch(MQTT_SUB_TOGGLE)).equals(p_topic)) 
+        if (HANDLER_TOGGLE == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->print(trace_PURE_MSG, "<<dimLight>> mqtt callback: ");
-            p_trace->println(trace_PURE_MSG, p_topic);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "<<dimLight>> mqtt callback: "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, p_topic));
             if(NEOPIX_NORMAL_MODE == this->mode_en)
             {
                 this->Toggle_vd();
             }
         }
         // execute command to switch on/off the light
-        else if (String(BuildReceiveTopic_pch(MQTT_SUB_SWITCH)).equals(p_topic)) 
+        else if (HANDLER_SWITCH == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->println(trace_PURE_MSG, " mqtt callback: ");
-            p_trace->print(trace_PURE_MSG, p_topic);
-            p_trace->print(trace_PURE_MSG, " : ");
-            p_trace->println(trace_PURE_MSG, p_payload);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, " mqtt callback: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, p_topic));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, " : "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, payload));
             // test if the payload is equal to "ON" or "OFF"
-            if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_ON))) 
+            if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_ON)) 
             {
                 if(NEOPIX_NORMAL_MODE == this->mode_en)
                 {
@@ -203,7 +231,7 @@ void NeoPix::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
                     this->Set_vd();
                 }  
             }
-            else if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_OFF)))
+            else if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_OFF))
             {
                 if(NEOPIX_NORMAL_MODE == this->mode_en)
                 {   
@@ -213,21 +241,21 @@ void NeoPix::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
             }
             else
             {
-                p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-                p_trace->println(trace_PURE_MSG, " unexpected payload: "); 
-                p_trace->println(trace_PURE_MSG, p_payload);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, " unexpected payload: ")); 
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
             }   
         } 
         // execute command to change brightness of light
-        else if (String(BuildReceiveTopic_pch(MQTT_SUB_BRIGHTNESS)).equals(p_topic)) 
+        else if (HANDLER_BRIGHTNESS == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->println(trace_PURE_MSG, " mqtt callback: ");
-            p_trace->print(trace_PURE_MSG, p_topic);
-            p_trace->print(trace_PURE_MSG, " : ");
-            p_trace->println(trace_PURE_MSG, p_payload);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, " mqtt callback: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, p_topic));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, " : "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, payload));
 
-            uint32_t payLoad_u32 = p_payload.toInt(); 
+            uint32_t payLoad_u32 = payload.ToInt_s32(); 
             // test if the payload is integer and in range
             if(payLoad_u32 < 100 && payLoad_u32 >= 0)
             {
@@ -236,26 +264,26 @@ void NeoPix::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
             }
             else
             {
-                p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-                p_trace->println(trace_PURE_MSG, " unexpected payload: "); 
-                p_trace->println(trace_PURE_MSG, p_payload);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, " unexpected payload: ")); 
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
             }   
         } 
         // execute command to change RGB of light
-        else if (String(BuildReceiveTopic_pch(MQTT_SUB_RGB)).equals(p_topic)) 
+        else if (HANDLER_RGB == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->println(trace_PURE_MSG, " mqtt callback: ");
-            p_trace->print(trace_PURE_MSG, p_topic);
-            p_trace->print(trace_PURE_MSG, " : ");
-            p_trace->println(trace_PURE_MSG, p_payload);
-
-            uint8_t firstIndex_u8 = p_payload.indexOf(',');
-            uint8_t lastIndex_u8 = p_payload.lastIndexOf(',');
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, " mqtt callback: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, p_topic));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, " : "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, payload));
+
+            int16_t firstIndex_s16 = payload.IndexOf_s16(',', 0);
+            int16_t lastIndex_s16 = payload.LastIndexOf_s16(',');
             
-            uint8_t red_u8 = p_payload.substring(0, firstIndex_u8).toInt();
-            uint8_t green_u8 = p_payload.substring(firstIndex_u8 + 1, lastIndex_u8).toInt();
-            uint8_t blue_u8 = p_payload.substring(lastIndex_u8 + 1).toInt();
+            uint8_t red_u8 = (uint8_t)payload.ToInt_s32(0);
+            uint8_t green_u8 = (uint8_t)payload.ToInt_s32((uint16_t)(firstIndex_s16 + 1));
+            uint8_t blue_u8 = (uint8_t)payload.ToInt_s32((uint16_t)(lastIndex_s16 + 1));
 
             this->red_u8 = red_u8;
             this->green_u8 = green_u8;
@@ -264,19 +292,22 @@ void NeoPix::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
             this->Set_vd();  
         }
         // execute command to activate or deactivate the alarm
-        else if(String(BuildReceiveTopicBCast_pch(MQTT_SUB_ALARM)).equals(p_topic))
+        else if(HANDLER_ALARM == handlerId_u8)
         {
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->println(trace_PURE_MSG, " mqtt callback: ");
-            p_trace->print(trace_PURE_MSG, p_topic);
-            p_trace->print(trace_PURE_MSG, " : ");
-            p_trace->println(trace_PURE_MSG, p_payload);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, " mqtt callback: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, p_topic));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, " : "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, payload));
             // test if the payload is equal to "ON" or "OFF"
-            if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_ON))) 
+            if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_ON)) 
             {
                 this->mode_en = NEOPIX_ALARM_MODE;  
+                this->alarmToggleRequest_bol = true;
+                this->StartTimer(TIMER_ALARM, this->ALARM_TOGGLE_TIME, 
+                                    this->ALARM_TOGGLE_TIME);
             }
-            else if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_OFF)))
+            else if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_OFF))
             {
                 if(NEOPIX_ALARM_MODE == this->mode_en)
                 {
@@ -285,21 +316,22 @@ void NeoPix::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
                     this->lightState_bol = false;
                     this->Set_vd();
                 }
+                this->StopTimer(TIMER_ALARM);
                 this->mode_en = NEOPIX_NORMAL_MODE;
             }
             else
             {
-                p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-                p_trace->println(trace_PURE_MSG, " unexpected payload: "); 
-                p_trace->println(trace_PURE_MSG, p_payload);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, " unexpected payload: ")); 
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
             } 
 
         }
     }
     else
     {
-        p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, "connection failure in CallbackMqtt "); 
+        TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+        TRACE_ERROR(p_trace->println(trace_PURE_MSG, "connection failure in CallbackMqtt ")); 
     }
 }
 
@@ -324,14 +356,14 @@ bool NeoPix::ProcessPublishRequests(PubSubClient *client)
         {
             if(true == this->lightState_bol)
             {
-              ret = PublishMessage_bol(client, MQTT_PUB_LIGHT_STATE, MQTT_PAYLOAD_CMD_ON);
+              ret = PublishMessage_bol(client, TOPIC_LIGHT_STATE, MQTT_PAYLOAD_CMD_ON);
             }
             else
             {
-              ret = PublishMessage_bol(client, MQTT_PUB_LIGHT_STATE, MQTT_PAYLOAD_CMD_OFF); 
+              ret = PublishMessage_bol(client, TOPIC_LIGHT_STATE, MQTT_PAYLOAD_CMD_OFF); 
             } 
 
-            ret = PublishMessage_bol(client, MQTT_PUB_RGB, 
+            ret = PublishMessage_bol(client, TOPIC_RGB_STATE, 
                                     Utils::RGBToString(this->red_u8, this->green_u8, 
                                                         this->blue_u8,
                                                         &this->mqttPayload_cha[0]));
@@ -343,8 +375,9 @@ bool NeoPix::ProcessPublishRequests(PubSubClient *client)
     }
     else
     {
-        p_trace->print(trace_ERROR_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, " connection failure in ProcessPublishRequests "); 
+        TRACE_ERROR(p_trace->print(trace_ERROR_MSG, this->deviceName_ccp));
+        TRACE_ERROR(p_trace->println(trace_PURE_MSG, 
+                        " connection failure in ProcessPublishRequests ")); 
     }
     return ret; 
 };
@@ -383,8 +416,8 @@ void NeoPix::TurnOff_vd(void)
         this->lightState_bol = false;
         this->pixels_pcl->setPixelColor(0, 0, 0, 0);
         this->pixels_pcl->show();   
-        p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, "light turned off");
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, "light turned off"));
         this->neoStateChanged_bol = true;
     }
 }
@@ -407,8 +440,8 @@ void NeoPix::TurnOn_vd(void)
         this->pixels_pcl->setBrightness(this->brightness_u8);
         this->pixels_pcl->show(); // This sends the updated pixel color to the hardware.
 
-        p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-        p_trace->println(trace_PURE_MSG, "light turned on");
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, "light turned on"));
         this->neoStateChanged_bol = true;
     }
 }
@@ -437,12 +470,12 @@ void NeoPix::Toggle_vd(void)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* NeoPix::BuildReceiveTopic_pch(const char *topic) 
 {
     return (Utils::BuildReceiveTopic(this->dev_p, this->channel_pch, 
-                                      topic, this->topicBuff_cha));
+                                      topic, buildBuffer_ca));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -450,11 +483,11 @@ char* NeoPix::BuildReceiveTopic_pch(const char *topic)
  * @author    winkste
  * @date      07. Jul. 2020
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* NeoPix::BuildReceiveTopicBCast_pch(const char *topic) 
 {
-    return (Utils::BuildReceiveTopicBCast(topic, this->topicBuff_cha));
+    return (Utils::BuildReceiveTopicBCast(topic, buildBuffer_ca));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -462,44 +495,42 @@ char* NeoPix::BuildReceiveTopicBCast_pch(const char *topic)
  * @author    winkste
  * @date      24 Sep. 2018
  * @param     client_p       pointer to pub sub client
- * @param     message_cp       pointer to topic string
+ * @param     topicId_u8       cached send topic id
  * @param     payload_ccp       pointer to topic payload string
  * @return    true, if message was successful send
 *//*-----------------------------------------------------------------------------------*/
-boolean NeoPix::PublishMessage_bol(PubSubClient *client_p, const char *message_cp, 
+boolean NeoPix::PublishMessage_bol(PubSubClient *client_p, uint8_t topicId_u8, 
                                   const char * payload_ccp)
 {
     boolean ret_bol = false;
 
-    p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-    p_trace->print(trace_PURE_MSG, "publish message: ");
-    p_trace->print(trace_PURE_MSG, 
-                    Utils::BuildSendTopic(this->dev_p, this->channel_pch, 
-                                          message_cp, this->topicBuff_cha));
-    p_trace->print(trace_PURE_MSG, "  :  ");
-    ret_bol = client_p->publish(Utils::BuildSendTopic(this->dev_p, this->channel_pch, 
-                                          message_cp, this->topicBuff_cha), 
-                                  payload_ccp, true);
-    p_trace->println(trace_PURE_MSG, payload_ccp);
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "publish message: "));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, GetTopic_ccp(topicId_u8)));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+    ret_bol = Publish_bol(client_p, GetTopic_ccp(topicId_u8), payload_ccp, true);
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, payload_ccp));
     
     return(ret_bol);
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     This function subscribes a message
+ * @brief     This function subscribes a message and registers its route
  * @author    winkste
  * @date      24 Sep. 2018
  * @param     client_p       pointer to pub sub client
  * @param     topic_ccp      complete topic
+ * @param     handlerId_u8   handler id passed to DispatchMqtt
  * @return    N/A
 *//*-----------------------------------------------------------------------------------*/
-void NeoPix::Subscribe_vd(PubSubClient *client_p, const char *topic_ccp)
+void NeoPix::Subscribe_vd(PubSubClient *client_p, const char *topic_ccp, 
+                          uint8_t handlerId_u8)
 {
-    client_p->subscribe(topic_ccp);  
-    client_p->loop();
-    p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-    p_trace->print(trace_PURE_MSG, "subscribe message: ");
-    p_trace->println(trace_PURE_MSG, topic_ccp);
+    this->Subscribe_bol(client_p, topic_ccp);
+    this->RegisterTopic(topic_ccp, handlerId_u8);
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "subscribe message: "));
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, topic_ccp));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -535,9 +566,9 @@ void NeoPix::ControlAlarmSignal_vd()
 {
     if(NEOPIX_ALARM_MODE == this->mode_en)
     {
-        if(    (this->prevTime_u32 + ALARM_TOGGLE_TIME) < millis() 
-            || (0 == this->prevTime_u32))
+        if(true == this->alarmToggleRequest_bol)
         {
+            this->alarmToggleRequest_bol = false;
             this->pixels_pcl->setPixelColor(0, 
                                     this->ALARM_RGB[this->alarmRgbIdx_u8][0], 
                                     this->ALARM_RGB[this->alarmRgbIdx_u8][1], 
@@ -553,12 +584,27 @@ void NeoPix::ControlAlarmSignal_vd()
         if(true == this->lightState_bol)
         {
             this->lightState_bol = false;
-            p_trace->print(trace_INFO_MSG, this->deviceName_ccp);
-            p_trace->println(trace_PURE_MSG, "light turned from on to alarm");
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, this->deviceName_ccp));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, "light turned from on to alarm"));
             this->neoStateChanged_bol = true;
         }
     }  
 }
 
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for the expired alarm timer, requests the next alarm light toggle
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    N/A
+*//*-----------------------------------------------------------------------------------*/
+void NeoPix::ProcessTimer(uint8_t timerId_u8)
+{
+    if(TIMER_ALARM == timerId_u8)
+    {
+        this->alarmToggleRequest_bol = true;
+    }
+}
+
 
 
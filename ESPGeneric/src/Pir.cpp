@@ -46,6 +46,8 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PAYLOAD_MOTION       "ON"
 #define MQTT_PAYLOAD_NO_MOTION    "OFF"
 
+#define TOPIC_PIR_STATE           0u
+
 #define LED_PIN_UNUSED            0xFF
 
 /****************************************************************************************/
@@ -146,7 +148,7 @@ Pir::~Pir()
 *//*-----------------------------------------------------------------------------------*/
 void Pir::Initialize()
 {
-    p_trace->println(trace_INFO_MSG, "<<pir>>Pir initialized");
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pir>>Pir initialized"));
 
     pinMode(this->pirPin_u8, INPUT_PULLUP);
 
@@ -178,14 +180,16 @@ void Pir::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "<<pir>> reconnected");
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_PIR_STATE, build_topic(MQTT_PUB_PIR_STATE));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pir>> reconnected"));
         // ... and resubscribe
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, 
-                                "<<pir>>uninizialized MQTT client in single relay detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                                "<<pir>>uninizialized MQTT client in single relay detected"));
         this->isConnected_bol = false;
     }
 }
@@ -194,12 +198,13 @@ void Pir::Reconnect(PubSubClient *client_p, const char *dev_p)
  * @brief     Callback function to process subscribed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
+ * @param     client_p   mqtt client object
  * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     payload    view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void Pir::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void Pir::CallbackMqtt(PubSubClient *client_p, char* p_topic, 
+                       const MqttPayload &payload)
 {
     if(true == this->isConnected_bol)
     {
@@ -207,7 +212,8 @@ void Pir::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, "<<pir>>connection failure in pir CallbackMqtt "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<pir>>connection failure in pir CallbackMqtt ")); 
     }
 }
 
@@ -231,20 +237,20 @@ bool Pir::ProcessPublishRequests(PubSubClient *client)
         }
         if(true == publishState_bol)
         {
-            p_trace->print(trace_INFO_MSG, "<<pir>> publish requested state: ");
-            p_trace->print(trace_PURE_MSG, MQTT_PUB_PIR_STATE);
-            p_trace->print(trace_PURE_MSG, "  :  ");
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<pir>> publish requested state: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, MQTT_PUB_PIR_STATE));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
             if(true == this->motionDetected_bol)
             {
-              ret = client->publish(build_topic(MQTT_PUB_PIR_STATE), 
+              ret = Publish_bol(client, GetTopic_ccp(TOPIC_PIR_STATE), 
                                         MQTT_PAYLOAD_MOTION, true);
-              p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_MOTION);
+              TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_MOTION));
             }
             else
             {
-                ret = client->publish(build_topic(MQTT_PUB_PIR_STATE), 
+                ret = Publish_bol(client, GetTopic_ccp(TOPIC_PIR_STATE), 
                                           MQTT_PAYLOAD_NO_MOTION, true); 
-                p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_NO_MOTION); 
+                TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_NO_MOTION)); 
             } 
             if(ret)
             {
@@ -254,8 +260,8 @@ bool Pir::ProcessPublishRequests(PubSubClient *client)
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, 
-                              "<<pir>>connection failure in relay ProcessPublishRequests "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                              "<<pir>>connection failure in relay ProcessPublishRequests ")); 
     }
     return ret; 
 };
@@ -295,8 +301,8 @@ void Pir::PollPirState(void)
         this->publishState_bol = true; 
         if(true == this->motionDetected_bol)
         {
-            this->p_trace->println(trace_INFO_MSG, 
-                                "<<pir>>Motion polling: motion detected");
+            TRACE_INFO(this->p_trace->println(trace_INFO_MSG, 
+                                "<<pir>>Motion polling: motion detected"));
             if(LED_PIN_UNUSED != this->ledPin_u8)
             {
                 digitalWrite(this->ledPin_u8, LOW);
@@ -304,8 +310,8 @@ void Pir::PollPirState(void)
         }
         else
         {
-            this->p_trace->println(trace_INFO_MSG,  
-                                "<<pir>>Motion verification: no motion detected");
+            TRACE_INFO(this->p_trace->println(trace_INFO_MSG,  
+                                "<<pir>>Motion verification: no motion detected"));
             if(LED_PIN_UNUSED != this->ledPin_u8)
             {
                 digitalWrite(this->ledPin_u8, HIGH);
@@ -327,6 +333,9 @@ ICACHE_RAM_ATTR void Pir::PirSignalChangedIsr()
     pinState_s32 = digitalRead(Pir::mySelf_p->pirPin_u8);
     Pir::mySelf_p->publishState_bol = true; 
     Pir::mySelf_p->motionDetected_bol = (HIGH == pinState_s32);
+    MqttDevice::RequestWakeup();
+    TRACE_INFO(Pir::mySelf_p->p_trace->Log(trace_INFO_MSG, TRACEFMT_PIR_MOTION, 
+                                    (uint32_t)(HIGH == pinState_s32)));
 
     // update the corresponding led output signal
     if(HIGH == pinState_s32)
@@ -354,11 +363,11 @@ ICACHE_RAM_ATTR void Pir::PirSignalChangedIsr()
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* Pir::build_topic(const char *topic) 
 {
-  sprintf(buffer_ca, "std/%s%s", this->dev_p, topic);
-  return buffer_ca;
+  sprintf(buildBuffer_ca, "std/%s%s", this->dev_p, topic);
+  return buildBuffer_ca;
 }
 
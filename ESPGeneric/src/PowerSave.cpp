@@ -40,6 +40,7 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #include "PubSubClient.h"
 
 #include "PowerSave.h"
+#include "PublishPolicy.h"
 
 /****************************************************************************************/
 /* Local constant defines */
@@ -52,6 +53,12 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_SUB_PWR_SAVE_CMD     "/r/pwr/cmd" // command message for power save handler
 #define MQTT_PAYLOAD_CMD_ON       "ON"
 #define MQTT_PAYLOAD_CMD_OFF      "OFF"
+#define HANDLER_PWR_SAVE_CMD      0u
+
+#define TOPIC_PWR_SAVE_CMD        0u
+#define TOPIC_PWR_SAVE_STATE      1u
+
+#define TIMER_PWR_ON              0u
 
 #define MQTT_PUB_PWR_SAVE_STATE   "/s/pwr/state" // state
 
@@ -85,8 +92,8 @@ PowerSave::PowerSave(Trace *p_trace) : MqttDevice(p_trace)
     this->pwrOnTimeMSec_u32 = DEFAULT_POWER_ON_TIME;
     this->pwrSaveTimeMSec_u32 = DEFAULT_POWER_SAVE_TIME;
     this->actualState_u8 = POWER_UP;
-    this->timer_u32 = 0l;
-    p_trace->println(trace_INFO_MSG, "<<pwr>> power up");
+    this->pwrOnTimeout_bol = false;
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> power up"));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -105,8 +112,8 @@ PowerSave::PowerSave(Trace *p_trace, bool powerSaveMode_bol) : MqttDevice(p_trac
     this->pwrOnTimeMSec_u32 = DEFAULT_POWER_ON_TIME;
     this->pwrSaveTimeMSec_u32 = DEFAULT_POWER_SAVE_TIME;
     this->actualState_u8 = POWER_UP;
-    this->timer_u32 = 0l;
-    p_trace->println(trace_INFO_MSG, "<<pwr>> power up");
+    this->pwrOnTimeout_bol = false;
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> power up"));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -124,8 +131,8 @@ PowerSave::PowerSave(Trace *p_trace, bool powerSaveMode_bol, uint16_t pwrOnTimeS
     this->publications_u16 = 0l;
     this->pwrSaveMode_bol = powerSaveMode_bol;
     this->actualState_u8 = POWER_UP;
-    this->timer_u32 = 0l;
-    p_trace->println(trace_INFO_MSG, "<<pwr>> power up");
+    this->pwrOnTimeout_bol = false;
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> power up"));
     this->pwrOnTimeMSec_u32 = pwrOnTimeSec_u16 * MILLISEC_IN_SEC;
     this->pwrSaveTimeMSec_u32 = pwrSaveTimeSec_u16 * MICROSEC_IN_SEC;
 
@@ -151,7 +158,7 @@ PowerSave::~PowerSave()
 void PowerSave::Initialize()
 {
     // ensure DHT is powered down
-    p_trace->println(trace_INFO_MSG, "<<pwr>> initialize"); 
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> initialize")); 
     this->isInitialized_bol = true;
     this->actualState_u8 = POWER_INITIALIZED;
 }
@@ -170,60 +177,67 @@ void PowerSave::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "<<pwr>> connected");
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_PWR_SAVE_CMD, build_topic(MQTT_SUB_PWR_SAVE_CMD));
+        this->CacheTopic(TOPIC_PWR_SAVE_STATE, build_topic(MQTT_PUB_PWR_SAVE_STATE));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> connected"));
         // ... and resubscribe
-        client_p->subscribe(build_topic(MQTT_SUB_PWR_SAVE_CMD));  
-        client_p->loop();
-        p_trace->print(trace_INFO_MSG, "<<pwr>> subscribed 1: ");
-        p_trace->println(trace_PURE_MSG, MQTT_SUB_PWR_SAVE_CMD);
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_PWR_SAVE_CMD));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_PWR_SAVE_CMD), HANDLER_PWR_SAVE_CMD);
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<pwr>> subscribed 1: "));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_SUB_PWR_SAVE_CMD));
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, "<<pwr>> uninizialized MQTT device detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<pwr>> uninizialized MQTT device detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void PowerSave::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void PowerSave::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                             char* p_topic, const MqttPayload &payload)
 {
     if(true == this->isConnected_bol)
     {
         // received DHT command
-        if (String(build_topic(MQTT_SUB_PWR_SAVE_CMD)).equals(p_topic)) 
+        if (HANDLER_PWR_SAVE_CMD == handlerId_u8) 
         {
-            p_trace->println(trace_INFO_MSG, "<<pwr>> mqtt callback");
-            p_trace->println(trace_INFO_MSG, p_topic);
-            p_trace->println(trace_INFO_MSG, p_payload);
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> mqtt callback"));
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, p_topic));
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, payload));
             // test if the payload is equal to "ON" or "OFF"
-            if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_ON))) 
+            if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_ON)) 
             {
                 this->pwrSaveMode_bol = false; 
                 this->actualState_u8 = POWER_DEACTIVATED;
             }
-            else if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_OFF)))
+            else if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_OFF))
             {
                 this->pwrSaveMode_bol = true;
             }
             else
             {
-                p_trace->print(trace_ERROR_MSG, "<<pwr>> unexpected payload: "); 
-                p_trace->println(trace_PURE_MSG, p_payload);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "<<pwr>> unexpected payload: ")); 
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
             }   
         } 
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, "<<pwr>>connection failure in CallbackMqtt "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<pwr>>connection failure in CallbackMqtt ")); 
     }
 }
 
@@ -243,12 +257,13 @@ bool PowerSave::ProcessPublishRequests(PubSubClient *client)
     {
         case POWER_INITIALIZED:
             this->prevTime_u32 = millis();
-            this->timer_u32 = 0u;
+            this->pwrOnTimeout_bol = false;
+            this->StartTimer(TIMER_PWR_ON, this->pwrOnTimeMSec_u32, 0);
             this->actualState_u8 = POWER_TIMER_ACTIVE;
-            p_trace->println(trace_INFO_MSG, "<<pwr>> timer activated");
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> timer activated"));
             if(true == this->isConnected_bol)
             {
-                ret_bol = client->publish(build_topic(MQTT_PUB_PWR_SAVE_STATE), 
+                ret_bol = Publish_bol(client, GetTopic_ccp(TOPIC_PWR_SAVE_STATE), 
                                         MQTT_PAYLOAD_CMD_ON, true);
             }
             else
@@ -257,36 +272,35 @@ bool PowerSave::ProcessPublishRequests(PubSubClient *client)
             }
             break;
         case POWER_TIMER_ACTIVE:
-            this->timer_u32 += (millis() - this->prevTime_u32);
-            this->prevTime_u32 = millis();
-            if(this->timer_u32 > this->pwrOnTimeMSec_u32)
+            if(true == this->pwrOnTimeout_bol)
             {
                 this->actualState_u8 = POWER_SLEEPING;
-                this->timer_u32 = 0u;
-                p_trace->println(trace_INFO_MSG, "<<pwr>> go to sleep mode");
+                this->pwrOnTimeout_bol = false;
+                TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> go to sleep mode"));
                 if(true == this->isConnected_bol)
                 {
-                    ret_bol = client->publish(build_topic(MQTT_PUB_PWR_SAVE_STATE), 
+                    ret_bol = Publish_bol(client, GetTopic_ccp(TOPIC_PWR_SAVE_STATE), 
                                             MQTT_PAYLOAD_CMD_OFF, true);
+                    // the main loop will not drain the queue anymore
+                    if(NULL != MqttDevice::queue_p)
+                    {
+                        (void)MqttDevice::queue_p->flush();
+                    }
                 }
                 else
                 {
                     ret_bol = false;
                 }
                 delay(500);
-                // power save time in seconds
+                // the sensors continue with their published values after the wake up
+                PublishPolicy::SaveToRtc(this->pwrSaveTimeMSec_u32 / MILLISEC_IN_SEC);
+                // power save time in microseconds
                 ESP.deepSleep(this->pwrSaveTimeMSec_u32); 
                 delay(100);
             }
-            else
-            {
-                /*p_trace->print(trace_INFO_MSG, "<<pwr>> actual timer counter in secs:");
-                p_trace->println(trace_PURE_MSG, 
-                                            (uint16_t)(this->timer_u32 / MILLISEC_IN_SEC));*/
-            }
             break;
         default:
-            p_trace->println(trace_INFO_MSG, "<<pwr>> unexpected state reached");
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<pwr>> unexpected state reached"));
             break;
     }
 
@@ -298,16 +312,31 @@ bool PowerSave::ProcessPublishRequests(PubSubClient *client)
 
 /****************************************************************************************/
 /* Protected functions: */
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for the expired power on timer, requests the deep sleep
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void PowerSave::ProcessTimer(uint8_t timerId_u8)
+{
+    if(TIMER_PWR_ON == timerId_u8)
+    {
+        this->pwrOnTimeout_bol = true;
+    }
+}
+
 /**---------------------------------------------------------------------------------------
  * @brief     This function helps to build the complete topic including the 
  *              custom device.
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* PowerSave::build_topic(const char *topic) 
 {
-  sprintf(buffer_ca, "std/%s%s", this->dev_p, topic);
-  return buffer_ca;
+  sprintf(buildBuffer_ca, "std/%s%s", this->dev_p, topic);
+  return buildBuffer_ca;
 }
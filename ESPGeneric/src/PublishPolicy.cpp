@@ -0,0 +1,482 @@
+/*****************************************************************************************
+* FILENAME :        PublishPolicy.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the report on change policy of a sensor value
+*
+* NOTES :
+*       The last published value is the reference for the delta, so small changes
+*       add up until they are published. A value rejected by the minimum interval
+*       is not stored, the next measurement after the interval is compared again.
+*       Invalid measurements (NaN) are never due.
+*       The RTC image stores the age of the publication including the sleep time,
+*       millis() starts again at zero after the wake up. The image is invalidated
+*       when it is restored, a later reset starts without a reference.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "PublishPolicy.h"
+#include <Arduino.h>
+#include <stddef.h>
+#include <string.h>
+
+/****************************************************************************************/
+/* Local constant defines */
+#define MILLISEC_IN_SEC             1000ul
+#define MAX_SECONDS                 (UINT32_MAX / MILLISEC_IN_SEC)  // fits in milliseconds
+#define PERCENT                     100.0F
+#define FIELD_SEPARATOR             ','
+#define POLICY_FIELDS               4u
+#define RELATIVE_MARK               '%'
+#define RTC_MAGIC                   0x50504C31ul    // "PPL1"
+#define RTC_USER_MEMORY             512u            // bytes of the RTC user memory
+#define RTC_FLAG_RELATIVE           0x01ul
+#define RTC_FLAG_PUBLISHED          0x02ul
+#define RTC_FLAG_USED               0x04ul
+#define FNV_OFFSET                  2166136261ul
+#define FNV_PRIME                   16777619ul
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct rtcPolicy_tag
+{
+    float               delta_f32;
+    uint32_t            minInterval_u32;
+    uint32_t            heartbeat_u32;
+    float               published_f32;
+    uint32_t            age_u32;            // milliseconds since the publication
+    uint32_t            flags_u32;
+}rtcPolicy_t;
+
+typedef struct rtcImage_tag
+{
+    uint32_t            magic_u32;
+    uint32_t            checksum_u32;       // of the count and the policies
+    uint32_t            count_u32;          // constructed policies at the save
+    rtcPolicy_t         policies_sta[PUBLISHPOLICY_RTC_SLOTS];
+}rtcImage_t;
+
+static_assert((PUBLISHPOLICY_RTC_OFFSET * sizeof(uint32_t)) + sizeof(rtcImage_t) 
+                <= RTC_USER_MEMORY, "publish policies do not fit into the RTC memory");
+
+/****************************************************************************************/
+/* Static Data instantiation */
+PublishPolicy *PublishPolicy::instances_pa[PUBLISHPOLICY_RTC_SLOTS] = {NULL};
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     FNV-1a checksum of the RTC image behind the checksum field
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     image_p     RTC image
+ * @return    checksum
+*//*-----------------------------------------------------------------------------------*/
+static uint32_t Checksum_u32(const rtcImage_t *image_p)
+{
+    const uint8_t *data_pu8 = (const uint8_t *)&image_p->count_u32;
+    uint16_t length_u16 = sizeof(rtcImage_t) - offsetof(rtcImage_t, count_u32);
+    uint32_t hash_u32 = FNV_OFFSET;
+
+    while(0u != length_u16--)
+    {
+        hash_u32 = (hash_u32 ^ *data_pu8++) * FNV_PRIME;
+    }
+    return(hash_u32);
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the publish policy, publishes every measurement until it
+ *              is configured
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+PublishPolicy::PublishPolicy()
+{
+    uint8_t idx_u8;
+
+    this->policy_st.delta_f32 = 0.0F;
+    this->policy_st.relative_bol = false;
+    this->policy_st.minInterval_u32 = 0u;
+    this->policy_st.heartbeat_u32 = 0u;
+    this->Reset();
+
+    // the first free slot, the policies of a capability get the same slots every boot
+    for(idx_u8 = 0; idx_u8 < PUBLISHPOLICY_RTC_SLOTS; idx_u8++)
+    {
+        if(NULL == PublishPolicy::instances_pa[idx_u8])
+        {
+            PublishPolicy::instances_pa[idx_u8] = this;
+            break;
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Destructor, frees the RTC slot of the policy
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+PublishPolicy::~PublishPolicy()
+{
+    uint8_t idx_u8;
+
+    for(idx_u8 = 0; idx_u8 < PUBLISHPOLICY_RTC_SLOTS; idx_u8++)
+    {
+        if(this == PublishPolicy::instances_pa[idx_u8])
+        {
+            PublishPolicy::instances_pa[idx_u8] = NULL;
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Sets delta, minimum interval and heartbeat, the last published value stays
+ *              the reference
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     policy_p    new policy
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void PublishPolicy::Configure(const publishPolicy_t *policy_p)
+{
+    if(NULL != policy_p)
+    {
+        this->policy_st = *policy_p;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the actual policy
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    pointer to the policy
+*//*-----------------------------------------------------------------------------------*/
+const publishPolicy_t* PublishPolicy::GetPolicy_cp(void) const
+{
+    return(&this->policy_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Checks, if a new measurement has to be published
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     value_f32   new measurement
+ * @param     now_u32     actual time in milliseconds
+ * @return    true, if the value has to be published
+*//*-----------------------------------------------------------------------------------*/
+bool PublishPolicy::IsDue_bol(float value_f32, uint32_t now_u32) const
+{
+    uint32_t silence_u32;
+    float limit_f32;
+
+    if(isnan(value_f32))
+    {
+        return(false);
+    }
+    if(false == this->published_bol)
+    {
+        return(true);
+    }
+
+    silence_u32 = now_u32 - this->publishedTime_u32;
+    if(silence_u32 < this->policy_st.minInterval_u32)
+    {
+        return(false);
+    }
+    if(    (0u != this->policy_st.heartbeat_u32) 
+        && (silence_u32 >= this->policy_st.heartbeat_u32))
+    {
+        return(true);
+    }
+
+    limit_f32 = this->policy_st.delta_f32;
+    if(true == this->policy_st.relative_bol)
+    {
+        limit_f32 = fabsf(this->published_f32) * limit_f32 / PERCENT;
+    }
+    return(fabsf(value_f32 - this->published_f32) >= limit_f32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Stores the published value as reference for the next measurements
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     value_f32   published value
+ * @param     now_u32     actual time in milliseconds
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void PublishPolicy::SetPublished(float value_f32, uint32_t now_u32)
+{
+    this->published_f32 = value_f32;
+    this->publishedTime_u32 = now_u32;
+    this->published_bol = true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Forgets the published value, the next measurement is due
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void PublishPolicy::Reset(void)
+{
+    this->published_f32 = 0.0F;
+    this->publishedTime_u32 = 0u;
+    this->published_bol = false;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Parses a configuration payload "<index>,<delta>[%],<min s>,<heartbeat s>",
+ *              the delta has to be finite and the seconds have to fit in milliseconds
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     payload     received configuration
+ * @param     index_pu8   returns the value index
+ * @param     policy_p    returns the policy
+ * @return    true, if all fields are valid
+*//*-----------------------------------------------------------------------------------*/
+bool PublishPolicy::Parse_bol(const MqttPayload &payload, uint8_t *index_pu8, 
+                                publishPolicy_t *policy_p)
+{
+    char buffer_ca[PUBLISHPOLICY_PAYLOAD_LENGTH];
+    char *field_pch[POLICY_FIELDS];
+    char *end_pch;
+    char *next_pch;
+    uint8_t idx_u8;
+    long index_s32;
+    long minInterval_s32;
+    long heartbeat_s32;
+    float delta_f32;
+
+    if(payload.GetLength_u16() >= PUBLISHPOLICY_PAYLOAD_LENGTH)
+    {
+        return(false);
+    }
+    (void)payload.CopyTo_u16(buffer_ca, sizeof(buffer_ca));
+
+    // split into exactly four fields
+    next_pch = buffer_ca;
+    for(idx_u8 = 0; idx_u8 < POLICY_FIELDS; idx_u8++)
+    {
+        if(NULL == next_pch)
+        {
+            return(false);
+        }
+        field_pch[idx_u8] = next_pch;
+        next_pch = strchr(next_pch, FIELD_SEPARATOR);
+        if(NULL != next_pch)
+        {
+            *next_pch = '\0';
+            next_pch++;
+        }
+    }
+    if(NULL != next_pch)
+    {
+        return(false);
+    }
+
+    index_s32 = strtol(field_pch[0], &end_pch, 10);
+    if((end_pch == field_pch[0]) || ('\0' != *end_pch) || (0 > index_s32) 
+        || (UINT8_MAX < index_s32))
+    {
+        return(false);
+    }
+    delta_f32 = strtof(field_pch[1], &end_pch);
+    if((end_pch == field_pch[1]) || (!isfinite(delta_f32)) || (0.0F > delta_f32))
+    {
+        return(false);
+    }
+    policy_p->relative_bol = (RELATIVE_MARK == *end_pch);
+    if(true == policy_p->relative_bol)
+    {
+        end_pch++;
+    }
+    if('\0' != *end_pch)
+    {
+        return(false);
+    }
+    minInterval_s32 = strtol(field_pch[2], &end_pch, 10);
+    if((end_pch == field_pch[2]) || ('\0' != *end_pch) || (0 > minInterval_s32)
+        || (MAX_SECONDS < (unsigned long)minInterval_s32))
+    {
+        return(false);
+    }
+    heartbeat_s32 = strtol(field_pch[3], &end_pch, 10);
+    if((end_pch == field_pch[3]) || ('\0' != *end_pch) || (0 > heartbeat_s32)
+        || (MAX_SECONDS < (unsigned long)heartbeat_s32))
+    {
+        return(false);
+    }
+
+    *index_pu8 = (uint8_t)index_s32;
+    policy_p->delta_f32 = delta_f32;
+    policy_p->minInterval_u32 = (uint32_t)minInterval_s32 * MILLISEC_IN_SEC;
+    policy_p->heartbeat_u32 = (uint32_t)heartbeat_s32 * MILLISEC_IN_SEC;
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Parses a configuration payload and configures the addressed policy of a
+ *              device
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     policies_pa     policies of the device values
+ * @param     count_u8        number of policies
+ * @param     payload         received configuration
+ * @return    true, if a policy was configured
+*//*-----------------------------------------------------------------------------------*/
+bool PublishPolicy::Apply_bol(PublishPolicy *policies_pa, uint8_t count_u8, 
+                                const MqttPayload &payload)
+{
+    publishPolicy_t policy_st;
+    uint8_t index_u8;
+
+    if(    (false == Parse_bol(payload, &index_u8, &policy_st)) 
+        || (index_u8 >= count_u8))
+    {
+        return(false);
+    }
+    policies_pa[index_u8].Configure(&policy_st);
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Saves all policies with their published values to the RTC user memory,
+ *              it is called right before the deep sleep
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     sleep_u32   deep sleep time in milliseconds, added to the age
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void PublishPolicy::SaveToRtc(uint32_t sleep_u32)
+{
+    rtcImage_t image_st;
+    const PublishPolicy *policy_p;
+    rtcPolicy_t *entry_p;
+    uint32_t now_u32 = millis();
+    uint8_t idx_u8;
+
+    memset(&image_st, 0, sizeof(image_st));
+    image_st.magic_u32 = RTC_MAGIC;
+    for(idx_u8 = 0; idx_u8 < PUBLISHPOLICY_RTC_SLOTS; idx_u8++)
+    {
+        policy_p = PublishPolicy::instances_pa[idx_u8];
+        if(NULL == policy_p)
+        {
+            continue;
+        }
+        entry_p = &image_st.policies_sta[idx_u8];
+        entry_p->delta_f32 = policy_p->policy_st.delta_f32;
+        entry_p->minInterval_u32 = policy_p->policy_st.minInterval_u32;
+        entry_p->heartbeat_u32 = policy_p->policy_st.heartbeat_u32;
+        entry_p->published_f32 = policy_p->published_f32;
+        entry_p->age_u32 = (now_u32 - policy_p->publishedTime_u32) + sleep_u32;
+        entry_p->flags_u32 = RTC_FLAG_USED
+                        | (policy_p->policy_st.relative_bol ? RTC_FLAG_RELATIVE : 0u)
+                        | (policy_p->published_bol ? RTC_FLAG_PUBLISHED : 0u);
+        image_st.count_u32++;
+    }
+    image_st.checksum_u32 = Checksum_u32(&image_st);
+    (void)ESP.rtcUserMemoryWrite(PUBLISHPOLICY_RTC_OFFSET, (uint32_t *)&image_st, 
+                                    sizeof(image_st));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Restores the policies saved before the deep sleep, it is called after the
+ *              devices are generated. The image is used only once.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    true, if a valid image of the same policies was restored
+*//*-----------------------------------------------------------------------------------*/
+bool PublishPolicy::RestoreFromRtc_bol(void)
+{
+    rtcImage_t image_st;
+    const rtcPolicy_t *entry_p;
+    PublishPolicy *policy_p;
+    uint32_t now_u32 = millis();
+    uint32_t invalid_u32 = 0u;
+    uint32_t count_u32 = 0u;
+    uint8_t idx_u8;
+
+    if(false == ESP.rtcUserMemoryRead(PUBLISHPOLICY_RTC_OFFSET, (uint32_t *)&image_st, 
+                                        sizeof(image_st)))
+    {
+        return(false);
+    }
+    if(    (RTC_MAGIC != image_st.magic_u32) 
+        || (Checksum_u32(&image_st) != image_st.checksum_u32))
+    {
+        return(false);
+    }
+    (void)ESP.rtcUserMemoryWrite(PUBLISHPOLICY_RTC_OFFSET, &invalid_u32, sizeof(invalid_u32));
+
+    // a different set of policies, e.g. after a capability change, is not restored
+    for(idx_u8 = 0; idx_u8 < PUBLISHPOLICY_RTC_SLOTS; idx_u8++)
+    {
+        if(    (NULL == PublishPolicy::instances_pa[idx_u8])
+            != (0u == (image_st.policies_sta[idx_u8].flags_u32 & RTC_FLAG_USED)))
+        {
+            return(false);
+        }
+        count_u32 += (NULL == PublishPolicy::instances_pa[idx_u8]) ? 0u : 1u;
+    }
+    if(count_u32 != image_st.count_u32)
+    {
+        return(false);
+    }
+
+    for(idx_u8 = 0; idx_u8 < PUBLISHPOLICY_RTC_SLOTS; idx_u8++)
+    {
+        policy_p = PublishPolicy::instances_pa[idx_u8];
+        if(NULL == policy_p)
+        {
+            continue;
+        }
+        entry_p = &image_st.policies_sta[idx_u8];
+        policy_p->policy_st.delta_f32 = entry_p->delta_f32;
+        policy_p->policy_st.relative_bol = (0u != (entry_p->flags_u32 & RTC_FLAG_RELATIVE));
+        policy_p->policy_st.minInterval_u32 = entry_p->minInterval_u32;
+        policy_p->policy_st.heartbeat_u32 = entry_p->heartbeat_u32;
+        policy_p->published_f32 = entry_p->published_f32;
+        policy_p->publishedTime_u32 = now_u32 - entry_p->age_u32;
+        policy_p->published_bol = (0u != (entry_p->flags_u32 & RTC_FLAG_PUBLISHED));
+    }
+    return(true);
+}
+
+/****************************************************************************************/
+/* Private functions: */
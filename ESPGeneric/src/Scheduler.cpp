@@ -0,0 +1,366 @@
+/*****************************************************************************************
+* FILENAME :        Scheduler.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the cooperative timer scheduler
+*
+* NOTES :
+*       Every active timer is linked into the wheel slot of its deadline tick.
+*       Process() only visits the slots of the ticks passed since the last call,
+*       at most one full wheel revolution. Timers of later revolutions share the
+*       slot and are skipped, because their deadline is not reached yet.
+*       The timer callbacks are executed in the context of Process() and may
+*       start or stop any timer.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <Arduino.h>
+#include "Scheduler.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define SLOT_MASK                   (SCHEDULER_SLOTS - 1u)
+#define TICK_MASK                   (0xFFFFFFFFu >> SCHEDULER_TICK_SHIFT)
+
+/****************************************************************************************/
+/* Local function like makros */
+// wraparound safe check if timestamp a is before timestamp b
+#define TIME_BEFORE(a, b)           ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+#define TIME_TO_SLOT(t)             (((uint32_t)(t) >> SCHEDULER_TICK_SHIFT) & SLOT_MASK)
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the scheduler
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+Scheduler::Scheduler()
+{
+    uint8_t idx_u8;
+
+    for(idx_u8 = 0; idx_u8 < SCHEDULER_SLOTS; idx_u8++)
+    {
+        this->slots_u8a[idx_u8] = SCHEDULER_INVALID;
+    }
+    for(idx_u8 = 0; idx_u8 < SCHEDULER_TIMERS; idx_u8++)
+    {
+        this->timers_sta[idx_u8].func_p = NULL;
+        this->timers_sta[idx_u8].context_p = NULL;
+        this->timers_sta[idx_u8].deadline_u32 = 0;
+        this->timers_sta[idx_u8].period_u32 = 0;
+        this->timers_sta[idx_u8].userId_u8 = 0;
+        this->timers_sta[idx_u8].list_u8 = SCHEDULER_INVALID;
+        this->timers_sta[idx_u8].next_u8 = SCHEDULER_INVALID;
+    }
+    this->size_u8 = 0;
+    this->lastTime_u32 = 0;
+    this->wakeup_bol = false;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Creates a stopped timer. Timers are never deleted, they shall be created
+ *              once during initialization.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     func_p        function called when the timer expires
+ * @param     context_p     context passed to the function, e.g. the device object
+ * @param     userId_u8     id passed to the function to identify the timer
+ * @return    timer handle or SCHEDULER_INVALID, if no timer is left
+*//*-----------------------------------------------------------------------------------*/
+uint8_t Scheduler::Create_u8(schedulerFunc_t func_p, void *context_p, uint8_t userId_u8)
+{
+    schedulerTimer_t *timer_p;
+
+    if((NULL == func_p) || (SCHEDULER_TIMERS <= this->size_u8))
+    {
+        return(SCHEDULER_INVALID);
+    }
+    timer_p = &this->timers_sta[this->size_u8];
+    timer_p->func_p = func_p;
+    timer_p->context_p = context_p;
+    timer_p->userId_u8 = userId_u8;
+    timer_p->list_u8 = SCHEDULER_INVALID;
+    timer_p->next_u8 = SCHEDULER_INVALID;
+    this->size_u8++;
+    return(this->size_u8 - 1u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Starts or restarts a timer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timer_u8      timer handle from Create_u8
+ * @param     now_u32       actual time in milliseconds
+ * @param     delay_u32     time until the first expiry in milliseconds, 0 expires at 
+ *                          the next Process call
+ * @param     period_u32    period in milliseconds for periodic timers, 0 for one shot
+ * @return    true, if the timer was started
+*//*-----------------------------------------------------------------------------------*/
+bool Scheduler::Start(uint8_t timer_u8, uint32_t now_u32, uint32_t delay_u32, 
+                        uint32_t period_u32)
+{
+    if(timer_u8 >= this->size_u8)
+    {
+        return(false);
+    }
+    this->Unlink(timer_u8);
+    this->timers_sta[timer_u8].deadline_u32 = now_u32 + delay_u32;
+    this->timers_sta[timer_u8].period_u32 = period_u32;
+    this->Link(timer_u8);
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Stops a timer, stopping a stopped timer has no effect
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timer_u8      timer handle from Create_u8
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Scheduler::Stop(uint8_t timer_u8)
+{
+    if(timer_u8 < this->size_u8)
+    {
+        this->Unlink(timer_u8);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Checks if a timer is running
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timer_u8      timer handle from Create_u8
+ * @return    true, if the timer is started and not yet expired or periodic
+*//*-----------------------------------------------------------------------------------*/
+bool Scheduler::IsActive_bol(uint8_t timer_u8) const
+{
+    return((timer_u8 < this->size_u8) 
+            && (SCHEDULER_INVALID != this->timers_sta[timer_u8].list_u8));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Executes all expired timers, has to be called cyclic from the main loop
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     now_u32       actual time in milliseconds
+ * @return    number of executed timers
+*//*-----------------------------------------------------------------------------------*/
+uint8_t Scheduler::Process_u8(uint32_t now_u32)
+{
+    uint32_t ticks_u32;
+    uint8_t slot_u8;
+    uint8_t idx_u8;
+    uint8_t next_u8;
+    uint8_t fired_u8 = 0;
+    schedulerTimer_t *timer_p;
+
+    // visit every slot passed since the last call, at most one revolution
+    ticks_u32 = ((now_u32 >> SCHEDULER_TICK_SHIFT) 
+                    - (this->lastTime_u32 >> SCHEDULER_TICK_SHIFT)) & TICK_MASK;
+    if(ticks_u32 >= SCHEDULER_SLOTS)
+    {
+        ticks_u32 = SCHEDULER_SLOTS - 1u;
+    }
+    slot_u8 = (uint8_t)TIME_TO_SLOT(this->lastTime_u32);
+    this->lastTime_u32 = now_u32;
+
+    do
+    {
+        idx_u8 = this->slots_u8a[slot_u8];
+        while(SCHEDULER_INVALID != idx_u8)
+        {
+            timer_p = &this->timers_sta[idx_u8];
+            next_u8 = timer_p->next_u8;
+            if(false == TIME_BEFORE(now_u32, timer_p->deadline_u32))
+            {
+                this->Unlink(idx_u8);
+                if(0 != timer_p->period_u32)
+                {
+                    // skip missed periods instead of firing them as burst
+                    if(TIME_BEFORE(now_u32, timer_p->deadline_u32 + timer_p->period_u32))
+                    {
+                        timer_p->deadline_u32 += timer_p->period_u32;
+                    }
+                    else
+                    {
+                        timer_p->deadline_u32 = now_u32 + timer_p->period_u32;
+                    }
+                    this->Link(idx_u8);
+                }
+                timer_p->func_p(timer_p->context_p, timer_p->userId_u8);
+                fired_u8++;
+                // the callback may have stopped the next timer, restart the slot
+                if((SCHEDULER_INVALID != next_u8) 
+                    && (slot_u8 != this->timers_sta[next_u8].list_u8))
+                {
+                    next_u8 = this->slots_u8a[slot_u8];
+                }
+            }
+            idx_u8 = next_u8;
+        }
+        slot_u8 = (slot_u8 + 1u) & SLOT_MASK;
+    }while(0 != ticks_u32--);
+
+    return(fired_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Calculates the time the main loop may sleep until the next timer expires
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     now_u32       actual time in milliseconds
+ * @param     maxIdle_u32   upper limit of the returned time
+ * @return    idle time in milliseconds, 0 if a timer is expired or a wakeup is pending
+*//*-----------------------------------------------------------------------------------*/
+uint32_t Scheduler::GetIdleTime_u32(uint32_t now_u32, uint32_t maxIdle_u32) const
+{
+    uint32_t idle_u32 = maxIdle_u32;
+    uint8_t idx_u8;
+
+    if(true == this->wakeup_bol)
+    {
+        return(0);
+    }
+    for(idx_u8 = 0; idx_u8 < this->size_u8; idx_u8++)
+    {
+        const schedulerTimer_t *timer_p = &this->timers_sta[idx_u8];
+
+        if(SCHEDULER_INVALID != timer_p->list_u8)
+        {
+            if(false == TIME_BEFORE(now_u32, timer_p->deadline_u32))
+            {
+                return(0);
+            }
+            else if((timer_p->deadline_u32 - now_u32) < idle_u32)
+            {
+                idle_u32 = timer_p->deadline_u32 - now_u32;
+            }
+        }
+    }
+    return(idle_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of created timers
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of timers
+*//*-----------------------------------------------------------------------------------*/
+uint8_t Scheduler::GetSize_u8(void) const
+{
+    return(this->size_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Ends the idle time of the main loop, can be called from interrupt context
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void Scheduler::Wakeup(void)
+{
+    this->wakeup_bol = true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Returns and clears the wakeup request
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    true, if Wakeup was called since the last call
+*//*-----------------------------------------------------------------------------------*/
+bool Scheduler::TakeWakeup_bol(void)
+{
+    bool ret_bol = this->wakeup_bol;
+
+    this->wakeup_bol = false;
+    return(ret_bol);
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Links a timer into the wheel slot of its deadline. Deadlines before the
+ *              last processed time are linked into the slot of the last processed time.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timer_u8      timer handle
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Scheduler::Link(uint8_t timer_u8)
+{
+    schedulerTimer_t *timer_p = &this->timers_sta[timer_u8];
+    uint8_t slot_u8;
+
+    if(TIME_BEFORE(timer_p->deadline_u32, this->lastTime_u32))
+    {
+        slot_u8 = (uint8_t)TIME_TO_SLOT(this->lastTime_u32);
+    }
+    else
+    {
+        slot_u8 = (uint8_t)TIME_TO_SLOT(timer_p->deadline_u32);
+    }
+    timer_p->list_u8 = slot_u8;
+    timer_p->next_u8 = this->slots_u8a[slot_u8];
+    this->slots_u8a[slot_u8] = timer_u8;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Removes a timer from its wheel slot
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timer_u8      timer handle
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Scheduler::Unlink(uint8_t timer_u8)
+{
+    uint8_t slot_u8 = this->timers_sta[timer_u8].list_u8;
+    uint8_t *link_pu8;
+
+    if(SCHEDULER_INVALID == slot_u8)
+    {
+        return;
+    }
+    link_pu8 = &this->slots_u8a[slot_u8];
+    while(SCHEDULER_INVALID != *link_pu8)
+    {
+        if(timer_u8 == *link_pu8)
+        {
+            *link_pu8 = this->timers_sta[timer_u8].next_u8;
+            break;
+        }
+        link_pu8 = &this->timers_sta[*link_pu8].next_u8;
+    }
+    this->timers_sta[timer_u8].list_u8 = SCHEDULER_INVALID;
+    this->timers_sta[timer_u8].next_u8 = SCHEDULER_INVALID;
+}
@@ -46,11 +46,32 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MICROSEC_IN_SEC           1000000l // microseconds in seconds
 #define MILLISEC_IN_SEC           1000l // milliseconds in seconds
 #define WARM_UP_TIME              500   // wait 500 milliseconds
+#define SAMPLE_POLL_TIME          20    // check for the served adc burst every 20 ms
 
 #define MQTT_PUB_MOISTURE         "/s/sen0193/moisture" // moisture data
 #define MQTT_PUB_LEVEL            "/s/sen0193/level" // moisture level data
 #define MQTT_PUB_STATUS           "/s/temp_hum/stat" // status of sensor
+#define MQTT_SUB_POLICY           "/r/sen0193/policy" // publish policy of the moisture
 #define MQTT_REPORT_INTERVAL      (30l * MILLISEC_IN_SEC) // 30 seconds between reports
+
+#define TOPIC_MOISTURE            0u
+#define TOPIC_LEVEL               1u
+#define TOPIC_STATUS              2u
+#define TOPIC_POLICY              3u
+
+#define HANDLER_POLICY            0u
+
+#define TIMER_REPORT              0u
+#define TIMER_SAMPLE              1u
+
+// ADC burst of 8 conversions, median against WiFi spikes, no averaging over the bursts
+#define ADC_BURST                 8u
+#define ADC_EMA_SHIFT             0u
+
+// moisture published on a change of 2 %, at least every 30 minutes
+#define POLICY_DELTA              2.0F
+#define POLICY_MIN_INTERVAL       0ul
+#define POLICY_HEARTBEAT          (30ul * 60ul * MILLISEC_IN_SEC)
 /*#define MQTT_PUB_PAY_STATUS_OK    "OK"
 #define MQTT_PUB_PAY_STATUS_ERR   "ERR"
 #define MQTT_PUB_PAY_LEVEL_LOW    "LOW"
@@ -90,6 +111,12 @@ Sen0193::Sen0193(Trace *p_trace) : MqttDevice(p_trace)
     this->status_chrp           = MQTT_PUB_PAY_STATUS_ERR;
     this->reportCycleMSec_u32   = MQTT_REPORT_INTERVAL;
     this->mode_u8               = 0;
+    this->reportRequest_bol     = false;
+    this->sampleRequest_bol     = false;
+    this->sampling_bol          = false;
+    this->adcId_u8              = ADCSAMPLER_INVALID;
+    this->lastLevel_u8          = 0xFFu;
+    this->lastStatus_chrp       = NULL;
 }
 
 /**---------------------------------------------------------------------------------------
@@ -149,9 +176,28 @@ Sen0193::~Sen0193()
 *//*-----------------------------------------------------------------------------------*/
 void Sen0193::Initialize()
 {
-    p_trace->println(trace_INFO_MSG, "<<sen0193>> initialize");
+    const adcConfig_t adcConfig_st = {ADC_BURST, ADCSAMPLER_MEDIAN, ADC_EMA_SHIFT};
+    const publishPolicy_t policyDefault_st = {POLICY_DELTA, false, POLICY_MIN_INTERVAL, 
+                                            POLICY_HEARTBEAT};
+
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<sen0193>> initialize"));
+    this->policy_st.Configure(&policyDefault_st);
+    if((ADCSAMPLER_INVALID == this->adcId_u8) && (NULL != MqttDevice::adc_p))
+    {
+        this->adcId_u8 = MqttDevice::adc_p->Register_u8(&adcConfig_st);
+        if(ADCSAMPLER_INVALID == this->adcId_u8)
+        {
+            TRACE_WARN(p_trace->println(trace_WARN_MSG, 
+                        "<<sen0193>> no adc consumer left, reading single samples"));
+        }
+    }
     this->PowerOff();
     this->SetMoistureLevelPins();   
+    // first report right after the connection, then every report cycle
+    this->reportRequest_bol = false;
+    this->sampleRequest_bol = false;
+    this->sampling_bol = false;
+    this->StartTimer(TIMER_REPORT, 0, this->reportCycleMSec_u32);
     this->isInitialized_bol = true;
 }
 
@@ -169,32 +215,50 @@ void Sen0193::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "<<sen0193>> connected");
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_MOISTURE, build_topic(MQTT_PUB_MOISTURE));
+        this->CacheTopic(TOPIC_LEVEL, build_topic(MQTT_PUB_LEVEL));
+        this->CacheTopic(TOPIC_STATUS, build_topic(MQTT_PUB_STATUS));
+        this->CacheTopic(TOPIC_POLICY, build_topic(MQTT_SUB_POLICY));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<sen0193>> connected"));
+        // ... and resubscribe the retained publish policy
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_POLICY));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_POLICY), HANDLER_POLICY);
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, 
-                    "<<sen0193>> uninizialized MQTT client in single relay detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                    "<<sen0193>> uninizialized MQTT client in single relay detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void Sen0193::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void Sen0193::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                           char* p_topic, const MqttPayload &payload)
 {
     if(true != this->isConnected_bol)
     {
-        p_trace->println(trace_ERROR_MSG, 
-                                "<<sen0193>> connection failure in DHT CallbackMqtt "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                                "<<sen0193>> connection failure in DHT CallbackMqtt ")); 
+    }
+    else if(HANDLER_POLICY == handlerId_u8)
+    {
+        if(false == PublishPolicy::Apply_bol(&this->policy_st, 1u, payload))
+        {
+            TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "<<sen0193>> invalid policy: ")); 
+            TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
+        }
     }
 }
 
@@ -207,63 +271,66 @@ void Sen0193::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload
 *//*-----------------------------------------------------------------------------------*/
 bool Sen0193::ProcessPublishRequests(PubSubClient *client)
 {
-    String tPayload;
     boolean ret = false;
 
-    if(this->prevTime_u32 + this->reportCycleMSec_u32 < millis() || this->prevTime_u32 == 0)
+    if(true == this->reportRequest_bol)
     {      
-        // the moisture and moisture level publication is time interval based
+        // the measurement is time interval based, the publication change based
+        this->reportRequest_bol = false;
         if(true == this->isConnected_bol)
         {
-            p_trace->println(trace_INFO_MSG, "<<sen0193>> processes publish request");
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, 
+                            "<<sen0193>> processes publish request"));
             this->prevTime_u32 = millis();
-            p_trace->println(trace_INFO_MSG, "<<sen0193>> reading moisture");
-
-            this->ReadData();
-            
-            this->ProcessMoisture();
-
-            this->SetMoistureLevelPins();
-            
-            // Check if any reads failed and exit
-            if (isnan(this->moisture_f32)) 
-            {
-                p_trace->println(trace_ERROR_MSG, "<<sen0193>> Failed to read from sensor!");
-            }
-            else
-            {      
-                p_trace->print(trace_INFO_MSG, "<<sen0193>> publish moisture: ");
-                p_trace->print(trace_PURE_MSG, MQTT_PUB_MOISTURE);
-                p_trace->print(trace_PURE_MSG, "  :  ");
-                ret = client->publish(build_topic(MQTT_PUB_MOISTURE), 
-                                        f2s(this->moisture_f32, 2), true);
-                p_trace->println(trace_PURE_MSG, f2s(this->moisture_f32, 2));
-                
-                p_trace->print(trace_INFO_MSG, "<<sen0193>> publish level: ");
-                p_trace->print(trace_PURE_MSG, MQTT_PUB_LEVEL);
-                p_trace->print(trace_PURE_MSG, "  :  ");
-                ret = client->publish(build_topic(MQTT_PUB_LEVEL), 
-                                        this->level_chrp, true);
-                p_trace->println(trace_PURE_MSG, this->level_chrp);  
-
-                p_trace->print(trace_INFO_MSG, "<<sen0193>> publish status: ");
-                p_trace->print(trace_PURE_MSG, MQTT_PUB_STATUS);
-                p_trace->print(trace_PURE_MSG, "  :  ");
-                ret = client->publish(build_topic(MQTT_PUB_STATUS), 
-                                        this->status_chrp, true);
-                p_trace->println(trace_PURE_MSG, this->level_chrp);
-            }
+            // warm up without blocking the loop, the sample timer continues
+            this->PowerOn();
+            this->sampling_bol = false;
+            this->StartTimer(TIMER_SAMPLE, WARM_UP_TIME, 0);
         } 
         else
         {
-            p_trace->println(trace_ERROR_MSG, 
-                    "<<sen0193>> connection failure in dht ProcessPublishRequests "); 
+            TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                    "<<sen0193>> connection failure in dht ProcessPublishRequests ")); 
+        }
+    }
+
+    if(true == this->sampleRequest_bol)
+    {
+        this->sampleRequest_bol = false;
+        if(true == this->ReadData())
+        {
+            this->PowerOff();
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<sen0193>> raw data: "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, this->rawData_u16));
+            this->ProcessMoisture();
+            this->SetMoistureLevelPins();
+            ret = this->PublishData(client);
         }
     }
 
     return ret;  
 }
 
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for the expired device timers, the report timer starts the next
+ *              measurement, the sample timer continues it
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Sen0193::ProcessTimer(uint8_t timerId_u8)
+{
+    if(TIMER_REPORT == timerId_u8)
+    {
+        this->reportRequest_bol = true;
+    }
+    else if(TIMER_SAMPLE == timerId_u8)
+    {
+        this->sampleRequest_bol = true;
+    }
+}
+
 /****************************************************************************************/
 /* Private functions: */
 
@@ -273,19 +340,19 @@ bool Sen0193::ProcessPublishRequests(PubSubClient *client)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* Sen0193::build_topic(const char *topic) 
 {
   if(0 == this->moistureId_u8)
   {
-      sprintf(buffer_ca, "std/%s%s", this->dev_p, topic);
+      sprintf(buildBuffer_ca, "std/%s%s", this->dev_p, topic);
   }
   else
   {
-      sprintf(buffer_ca, "std/%s%s%d", this->dev_p, topic, this->moistureId_u8);  
+      sprintf(buildBuffer_ca, "std/%s%s%d", this->dev_p, topic, this->moistureId_u8);  
   }
-  return buffer_ca;
+  return buildBuffer_ca;
 }
 
 /****************************************************************************************/
@@ -328,8 +395,7 @@ void Sen0193::PowerOn()
     if(NULL != pwrPin_p)
     {
         this->pwrPin_p->DigitalWrite(HIGH);
-        p_trace->println(trace_INFO_MSG, "<<dht>>dht turned on");
-        delay(WARM_UP_TIME);
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<sen0193>> turned on"));
     } 
 }
 
@@ -344,26 +410,92 @@ void Sen0193::PowerOff()
     if(NULL != this->pwrPin_p)
     {
         this->pwrPin_p->DigitalWrite(LOW);
-        p_trace->println(trace_INFO_MSG, "<<sen0193>> turned off");
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<sen0193>> turned off"));
     }
 }
 
 /**--------------------------------------------------------------------------------------
- * @brief     This function reads the internal adc channel.
+ * @brief     This function reads the internal adc channel. The first call after the 
+ *              warm up requests a burst from the sampler, the following calls take it.
+ *              Without sampler a single conversion is used.
  * @author    S. Wink
  * @date      04 Jul 2018
- * @return    n/a
+ * @return    true, if the raw data of the measurement is available
 *//*-----------------------------------------------------------------------------------*/
-void Sen0193::ReadData(void) 
+bool Sen0193::ReadData(void) 
 {
-    // power sensor device (warm up needs to be handled in the power up function)
-    this->PowerOn();
-    // read the internal ADC
-    this->rawData_u16 = analogRead(DEFAULT_DATAPIN);
-    // power down the sensor
-    this->PowerOff();
-    p_trace->print(trace_INFO_MSG, "<<sen0193>> raw data: ");
-    p_trace->println(trace_PURE_MSG, this->rawData_u16);
+    if(ADCSAMPLER_INVALID == this->adcId_u8)
+    {
+        this->rawData_u16 = analogRead(DEFAULT_DATAPIN);
+        return(true);
+    }
+
+    if(false == this->sampling_bol)
+    {
+        this->sampling_bol = MqttDevice::adc_p->Request_bol(this->adcId_u8);
+    }
+    else if(true == MqttDevice::adc_p->Take_bol(this->adcId_u8, &this->rawData_u16))
+    {
+        this->sampling_bol = false;
+        return(true);
+    }
+    // burst not yet served
+    this->StartTimer(TIMER_SAMPLE, SAMPLE_POLL_TIME, 0);
+    return(false);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     This function publishes the data to the broker, if the publish policy of 
+ *              the moisture requests it or the level or status changed
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     client     mqtt client object
+ * @return    true if transmission was successful
+*//*-----------------------------------------------------------------------------------*/
+bool Sen0193::PublishData(PubSubClient *client)
+{
+    boolean ret = true;
+
+    // Check if any reads failed and exit
+    if (isnan(this->moisture_f32)) 
+    {
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<sen0193>> Failed to read from sensor!"));
+        return(false);
+    }
+
+    if(    (this->level_u8 == this->lastLevel_u8) 
+        && (this->status_chrp == this->lastStatus_chrp)
+        && (false == this->policy_st.IsDue_bol(this->moisture_f32, millis())))
+    {
+        return(ret);
+    }
+    this->lastLevel_u8 = this->level_u8;
+    this->lastStatus_chrp = this->status_chrp;
+    this->policy_st.SetPublished(this->moisture_f32, millis());
+
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<sen0193>> publish moisture: "));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, MQTT_PUB_MOISTURE));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+    ret = Publish_bol(client, GetTopic_ccp(TOPIC_MOISTURE), 
+                            f2s(this->moisture_f32, 2), true);
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, f2s(this->moisture_f32, 2)));
+    
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<sen0193>> publish level: "));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, MQTT_PUB_LEVEL));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+    ret = Publish_bol(client, GetTopic_ccp(TOPIC_LEVEL), 
+                            this->level_chrp, true);
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, this->level_chrp));  
+
+    TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<sen0193>> publish status: "));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, MQTT_PUB_STATUS));
+    TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+    ret = Publish_bol(client, GetTopic_ccp(TOPIC_STATUS), 
+                            this->status_chrp, true);
+    TRACE_INFO(p_trace->println(trace_PURE_MSG, this->level_chrp));
+
+    return(ret);
 }
 
 /**--------------------------------------------------------------------------------------
@@ -398,27 +530,27 @@ void Sen0193::ProcessMoisture(void)
         this->moisture_f32 = this->moisture_f32 * 100.0F;
         this->moisture_f32 = 100.0F - this->moisture_f32;
 
-        p_trace->print(trace_INFO_MSG, "<<sen0193>> moisture processed: ");
-        p_trace->println(trace_PURE_MSG, (uint16_t)(this->moisture_f32));
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<sen0193>> moisture processed: "));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, (uint16_t)(this->moisture_f32)));
     
         // calculate moisture level for dry/low = 0, med wet = 1 and wet = 2
         if(this->rawData_u16 < this->highLevel_u16c)  // 500
         {
             this->level_u8 = 2U;
             this->level_chrp = MQTT_PUB_PAY_LEVEL_HIGH;
-            p_trace->println(trace_INFO_MSG, "<<sen0193>> moisture level high");
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<sen0193>> moisture level high"));
         }     
         else if(this->rawData_u16 < this->medLevel_u16c)  // 650
         {
             this->level_u8 = 1U;
             this->level_chrp = MQTT_PUB_PAY_LEVEL_MED;
-            p_trace->println(trace_INFO_MSG, "<<sen0193>> moisture level medium");
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<sen0193>> moisture level medium"));
         }
         else
         {
             this->level_u8 = 0U;
             this->level_chrp = MQTT_PUB_PAY_LEVEL_LOW;
-            p_trace->println(trace_INFO_MSG, "<<sen0193>> moisture level low");
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<sen0193>> moisture level low"));
         }    
     }
 }
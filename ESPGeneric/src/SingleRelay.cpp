@@ -48,6 +48,13 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PAYLOAD_CMD_ON       "ON"
 #define MQTT_PAYLOAD_CMD_OFF      "OFF"
 
+#define HANDLER_TOGGLE            0u
+#define HANDLER_BUTTON            1u
+
+#define TOPIC_TOGGLE              0u
+#define TOPIC_BUTTON              1u
+#define TOPIC_LIGHT_STATE         2u
+
 /****************************************************************************************/
 /* Local function like makros */
 
@@ -99,7 +106,7 @@ SingleRelay::~SingleRelay()
 void SingleRelay::Initialize()
 {
     this->isInitialized_bol = true;
-    p_trace->println(trace_INFO_MSG, "<<singRel>>Single relay initialized");
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<singRel>>Single relay initialized"));
     //pinMode(this->pin_u8, OUTPUT);
     //this->setRelay();
     this->TurnRelayOff();
@@ -119,77 +126,84 @@ void SingleRelay::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "<<singRel>>Single relay reconnected");
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<singRel>>Single relay reconnected"));
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_TOGGLE, BuildReceiveTopic(MQTT_SUB_TOGGLE));
+        this->CacheTopic(TOPIC_BUTTON, BuildReceiveTopic(MQTT_SUB_BUTTON));
+        this->CacheTopic(TOPIC_LIGHT_STATE, BuildSendTopic(MQTT_PUB_LIGHT_STATE));
         // ... and resubscribe
         // toggle relay
-        client_p->subscribe(BuildReceiveTopic(MQTT_SUB_TOGGLE));  
-        client_p->loop();
-        p_trace->print(trace_INFO_MSG, "<<singRel>> subscribed 1: ");
-        p_trace->println(trace_PURE_MSG, BuildReceiveTopic(MQTT_SUB_TOGGLE));
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_TOGGLE));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_TOGGLE), HANDLER_TOGGLE);
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<singRel>> subscribed 1: "));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, GetTopic_ccp(TOPIC_TOGGLE)));
         // change relay state with payload
-        client_p->subscribe(BuildReceiveTopic(MQTT_SUB_BUTTON));  
-        client_p->loop();
-        p_trace->print(trace_INFO_MSG, "<<singRel>> subscribed 2: ");
-        p_trace->println(trace_PURE_MSG, BuildReceiveTopic(MQTT_SUB_BUTTON));
-        client_p->loop();
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_BUTTON));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_BUTTON), HANDLER_BUTTON);
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<singRel>> subscribed 2: "));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, GetTopic_ccp(TOPIC_BUTTON)));
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, 
-                         "<<singRel>>uninizialized MQTT client in single relay detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                         "<<singRel>>uninizialized MQTT client in single relay detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void SingleRelay::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void SingleRelay::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                               char* p_topic, const MqttPayload &payload)
 {
     if(true == this->isConnected_bol)
     {
         // received toggle relay mqtt topic
-        if (String(BuildReceiveTopic(MQTT_SUB_TOGGLE)).equals(p_topic)) 
+        if (HANDLER_TOGGLE == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, "<<singRel>>mqtt callback: ");
-            p_trace->println(trace_PURE_MSG, p_topic);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<singRel>>mqtt callback: "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, p_topic));
             this->ToggleRelay();
         }
         // execute command to switch on/off the relay
-        else if (String(BuildReceiveTopic(MQTT_SUB_BUTTON)).equals(p_topic)) 
+        else if (HANDLER_BUTTON == handlerId_u8) 
         {
-            p_trace->print(trace_INFO_MSG, "<<singRel>>mqtt callback: ");
-            p_trace->print(trace_PURE_MSG, p_topic);
-            p_trace->print(trace_PURE_MSG, " : ");
-            p_trace->println(trace_PURE_MSG, p_payload);
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<singRel>>mqtt callback: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, p_topic));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, " : "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, payload));
             // test if the payload is equal to "ON" or "OFF"
-            if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_ON))) 
+            if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_ON)) 
             {
                 this->relayState_bol = true;
                 this->SetRelay();  
             }
-            else if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_OFF)))
+            else if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_OFF))
             {
                 this->relayState_bol = false;
                 this->SetRelay();
             }
             else
             {
-                p_trace->print(trace_ERROR_MSG, "<<singRel>> unexpected payload: "); 
-                p_trace->println(trace_PURE_MSG, p_payload);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, 
+                                "<<singRel>> unexpected payload: ")); 
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
             }   
         } 
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, "<<singRel>>connection failure in sonoff CallbackMqtt "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "<<singRel>>connection failure in sonoff CallbackMqtt ")); 
     }
 }
 
@@ -210,20 +224,20 @@ bool SingleRelay::ProcessPublishRequests(PubSubClient *client)
         // check if state has changed, than publish this state
         if(true == publishState_bol)
         {
-            p_trace->print(trace_INFO_MSG, "<<singRel>> publish requested state: ");
-            p_trace->print(trace_PURE_MSG, BuildSendTopic(MQTT_PUB_LIGHT_STATE));
-            p_trace->print(trace_PURE_MSG, "  :  ");
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<singRel>> publish requested state: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, GetTopic_ccp(TOPIC_LIGHT_STATE)));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
             if(true == this->relayState_bol)
             {
-              ret = client->publish(BuildSendTopic(MQTT_PUB_LIGHT_STATE), 
-                                        MQTT_PAYLOAD_CMD_ON, true);
-              p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_CMD_ON);
+              ret = Publish_bol(client, GetTopic_ccp(TOPIC_LIGHT_STATE), 
+                                        MQTT_PAYLOAD_CMD_ON, MQTTDEVICE_QOS_1, true);
+              TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_CMD_ON));
             }
             else
             {
-                ret = client->publish(BuildSendTopic(MQTT_PUB_LIGHT_STATE), 
-                                          MQTT_PAYLOAD_CMD_OFF, true); 
-                p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_CMD_OFF); 
+                ret = Publish_bol(client, GetTopic_ccp(TOPIC_LIGHT_STATE), 
+                                          MQTT_PAYLOAD_CMD_OFF, MQTTDEVICE_QOS_1, true); 
+                TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_CMD_OFF)); 
             } 
             if(ret)
             {
@@ -233,8 +247,8 @@ bool SingleRelay::ProcessPublishRequests(PubSubClient *client)
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, 
-                              "connection failure in relay ProcessPublishRequests "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                              "connection failure in relay ProcessPublishRequests ")); 
     }
     return ret; 
 };
@@ -278,7 +292,7 @@ void SingleRelay::TurnRelayOff(void)
       {
         gpio_p->DigitalWrite(LOW);
       }     
-      p_trace->println(trace_INFO_MSG, "<<singRel>>relay turned off");
+      TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<singRel>>relay turned off"));
       this->publishState_bol = true;
   }
 }
@@ -302,7 +316,7 @@ void SingleRelay::TurnRelayOn(void)
       {
         gpio_p->DigitalWrite(HIGH);
       }
-      p_trace->println(trace_INFO_MSG, "<<singRel>>relay turned on");
+      TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<singRel>>relay turned on"));
       this->publishState_bol = true;
   }
 }
@@ -332,12 +346,12 @@ void SingleRelay::SetRelay(void)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* SingleRelay::BuildSendTopic(const char *topic) 
 {
-  sprintf(buffer_ca, "std/%s/s/%s/%s", this->dev_p, this->channel_p, topic);
-  return buffer_ca;
+  sprintf(buildBuffer_ca, "std/%s/s/%s/%s", this->dev_p, this->channel_p, topic);
+  return buildBuffer_ca;
 }
 
 /**---------------------------------------------------------------------------------------
@@ -346,11 +360,11 @@ char* SingleRelay::BuildSendTopic(const char *topic)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* SingleRelay::BuildReceiveTopic(const char *topic) 
 {
-  sprintf(buffer_ca, "std/%s/r/%s/%s", this->dev_p, this->channel_p, topic);
-  return buffer_ca;
+  sprintf(buildBuffer_ca, "std/%s/r/%s/%s", this->dev_p, this->channel_p, topic);
+  return buildBuffer_ca;
 }
 
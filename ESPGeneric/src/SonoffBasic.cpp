@@ -50,6 +50,13 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #define MQTT_PAYLOAD_CMD_ON       "ON"
 #define MQTT_PAYLOAD_CMD_OFF      "OFF"
 
+#define HANDLER_TOGGLE            0u
+#define HANDLER_BUTTON            1u
+
+#define TOPIC_TOGGLE              0u
+#define TOPIC_BUTTON              1u
+#define TOPIC_LIGHT_STATE         2u
+
 #define BUTTON_TIMEOUT            1500  // max 1500ms timeout between each button press to count up (start of config)
 #define BUTTON_DEBOUNCE           400  // ms debouncing for the botton
 
@@ -117,7 +124,7 @@ SonoffBasic::~SonoffBasic()
 *//*-----------------------------------------------------------------------------------*/
 void SonoffBasic::Initialize()
 {
-    p_trace->println(trace_INFO_MSG, "Single relay initialized");
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "Single relay initialized"));
     
     pinMode(RELAY_PIN, OUTPUT);
     if(LED_PIN_UNUSED != this->ledPin_u8)
@@ -148,77 +155,83 @@ void SonoffBasic::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "Single relay reconnected");
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_TOGGLE, build_topic(MQTT_SUB_TOGGLE));
+        this->CacheTopic(TOPIC_BUTTON, build_topic(MQTT_SUB_BUTTON));
+        this->CacheTopic(TOPIC_LIGHT_STATE, build_topic(MQTT_PUB_LIGHT_STATE));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "Single relay reconnected"));
         // ... and resubscribe
         // toggle relay
-        client_p->subscribe(build_topic(MQTT_SUB_TOGGLE));  
-        client_p->loop();
-        p_trace->print(trace_INFO_MSG, "<<mqtt>> subscribed 1: ");
-        p_trace->println(trace_PURE_MSG, MQTT_SUB_TOGGLE);
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_TOGGLE));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_TOGGLE), HANDLER_TOGGLE);
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<mqtt>> subscribed 1: "));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_SUB_TOGGLE));
         // change relay state with payload
-        client_p->subscribe(build_topic(MQTT_SUB_BUTTON));  
-        client_p->loop();
-        p_trace->print(trace_INFO_MSG, "<<mqtt>> subscribed 2: ");
-        p_trace->println(trace_PURE_MSG, MQTT_SUB_BUTTON);
-        client_p->loop();
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_BUTTON));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_BUTTON), HANDLER_BUTTON);
+        TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<mqtt>> subscribed 2: "));
+        TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_SUB_BUTTON));
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, 
-                                "uninizialized MQTT client in single relay detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                                "uninizialized MQTT client in single relay detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void SonoffBasic::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void SonoffBasic::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                               char* p_topic, const MqttPayload &payload)
 {
     if(true == this->isConnected_bol)
     {
         // received toggle relay mqtt topic
-        if (String(build_topic(MQTT_SUB_TOGGLE)).equals(p_topic)) 
+        if (HANDLER_TOGGLE == handlerId_u8) 
         {
-            p_trace->println(trace_INFO_MSG, "Single relay mqtt callback");
-            p_trace->println(trace_INFO_MSG, p_topic);
-            p_trace->println(trace_INFO_MSG, p_payload);
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, "Single relay mqtt callback"));
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, p_topic));
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, payload));
             this->ToggleRelay();
         }
         // execute command to switch on/off the relay
-        else if (String(build_topic(MQTT_SUB_BUTTON)).equals(p_topic)) 
+        else if (HANDLER_BUTTON == handlerId_u8) 
         {
-            p_trace->println(trace_INFO_MSG, "Single relay mqtt callback");
-            p_trace->println(trace_INFO_MSG, p_topic);
-            p_trace->println(trace_INFO_MSG, p_payload);
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, "Single relay mqtt callback"));
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, p_topic));
+            TRACE_INFO(p_trace->println(trace_INFO_MSG, payload));
             // test if the payload is equal to "ON" or "OFF"
-            if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_ON))) 
+            if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_ON)) 
             {
                 this->relayState_bol = true;
                 this->setRelay();  
             }
-            else if(0 == p_payload.indexOf(String(MQTT_PAYLOAD_CMD_OFF)))
+            else if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_OFF))
             {
                 this->relayState_bol = false;
                 this->setRelay();
             }
             else
             {
-                p_trace->print(trace_ERROR_MSG, "<<mqtt>> unexpected payload: "); 
-                p_trace->println(trace_PURE_MSG, p_payload);
+                TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "<<mqtt>> unexpected payload: ")); 
+                TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
             }   
         } 
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, "connection failure in sonoff CallbackMqtt "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                        "connection failure in sonoff CallbackMqtt ")); 
     }
 }
 
@@ -239,20 +252,20 @@ bool SonoffBasic::ProcessPublishRequests(PubSubClient *client)
         // check if state has changed, than publish this state
         if(true == publishState_bol)
         {
-            p_trace->print(trace_INFO_MSG, "<<mqtt>> publish requested state: ");
-            p_trace->print(trace_PURE_MSG, MQTT_PUB_LIGHT_STATE);
-            p_trace->print(trace_PURE_MSG, "  :  ");
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<mqtt>> publish requested state: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, MQTT_PUB_LIGHT_STATE));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
             if(true == this->relayState_bol)
             {
-              ret = client->publish(build_topic(MQTT_PUB_LIGHT_STATE), 
-                                        MQTT_PAYLOAD_CMD_ON, true);
-              p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_CMD_ON);
+              ret = Publish_bol(client, GetTopic_ccp(TOPIC_LIGHT_STATE), 
+                                        MQTT_PAYLOAD_CMD_ON, MQTTDEVICE_QOS_1, true);
+              TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_CMD_ON));
             }
             else
             {
-                ret = client->publish(build_topic(MQTT_PUB_LIGHT_STATE), 
-                                          MQTT_PAYLOAD_CMD_OFF, true); 
-                p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_CMD_OFF); 
+                ret = Publish_bol(client, GetTopic_ccp(TOPIC_LIGHT_STATE), 
+                                          MQTT_PAYLOAD_CMD_OFF, MQTTDEVICE_QOS_1, true); 
+                TRACE_INFO(p_trace->println(trace_PURE_MSG, MQTT_PAYLOAD_CMD_OFF)); 
             } 
             if(ret)
             {
@@ -262,8 +275,8 @@ bool SonoffBasic::ProcessPublishRequests(PubSubClient *client)
     }
     else
     {
-        p_trace->println(trace_ERROR_MSG, 
-                              "connection failure in relay ProcessPublishRequests "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                              "connection failure in relay ProcessPublishRequests ")); 
     }
     return ret; 
 };
@@ -304,7 +317,7 @@ void SonoffBasic::TurnRelayOff(void)
       {
         digitalWrite(this->ledPin_u8, HIGH);
       }
-      p_trace->println(trace_INFO_MSG, "relay turned off");
+      TRACE_INFO(p_trace->println(trace_INFO_MSG, "relay turned off"));
       this->publishState_bol = true;
   }
 }
@@ -325,7 +338,7 @@ void SonoffBasic::TurnRelayOn(void)
       {
         digitalWrite(this->ledPin_u8, LOW);
       }
-      p_trace->println(trace_INFO_MSG, "relay turned on");
+      TRACE_INFO(p_trace->println(trace_INFO_MSG, "relay turned on"));
       this->publishState_bol = true;
   }
 }
@@ -355,12 +368,12 @@ void SonoffBasic::setRelay(void)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* SonoffBasic::build_topic(const char *topic) 
 {
-  sprintf(buffer_ca, "std/%s%s", this->dev_p, topic);
-  return buffer_ca;
+  sprintf(buildBuffer_ca, "std/%s%s", this->dev_p, topic);
+  return buildBuffer_ca;
 }
 
 /**---------------------------------------------------------------------------------------
@@ -415,6 +428,7 @@ ICACHE_RAM_ATTR void SonoffBasic::UpdateBUTTONstate()
 
     };
     SonoffBasic::timerButtonDown_u32 = millis();
+    MqttDevice::RequestWakeup();
   }
 }
 
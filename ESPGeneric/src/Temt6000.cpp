@@ -51,8 +51,25 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 
 #define MQTT_PUB_BRIGHTNESS       "s/temt6000/raw" // raw sensor data in digits
 #define MQTT_PUB_BRIGHT_LEVEL     "s/temt6000/level" // brightness level data
+#define MQTT_SUB_POLICY           "policy" // publish policy of the brightness
+#define MQTT_CHANNEL              "temt6000"
 #define MQTT_REPORT_INTERVAL      (2l * MILLISEC_IN_SEC) // 1 second between processing
-#define SENSOR_AVERAGES           10U
+// ADC burst of 8 conversions, median against WiFi spikes, EMA of 1/4 over the bursts
+#define ADC_BURST                 8u
+#define ADC_EMA_SHIFT             2u
+
+// brightness published on a change of 10 digits, at least every 15 minutes
+#define POLICY_DELTA              10.0F
+#define POLICY_MIN_INTERVAL       0ul
+#define POLICY_HEARTBEAT          (15ul * 60ul * MILLISEC_IN_SEC)
+
+#define TOPIC_BRIGHTNESS          0u
+#define TOPIC_BRIGHT_LEVEL        1u
+#define TOPIC_POLICY              2u
+
+#define HANDLER_POLICY            0u
+
+#define TIMER_STATE_LOOP          0u
 /****************************************************************************************/
 /* Local function like makros */
 
@@ -77,14 +94,11 @@ Temt6000::Temt6000(Trace *p_trace) : MqttDevice(p_trace)
     this->level_u8              = 0U;
     this->level_chrp            = MQTT_PUB_PAY_LEVEL_DARK;
     this->lastLevel_u8          = 1U;
-    this->lastBrightness_f32    = 999.0F;
     this->rawData_u16           = 0U;
     this->brightness_f32        = 0.0F;
     this->brightId_u8           = 0U;
     this->reportCycleMSec_u32   = MQTT_REPORT_INTERVAL;
-
-    this->avgCnt_u16            = 0U;
-    this->avgData_32            = 0;
+    this->adcId_u8              = ADCSAMPLER_INVALID;
 }
 
 /**---------------------------------------------------------------------------------------
@@ -137,12 +151,28 @@ Temt6000::~Temt6000()
 *//*-----------------------------------------------------------------------------------*/
 void Temt6000::Initialize()
 {
-    p_trace->println(trace_INFO_MSG, "<<temt6000>> initialize");
+    const adcConfig_t adcConfig_st = {ADC_BURST, ADCSAMPLER_MEDIAN, ADC_EMA_SHIFT};
+    const publishPolicy_t policyDefault_st = {POLICY_DELTA, false, POLICY_MIN_INTERVAL, 
+                                            POLICY_HEARTBEAT};
+
+    TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<temt6000>> initialize"));
+    this->policy_st.Configure(&policyDefault_st);
+    if((ADCSAMPLER_INVALID == this->adcId_u8) && (NULL != MqttDevice::adc_p))
+    {
+        this->adcId_u8 = MqttDevice::adc_p->Register_u8(&adcConfig_st);
+        if(ADCSAMPLER_INVALID == this->adcId_u8)
+        {
+            TRACE_WARN(p_trace->println(trace_WARN_MSG, 
+                        "<<temt6000>> no adc consumer left, reading single samples"));
+        }
+    }
     this->PowerOff();
     if(NULL != this->brightPin_p)
     {
         this->brightPin_p->DigitalWrite(LOW);   
     }
+    this->stateLoopRequest_bol = false;
+    this->StartTimer(TIMER_STATE_LOOP, 0, this->STATE_LOOP_CYCLE);
     this->isInitialized_bol = true;
 }
 
@@ -160,32 +190,52 @@ void Temt6000::Reconnect(PubSubClient *client_p, const char *dev_p)
     {
         this->dev_p = dev_p;
         this->isConnected_bol = true;
-        p_trace->println(trace_INFO_MSG, "<<temt6000>> connected");
+        // build the topics once for this connection
+        this->CacheTopic(TOPIC_BRIGHTNESS, Utils::BuildSendTopic(this->dev_p, 
+                                            MQTT_PUB_BRIGHTNESS, buildBuffer_ca));
+        this->CacheTopic(TOPIC_BRIGHT_LEVEL, Utils::BuildSendTopic(this->dev_p, 
+                                            MQTT_PUB_BRIGHT_LEVEL, buildBuffer_ca));
+        this->CacheTopic(TOPIC_POLICY, Utils::BuildReceiveTopic(this->dev_p, 
+                                            MQTT_CHANNEL, MQTT_SUB_POLICY, buildBuffer_ca));
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<temt6000>> connected"));
+        // ... and resubscribe the retained publish policy
+        this->Subscribe_bol(client_p, GetTopic_ccp(TOPIC_POLICY));
+        this->RegisterTopic(GetTopic_ccp(TOPIC_POLICY), HANDLER_POLICY);
     }
     else
     {
         // failure, not connected
-        p_trace->println(trace_ERROR_MSG, 
-                    "<<temt6000>> uninizialized MQTT client detected");
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                    "<<temt6000>> uninizialized MQTT client detected"));
         this->isConnected_bol = false;
     }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Callback function to process subscribed MQTT publication
+ * @brief     Callback function to process routed MQTT publication
  * @author    winkste
  * @date      20 Okt. 2017
- * @param     client     mqtt client object
- * @param     p_topic    received topic
- * @param     p_payload  attached payload message
+ * @param     client_p      mqtt client object
+ * @param     handlerId_u8  handler id of the received topic
+ * @param     p_topic       received topic
+ * @param     payload       view on the received payload
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void Temt6000::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payload)
+void Temt6000::DispatchMqtt(PubSubClient *client_p, uint8_t handlerId_u8, 
+                            char* p_topic, const MqttPayload &payload)
 {
     if(true != this->isConnected_bol)
     {
-        p_trace->println(trace_ERROR_MSG, 
-                                "<<temt6000>> connection failure in CallbackMqtt "); 
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                                "<<temt6000>> connection failure in CallbackMqtt ")); 
+    }
+    else if(HANDLER_POLICY == handlerId_u8)
+    {
+        if(false == PublishPolicy::Apply_bol(&this->policy_st, 1u, payload))
+        {
+            TRACE_ERROR(p_trace->print(trace_ERROR_MSG, "<<temt6000>> invalid policy: ")); 
+            TRACE_ERROR(p_trace->println(trace_PURE_MSG, payload));
+        }
     }
 }
 
@@ -199,12 +249,11 @@ void Temt6000::CallbackMqtt(PubSubClient *client, char* p_topic, String p_payloa
 bool Temt6000::ProcessPublishRequests(PubSubClient *client)
 {
     boolean ret_bol = true;
-    uint32_t actualTime_u32 = millis();
 
-    if(    (this->prevTime_u32 + this->STATE_LOOP_CYCLE < actualTime_u32) 
-        || (0 == this->prevTime_u32))
+    if(true == this->stateLoopRequest_bol)
     {
-        this->prevTime_u32 = actualTime_u32;
+        this->stateLoopRequest_bol = false;
+        this->prevTime_u32 = millis();
         ret_bol = ret_bol && ProcessSensorStateMachine(client);
     }
 
@@ -220,24 +269,39 @@ bool Temt6000::ProcessPublishRequests(PubSubClient *client)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @return    combined topic as char pointer, it uses buildBuffer_ca to store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* Temt6000::build_topic(const char *topic) 
 {
   if(0 == this->brightId_u8)
   {
-      sprintf(buffer_ca, "std/%s%s", this->dev_p, topic);
+      sprintf(buildBuffer_ca, "std/%s%s", this->dev_p, topic);
   }
   else
   {
-      sprintf(buffer_ca, "std/%s%s%d", this->dev_p, topic, this->brightId_u8);  
+      sprintf(buildBuffer_ca, "std/%s%s%d", this->dev_p, topic, this->brightId_u8);  
   }
-  return buffer_ca;
+  return buildBuffer_ca;
 }
 
 /****************************************************************************************/
 /* Protected functions: */
 
+/**---------------------------------------------------------------------------------------
+ * @brief     Handler for the expired state loop timer, requests the next state machine step
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     timerId_u8    device local timer id
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Temt6000::ProcessTimer(uint8_t timerId_u8)
+{
+    if(TIMER_STATE_LOOP == timerId_u8)
+    {
+        this->stateLoopRequest_bol = true;
+    }
+}
+
 /**---------------------------------------------------------------------------------------
  * @brief     This function checks if we have to start a new measurement cycle
  * @author    winkste
@@ -248,8 +312,6 @@ void Temt6000::CheckForMeasRequest(void)
 {
     // no trigger needed here, directly start a new measurement cycle
     this->state_en = TEMT6000_MEAS_REQ;
-    this->avgCnt_u16 = 0U;
-    this->avgData_32 = 0;
 }
 
 /**--------------------------------------------------------------------------------------
@@ -264,7 +326,7 @@ void Temt6000::PowerOn()
     if(NULL != pwrPin_p)
     {
         this->pwrPin_p->DigitalWrite(HIGH);
-        p_trace->println(trace_INFO_MSG, "<<temt6000>> turned on");
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<temt6000>> turned on"));
     } 
 }
 
@@ -279,31 +341,41 @@ void Temt6000::PowerOff()
     if(NULL != this->pwrPin_p)
     {
         this->pwrPin_p->DigitalWrite(LOW);
-        p_trace->println(trace_INFO_MSG, "<<temt6000>> turned off");
+        TRACE_INFO(p_trace->println(trace_INFO_MSG, "<<temt6000>> turned off"));
     }
 }
 
 /**--------------------------------------------------------------------------------------
- * @brief     This function reads the internal adc channel.
+ * @brief     This function requests a burst of the internal adc channel from the 
+ *              sampler, without sampler a single conversion is used.
  * @author    S. Wink
  * @date      04 Jul 2018
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
 void Temt6000::ReadData(void) 
 {
-    uint16_t temData_u16;
-
-    // read data from internal ADC and summarize it
-    temData_u16 = analogRead(DEFAULT_DATAPIN);
-    this->avgData_32 += temData_u16;
-    this->avgCnt_u16++;
+    if(    (ADCSAMPLER_INVALID != this->adcId_u8)
+        && (true == MqttDevice::adc_p->Request_bol(this->adcId_u8)))
+    {
+        this->state_en = TEMT6000_SAMPLING;
+    }
+    else
+    {
+        this->rawData_u16 = analogRead(DEFAULT_DATAPIN);
+        this->state_en = TEMT6000_SAMPLE_COMPLETED;
+    }
+}
 
-    if(SENSOR_AVERAGES < this->avgCnt_u16)
+/**--------------------------------------------------------------------------------------
+ * @brief     This function takes the filtered burst, if the sampler served it.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Temt6000::TakeData(void) 
+{
+    if(true == MqttDevice::adc_p->Take_bol(this->adcId_u8, &this->rawData_u16))
     {
-        // measurement cycle completed
-        this->rawData_u16 = (uint16_t) this->avgData_32 / this->avgCnt_u16;
-        this->avgData_32 = 0;
-        this->avgCnt_u16 = 0U;
         this->state_en = TEMT6000_SAMPLE_COMPLETED;
     }
 }
@@ -356,38 +428,34 @@ boolean Temt6000::PublishData(PubSubClient *client)
     if(true == this->isConnected_bol)
     {
         if(    (this->level_u8 != this->lastLevel_u8) 
-            || (this->brightness_f32 != this->lastBrightness_f32))
+            || (true == this->policy_st.IsDue_bol(this->brightness_f32, millis())))
         {
             this->lastLevel_u8 = this->level_u8;
-            this->lastBrightness_f32 = this->brightness_f32;
-            p_trace->print(trace_INFO_MSG, "<<temt6000>> publish brigthness: ");
-            p_trace->print(trace_PURE_MSG, Utils::BuildSendTopic(this->dev_p, 
-                                            MQTT_PUB_BRIGHTNESS, this->buffer_ca));
-            p_trace->print(trace_PURE_MSG, "  :  ");
-            p_trace->println(trace_PURE_MSG, this->rawData_u16);
+            this->policy_st.SetPublished(this->brightness_f32, millis());
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<temt6000>> publish brigthness: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, GetTopic_ccp(TOPIC_BRIGHTNESS)));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, this->rawData_u16));
             /*ret_bol = client->publish(build_topic(MQTT_PUB_BRIGHTNESS), 
                                 Utils::IntegerToDecString(this->rawData_u16, &buff_ca[0]), true);*/
-            ret_bol = client->publish(
-                    Utils::BuildSendTopic(this->dev_p, MQTT_PUB_BRIGHTNESS, this->buffer_ca), 
+            ret_bol = Publish_bol(client, GetTopic_ccp(TOPIC_BRIGHTNESS), 
                     Utils::IntegerToDecString(this->rawData_u16, &buff_ca[0]), true);
 
             
 
-            p_trace->print(trace_INFO_MSG, "<<temt6000>> publish level: ");
-            p_trace->print(trace_PURE_MSG, Utils::BuildSendTopic(this->dev_p, 
-                                            MQTT_PUB_BRIGHT_LEVEL, this->buffer_ca));
-            p_trace->print(trace_PURE_MSG, "  :  ");
-            ret_bol = client->publish(Utils::BuildSendTopic(this->dev_p, 
-                                            MQTT_PUB_BRIGHT_LEVEL, this->buffer_ca), 
+            TRACE_INFO(p_trace->print(trace_INFO_MSG, "<<temt6000>> publish level: "));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, GetTopic_ccp(TOPIC_BRIGHT_LEVEL)));
+            TRACE_INFO(p_trace->print(trace_PURE_MSG, "  :  "));
+            ret_bol = Publish_bol(client, GetTopic_ccp(TOPIC_BRIGHT_LEVEL), 
                                 this->level_chrp, true);
-            p_trace->println(trace_PURE_MSG, this->level_chrp);
+            TRACE_INFO(p_trace->println(trace_PURE_MSG, this->level_chrp));
         } 
     }
     else
     {
         ret_bol = false;
-        p_trace->println(trace_ERROR_MSG, 
-                    "<<temt6000>> connection failure in dht ProcessPublishRequests ");  
+        TRACE_ERROR(p_trace->println(trace_ERROR_MSG, 
+                    "<<temt6000>> connection failure in dht ProcessPublishRequests "));  
     }
     this->state_en = TEMT6000_MEAS_PUBLISHED;
 
@@ -417,6 +485,9 @@ boolean Temt6000::ProcessSensorStateMachine(PubSubClient *client)
         case TEMT6000_POWER_STARTED:
             ReadData();
             break;
+        case TEMT6000_SAMPLING:
+            TakeData();
+            break;
         case TEMT6000_SAMPLE_COMPLETED:
             ProcessBrightness();
             PowerOff();
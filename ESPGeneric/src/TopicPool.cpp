@@ -0,0 +1,152 @@
+/*****************************************************************************************
+* FILENAME :        TopicPool.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the interned MQTT topic string pool
+*
+* NOTES :
+*       The topics are stored back to back with their termination. Interning
+*       searches the pool for an identical topic first, so topics used by more
+*       than one device (e.g. broadcast topics) are stored only once. The search
+*       is linear, but is only done during reconnect.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "TopicPool.h"
+#include <string.h>
+
+/****************************************************************************************/
+/* Local constant defines */
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the topic pool
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+TopicPool::TopicPool()
+{
+    this->Clear();
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Removes all topics, has to be called before the devices reconnect. All
+ *              pointers returned by Intern() are invalid afterwards.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void TopicPool::Clear(void)
+{
+    this->pool_ca[0] = '\0';
+    this->used_u16 = 0;
+    this->count_u8 = 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Stores a topic in the pool, an already stored identical topic is reused
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp       complete topic
+ * @return    pointer to the pooled topic or NULL, if the pool is full
+*//*-----------------------------------------------------------------------------------*/
+const char* TopicPool::Intern(const char *topic_ccp)
+{
+    uint16_t idx_u16 = 0;
+    uint16_t length_u16;
+
+    if(NULL == topic_ccp)
+    {
+        return(NULL);
+    }
+
+    // search for an identical topic
+    while(idx_u16 < this->used_u16)
+    {
+        if(0 == strcmp(&this->pool_ca[idx_u16], topic_ccp))
+        {
+            return(&this->pool_ca[idx_u16]);
+        }
+        idx_u16 += (uint16_t)(strlen(&this->pool_ca[idx_u16]) + 1u);
+    }
+
+    // append the new topic including the termination
+    length_u16 = (uint16_t)strlen(topic_ccp) + 1u;
+    if(length_u16 > (TOPICPOOL_SIZE - this->used_u16))
+    {
+        return(NULL);
+    }
+    memcpy(&this->pool_ca[this->used_u16], topic_ccp, length_u16);
+    this->used_u16 += length_u16;
+    this->count_u8++;
+    return(&this->pool_ca[this->used_u16 - length_u16]);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of used pool bytes
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    used bytes including the string terminations
+*//*-----------------------------------------------------------------------------------*/
+uint16_t TopicPool::GetUsed_u16(void) const
+{
+    return(this->used_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the pool size, this is the static RAM reserved for the topics
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    size of the pool in bytes
+*//*-----------------------------------------------------------------------------------*/
+uint16_t TopicPool::GetSize_u16(void) const
+{
+    return(TOPICPOOL_SIZE);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of stored topics
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of topics
+*//*-----------------------------------------------------------------------------------*/
+uint8_t TopicPool::GetCount_u8(void) const
+{
+    return(this->count_u8);
+}
+
+/****************************************************************************************/
+/* Private functions: */
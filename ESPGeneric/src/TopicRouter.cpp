@@ -0,0 +1,243 @@
+/*****************************************************************************************
+* FILENAME :        TopicRouter.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the MQTT receive topic router
+*
+* NOTES :
+*       Open addressing hash table with linear probing. The FNV-1a hash selects
+*       the slot, hash and length filter the probed routes and a strcmp with the
+*       registered topic confirms the hit. Different topics with the same hash
+*       take the next free slot like any other collision. A failed registration
+*       is counted, the owner of the router has to report it, otherwise the
+*       commands of the topic are silently dropped.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <string.h>
+#include "TopicRouter.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define FNV_OFFSET_BASIS            2166136261u
+#define FNV_PRIME                   16777619u
+#define MAX_TOPIC_LENGTH            255u
+
+/****************************************************************************************/
+/* Local function like makros */
+#define SLOT_MASK                   (TOPICROUTER_SLOTS - 1u)
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the topic router
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+TopicRouter::TopicRouter()
+{
+    this->Clear();
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Removes all routes, has to be called before the devices reconnect
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void TopicRouter::Clear(void)
+{
+    uint8_t idx_u8;
+
+    for(idx_u8 = 0; idx_u8 < TOPICROUTER_SLOTS; idx_u8++)
+    {
+        this->routes_sta[idx_u8].hash_u32 = 0;
+        this->routes_sta[idx_u8].topic_ccp = NULL;
+        this->routes_sta[idx_u8].device_p = NULL;
+        this->routes_sta[idx_u8].length_u8 = 0;
+        this->routes_sta[idx_u8].handlerId_u8 = 0;
+    }
+    this->size_u8 = 0;
+    this->failures_u8 = 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Adds a route for a complete receive topic. Registering the same topic
+ *              again for the same device updates the handler id.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp       complete receive topic, has to stay valid until Clear()
+ * @param     device_p        device handling the topic
+ * @param     handlerId_u8    device local handler id
+ * @return    true, if the route was stored
+*//*-----------------------------------------------------------------------------------*/
+bool TopicRouter::Register(const char *topic_ccp, MqttDevice *device_p,
+                            uint8_t handlerId_u8)
+{
+    uint8_t length_u8;
+    uint32_t hash_u32;
+    uint8_t slot_u8;
+    uint8_t probe_u8;
+
+    if((NULL == topic_ccp) || (NULL == device_p))
+    {
+        this->failures_u8++;
+        return(false);
+    }
+
+    hash_u32 = Hash_u32(topic_ccp, &length_u8);
+    slot_u8 = (uint8_t)(hash_u32 & SLOT_MASK);
+    for(probe_u8 = 0; probe_u8 < TOPICROUTER_SLOTS; probe_u8++)
+    {
+        topicRoute_t *route_p = &this->routes_sta[slot_u8];
+
+        if(NULL == route_p->device_p)
+        {
+            route_p->hash_u32 = hash_u32;
+            route_p->topic_ccp = topic_ccp;
+            route_p->device_p = device_p;
+            route_p->length_u8 = length_u8;
+            route_p->handlerId_u8 = handlerId_u8;
+            this->size_u8++;
+            return(true);
+        }
+        else if((hash_u32 == route_p->hash_u32) && (length_u8 == route_p->length_u8) 
+                    && (0 == strcmp(topic_ccp, route_p->topic_ccp)))
+        {
+            // same topic registered again, only the owner may update it
+            if(device_p == route_p->device_p)
+            {
+                route_p->handlerId_u8 = handlerId_u8;
+                return(true);
+            }
+            this->failures_u8++;
+            return(false);
+        }
+        slot_u8 = (slot_u8 + 1u) & SLOT_MASK;
+    }
+
+    // table full
+    this->failures_u8++;
+    return(false);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Searches the route for a received topic
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp       received topic
+ * @return    pointer to the route or NULL, if the topic is not registered
+*//*-----------------------------------------------------------------------------------*/
+const topicRoute_t* TopicRouter::Lookup(const char *topic_ccp) const
+{
+    uint8_t length_u8;
+    uint32_t hash_u32;
+    uint8_t slot_u8;
+    uint8_t probe_u8;
+
+    if((NULL == topic_ccp) || (0 == this->size_u8))
+    {
+        return(NULL);
+    }
+
+    hash_u32 = Hash_u32(topic_ccp, &length_u8);
+    slot_u8 = (uint8_t)(hash_u32 & SLOT_MASK);
+    for(probe_u8 = 0; probe_u8 < TOPICROUTER_SLOTS; probe_u8++)
+    {
+        const topicRoute_t *route_p = &this->routes_sta[slot_u8];
+
+        if(NULL == route_p->device_p)
+        {
+            break;
+        }
+        else if((hash_u32 == route_p->hash_u32) && (length_u8 == route_p->length_u8) 
+                    && (0 == strcmp(topic_ccp, route_p->topic_ccp)))
+        {
+            return(route_p);
+        }
+        slot_u8 = (slot_u8 + 1u) & SLOT_MASK;
+    }
+    return(NULL);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of registered routes
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of routes
+*//*-----------------------------------------------------------------------------------*/
+uint8_t TopicRouter::GetSize_u8(void) const
+{
+    return(this->size_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of rejected registrations since the last Clear()
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of topics without route
+*//*-----------------------------------------------------------------------------------*/
+uint8_t TopicRouter::GetFailures_u8(void) const
+{
+    return(this->failures_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Calculates the 32bit FNV-1a hash of a topic in a single pass
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp       zero terminated topic
+ * @param     length_pu8      returns the topic length, saturated at 255
+ * @return    hash value
+*//*-----------------------------------------------------------------------------------*/
+uint32_t TopicRouter::Hash_u32(const char *topic_ccp, uint8_t *length_pu8)
+{
+    uint32_t hash_u32 = FNV_OFFSET_BASIS;
+    uint16_t length_u16 = 0;
+
+    while('\0' != *topic_ccp)
+    {
+        hash_u32 ^= (uint8_t)*topic_ccp;
+        hash_u32 *= FNV_PRIME;
+        topic_ccp++;
+        length_u16++;
+    }
+
+    if(NULL != length_pu8)
+    {
+        *length_pu8 = (length_u16 > MAX_TOPIC_LENGTH) ? MAX_TOPIC_LENGTH : (uint8_t)length_u16;
+    }
+    return(hash_u32);
+}
+
+/****************************************************************************************/
+/* Private functions: */
@@ -37,12 +37,17 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
 #include <ESP8266WiFi.h>
 #include "Trace.h"
 #include <PubSubClient.h>
-#include <LinkedList.h>
 
 /*****************************************************************************************
  * Local constant defines
 *****************************************************************************************/
 #define MQTT_TRACE_TOPIC        "s/trace/"     //trace message
+#define MQTT_TRACEBIN_TOPIC     "s/tracebin/"  //binary trace record
+#define NUMBER_LENGTH           12u
+
+#if (trace_BATCH_SIZE < (TRACERING_MAX_TEXT + TRACERING_HEADER_SIZE))
+#error "trace_BATCH_SIZE has to hold a record of maximum length"
+#endif
 /*****************************************************************************************
  * Local function like makros 
 *****************************************************************************************/
@@ -61,11 +66,8 @@ vAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
  * @date      20 Okt. 2017
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-Trace::Trace()
+Trace::Trace() : Trace(true)
 {
-    this->isActive_bol = true;
-    this->channel_u8 = trace_CHANNEL_SERIAL;
-
 }
 
 /**---------------------------------------------------------------------------------------
@@ -75,11 +77,26 @@ Trace::Trace()
  * @param     isActive_bol     trace active or not
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-Trace::Trace(bool isActive_bol)
+Trace::Trace(bool isActive_bol) 
+        : infRing_st(infBuffer_au8, sizeof(infBuffer_au8)), 
+          errRing_st(errBuffer_au8, sizeof(errBuffer_au8))
 {
     this->isActive_bol = isActive_bol;
     this->channel_u8 = trace_CHANNEL_SERIAL;
-
+    this->client_p = NULL;
+    this->dev_p = NULL;
+    this->lineLength_u8 = 0;
+    this->lineStarted_bol = false;
+    this->type_u8 = trace_PURE_MSG;
+    this->reportedDrops_u32 = 0;
+    this->infBucket_st.refill_u32 = 0;
+    this->infBucket_st.tokens_u16 = trace_INFO_BURST;
+    this->infBucket_st.rate_u16 = trace_INFO_RATE;
+    this->infBucket_st.burst_u16 = trace_INFO_BURST;
+    this->errBucket_st.refill_u32 = 0;
+    this->errBucket_st.tokens_u16 = trace_ERROR_BURST;
+    this->errBucket_st.rate_u16 = trace_ERROR_RATE;
+    this->errBucket_st.burst_u16 = trace_ERROR_BURST;
 }
 
 /**---------------------------------------------------------------------------------------
@@ -96,12 +113,17 @@ void Trace::InitializeMqtt(PubSubClient *client_p, const char *dev_p)
   {
     this->client_p = client_p;
     this->dev_p = dev_p;
-    this->msgList_p = new LinkedList<Message*>;
-    this->println(trace_INFO_MSG, "<<trace>>MQTT channel configured");
-    this->print(trace_INFO_MSG, "<<trace>>MQTT topics:");
-    this->print(trace_PURE_MSG, buildTopic(MQTT_TRACE_TOPIC, trace_ERROR_MSG));
-    this->print(trace_PURE_MSG," or ");
-    this->print(trace_PURE_MSG, buildTopic(MQTT_TRACE_TOPIC, trace_INFO_MSG));
+    // the topics are built once here and reused for every trace message
+    (void)buildTopic(MQTT_TRACE_TOPIC, trace_ERROR_MSG);
+    (void)buildTopic(MQTT_TRACE_TOPIC, trace_INFO_MSG);
+    snprintf(binTopic_ca, sizeof(binTopic_ca), "inf/%s/%s", this->dev_p, MQTT_TRACEBIN_TOPIC);
+    TRACE_INFO(this->println(trace_INFO_MSG, "<<trace>>MQTT channel configured"));
+    TRACE_INFO(this->print(trace_INFO_MSG, "<<trace>>MQTT topics:"));
+    TRACE_INFO(this->print(trace_PURE_MSG, errTopic_ca));
+    TRACE_INFO(this->print(trace_PURE_MSG," or "));
+    TRACE_INFO(this->print(trace_PURE_MSG, infTopic_ca));
+    TRACE_INFO(this->print(trace_PURE_MSG," and "));
+    TRACE_INFO(this->println(trace_PURE_MSG, binTopic_ca));
   }
   else
   {
@@ -118,7 +140,7 @@ void Trace::InitializeMqtt(PubSubClient *client_p, const char *dev_p)
 *//*-----------------------------------------------------------------------------------*/
 void Trace::SwitchToOff()
 {
-  this->println(trace_INFO_MSG, "<<trace>> trace switch received off");
+  TRACE_INFO(this->println(trace_INFO_MSG, "<<trace>> trace switch received off"));
   this->channel_u8 = trace_CHANNEL_OFF;
 }
 
@@ -132,7 +154,7 @@ void Trace::SwitchToMqtt()
 {
   if((NULL != client_p) && (NULL != dev_p))
   {
-    this->println(trace_INFO_MSG, "<<trace>> trace switch received to MQTT:");
+    TRACE_INFO(this->println(trace_INFO_MSG, "<<trace>> trace switch received to MQTT:"));
     this->channel_u8 = trace_CHANNEL_MQTT;  
   }
 }
@@ -145,7 +167,7 @@ void Trace::SwitchToMqtt()
 *//*-----------------------------------------------------------------------------------*/
 void Trace::SwitchToSerial()
 {
-  this->println(trace_INFO_MSG, "<<trace>> trace switch received to serial:");
+  TRACE_INFO(this->println(trace_INFO_MSG, "<<trace>> trace switch received to serial:"));
   this->channel_u8 = trace_CHANNEL_SERIAL;
 }
 
@@ -209,8 +231,12 @@ void Trace::Initialize()
 *//*-----------------------------------------------------------------------------------*/
 void Trace::print(uint8_t type_u8, String msg_str)
 {
-  this->prepareMsg(type_u8, String(msg_str));
-  this->printMsg();
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, avoid the string allocation
+    return;
+  }
+  this->prepareMsg(type_u8, msg_str.c_str(), msg_str.length());
   
 }
 
@@ -224,7 +250,12 @@ void Trace::print(uint8_t type_u8, String msg_str)
 *//*-----------------------------------------------------------------------------------*/
 void Trace::println(uint8_t type_u8, String msg_str)
 {
-  this->prepareMsg(type_u8, String(msg_str));
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, avoid the string allocation
+    return;
+  }
+  this->prepareMsg(type_u8, msg_str.c_str(), msg_str.length());
   this->printlnMsg();
 }
 
@@ -238,8 +269,12 @@ void Trace::println(uint8_t type_u8, String msg_str)
 *//*-----------------------------------------------------------------------------------*/
 void Trace::print(uint8_t type_u8, const char *msg_pc)
 {
-  this->prepareMsg(type_u8, String(msg_pc));
-  this->printMsg();
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, avoid the string allocation
+    return;
+  }
+  this->prepareMsg(type_u8, msg_pc, (uint16_t)strlen(msg_pc));
   
 }
 
@@ -254,7 +289,12 @@ void Trace::print(uint8_t type_u8, const char *msg_pc)
 *//*-----------------------------------------------------------------------------------*/
 void Trace::println(uint8_t type_u8, const char *msg_pc)
 {
-  this->prepareMsg(type_u8, String(msg_pc));
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, avoid the string allocation
+    return;
+  }
+  this->prepareMsg(type_u8, msg_pc, (uint16_t)strlen(msg_pc));
   this->printlnMsg();
 }
 
@@ -268,8 +308,15 @@ void Trace::println(uint8_t type_u8, const char *msg_pc)
 *//*-----------------------------------------------------------------------------------*/
 void Trace::print(uint8_t type_u8, uint8_t value_u8)
 {
-  this->prepareMsg(type_u8, String(value_u8));
-  this->printMsg();
+  char number_ca[NUMBER_LENGTH];
+
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, avoid the string allocation
+    return;
+  }
+  (void)snprintf(number_ca, sizeof(number_ca), "%u", (unsigned int)value_u8);
+  this->prepareMsg(type_u8, number_ca, (uint16_t)strlen(number_ca));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -283,7 +330,15 @@ void Trace::print(uint8_t type_u8, uint8_t value_u8)
 *//*-----------------------------------------------------------------------------------*/
 void Trace::println(uint8_t type_u8, uint8_t value_u8)
 {
-  this->prepareMsg(type_u8, String(value_u8 ));
+  char number_ca[NUMBER_LENGTH];
+
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, avoid the string allocation
+    return;
+  }
+  (void)snprintf(number_ca, sizeof(number_ca), "%u", (unsigned int)value_u8);
+  this->prepareMsg(type_u8, number_ca, (uint16_t)strlen(number_ca));
   this->printlnMsg();
 }
 
@@ -297,8 +352,15 @@ void Trace::println(uint8_t type_u8, uint8_t value_u8)
 *//*-----------------------------------------------------------------------------------*/
 void Trace::print(uint8_t type_u8, uint16_t value_u16)
 {
-  this->prepareMsg(type_u8, String(value_u16));
-  this->printMsg();
+  char number_ca[NUMBER_LENGTH];
+
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, avoid the string allocation
+    return;
+  }
+  (void)snprintf(number_ca, sizeof(number_ca), "%u", (unsigned int)value_u16);
+  this->prepareMsg(type_u8, number_ca, (uint16_t)strlen(number_ca));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -312,110 +374,249 @@ void Trace::print(uint8_t type_u8, uint16_t value_u16)
 *//*-----------------------------------------------------------------------------------*/
 void Trace::println(uint8_t type_u8, uint16_t value_u16)
 {
-  this->prepareMsg(type_u8, String(value_u16));
+  char number_ca[NUMBER_LENGTH];
+
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, avoid the string allocation
+    return;
+  }
+  (void)snprintf(number_ca, sizeof(number_ca), "%u", (unsigned int)value_u16);
+  this->prepareMsg(type_u8, number_ca, (uint16_t)strlen(number_ca));
   this->printlnMsg();
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     For asynchronous data channels, this function can be used to send 
- *            queued messages to the channel at a dedicated time.
+ * @brief     Trace print function for a received MQTT payload w/o new line at the end
  * @author    winkste
- * @date      20 Okt. 2017
+ * @date      17 Okt. 2026
+ * @param     type_u8         trace message type
+ * @param     payload         payload view
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void Trace::PushToChannel()
+void Trace::print(uint8_t type_u8, const MqttPayload &payload)
 {
-  Message *msg_p;
-
-  switch(this->channel_u8)
+  if(trace_CHANNEL_OFF == this->channel_u8)
   {
-    case trace_CHANNEL_OFF:
-      break;
-    case trace_CHANNEL_SERIAL:
-      break;
-    case trace_CHANNEL_MQTT:
-      if((msgList_p != NULL) && (this->client_p != NULL) && (this->dev_p != NULL))
-      {
-        while(0 != msgList_p->size())
-        {
-          msg_p = msgList_p->shift();
-          (void)client_p->publish(buildTopic(MQTT_TRACE_TOPIC, msg_p->type_u8), 
-                                      buildPayload(msg_p->msg), true);
-          delete msg_p;
-        }    
-      }
-      break;
-    default:
-      // unsupported channel selected, set to default channel = serial
-      this->channel_u8 = 0; 
+    return;
   }
+  this->prepareMsg(type_u8, (const char*)payload.GetData_pu8(), payload.GetLength_u16());
 }
 
-/****************************************************************************************/
-/* Private functions: */
-/****************************************************************************************/
 /**---------------------------------------------------------------------------------------
- * @brief     Trace preparation function to combine message type and message 
+ * @brief     Trace print line function for a received MQTT payload with new line 
  *              at the end
  * @author    winkste
- * @date      20 Okt. 2017
+ * @date      17 Okt. 2026
  * @param     type_u8         trace message type
- * @param     msg_str         message
+ * @param     payload         payload view
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void Trace::prepareMsg(uint8_t type_u8, String msg_str)
+void Trace::println(uint8_t type_u8, const MqttPayload &payload)
 {
-  // check if a message was already started
-  if(NULL == message_p)
+  if(trace_CHANNEL_OFF == this->channel_u8)
   {
-    // new start of a trace message
-    buffer_str = "";
-    message_p = new Message();    
-    if(message_p == NULL)
-    { 
-      // error in memory handling, switch to serial trace
-      this->channel_u8 = trace_CHANNEL_SERIAL;
-    }
-    else
-    {
-      message_p->type_u8 = type_u8;
-    }   
-  } 
-  else
+    return;
+  }
+  this->prepareMsg(type_u8, (const char*)payload.GetData_pu8(), payload.GetLength_u16());
+  this->printlnMsg();
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Trace print line function for interrupt service routines. The message
+ *              is only stored in the record buffer and forwarded to the channel by
+ *              the next PushToChannel() call. The message has to be located in RAM.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8         trace message type
+ * @param     msg_pc          zero terminated message
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void Trace::PrintlnIsr(uint8_t type_u8, const char *msg_pc)
+{
+  uint8_t length_u8 = 0;
+
+  if((trace_CHANNEL_OFF == this->channel_u8) || (NULL == msg_pc))
   {
-    // continue existing message   
+    return;
   }
+  while((TRACERING_MAX_TEXT > length_u8) && ('\0' != msg_pc[length_u8]))
+  {
+    length_u8++;
+  }
+  (void)this->getRing(type_u8)->Write_bol(type_u8, msg_pc, length_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Binary trace of a message without arguments. Only the format id, the
+ *              time stamp and the arguments are stored, the text is built when the
+ *              record is forwarded. Can be called from interrupt context.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8         trace message type
+ * @param     format_u16      format id out of TRACEFORMAT_TABLE
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void Trace::Log(uint8_t type_u8, uint16_t format_u16)
+{
+  this->logRecord(type_u8, format_u16, NULL, 0);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Binary trace of a message with one argument
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8         trace message type
+ * @param     format_u16      format id out of TRACEFORMAT_TABLE
+ * @param     arg0_u32        first argument
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void Trace::Log(uint8_t type_u8, uint16_t format_u16, uint32_t arg0_u32)
+{
+  uint32_t args_au32[1] = {arg0_u32};
+
+  this->logRecord(type_u8, format_u16, args_au32, 1u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Binary trace of a message with two arguments
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8         trace message type
+ * @param     format_u16      format id out of TRACEFORMAT_TABLE
+ * @param     arg0_u32        first argument
+ * @param     arg1_u32        second argument
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void Trace::Log(uint8_t type_u8, uint16_t format_u16, uint32_t arg0_u32, 
+                                  uint32_t arg1_u32)
+{
+  uint32_t args_au32[2] = {arg0_u32, arg1_u32};
 
-  buffer_str = buffer_str + String(msg_str);
+  this->logRecord(type_u8, format_u16, args_au32, 2u);
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Depending on the channel, this function adds the message to the buffer
- *            list or direct plots it to the serial interface
+ * @brief     Binary trace of a message with three arguments
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8         trace message type
+ * @param     format_u16      format id out of TRACEFORMAT_TABLE
+ * @param     arg0_u32        first argument
+ * @param     arg1_u32        second argument
+ * @param     arg2_u32        third argument
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void Trace::Log(uint8_t type_u8, uint16_t format_u16, uint32_t arg0_u32, 
+                                  uint32_t arg1_u32, uint32_t arg2_u32)
+{
+  uint32_t args_au32[3] = {arg0_u32, arg1_u32, arg2_u32};
+
+  this->logRecord(type_u8, format_u16, args_au32, 3u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Binary trace of a message with four arguments
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8         trace message type
+ * @param     format_u16      format id out of TRACEFORMAT_TABLE
+ * @param     arg0_u32        first argument
+ * @param     arg1_u32        second argument
+ * @param     arg2_u32        third argument
+ * @param     arg3_u32        fourth argument
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void Trace::Log(uint8_t type_u8, uint16_t format_u16, uint32_t arg0_u32, 
+                                  uint32_t arg1_u32, uint32_t arg2_u32, uint32_t arg3_u32)
+{
+  uint32_t args_au32[4] = {arg0_u32, arg1_u32, arg2_u32, arg3_u32};
+
+  this->logRecord(type_u8, format_u16, args_au32, 4u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of trace records overwritten before they were
+ *              forwarded to the channel
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of dropped records
+*//*-----------------------------------------------------------------------------------*/
+uint32_t Trace::GetDropped_u32(void) const
+{
+  return(this->errRing_st.GetDropped_u32() + this->infRing_st.GetDropped_u32());
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     For asynchronous data channels, this function can be used to send 
+ *            queued messages to the channel at a dedicated time. Records written
+ *            from interrupt context are forwarded on every channel. Error records
+ *            are always forwarded first.
  * @author    winkste
  * @date      20 Okt. 2017
  * @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void Trace::printMsg(void)
+void Trace::PushToChannel()
 {
-   switch(this->channel_u8)
+  if((trace_CHANNEL_MQTT == this->channel_u8) 
+      && ((NULL == this->client_p) || (NULL == this->dev_p)))
+  {
+    // keep the records until the mqtt channel is configured
+    return;
+  }
+
+  this->pushRing(&this->errRing_st, &this->errBucket_st);
+  this->pushRing(&this->infRing_st, &this->infBucket_st);
+  this->reportDrops();
+}
+
+/****************************************************************************************/
+/* Private functions: */
+/****************************************************************************************/
+/**---------------------------------------------------------------------------------------
+ * @brief     Trace preparation function to combine message type and message. On the
+ *              serial channel the message is written directly, on the mqtt channel
+ *              it is collected in the line buffer until the line is finished.
+ * @author    winkste
+ * @date      20 Okt. 2017
+ * @param     type_u8         trace message type
+ * @param     msg_pc          message, no zero termination required
+ * @param     length_u16      message length
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Trace::prepareMsg(uint8_t type_u8, const char *msg_pc, uint16_t length_u16)
+{
+  uint16_t idx_u16;
+
+  switch(this->channel_u8)
   {
-    case trace_CHANNEL_OFF:
-      break;
     case trace_CHANNEL_SERIAL:
-      Serial.print(buffer_str);
-      buffer_str = "";
+      (void)Serial.write((const uint8_t*)msg_pc, length_u16);
       break;
     case trace_CHANNEL_MQTT:
+      // check if a message was already started
+      if(false == this->lineStarted_bol)
+      {
+        this->lineStarted_bol = true;
+        this->lineLength_u8 = 0;
+        this->type_u8 = type_u8;
+      }
+      // the line is truncated at the maximum record length
+      for(idx_u16 = 0; (idx_u16 < length_u16) 
+                        && (this->lineLength_u8 < TRACERING_MAX_TEXT); idx_u16++)
+      {
+        this->line_ca[this->lineLength_u8] = msg_pc[idx_u16];
+        this->lineLength_u8++;
+      }
       break;
     default:
-      break;  
+      break;
   }
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     Depending on the channel, this function adds the message to the buffer
- *            list or direct plots it to the serial interface
+ * @brief     Depending on the channel, this function finishes the line on the serial
+ *            interface or stores the collected line in the record buffer
  * @author    winkste
  * @date      20 Okt. 2017
  * @return    n/a
@@ -427,19 +628,39 @@ void Trace::printlnMsg(void)
     case trace_CHANNEL_OFF:
       break;
     case trace_CHANNEL_SERIAL:
-      Serial.println(buffer_str);
+      (void)Serial.println();
       break;
     case trace_CHANNEL_MQTT:
-      message_p->msg = String(buffer_str + "\n");
-      msgList_p->add(message_p);
-      // no free message_p, because the object is now in the linked list
-      message_p = NULL;
+      if(true == this->lineStarted_bol)
+      {
+        (void)this->getRing(this->type_u8)->Write_bol(this->type_u8, this->line_ca, 
+                                                        this->lineLength_u8);
+      }
       break;
     default:
       break;
   }
 
-  buffer_str = "";
+  this->lineStarted_bol = false;
+  this->lineLength_u8 = 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Traces a warning, if records were overwritten since the last report
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Trace::reportDrops(void)
+{
+  uint32_t dropped_u32 = this->GetDropped_u32();
+
+  if(dropped_u32 != this->reportedDrops_u32)
+  {
+    TRACE_WARN(this->Log(trace_WARN_MSG, TRACEFMT_TRACE_DROPS, 
+                          dropped_u32 - this->reportedDrops_u32));
+    this->reportedDrops_u32 = dropped_u32;
+  }
 }
 
 /**---------------------------------------------------------------------------------------
@@ -448,34 +669,260 @@ void Trace::printlnMsg(void)
  * @author    winkste
  * @date      20 Okt. 2017
  * @param     topic       pointer to topic string
- * @return    combined topic as char pointer, it uses buffer_stca to store the topic
+ * @param     type_u8     trace message type
+ * @return    combined topic as char pointer, it uses errTopic_ca or infTopic_ca to 
+ *              store the topic
 *//*-----------------------------------------------------------------------------------*/
 char* Trace::buildTopic(const char *topic, uint8_t type_u8) 
 {
   if(type_u8 == trace_ERROR_MSG)
   {
-    sprintf(buffer_ca, "err/%s/%s", this->dev_p, topic);
+    snprintf(errTopic_ca, sizeof(errTopic_ca), "err/%s/%s", this->dev_p, topic);
+    return errTopic_ca;
   }
   else
   {
-    sprintf(buffer_ca, "inf/%s/%s", this->dev_p, topic);
+    snprintf(infTopic_ca, sizeof(infTopic_ca), "inf/%s/%s", this->dev_p, topic);
+    return infTopic_ca;
   }
-  
-  return buffer_ca;
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief     This function converts the payload string to a char pointer, the char 
- *            buffer is part of the object
+ * @brief     Getter for the topic built during InitializeMqtt
  * @author    winkste
- * @date      20 Okt. 2017
- * @param     payload       pointer to payload string
- * @return    pointer to the payload string
+ * @date      17 Okt. 2026
+ * @param     type_u8     trace message type
+ * @return    topic of the message type
 *//*-----------------------------------------------------------------------------------*/
-char* Trace::buildPayload(String payload) 
+const char* Trace::getTopic(uint8_t type_u8) const
 {
-  payload.toCharArray(payload_ca, payload.length());
-  return payload_ca;
+  return((trace_ERROR_MSG == type_u8) ? errTopic_ca : infTopic_ca);
 }
 
+/**---------------------------------------------------------------------------------------
+ * @brief     Streams a batch to the broker. The trace messages are not retained, 
+ *              binary records are published on the binary trace topic.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8       trace message type of the batch
+ * @param     msg_pc        batch data
+ * @param     length_u16    batch length
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Trace::publishMsg(uint8_t type_u8, const char *msg_pc, uint16_t length_u16)
+{
+  const char *topic_ccp;
+
+  topic_ccp = (0 != (trace_BINARY_FLAG & type_u8)) ? binTopic_ca : getTopic(type_u8);
+  if(true == client_p->beginPublish(topic_ccp, length_u16, false))
+  {
+    (void)client_p->write((const uint8_t*)msg_pc, length_u16);
+    (void)client_p->endPublish();
+  }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Selects the record buffer for a message type
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8       trace message type
+ * @return    error record buffer for error messages, else info record buffer
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR TraceRing* Trace::getRing(uint8_t type_u8)
+{
+  return((trace_ERROR_MSG == (type_u8 & ~trace_BINARY_FLAG)) 
+            ? &this->errRing_st : &this->infRing_st);
+}
 
+/**---------------------------------------------------------------------------------------
+ * @brief     Forwards the records of one buffer to the selected channel
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     ring_p        record buffer
+ * @param     bucket_p      rate limit of the record buffer, only used for mqtt
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Trace::pushRing(TraceRing *ring_p, traceBucket_t *bucket_p)
+{
+  char record_ca[trace_LINE_LENGTH];
+  char text_ca[trace_LINE_LENGTH];
+  uint8_t type_u8;
+  uint8_t length_u8;
+
+  switch(this->channel_u8)
+  {
+    case trace_CHANNEL_OFF:
+      ring_p->Clear();
+      break;
+    case trace_CHANNEL_SERIAL:
+      while(true == ring_p->Read_bol(&type_u8, record_ca, sizeof(record_ca), &length_u8))
+      {
+        if(0 != (trace_BINARY_FLAG & type_u8))
+        {
+          (void)TraceFormat::Format_u16(text_ca, sizeof(text_ca), 
+                                          (const uint8_t*)record_ca, length_u8);
+          Serial.println(text_ca);
+        }
+        else
+        {
+          Serial.println(record_ca);
+        }
+      }
+      break;
+    case trace_CHANNEL_MQTT:
+      this->publishBatch(ring_p, bucket_p);
+      break;
+    default:
+      // unsupported channel selected, set to default channel = serial
+      this->channel_u8 = trace_CHANNEL_SERIAL;
+      break;
+  }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Packs the records of one buffer into as few publishes as possible.
+ *              Text lines are separated by a line feed, binary records keep their
+ *              length and type byte. Every record takes a token of the bucket, 
+ *              without tokens or without connection the records stay in the buffer.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     ring_p        record buffer
+ * @param     bucket_p      rate limit of the record buffer
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void Trace::publishBatch(TraceRing *ring_p, traceBucket_t *bucket_p)
+{
+  char batch_ca[trace_BATCH_SIZE];
+  char record_ca[trace_LINE_LENGTH];
+  uint32_t now_u32 = millis();
+  uint16_t used_u16 = 0;
+  uint16_t entry_u16;
+  uint8_t batchType_u8 = trace_PURE_MSG;
+  uint8_t type_u8 = trace_PURE_MSG;
+  uint8_t length_u8 = 0;
+  bool binary_bol;
+  bool pending_bol = false;
+
+  // a record read from the buffer is lost if its publish fails, keep them until connected
+  if((NULL == client_p) || (false == client_p->connected()))
+  {
+    return;
+  }
+
+  while(true)
+  {
+    if(false == pending_bol)
+    {
+      if((0 == ring_p->GetRecords_u16()) || (false == this->takeToken(bucket_p, now_u32)))
+      {
+        break;
+      }
+      if(false == ring_p->Read_bol(&type_u8, record_ca, sizeof(record_ca), &length_u8))
+      {
+        break;
+      }
+      pending_bol = true;
+    }
+
+    binary_bol = (0 != (trace_BINARY_FLAG & type_u8));
+    entry_u16 = (true == binary_bol) ? (TRACERING_HEADER_SIZE + length_u8) 
+                                      : (length_u8 + ((0 == used_u16) ? 0u : 1u));
+    if((0 != used_u16) 
+        && ((0 != (trace_BINARY_FLAG & (type_u8 ^ batchType_u8))) 
+            || (trace_BATCH_SIZE < (used_u16 + entry_u16))))
+    {
+      // the record starts the next batch
+      this->publishMsg(batchType_u8, batch_ca, used_u16);
+      used_u16 = 0;
+      continue;
+    }
+
+    if(0 == used_u16)
+    {
+      batchType_u8 = type_u8;
+    }
+    if(true == binary_bol)
+    {
+      batch_ca[used_u16++] = (char)length_u8;
+      batch_ca[used_u16++] = (char)type_u8;
+    }
+    else if(0 != used_u16)
+    {
+      batch_ca[used_u16++] = '\n';
+    }
+    memcpy(&batch_ca[used_u16], record_ca, length_u8);
+    used_u16 += length_u8;
+    pending_bol = false;
+  }
+
+  if(0 != used_u16)
+  {
+    this->publishMsg(batchType_u8, batch_ca, used_u16);
+  }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Token bucket rate limit, refills the bucket and takes one token
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     bucket_p      token bucket
+ * @param     now_u32       current time in ms
+ * @return    true, if a token was available
+*//*-----------------------------------------------------------------------------------*/
+bool Trace::takeToken(traceBucket_t *bucket_p, uint32_t now_u32)
+{
+  uint32_t elapsed_u32 = now_u32 - bucket_p->refill_u32;
+  uint32_t tokens_u32;
+
+  if(elapsed_u32 >= ((uint32_t)bucket_p->burst_u16 * 1000u))
+  {
+    // idle for a long time, the bucket is full
+    bucket_p->tokens_u16 = bucket_p->burst_u16;
+    bucket_p->refill_u32 = now_u32;
+  }
+  else
+  {
+    tokens_u32 = (elapsed_u32 * bucket_p->rate_u16) / 1000u;
+    if(0 != tokens_u32)
+    {
+      // keep the remainder of the refill period for the next token
+      bucket_p->refill_u32 += (tokens_u32 * 1000u) / bucket_p->rate_u16;
+      tokens_u32 += bucket_p->tokens_u16;
+      bucket_p->tokens_u16 = (tokens_u32 > bucket_p->burst_u16) 
+                                ? bucket_p->burst_u16 : (uint16_t)tokens_u32;
+    }
+  }
+
+  if(0 == bucket_p->tokens_u16)
+  {
+    return(false);
+  }
+  bucket_p->tokens_u16--;
+  return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Encodes a binary trace record and stores it in the record buffer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8       trace message type
+ * @param     format_u16    format id out of TRACEFORMAT_TABLE
+ * @param     args_pu32     argument values
+ * @param     count_u8      number of arguments
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void Trace::logRecord(uint8_t type_u8, uint16_t format_u16, 
+                                        const uint32_t *args_pu32, uint8_t count_u8)
+{
+  uint8_t body_au8[TRACEFORMAT_MAX_BODY];
+  uint8_t length_u8;
+
+  if(trace_CHANNEL_OFF == this->channel_u8)
+  {
+    // nothing to do, the record is not encoded
+    return;
+  }
+  length_u8 = TraceFormat::Encode_u8(body_au8, format_u16, millis(), args_pu32, count_u8);
+  (void)this->getRing(type_u8)->Write_bol(type_u8 | trace_BINARY_FLAG, 
+                                            (const char*)body_au8, length_u8);
+}
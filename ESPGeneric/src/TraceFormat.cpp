@@ -0,0 +1,230 @@
+/*****************************************************************************************
+* FILENAME :        TraceFormat.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the binary trace records with deferred formatting
+*
+* NOTES :
+*       Record body: format id (2 bytes), time stamp in ms (4 bytes), both little
+*       endian, followed by the arguments as unsigned LEB128 values, so small
+*       values like pin numbers or states only need a single byte. The format
+*       strings are stored in flash, the pointer table stays in RAM.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "TraceFormat.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define FIXED_SIZE                  6u
+#define UNKNOWN_FORMAT              "<<trace>> unknown format %lu: %lu %lu %lu %lu"
+
+/****************************************************************************************/
+/* Local function like makros */
+#define TRACEFORMAT_STRING(id, format)  static const char id##_ca[] PROGMEM = format;
+#define TRACEFORMAT_POINTER(id, format) id##_ca,
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Local data definitions */
+TRACEFORMAT_TABLE(TRACEFORMAT_STRING)
+
+static const char * const formats_stccpa[TRACEFMT_COUNT] = 
+{
+    TRACEFORMAT_TABLE(TRACEFORMAT_POINTER)
+};
+
+static const char unknown_stca[] PROGMEM = UNKNOWN_FORMAT;
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Encodes a binary record body, can be called from interrupt context
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     body_pu8      destination, at least TRACEFORMAT_MAX_BODY bytes
+ * @param     format_u16    format id
+ * @param     time_u32      time stamp in ms
+ * @param     args_pu32     argument values
+ * @param     count_u8      number of arguments, limited to TRACEFORMAT_MAX_ARGS
+ * @return    body length in bytes
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR uint8_t TraceFormat::Encode_u8(uint8_t *body_pu8, uint16_t format_u16, 
+                                                uint32_t time_u32, const uint32_t *args_pu32, 
+                                                uint8_t count_u8)
+{
+    uint8_t length_u8 = 0;
+    uint8_t arg_u8;
+    uint32_t value_u32;
+
+    body_pu8[length_u8++] = (uint8_t)(format_u16);
+    body_pu8[length_u8++] = (uint8_t)(format_u16 >> 8);
+    body_pu8[length_u8++] = (uint8_t)(time_u32);
+    body_pu8[length_u8++] = (uint8_t)(time_u32 >> 8);
+    body_pu8[length_u8++] = (uint8_t)(time_u32 >> 16);
+    body_pu8[length_u8++] = (uint8_t)(time_u32 >> 24);
+
+    if(TRACEFORMAT_MAX_ARGS < count_u8)
+    {
+        count_u8 = TRACEFORMAT_MAX_ARGS;
+    }
+    for(arg_u8 = 0; arg_u8 < count_u8; arg_u8++)
+    {
+        value_u32 = args_pu32[arg_u8];
+        while(0x80u <= value_u32)
+        {
+            body_pu8[length_u8++] = (uint8_t)(value_u32 | 0x80u);
+            value_u32 >>= 7;
+        }
+        body_pu8[length_u8++] = (uint8_t)value_u32;
+    }
+    return(length_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Decodes a binary record body
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     body_pu8      record body
+ * @param     length_u8     body length
+ * @param     format_pu16   returns the format id
+ * @param     time_pu32     returns the time stamp in ms
+ * @param     args_pu32     returns the arguments, TRACEFORMAT_MAX_ARGS entries
+ * @param     count_pu8     returns the number of arguments
+ * @return    true, if the body is valid
+*//*-----------------------------------------------------------------------------------*/
+bool TraceFormat::Decode_bol(const uint8_t *body_pu8, uint8_t length_u8, 
+                                uint16_t *format_pu16, uint32_t *time_pu32, 
+                                uint32_t *args_pu32, uint8_t *count_pu8)
+{
+    uint8_t idx_u8 = FIXED_SIZE;
+    uint8_t shift_u8;
+    uint32_t value_u32;
+
+    if((NULL == body_pu8) || (FIXED_SIZE > length_u8))
+    {
+        return(false);
+    }
+
+    *format_pu16 = (uint16_t)(body_pu8[0] | ((uint16_t)body_pu8[1] << 8));
+    *time_pu32 = (uint32_t)body_pu8[2] | ((uint32_t)body_pu8[3] << 8)
+                    | ((uint32_t)body_pu8[4] << 16) | ((uint32_t)body_pu8[5] << 24);
+    *count_pu8 = 0;
+    while(idx_u8 < length_u8)
+    {
+        if(TRACEFORMAT_MAX_ARGS <= *count_pu8)
+        {
+            return(false);
+        }
+        value_u32 = 0;
+        shift_u8 = 0;
+        do
+        {
+            if((idx_u8 >= length_u8) || (28u < shift_u8))
+            {
+                return(false);
+            }
+            value_u32 |= (uint32_t)(body_pu8[idx_u8] & 0x7Fu) << shift_u8;
+            shift_u8 += 7u;
+        } while(0 != (body_pu8[idx_u8++] & 0x80u));
+        args_pu32[*count_pu8] = value_u32;
+        (*count_pu8)++;
+    }
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Formats a binary record body as text, arguments which are not part of
+ *              the record are zero
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     text_pch      destination buffer
+ * @param     size_u16      size of the destination buffer including termination
+ * @param     body_pu8      record body
+ * @param     length_u8     body length
+ * @return    length of the text, 0 for an invalid record
+*//*-----------------------------------------------------------------------------------*/
+uint16_t TraceFormat::Format_u16(char *text_pch, uint16_t size_u16, 
+                                    const uint8_t *body_pu8, uint8_t length_u8)
+{
+    uint32_t args_au32[TRACEFORMAT_MAX_ARGS] = {0};
+    uint16_t format_u16;
+    uint32_t time_u32;
+    uint8_t count_u8;
+    const char *format_ccp;
+    int written_s32;
+
+    if((NULL == text_pch) || (0 == size_u16))
+    {
+        return(0);
+    }
+    text_pch[0] = '\0';
+    if(false == Decode_bol(body_pu8, length_u8, &format_u16, &time_u32, 
+                            args_au32, &count_u8))
+    {
+        return(0);
+    }
+
+    format_ccp = GetFormat_ccp(format_u16);
+    if(NULL == format_ccp)
+    {
+        written_s32 = snprintf_P(text_pch, size_u16, unknown_stca, (unsigned long)format_u16,
+                                    (unsigned long)args_au32[0], (unsigned long)args_au32[1],
+                                    (unsigned long)args_au32[2], (unsigned long)args_au32[3]);
+    }
+    else
+    {
+        written_s32 = snprintf_P(text_pch, size_u16, format_ccp, 
+                                    (unsigned long)args_au32[0], (unsigned long)args_au32[1],
+                                    (unsigned long)args_au32[2], (unsigned long)args_au32[3]);
+    }
+
+    if(0 > written_s32)
+    {
+        text_pch[0] = '\0';
+        return(0);
+    }
+    return(((uint16_t)written_s32 < size_u16) ? (uint16_t)written_s32 : (size_u16 - 1u));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the format string of an id
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     format_u16    format id
+ * @return    format string located in flash, NULL for an unknown id
+*//*-----------------------------------------------------------------------------------*/
+const char* TraceFormat::GetFormat_ccp(uint16_t format_u16)
+{
+    return((TRACEFMT_COUNT > format_u16) ? formats_stccpa[format_u16] : NULL);
+}
+
+/****************************************************************************************/
+/* Private functions: */
@@ -0,0 +1,262 @@
+/*****************************************************************************************
+* FILENAME :        TraceRing.cpp
+*
+* DESCRIPTION :
+*       Class implementation for the fixed size trace record ring buffer
+*
+* NOTES :
+*       Head and tail are free running byte indices, the buffer position is the
+*       index masked with the buffer size. A record never exceeds the buffer, so
+*       the writer can always make room by dropping records from the tail. The
+*       critical sections only protect the index update and the byte copy, they
+*       save and restore the interrupt level and can be nested in an ISR.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "TraceRing.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+
+/****************************************************************************************/
+/* Local function like makros */
+#define RING_POS(idx)               ((uint16_t)((idx) & (this->size_u16 - 1u)))
+
+#if defined(ARDUINO_ARCH_ESP8266)
+#define CRITICAL_ENTER(level)       ((level) = xt_rsil(15))
+#define CRITICAL_EXIT(level)        xt_wsr_ps(level)
+#else
+#define CRITICAL_ENTER(level)       do { (level) = 0u; noInterrupts(); } while(0)
+#define CRITICAL_EXIT(level)        do { (void)(level); interrupts(); } while(0)
+#endif
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Constructor for the trace ring buffer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     buffer_pu8    record buffer, at least TRACERING_MAX_TEXT + 
+ *                            TRACERING_HEADER_SIZE bytes
+ * @param     size_u16      size of the record buffer, a power of two
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+TraceRing::TraceRing(uint8_t *buffer_pu8, uint16_t size_u16)
+{
+    // the size is rounded down to a power of two
+    this->size_u16 = 0x8000u;
+    while(this->size_u16 > size_u16)
+    {
+        this->size_u16 >>= 1;
+    }
+    this->buffer_pu8 = buffer_pu8;
+    this->Clear();
+    this->dropped_u32 = 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Removes all records, the dropped counter is kept
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void TraceRing::Clear(void)
+{
+    uint32_t level_u32;
+
+    CRITICAL_ENTER(level_u32);
+    this->head_u16 = 0;
+    this->tail_u16 = 0;
+    this->records_u16 = 0;
+    CRITICAL_EXIT(level_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Stores a trace record. If the buffer is full, the oldest records are
+ *              overwritten. Can be called from interrupt context.
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8       trace message type
+ * @param     text_ccp      record text, no zero termination required
+ * @param     length_u8     text length, truncated to TRACERING_MAX_TEXT
+ * @return    true, if the record was stored
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR bool TraceRing::Write_bol(uint8_t type_u8, const char *text_ccp,
+                                            uint8_t length_u8)
+{
+    uint32_t level_u32;
+    uint16_t head_u16;
+    uint16_t first_u16;
+
+    if((NULL == text_ccp) && (0 != length_u8))
+    {
+        return(false);
+    }
+    if(TRACERING_MAX_TEXT < length_u8)
+    {
+        length_u8 = TRACERING_MAX_TEXT;
+    }
+    if((uint16_t)(length_u8 + TRACERING_HEADER_SIZE) > this->size_u16)
+    {
+        // buffer too small for this record
+        return(false);
+    }
+
+    CRITICAL_ENTER(level_u32);
+    while((uint16_t)(this->size_u16 - (uint16_t)(this->head_u16 - this->tail_u16))
+            < (uint16_t)(length_u8 + TRACERING_HEADER_SIZE))
+    {
+        this->dropOldest();
+    }
+
+    head_u16 = this->head_u16;
+    this->buffer_pu8[RING_POS(head_u16)] = length_u8;
+    this->buffer_pu8[RING_POS(head_u16 + 1u)] = type_u8;
+    head_u16 += TRACERING_HEADER_SIZE;
+    // the text is copied in two parts, if it wraps around the buffer end
+    first_u16 = this->size_u16 - RING_POS(head_u16);
+    if(first_u16 > length_u8)
+    {
+        first_u16 = length_u8;
+    }
+    memcpy(&this->buffer_pu8[RING_POS(head_u16)], text_ccp, first_u16);
+    memcpy(&this->buffer_pu8[0], &text_ccp[first_u16], length_u8 - first_u16);
+    this->head_u16 = (uint16_t)(head_u16 + length_u8);
+    this->records_u16++;
+    CRITICAL_EXIT(level_u32);
+
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Removes the oldest record and copies it into a zero terminated buffer,
+ *              the text is truncated if the buffer is too small
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_pu8      returns the trace message type
+ * @param     text_pch      destination buffer
+ * @param     size_u8       size of the destination buffer including termination
+ * @param     length_pu8    returns the number of copied text bytes
+ * @return    true, if a record was read
+*//*-----------------------------------------------------------------------------------*/
+bool TraceRing::Read_bol(uint8_t *type_pu8, char *text_pch, uint8_t size_u8,
+                            uint8_t *length_pu8)
+{
+    uint32_t level_u32;
+    uint16_t tail_u16;
+    uint16_t first_u16;
+    uint8_t length_u8;
+    uint8_t copied_u8;
+
+    if((NULL == type_pu8) || (NULL == text_pch) || (0 == size_u8) || (NULL == length_pu8))
+    {
+        return(false);
+    }
+
+    CRITICAL_ENTER(level_u32);
+    if(0 == this->records_u16)
+    {
+        CRITICAL_EXIT(level_u32);
+        return(false);
+    }
+
+    tail_u16 = this->tail_u16;
+    length_u8 = this->buffer_pu8[RING_POS(tail_u16)];
+    *type_pu8 = this->buffer_pu8[RING_POS(tail_u16 + 1u)];
+    tail_u16 += TRACERING_HEADER_SIZE;
+    copied_u8 = (length_u8 < size_u8) ? length_u8 : (uint8_t)(size_u8 - 1u);
+    first_u16 = this->size_u16 - RING_POS(tail_u16);
+    if(first_u16 > copied_u8)
+    {
+        first_u16 = copied_u8;
+    }
+    memcpy(text_pch, &this->buffer_pu8[RING_POS(tail_u16)], first_u16);
+    memcpy(&text_pch[first_u16], &this->buffer_pu8[0], copied_u8 - first_u16);
+    this->tail_u16 = (uint16_t)(tail_u16 + length_u8);
+    this->records_u16--;
+    CRITICAL_EXIT(level_u32);
+
+    text_pch[copied_u8] = '\0';
+    *length_pu8 = copied_u8;
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of used buffer bytes
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    used bytes including the record headers
+*//*-----------------------------------------------------------------------------------*/
+uint16_t TraceRing::GetUsed_u16(void) const
+{
+    return((uint16_t)(this->head_u16 - this->tail_u16));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of stored records
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of records
+*//*-----------------------------------------------------------------------------------*/
+uint16_t TraceRing::GetRecords_u16(void) const
+{
+    return(this->records_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Getter for the number of records overwritten since start up
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of dropped records
+*//*-----------------------------------------------------------------------------------*/
+uint32_t TraceRing::GetDropped_u32(void) const
+{
+    return(this->dropped_u32);
+}
+
+/****************************************************************************************/
+/* Private functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Removes the oldest record, has to be called inside the critical section
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+ICACHE_RAM_ATTR void TraceRing::dropOldest(void)
+{
+    uint8_t length_u8;
+
+    length_u8 = this->buffer_pu8[RING_POS(this->tail_u16)];
+    this->tail_u16 = (uint16_t)(this->tail_u16 + TRACERING_HEADER_SIZE + length_u8);
+    this->records_u16--;
+    this->dropped_u32++;
+}
@@ -54,19 +54,43 @@
 #include "gensettings.h"
 #include "Trace.h"
 #include "DeviceFactory.h"
-#include "LinkedList.h"
+#include "DeviceRegistry.h"
 #include "MqttDevice.h"
+#include "TopicRouter.h"
+#include "TopicPool.h"
+#include "MqttPayload.h"
+#include "Scheduler.h"
+#include "AdcSampler.h"
+#include "PubSubQueue.h"
+#include "PubSubSubscriber.h"
+#include "MqttConnection.h"
+#include "LoopProfiler.h"
+#include "PublishPolicy.h"
 
 #include "myVersion.h"
 
 /*****************************************************************************************
    Local constant defines
 *****************************************************************************************/
+#define GEN_TOPIC_COMMAND         0u
+#define GEN_TOPIC_FW_IDENT        1u
+#define GEN_TOPIC_FW_VERSION      2u
+#define GEN_TOPIC_FW_DESC         3u
+#define GEN_TOPIC_DEV_ROOM        4u
+#define GEN_TOPIC_OWN_IP          5u
+#define GEN_TOPIC_CAP             6u
+#define GEN_TOPIC_TRACE           7u
+#define GEN_TOPIC_CONN            8u
+#define GEN_TOPIC_WILDCARD        9u
+#define GEN_TOPIC_PROF            10u
+#define GEN_TOPICS                11u
 
 /*****************************************************************************************
    Local function like makros
 *****************************************************************************************/
 char* build_topic(const char *topic);
+void cacheGenericTopics(void);
+uint8_t deviceIndex_u8(const MqttDevice *device_p);
 char* build_ssid(const char *ssidName);
 char* buildPayload(String payload) ;
 
@@ -92,11 +116,20 @@ static IPAddress *ownIpAddress_sts;
 // buffer_stca, as both are needed simultaniously
 static WiFiClient            wifiClient_sts;
 static PubSubClient          client_sts(wifiClient_sts);
+static PubSubQueue           publishQueue_sts(client_sts);
+static PubSubSubscriber      subscriber_sts(client_sts);
+static MqttConnection        connection_sts(&client_sts, CONNECT_RETRIES);
 static mqttData_t            mqttData_sts;
 static Trace                 trace_st(true);
 static DeviceFactory         factory_st(&trace_st);
 //static MqttDevice            *device_pst = NULL;
-static LinkedList<MqttDevice*> *deviceList_pst = NULL;
+static DeviceRegistry        devices_sts;
+static TopicRouter           topicRouter_sts;
+static TopicPool             topicPool_sts;
+static Scheduler             scheduler_sts;
+static AdcSampler            adc_sts(A0);
+static LoopProfiler          profiler_sts;
+static const char            *genTopics_stccpa[GEN_TOPICS];
 static WiFiManager           wifiManager_sts;
 // prepare wifimanager variables
 static WiFiManagerParameter  wifiManagerParamMqttServerId_sts("mq_ip", "mqtt server ip", "", 16);
@@ -108,13 +141,12 @@ static WiFiManagerParameter  wifiManagerParamMqttClientRoom_sts("room", "room id
 static WiFiManagerParameter  wifiManagerParamMqttServerLogin_sts("login", "mqtt login", "", 16);
 static WiFiManagerParameter  wifiManagerParamMqttServerPw_sts("pw", "mqtt pw", "", 16);
 
-static uint32_t             timerRepubAvoid_u32st = 0;
-static uint32_t             timerLastPub_u32st = 0;
 static boolean              publishInfo_bolst = false;
 static boolean              publishCap_bolst = false;
 static boolean              publishTrac_bolst = false;
 static boolean              publishPar_bolst = false;
 static boolean              publishRoom_bolst = false;
+static boolean              publishProf_bolst = false;
 static boolean              startWifiConfig_bolst = false;
 
 /*****************************************************************************************
@@ -131,31 +163,32 @@ static boolean              startWifiConfig_bolst = false;
 boolean processPublishRequests(void)
 {
   uint8_t idx_u8 = 0;
+  uint32_t start_u32;
   String tPayload;
   boolean ret_bol = false;
 
   if (true == publishInfo_bolst)
   {
-    trace_st.println(trace_PURE_MSG, "");
-    trace_st.print(trace_INFO_MSG, "<<gen>>publish requested info: ");
-    trace_st.print(trace_PURE_MSG, myVersion_FWIDENT);
-    trace_st.println(trace_PURE_MSG, myVersion_FWVERSION);
-    trace_st.print(trace_INFO_MSG, "<<gen>>firmware description: ");
-    trace_st.println(trace_PURE_MSG, myVersion_FWDESCRIPTION);
-    trace_st.print(trace_INFO_MSG, "<<gen>>device room: ");
-    trace_st.println(trace_PURE_MSG, &mqttData_sts.room[0]);
-    trace_st.print(trace_INFO_MSG, "<<gen>> publish own IP address: ");
-    trace_st.println(trace_PURE_MSG, ownIpAddress_sts->toString());
-    ret_bol = client_sts.publish(build_topic(MQTT_PUB_FW_IDENT), 
-                                  myVersion_FWIDENT, true);
-    ret_bol &= client_sts.publish(build_topic(MQTT_PUB_FW_VERSION), 
-                                  myVersion_FWVERSION, true);
-    ret_bol &= client_sts.publish(build_topic(MQTT_PUB_FW_DESC), 
-                                  myVersion_FWDESCRIPTION, true);
-    ret_bol &= client_sts.publish(build_topic(MQTT_PUB_DEV_ROOM), 
-                                  &mqttData_sts.room[0], true);
-    ret_bol &= client_sts.publish(build_topic(MQTT_PUB_OWN_IP), 
-                                  buildPayload(ownIpAddress_sts->toString()), true);
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, ""));
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>>publish requested info: "));
+    TRACE_INFO(trace_st.print(trace_PURE_MSG, myVersion_FWIDENT));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, myVersion_FWVERSION));
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>>firmware description: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, myVersion_FWDESCRIPTION));
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>>device room: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, &mqttData_sts.room[0]));
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> publish own IP address: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, ownIpAddress_sts->toString()));
+    ret_bol = publishQueue_sts.publish(genTopics_stccpa[GEN_TOPIC_FW_IDENT], 
+                                        myVersion_FWIDENT, true);
+    ret_bol &= publishQueue_sts.publish(genTopics_stccpa[GEN_TOPIC_FW_VERSION], 
+                                        myVersion_FWVERSION, true);
+    ret_bol &= publishQueue_sts.publish(genTopics_stccpa[GEN_TOPIC_FW_DESC], 
+                                        myVersion_FWDESCRIPTION, true);
+    ret_bol &= publishQueue_sts.publish(genTopics_stccpa[GEN_TOPIC_DEV_ROOM], 
+                                        &mqttData_sts.room[0], true);
+    ret_bol &= publishQueue_sts.publish(genTopics_stccpa[GEN_TOPIC_OWN_IP], 
+                                        buildPayload(ownIpAddress_sts->toString()), true);
 
     if (ret_bol)
     {
@@ -164,9 +197,9 @@ boolean processPublishRequests(void)
   }
   else if (true == publishCap_bolst)
   {
-    trace_st.print(trace_INFO_MSG, "<<gen>>publish requested capability: ");
-    trace_st.println(trace_PURE_MSG, &mqttData_sts.cap[0]);
-    ret_bol &= client_sts.publish(build_topic(MQTT_PUB_CAP), &mqttData_sts.cap[0], true);
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>>publish requested capability: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, &mqttData_sts.cap[0]));
+    ret_bol = publishQueue_sts.publish(genTopics_stccpa[GEN_TOPIC_CAP], &mqttData_sts.cap[0], true);
     if (ret_bol)
     {
       publishCap_bolst = false;
@@ -174,34 +207,50 @@ boolean processPublishRequests(void)
   }
   else if (true == publishTrac_bolst)
   {
-    trace_st.print(trace_INFO_MSG, "<<gen>>publish requested trace channel: ");
-    trace_st.println(trace_PURE_MSG, &mqttData_sts.chan[0]);
-    ret_bol &= client_sts.publish(build_topic(MQTT_PUB_TRACE), &mqttData_sts.chan[0], true);
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>>publish requested trace channel: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, &mqttData_sts.chan[0]));
+    ret_bol = publishQueue_sts.publish(genTopics_stccpa[GEN_TOPIC_TRACE], &mqttData_sts.chan[0], true);
     if (ret_bol)
     {
-      publishCap_bolst = false;
+      publishTrac_bolst = false;
     }
   }
   else if (true == publishRoom_bolst)
   {
-    trace_st.print(trace_INFO_MSG, "<<gen>>publish requested room: ");
-    trace_st.println(trace_PURE_MSG, &mqttData_sts.room[0]);
-    ret_bol &= client_sts.publish(build_topic(MQTT_PUB_TRACE), &mqttData_sts.room[0], true);
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>>publish requested room: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, &mqttData_sts.room[0]));
+    ret_bol = publishQueue_sts.publish(genTopics_stccpa[GEN_TOPIC_DEV_ROOM], 
+                                        &mqttData_sts.room[0], true);
     if (ret_bol)
     {
       publishRoom_bolst = false;
     }
   }
-  else
+  else if (true == publishProf_bolst)
   {
-    idx_u8 = 0;
-    while (idx_u8 < deviceList_pst->size())
+    TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>>publish requested loop profile"));
+    // streamed directly, the queued messages are sent before
+    publishQueue_sts.flush();
+    if (0 == publishQueue_sts.depth())
     {
-      deviceList_pst->get(idx_u8)->ProcessPublishRequests(&client_sts);
-      idx_u8++;
+      ret_bol = profiler_sts.Publish_bol(&client_sts, genTopics_stccpa[GEN_TOPIC_PROF]);
+    }
+    if (ret_bol)
+    {
+      publishProf_bolst = false;
     }
   }
 
+  // the devices only queue their messages, so all of them are serviced every cycle
+  idx_u8 = 0;
+  for (MqttDevice *device_p : devices_sts)
+  {
+    start_u32 = micros();
+    device_p->ProcessPublishRequests(&client_sts);
+    profiler_sts.Record(idx_u8, LOOPPROFILER_OP_PROCESS, start_u32);
+    idx_u8++;
+  }
+
   return (ret_bol);
 }
 
@@ -219,190 +268,280 @@ boolean processPublishRequests(void)
 void callback(char* p_topic, byte* p_payload, unsigned int p_length)
 {
   uint8_t idx_u8 = 0;
-  String payload;
-
-  // concat the payload into a string
-  for (uint8_t i = 0; i < p_length; i++)
-  {
-    payload.concat((char)p_payload[i]);
-  }
+  // non owning view into the PubSubClient buffer, no copy of the payload
+  MqttPayload payload(p_payload, (uint16_t)p_length);
+  const topicRoute_t *route_p;
+  uint32_t start_u32;
 
   // print received topic and payload
-  trace_st.print(trace_INFO_MSG, "<<gen>> message received: ");
-  trace_st.print(trace_PURE_MSG, p_topic);
-  trace_st.print(trace_PURE_MSG, "   ");
-  trace_st.println(trace_PURE_MSG, payload);
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> message received: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, p_topic));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, "   "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, payload));
 
   // execute generic support command
-  if (String(build_topic(MQTT_SUB_COMMAND)).equals(p_topic))
+  if (0 == strcmp(genTopics_stccpa[GEN_TOPIC_COMMAND], p_topic))
   {
     // print firmware information
-    if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_INFO)))
+    if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_INFO))
     {
       publishInfo_bolst = true;
     }
     // goto wifimanager configuration
-    else if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_SETUP)))
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_SETUP))
     {
       startWifiConfig_bolst = true;
     }
     // send capability setting
-    else if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_CAP)))
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_CAP))
     {
       // send room setting
       publishCap_bolst = true;
     }
-    else if(0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_ROOM)))
+    else if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_ROOM))
     {
       // send trace setting
       publishRoom_bolst = true;
     }
     // send trace channel setting
-    else if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_TRAC)))
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_TRAC))
     {
       // send trace setting
       publishTrac_bolst = true;
     }
     // send parameter set
-    else if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_PAR)))
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_PAR))
     {
       // send parameter setting
       publishPar_bolst = true;
     }
+    // send loop time profile
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_PROF))
+    {
+      publishProf_bolst = true;
+    }
     else
     {
-      trace_st.print(trace_ERROR_MSG, "<<gen>> unexpected command: ");
-      trace_st.println(trace_PURE_MSG, payload);
+      TRACE_ERROR(trace_st.print(trace_ERROR_MSG, "<<gen>> unexpected command: "));
+      TRACE_ERROR(trace_st.println(trace_PURE_MSG, payload));
     }
   }
-  else if (String(MQTT_SUB_BCAST).equals(p_topic))
+  else if (0 == strcmp(MQTT_SUB_BCAST, p_topic))
   {
     // print firmware information
-    if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_INFO)))
+    if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_INFO))
     {
       publishInfo_bolst = true;
     }
         // send capability setting
-    else if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_CAP)))
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_CAP))
     {
       // send room setting
       publishCap_bolst = true;
     }
-    else if(0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_ROOM)))
+    else if(payload.StartsWith_bol(MQTT_PAYLOAD_CMD_ROOM))
     {
       // send trace setting
       publishRoom_bolst = true;
     }
     // send trace channel setting
-    else if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_TRAC)))
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_TRAC))
     {
       // send trace setting
       publishTrac_bolst = true;
     }
     // send parameter set
-    else if (0 == payload.indexOf(String(MQTT_PAYLOAD_CMD_PAR)))
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_PAR))
     {
       // send parameter setting
       publishPar_bolst = true;
     }
+    // send loop time profile
+    else if (payload.StartsWith_bol(MQTT_PAYLOAD_CMD_PROF))
+    {
+      publishProf_bolst = true;
+    }
     else
     {
-      trace_st.print(trace_ERROR_MSG, "<<gen>> unexpected command: ");
-      trace_st.println(trace_PURE_MSG, payload);
+      TRACE_ERROR(trace_st.print(trace_ERROR_MSG, "<<gen>> unexpected command: "));
+      TRACE_ERROR(trace_st.println(trace_PURE_MSG, payload));
     }
   }
-  else if (String(MQTT_SUB_CAP).equals(p_topic))
+  else if (0 == strcmp(MQTT_SUB_CAP, p_topic))
+  {
+      TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> write capability command: "));
+      TRACE_INFO(trace_st.println(trace_PURE_MSG, payload));
+  }
+  else if (0 == strcmp(MQTT_SUB_TRACE, p_topic))
   {
-      trace_st.print(trace_INFO_MSG, "<<gen>> write capability command: ");
-      trace_st.println(trace_PURE_MSG, payload);
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> write trace command: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, payload));
   }
-  else if (String(MQTT_SUB_TRACE).equals(p_topic))
+  else if (NULL != (route_p = topicRouter_sts.Lookup(p_topic)))
   {
-    trace_st.print(trace_INFO_MSG, "<<gen>> write trace command: ");
-    trace_st.println(trace_PURE_MSG, payload);
+    // device topic registered during reconnect, dispatch to the owner only
+    start_u32 = micros();
+    route_p->device_p->DispatchMqtt(&client_sts, route_p->handlerId_u8, p_topic, payload);
+    profiler_sts.Record(deviceIndex_u8(route_p->device_p), LOOPPROFILER_OP_CALLBACK, 
+                        start_u32);
   }
   else
   {
     idx_u8 = 0;
-    while (idx_u8 < deviceList_pst->size())
+    for (MqttDevice *device_p : devices_sts)
     {
-      deviceList_pst->get(idx_u8)->CallbackMqtt(&client_sts, p_topic, payload);
+      start_u32 = micros();
+      device_p->CallbackMqtt(&client_sts, p_topic, payload);
+      profiler_sts.Record(idx_u8, LOOPPROFILER_OP_CALLBACK, start_u32);
       idx_u8++;
     }
   }
 }
 
 /**---------------------------------------------------------------------------------------
-   @brief     This function handles the connection to the MQTT broker. If connection can't
-                be established after several attempts the WifiManager is called. If
-                connection is successfull, all needed subscriptions are done.
+   @brief     This function is called after the connection to the MQTT broker was 
+                established. All needed subscriptions are done and the generic 
+                information is published.
    @author    winkste
    @date      20 Okt. 2017
    @return    n/a
 *//*-----------------------------------------------------------------------------------*/
-void reconnect()
+void onConnected()
 {
-  // Loop until we're reconnected
   uint8_t idx_u8 = 0;
-  uint8_t tries = 0;
-  while (!client_sts.connected())
+  uint32_t start_u32;
+
+  // all topics are built once per connection, the devices add theirs during reconnect
+  topicPool_sts.Clear();
+  cacheGenericTopics();
+  trace_st.InitializeMqtt(&client_sts, mqttData_sts.dev_short);
+  factory_st.SelectTraceChannel(atoi(&mqttData_sts.chan[0]));
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>> connected"));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> connect latency: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, String(connection_sts.GetLatency_u32())));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " ms, failed attempts: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, connection_sts.GetFailures_u16()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " max latency: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, String(connection_sts.GetMaxLatency_u32())));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " ms, reconnects: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, connection_sts.GetReconnects_u16()));
+  // all subscriptions are collected and sent together after the devices reconnected
+  subscriber_sts.clear();
+  subscriber_sts.resetCounters();
+  if (0 != MQTT_USE_WILDCARD)
   {
-    trace_st.println(trace_INFO_MSG, "<<gen>> Attempting connection...");
-    // Attempt to connect
-    trace_st.print(trace_INFO_MSG, "<<gen>> client id: ");
-    trace_st.println(trace_PURE_MSG, mqttData_sts.dev_short);
-    if (client_sts.connect(mqttData_sts.dev_short, mqttData_sts.login, mqttData_sts.pw))
-    {
-      trace_st.InitializeMqtt(&client_sts, mqttData_sts.dev_short);
-      factory_st.SelectTraceChannel(atoi(&mqttData_sts.chan[0]));
-      trace_st.println(trace_INFO_MSG, "<<gen>> connected");
-      client_sts.loop();
-      trace_st.print(trace_INFO_MSG, "<<gen>> subscribed generic: ");
-      trace_st.println(trace_PURE_MSG, MQTT_SUB_COMMAND);
-      client_sts.subscribe(build_topic(MQTT_SUB_COMMAND));  // request general command with payload
-      client_sts.loop();
-      trace_st.print(trace_INFO_MSG, "<<gen>> broadcast topic: ");
-      trace_st.println(trace_PURE_MSG, MQTT_SUB_BCAST);
-      client_sts.subscribe(MQTT_SUB_BCAST);  // request broadcast command with payload
-      client_sts.loop();
-
-      // reconnect all client device topics
-      idx_u8 = 0;
-      while (idx_u8 < deviceList_pst->size())
-      {
-        deviceList_pst->get(idx_u8)->Reconnect(&client_sts, mqttData_sts.dev_short);
-        idx_u8++;
-      }
-
-      // send out generic commands
-      trace_st.println(trace_INFO_MSG, "<<gen>> subscribing finished");
-      trace_st.print(trace_INFO_MSG, "<<gen>> publish firmware partnumber: ");
-      trace_st.print(trace_PURE_MSG, myVersion_FWIDENT);
-      trace_st.println(trace_PURE_MSG, myVersion_FWVERSION);
-      trace_st.print(trace_INFO_MSG, "<<gen>> publish firmware description: ");
-      trace_st.println(trace_PURE_MSG, myVersion_FWDESCRIPTION);
-      trace_st.print(trace_INFO_MSG, "<<gen>> publish own IP address: ");
-      trace_st.println(trace_PURE_MSG, ownIpAddress_sts->toString());
-      client_sts.publish(build_topic(MQTT_PUB_FW_IDENT), myVersion_FWIDENT, true);
-      client_sts.publish(build_topic(MQTT_PUB_FW_VERSION), myVersion_FWVERSION, true);
-      client_sts.publish(build_topic(MQTT_PUB_FW_DESC), myVersion_FWDESCRIPTION, true);
-      client_sts.publish(build_topic(MQTT_PUB_OWN_IP), buildPayload(ownIpAddress_sts->toString()), true);
-      trace_st.println(trace_INFO_MSG, "<<gen>> publishing finished");
-    }
-    else
-    {
-      trace_st.print(trace_ERROR_MSG, "<<gen>>failed, rc=");
-      trace_st.print(trace_PURE_MSG, String(client_sts.state()));
-      trace_st.println(trace_PURE_MSG, ", try again in 5 seconds");
-      // Wait 5 seconds before retrying
-      delay(5000);
-    }
-    tries++;
-    if (tries >= CONNECT_RETRIES)
-    {
-      trace_st.println(trace_ERROR_MSG, "<<gen>>Can't connect, starting AP");
+    // one subscription for all receive topics of the device, including the command
+    MqttDevice::SetWildcard(genTopics_stccpa[GEN_TOPIC_WILDCARD]);
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> subscribed wildcard: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, genTopics_stccpa[GEN_TOPIC_WILDCARD]));
+    subscriber_sts.subscribe(genTopics_stccpa[GEN_TOPIC_WILDCARD]);
+  }
+  else
+  {
+    TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> subscribed generic: "));
+    TRACE_INFO(trace_st.println(trace_PURE_MSG, MQTT_SUB_COMMAND));
+    subscriber_sts.subscribe(genTopics_stccpa[GEN_TOPIC_COMMAND]);  // request general command with payload
+  }
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> broadcast topic: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, MQTT_SUB_BCAST));
+  subscriber_sts.subscribe(MQTT_SUB_BCAST);  // request broadcast command with payload
+
+  // reconnect all client device topics, the devices register their routes again
+  topicRouter_sts.Clear();
+  idx_u8 = 0;
+  for (MqttDevice *device_p : devices_sts)
+  {
+    start_u32 = micros();
+    device_p->Reconnect(&client_sts, mqttData_sts.dev_short);
+    profiler_sts.Record(idx_u8, LOOPPROFILER_OP_RECONNECT, start_u32);
+    idx_u8++;
+  }
+  if (0 != topicRouter_sts.GetFailures_u8())
+  {
+    // converted devices only handle routed topics, commands to these are dropped
+    TRACE_ERROR(trace_st.print(trace_ERROR_MSG, "<<gen>> topics without route: "));
+    TRACE_ERROR(trace_st.print(trace_PURE_MSG, topicRouter_sts.GetFailures_u8()));
+    TRACE_ERROR(trace_st.println(trace_PURE_MSG, 
+                                  ", router or topic pool full or topic owned twice"));
+  }
+  subscriber_sts.flush();
+  client_sts.loop();
+
+  // send out generic commands
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>> subscribing finished"));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> subscribed topics: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, subscriber_sts.topicCount()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " in packets: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, subscriber_sts.packetCount()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " failed: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, subscriber_sts.failedCount()));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> routed topics: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, topicRouter_sts.GetSize_u8()));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> topic pool used: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, topicPool_sts.GetUsed_u16()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " of "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, topicPool_sts.GetSize_u16()));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> publish queue depth: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, publishQueue_sts.depth()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " max: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, publishQueue_sts.maxDepth()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " dropped: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, publishQueue_sts.droppedCount()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " collapsed: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, publishQueue_sts.collapsedCount()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " in flight: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, client_sts.inflight()));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> publish firmware partnumber: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, myVersion_FWIDENT));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, myVersion_FWVERSION));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> publish firmware description: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, myVersion_FWDESCRIPTION));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> publish own IP address: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, ownIpAddress_sts->toString()));
+  client_sts.publish(genTopics_stccpa[GEN_TOPIC_FW_IDENT], myVersion_FWIDENT, true);
+  client_sts.publish(genTopics_stccpa[GEN_TOPIC_FW_VERSION], myVersion_FWVERSION, true);
+  client_sts.publish(genTopics_stccpa[GEN_TOPIC_FW_DESC], myVersion_FWDESCRIPTION, true);
+  client_sts.publish(genTopics_stccpa[GEN_TOPIC_OWN_IP], buildPayload(ownIpAddress_sts->toString()), true);
+  client_sts.publish(genTopics_stccpa[GEN_TOPIC_CONN], buildPayload(String(connection_sts.GetLatency_u32())), true);
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>> publishing finished"));
+}
+
+/**---------------------------------------------------------------------------------------
+   @brief     This function runs the non blocking connection handling to the MQTT broker.
+                A broker outage does not block the main loop, the devices keep running
+                and the connection is retried with an increasing backoff. The config
+                portal is only started, if the broker was never reached since boot.
+   @author    winkste
+   @date      17 Okt. 2026
+   @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void processConnection()
+{
+  switch (connection_sts.Process_u8(millis()))
+  {
+    case MQTTCONN_EVENT_CONNECTED:
+      onConnected();
+      break;
+    case MQTTCONN_EVENT_LOST:
+      TRACE_ERROR(trace_st.print(trace_ERROR_MSG, "<<gen>> connection lost, rc="));
+      TRACE_ERROR(trace_st.println(trace_PURE_MSG, String(client_sts.state())));
+      break;
+    case MQTTCONN_EVENT_FAILED:
+      TRACE_ERROR(trace_st.print(trace_ERROR_MSG, "<<gen>>failed, rc="));
+      TRACE_ERROR(trace_st.print(trace_PURE_MSG, String(client_sts.state())));
+      TRACE_ERROR(trace_st.print(trace_PURE_MSG, ", attempt took "));
+      TRACE_ERROR(trace_st.print(trace_PURE_MSG, String(connection_sts.GetAttemptTime_u32())));
+      TRACE_ERROR(trace_st.print(trace_PURE_MSG, " ms, retry in "));
+      TRACE_ERROR(trace_st.print(trace_PURE_MSG, 
+                      String(connection_sts.GetIdleTime_u32(millis(), MQTTCONN_BACKOFF_MAX))));
+      TRACE_ERROR(trace_st.println(trace_PURE_MSG, " ms"));
+      break;
+    case MQTTCONN_EVENT_PORTAL:
+      TRACE_ERROR(trace_st.println(trace_ERROR_MSG, "<<gen>>Can't connect, starting AP"));
       wifiManager_sts.startConfigPortal(build_ssid(CONFIG_SSID)); // needs to be tested!
-    }
+      break;
+    default:
+      break;
   }
 }
 
@@ -427,7 +566,7 @@ void configModeCallback(WiFiManager *myWiFiManager)
   wifiManager_sts.setAPStaticIPConfig(IPAddress(192, 168, 4, 1),
                                       IPAddress(192, 168, 4, 255),
                                       IPAddress(255, 255, 255, 0));
-  trace_st.println(trace_INFO_MSG, "<<gen>>entered config mode");
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>>entered config mode"));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -446,24 +585,24 @@ void saveConfigCallback()
   sprintf(mqttData_sts.server_port, "%s", wifiManagerParamMqttServerPort_sts.getValue());
   sprintf(mqttData_sts.dev_short, "%s", wifiManagerParamMqttClientShort_sts.getValue());
   sprintf(mqttData_sts.room, "%s", wifiManagerParamMqttClientRoom_sts.getValue());
-  trace_st.println(trace_INFO_MSG, "======== Saving parameters: ========");
-  trace_st.print(trace_INFO_MSG, "mqtt ip: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.server_ip);
-  trace_st.print(trace_INFO_MSG, "mqtt port: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.server_port);
-  trace_st.print(trace_INFO_MSG, "mqtt user: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.login);
-  trace_st.print(trace_INFO_MSG, "mqtt pw: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.pw);
-  trace_st.print(trace_INFO_MSG, "mqtt dev short: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.dev_short);
-  trace_st.print(trace_INFO_MSG, "mqtt dev room location: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.room);
-  trace_st.print(trace_INFO_MSG, "capabilities: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.cap);
-  trace_st.print(trace_INFO_MSG, "trace channel: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.chan);
-  trace_st.println(trace_INFO_MSG, "======== End of parameters ========");
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "======== Saving parameters: ========"));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt ip: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.server_ip));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt port: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.server_port));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt user: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.login));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt pw: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.pw));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt dev short: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.dev_short));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt dev room location: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.room));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "capabilities: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.cap));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "trace channel: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.chan));
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "======== End of parameters ========"));
 
   char* temp = (char*) &mqttData_sts;
   for (unsigned int i = 0; i < sizeof(mqttData_sts); i++) {
@@ -481,7 +620,7 @@ void saveConfigCallback()
   wifiManagerParamMqttServerLogin_sts.setDefaultValue(&mqttData_sts.login[0], 16);
   wifiManagerParamMqttServerPw_sts.setDefaultValue(&mqttData_sts.pw[0], 16);
 
-  trace_st.println(trace_INFO_MSG, "<<gen>> configuration saved, restarting");
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>> configuration saved, restarting"));
   delay(2000);
   ESP.reset(); // we can't change from AP mode to client mode, thus: reboot
 }
@@ -514,30 +653,36 @@ void loadConfig()
   wifiManagerParamMqttServerLogin_sts.setDefaultValue(&mqttData_sts.login[0], 16);
   wifiManagerParamMqttServerPw_sts.setDefaultValue(&mqttData_sts.pw[0], 16);
 
-  trace_st.println(trace_INFO_MSG, "======== Loaded parameters: ========");
-  trace_st.print(trace_INFO_MSG, "mqtt ip: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.server_ip);
-  trace_st.print(trace_INFO_MSG, "mqtt port: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.server_port);
-  trace_st.print(trace_INFO_MSG, "mqtt user: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.login);
-  trace_st.print(trace_INFO_MSG, "mqtt pw: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.pw);
-  trace_st.print(trace_INFO_MSG, "mqtt dev short: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.dev_short);
-  trace_st.print(trace_INFO_MSG, "mqtt dev room: ");
-  trace_st.println(trace_PURE_MSG, mqttData_sts.room);
-  trace_st.print(trace_INFO_MSG, "capabilities: ");
-  trace_st.print(trace_PURE_MSG, mqttData_sts.cap);
-  trace_st.println(trace_PURE_MSG, (uint8_t)atoi(&mqttData_sts.cap[0]));
-  trace_st.print(trace_INFO_MSG, "channel: ");
-  trace_st.print(trace_PURE_MSG, mqttData_sts.chan);
-  trace_st.println(trace_PURE_MSG, (uint8_t)atoi(&mqttData_sts.chan[0]));
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "======== Loaded parameters: ========"));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt ip: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.server_ip));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt port: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.server_port));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt user: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.login));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt pw: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.pw));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt dev short: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.dev_short));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "mqtt dev room: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, mqttData_sts.room));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "capabilities: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, mqttData_sts.cap));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, (uint8_t)atoi(&mqttData_sts.cap[0])));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "channel: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, mqttData_sts.chan));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, (uint8_t)atoi(&mqttData_sts.chan[0])));
 
   // generate devices according to the selected capabilities
-  deviceList_pst = factory_st.GenerateDevice(atoi(&mqttData_sts.cap[0]));
+  devices_sts.Clear();
+  (void)factory_st.GenerateDevice(atoi(&mqttData_sts.cap[0]), &devices_sts);
+  // the publish policies continue with the values published before the deep sleep
+  if(true == PublishPolicy::RestoreFromRtc_bol())
+  {
+    TRACE_INFO(trace_st.println(trace_INFO_MSG, "publish policies restored"));
+  }
 
-  trace_st.println(trace_INFO_MSG, "======== End of parameters ========");
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "======== End of parameters ========"));
 }
 
 /**---------------------------------------------------------------------------------------
@@ -553,6 +698,48 @@ char* build_topic(const char *topic)
   return buffer_stca;
 }
 
+/**---------------------------------------------------------------------------------------
+   @brief     This function builds the generic topics and stores them in the topic pool,
+                it has to be called after the pool was cleared.
+   @author    winkste
+   @date      17 Okt. 2026
+   @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void cacheGenericTopics(void)
+{
+  const char *topics_ccpa[GEN_TOPICS] = {MQTT_SUB_COMMAND, MQTT_PUB_FW_IDENT,
+                                          MQTT_PUB_FW_VERSION, MQTT_PUB_FW_DESC,
+                                          MQTT_PUB_DEV_ROOM, MQTT_PUB_OWN_IP,
+                                          MQTT_PUB_CAP, MQTT_PUB_TRACE, 
+                                          MQTT_PUB_CONN, MQTT_SUB_WILDCARD,
+                                          MQTT_PUB_PROF};
+  uint8_t idx_u8;
+
+  for (idx_u8 = 0; idx_u8 < GEN_TOPICS; idx_u8++)
+  {
+    genTopics_stccpa[idx_u8] = topicPool_sts.Intern(build_topic(topics_ccpa[idx_u8]));
+    if (NULL == genTopics_stccpa[idx_u8])
+    {
+      TRACE_ERROR(trace_st.print(trace_ERROR_MSG, "<<gen>> topic not cached: "));
+      TRACE_ERROR(trace_st.println(trace_PURE_MSG, buffer_stca));
+      genTopics_stccpa[idx_u8] = "";
+    }
+  }
+}
+
+/**---------------------------------------------------------------------------------------
+   @brief     This function searches the index of a device in the device registry, 
+                the index identifies the device in the loop profile.
+   @author    winkste
+   @date      17 Okt. 2026
+   @param     device_p    pointer to the device
+   @return    index of the device or the size of the registry, if it is not found
+*//*-----------------------------------------------------------------------------------*/
+uint8_t deviceIndex_u8(const MqttDevice *device_p)
+{
+  return (devices_sts.IndexOf_u8(device_p));
+}
+
 /**---------------------------------------------------------------------------------------
    @brief     This function helps to build the ssid for the wifi config portal.
    @author    winkste
@@ -621,20 +808,18 @@ void OtaInitialize(void)
 *//*-----------------------------------------------------------------------------------*/
 void setupCallback()
 {
-  uint8_t idx_u8 = 0;
-
   // init the serial
   //Serial.begin(115200);
   // first task: initialize Trace
   trace_st.Initialize();
 
-  trace_st.println(trace_PURE_MSG, "");
-  trace_st.println(trace_INFO_MSG, "... starting");
-  trace_st.print(trace_INFO_MSG, "Firmware Information:");
-  trace_st.print(trace_PURE_MSG, myVersion_FWIDENT);
-  trace_st.println(trace_PURE_MSG, myVersion_FWVERSION);
-  trace_st.print(trace_INFO_MSG, "Firmware Description:");
-  trace_st.println(trace_PURE_MSG, myVersion_FWDESCRIPTION);
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, ""));
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "... starting"));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "Firmware Information:"));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, myVersion_FWIDENT));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, myVersion_FWVERSION));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "Firmware Description:"));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, myVersion_FWDESCRIPTION));
   EEPROM.begin(512); // can be up to 4096
 
   // start wifi manager
@@ -643,34 +828,67 @@ void setupCallback()
   wifiManager_sts.setConfigPortalTimeout(MAX_AP_TIME);
   WiFi.mode(WIFI_STA); // avoid station and ap at the same time
 
-  trace_st.println(trace_INFO_MSG, "<<gen>> connecting... ");
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>> connecting... "));
   if (!wifiManager_sts.autoConnect(build_ssid(CONFIG_SSID))) 
   {
     // possible situataion: Main power out, ESP went to config mode as the routers wifi wasn available on time ..
-    trace_st.println(trace_ERROR_MSG, "<<wifi>> failed to connect and hit timeout, restarting ...");
+    TRACE_ERROR(trace_st.println(trace_ERROR_MSG, 
+                    "<<wifi>> failed to connect and hit timeout, restarting ..."));
     delay(1000); // time for serial to print
     ESP.reset(); // reset loop if not only or configured after 5min ..
   }
 
   // load parameters from eeprom
+  MqttDevice::SetTopicRouter(&topicRouter_sts);
+  MqttDevice::SetTopicPool(&topicPool_sts);
+  MqttDevice::SetScheduler(&scheduler_sts);
+  MqttDevice::SetAdcSampler(&adc_sts);
+  MqttDevice::SetPublishQueue(&publishQueue_sts);
+  MqttDevice::SetSubscriber(&subscriber_sts);
   loadConfig();
 
   // initialize devices
-  idx_u8 = 0;
-  while (idx_u8 < deviceList_pst->size())
+  for (MqttDevice *device_p : devices_sts)
   {
-    deviceList_pst->get(idx_u8)->Initialize();
-    idx_u8++;
+    device_p->Initialize();
   }
 
-  trace_st.println(trace_INFO_MSG, "<<gen>> connected");
-  trace_st.print(trace_INFO_MSG, "<<gen>>  IP address: ");
-  trace_st.println(trace_PURE_MSG, WiFi.localIP().toString());
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> devices registered: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, devices_sts.GetSize_u8()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " of "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, devices_sts.GetCapacity_u8()));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> device arena RAM: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, String(factory_st.GetArenaUsed_u16())));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " of "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, String(DeviceFactory::GetArenaSize_u16())));
+
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> scheduler timers used: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, scheduler_sts.GetSize_u8()));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " of "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, (uint8_t)SCHEDULER_TIMERS));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> publish queue RAM: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, (uint16_t)sizeof(publishQueue_sts)));
+
+  // static RAM of the topic cache: pool, generic topics and the per device topic slots
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>> topic cache RAM: "));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, (uint16_t)(topicPool_sts.GetSize_u16() 
+                                  + sizeof(genTopics_stccpa)
+                                  + (devices_sts.GetSize_u8() * MQTTDEVICE_TOPICS 
+                                      * sizeof(const char *)))));
+  TRACE_INFO(trace_st.print(trace_PURE_MSG, " bytes, free heap: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, String(ESP.getFreeHeap())));
+
+  TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>> connected"));
+  TRACE_INFO(trace_st.print(trace_INFO_MSG, "<<gen>>  IP address: "));
+  TRACE_INFO(trace_st.println(trace_PURE_MSG, WiFi.localIP().toString()));
   ownIpAddress_sts = new IPAddress(WiFi.localIP());
 
   // init the MQTT connection
+  wifiClient_sts.setTimeout(CONNECT_TCP_TIMEOUT);
   client_sts.setServer(mqttData_sts.server_ip, atoi(mqttData_sts.server_port));
   client_sts.setCallback(callback);
+  connection_sts.Configure(mqttData_sts.dev_short, mqttData_sts.login, mqttData_sts.pw);
+  connection_sts.SetSeed(ESP.getChipId() ^ micros());
 
   OtaInitialize();
 }
@@ -683,34 +901,56 @@ void setupCallback()
 *//*-----------------------------------------------------------------------------------*/
 void loopCallback()
 {
+  uint32_t idleStart_u32;
+  uint32_t idleTime_u32;
+  uint32_t loopStart_u32 = micros();
 
   ArduinoOTA.handle();
 
-  if (!client_sts.connected())
-  {
-    reconnect();
-  }
+  processConnection();
   client_sts.loop();
 
-  //// check for publish requests, but keep an minimum time between two publifications
-  if (millis() - timerLastPub_u32st > PUBLISH_TIME_OFFSET)
+  // execute the expired device timers, the devices queue the resulting publications
+  (void)scheduler_sts.TakeWakeup_bol();
+  scheduler_sts.Process_u8(millis());
+  processPublishRequests();
+  // one ADC burst per loop, further requested bursts keep the loop awake
+  if(0 != adc_sts.Process_u8())
   {
-    processPublishRequests();
-    timerRepubAvoid_u32st = millis();
-    timerLastPub_u32st = millis();
-
-    trace_st.PushToChannel();
+    scheduler_sts.Wakeup();
   }
+  // send as many queued messages as the socket accepts, the rest stays queued
+  publishQueue_sts.flush();
+  trace_st.PushToChannel();
 
   // check for a re-configuration trigger
   if ((true == startWifiConfig_bolst) || MqttDevice::GetReconfigRequest())
   {
     startWifiConfig_bolst = false;
-    trace_st.println(trace_INFO_MSG, "<<gen>> Rebooting to setup mode");
+    TRACE_INFO(trace_st.println(trace_INFO_MSG, "<<gen>> Rebooting to setup mode"));
     delay(200);
     wifiManager_sts.startConfigPortal(build_ssid(CONFIG_SSID)); // needs to be tested!
     //ESP.reset(); // reboot and switch to setup mode right after that
   }
+
+  // the idle time is not part of the loop profile
+  profiler_sts.RecordLoop(loopStart_u32);
+
+  // sleep until the next timer expires, an interrupt requests a wakeup or data arrives
+  idleStart_u32 = millis();
+  idleTime_u32 = scheduler_sts.GetIdleTime_u32(idleStart_u32, LOOP_IDLE_MAX_TIME);
+  idleTime_u32 = connection_sts.GetIdleTime_u32(idleStart_u32, idleTime_u32);
+  if (0 != publishQueue_sts.depth())
+  {
+    // the publish queue is not empty, flush it with the next loop without sleeping
+    idleTime_u32 = 0;
+  }
+  while ((millis() - idleStart_u32 < idleTime_u32) 
+          && (0 == wifiClient_sts.available()) 
+          && (false == scheduler_sts.TakeWakeup_bol()))
+  {
+    delay(LOOP_IDLE_SLICE_TIME);
+  }
 }
 
 /**---------------------------------------------------------------------------------------
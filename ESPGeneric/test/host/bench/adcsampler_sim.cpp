@@ -0,0 +1,188 @@
+/*****************************************************************************************
+* FILENAME :        adcsampler_sim.cpp
+*
+* DESCRIPTION :
+*       Host test of the shared ADC sampler with a simulated noisy input
+*
+* NOTES :
+*       The analog hook of the stubs delivers a constant level with a small 
+*       deterministic noise and, on request, a spike every fifth conversion as it
+*       is seen during WiFi transmissions. The test checks the median against the
+*       spikes, the mean of a burst, the settling of the moving average and the
+*       turn taking of two consumers.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs test/host/bench/adcsampler_sim.cpp
+*           src/AdcSampler.cpp test/host/stubs/Arduino.cpp -o adcsim
+*       ./adcsim
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include "Arduino.h"
+#include "AdcSampler.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define SPIKE_VALUE                 1023
+#define SPIKE_PERIOD                5u
+#define NOISE_PERIOD                3u
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Local data */
+static int level_s32 = 0;
+static bool spikes_bol = false;
+static uint32_t conversions_u32 = 0;
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Simulated analog input, level with -1/0/+1 noise and optional spikes
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     pin         analog pin
+ * @return    conversion result
+*//*-----------------------------------------------------------------------------------*/
+static int Input(uint8_t pin)
+{
+    conversions_u32++;
+    if((true == spikes_bol) && (0u == (conversions_u32 % SPIKE_PERIOD)))
+    {
+        return(SPIKE_VALUE);
+    }
+    return(level_s32 + (int)(conversions_u32 % NOISE_PERIOD) - 1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Requests and serves one burst of a single consumer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     adc_p       sampler
+ * @param     id_u8       consumer id
+ * @return    filtered value
+*//*-----------------------------------------------------------------------------------*/
+static uint16_t Sample_u16(AdcSampler *adc_p, uint8_t id_u8)
+{
+    uint16_t value_u16 = 0;
+
+    (void)adc_p->Request_bol(id_u8);
+    (void)adc_p->Process_u8();
+    (void)adc_p->Take_bol(id_u8, &value_u16);
+    return(value_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Prints and counts the result of one check
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     pass_bol    result of the check
+ * @param     name_ccp    name of the check
+ * @param     value_s32   measured value
+ * @return    1 for a failed check, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Check(bool pass_bol, const char *name_ccp, long value_s32)
+{
+    printf("%s %-26s %ld\n", pass_bol ? "PASS" : "FAIL", name_ccp, value_s32);
+    return(pass_bol ? 0 : 1);
+}
+
+/****************************************************************************************/
+/* Main */
+int main(void)
+{
+    const adcConfig_t median_st = {8u, ADCSAMPLER_MEDIAN, 0u};
+    const adcConfig_t mean_st = {6u, ADCSAMPLER_MEAN, 0u};
+    const adcConfig_t ema_st = {8u, ADCSAMPLER_MEDIAN, 2u};
+    AdcSampler adc_st(A0);
+    uint8_t median_u8;
+    uint8_t mean_u8;
+    uint8_t ema_u8;
+    uint16_t value_u16 = 0;
+    uint8_t idx_u8;
+    uint8_t pending_u8;
+    int failed_s32 = 0;
+
+    host_SetAnalogHook(Input);
+    median_u8 = adc_st.Register_u8(&median_st);
+    mean_u8 = adc_st.Register_u8(&mean_st);
+    failed_s32 += Check(ADCSAMPLER_INVALID == adc_st.Register_u8(&ema_st), 
+                        "consumers limited", adc_st.GetSize_u8());
+    failed_s32 += Check(false == adc_st.Take_bol(median_u8, &value_u16), 
+                        "nothing before request", 0);
+
+    // the median removes the spikes, the mean of the noise is the level
+    level_s32 = 500;
+    spikes_bol = true;
+    value_u16 = Sample_u16(&adc_st, median_u8);
+    failed_s32 += Check((value_u16 >= 499u) && (value_u16 <= 501u), 
+                        "median rejects spikes", value_u16);
+    failed_s32 += Check(false == adc_st.Take_bol(median_u8, &value_u16), 
+                        "value taken once", 0);
+    spikes_bol = false;
+    value_u16 = Sample_u16(&adc_st, mean_u8);
+    failed_s32 += Check(500u == value_u16, "mean of noise", value_u16);
+
+    // two requests are served one per call in turn
+    (void)adc_st.Request_bol(median_u8);
+    (void)adc_st.Request_bol(mean_u8);
+    conversions_u32 = 0;
+    pending_u8 = adc_st.Process_u8();
+    failed_s32 += Check((1u == pending_u8) && (8u == conversions_u32), 
+                        "one burst per call", conversions_u32);
+    pending_u8 = adc_st.Process_u8();
+    failed_s32 += Check((0u == pending_u8) && (14u == conversions_u32)
+                        && (true == adc_st.Take_bol(median_u8, &value_u16))
+                        && (true == adc_st.Take_bol(mean_u8, &value_u16)), 
+                        "both consumers served", conversions_u32);
+
+    // the moving average settles on a step within a few bursts
+    AdcSampler emaAdc_st(A0);
+    ema_u8 = emaAdc_st.Register_u8(&ema_st);
+    level_s32 = 100;
+    value_u16 = Sample_u16(&emaAdc_st, ema_u8);
+    failed_s32 += Check(100u == value_u16, "ema starts at first value", value_u16);
+    level_s32 = 300;
+    value_u16 = Sample_u16(&emaAdc_st, ema_u8);
+    failed_s32 += Check(150u == value_u16, "ema quarter step", value_u16);
+    for(idx_u8 = 0; idx_u8 < 20u; idx_u8++)
+    {
+        value_u16 = Sample_u16(&emaAdc_st, ema_u8);
+    }
+    failed_s32 += Check((value_u16 >= 299u) && (value_u16 <= 300u), 
+                        "ema settled", value_u16);
+
+    host_SetAnalogHook(NULL);
+    printf("%d checks failed\n", failed_s32);
+    return((0 == failed_s32) ? 0 : 1);
+}
@@ -0,0 +1,325 @@
+/*****************************************************************************************
+* FILENAME :        bme280_vectors.cpp
+*
+* DESCRIPTION :
+*       Host test of the forced mode BME280 reader with raw register vectors
+*
+* NOTES :
+*       Every vector is a calibration and the raw data registers of one 
+*       measurement. They are loaded into the simulated I2C device of the stubs,
+*       the reader runs its real I2C path. The first vector is the compensation
+*       example of the Bosch datasheet with known results. All vectors are
+*       checked against the double precision formulas of the datasheet.
+*       The test also checks the control register writes and the number of I2C 
+*       transactions of one sample.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs test/host/bench/bme280_vectors.cpp
+*           src/Bme280Reader.cpp test/host/stubs/Arduino.cpp -o bme280vec
+*       ./bme280vec
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "Arduino.h"
+#include "Wire.h"
+#include "Bme280Reader.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define REG_CALIB_TP                0x88u
+#define REG_CHIP_ID                 0xD0u
+#define REG_CALIB_H                 0xE1u
+#define REG_CTRL_HUM                0xF2u
+#define REG_CTRL_MEAS               0xF4u
+#define REG_DATA                    0xF7u
+
+// two control writes, the register address write and the burst read
+#define SAMPLE_TRANSACTIONS         4u
+#define NOT_CHECKED                 -1l
+
+// deviation of the integer compensation from the double formulas
+#define TOLERANCE_TEMPERATURE       0.01
+#define TOLERANCE_PRESSURE          1.0
+#define TOLERANCE_HUMIDITY          0.05
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct vector_tag
+{
+    const char      *name_ccp;
+    bme280Calib_t   calib_st;
+    int32_t         adcT_s32;
+    int32_t         adcP_s32;
+    int32_t         adcH_s32;
+    // exact results, NOT_CHECKED if only the double formulas are compared
+    int32_t         temperature_s32;
+    int64_t         pressure_s64;
+}vector_t;
+
+/****************************************************************************************/
+/* Local data definitions */
+static const vector_t vectors_stca[] =
+{
+    // datasheet example: t_fine 128422, 25.08 degC and 100653 Pa
+    { "datasheet", { 27504u, 26435, -1000, 36477u, -10685, 3024, 2855, 140, -7, 15500, 
+                    -14600, 6000, 75u, 362, 0u, 313, 50, 30 }, 
+        519888l, 415148l, 27000l, 2508l, 25767233ll },
+    { "room", { 28485u, 26735, 50, 36738u, -10635, 3024, 6980, -4, -7, 9900, -10230, 4285, 
+                    75u, 362, 0u, 328, 0, 30 },
+        528000l, 330000l, 27500l, NOT_CHECKED, NOT_CHECKED },
+    { "frost", { 28485u, 26735, 50, 36738u, -10635, 3024, 6980, -4, -7, 9900, -10230, 4285, 
+                    75u, 362, 0u, 328, 0, 30 },
+        470000l, 345000l, 33000l, NOT_CHECKED, NOT_CHECKED },
+    { "humid", { 27890u, 26532, 50, 37432u, -10580, 3024, 7215, 11, -7, 9900, -10230, 4285, 
+                    75u, 366, 0u, 305, 50, 30 },
+        545000l, 310000l, 38000l, NOT_CHECKED, NOT_CHECKED },
+    { "dry", { 27890u, 26532, 50, 37432u, -10580, 3024, 7215, 11, -7, 9900, -10230, 4285, 
+                    75u, 366, 0u, 305, 50, 30 },
+        545000l, 310000l, 18000l, NOT_CHECKED, NOT_CHECKED }
+};
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Stores a 16 bit value little endian
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     data_pu8    destination
+ * @param     value_u16   value
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void PutLe16(uint8_t *data_pu8, uint16_t value_u16)
+{
+    data_pu8[0] = (uint8_t)value_u16;
+    data_pu8[1] = (uint8_t)(value_u16 >> 8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Loads the calibration and the raw data of a vector into the simulated 
+ *              sensor registers
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     vector_p    vector
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void LoadRegisters(const vector_t *vector_p)
+{
+    const bme280Calib_t *calib_p = &vector_p->calib_st;
+    uint8_t tp_u8a[BME280READER_CALIB_TP_BYTES];
+    uint8_t h_u8a[BME280READER_CALIB_H_BYTES];
+    uint8_t data_u8a[BME280READER_DATA_BYTES];
+    uint8_t chipId_u8 = BME280READER_CHIP_ID;
+
+    memset(tp_u8a, 0, sizeof(tp_u8a));
+    PutLe16(&tp_u8a[0], calib_p->t1_u16);
+    PutLe16(&tp_u8a[2], (uint16_t)calib_p->t2_s16);
+    PutLe16(&tp_u8a[4], (uint16_t)calib_p->t3_s16);
+    PutLe16(&tp_u8a[6], calib_p->p1_u16);
+    PutLe16(&tp_u8a[8], (uint16_t)calib_p->p2_s16);
+    PutLe16(&tp_u8a[10], (uint16_t)calib_p->p3_s16);
+    PutLe16(&tp_u8a[12], (uint16_t)calib_p->p4_s16);
+    PutLe16(&tp_u8a[14], (uint16_t)calib_p->p5_s16);
+    PutLe16(&tp_u8a[16], (uint16_t)calib_p->p6_s16);
+    PutLe16(&tp_u8a[18], (uint16_t)calib_p->p7_s16);
+    PutLe16(&tp_u8a[20], (uint16_t)calib_p->p8_s16);
+    PutLe16(&tp_u8a[22], (uint16_t)calib_p->p9_s16);
+    tp_u8a[25] = calib_p->h1_u8;
+    PutLe16(&h_u8a[0], (uint16_t)calib_p->h2_s16);
+    h_u8a[2] = calib_p->h3_u8;
+    h_u8a[3] = (uint8_t)(calib_p->h4_s16 >> 4);
+    h_u8a[4] = (uint8_t)((calib_p->h4_s16 & 0x0F) | ((calib_p->h5_s16 & 0x0F) << 4));
+    h_u8a[5] = (uint8_t)(calib_p->h5_s16 >> 4);
+    h_u8a[6] = (uint8_t)calib_p->h6_s8;
+
+    data_u8a[0] = (uint8_t)(vector_p->adcP_s32 >> 12);
+    data_u8a[1] = (uint8_t)(vector_p->adcP_s32 >> 4);
+    data_u8a[2] = (uint8_t)(vector_p->adcP_s32 << 4);
+    data_u8a[3] = (uint8_t)(vector_p->adcT_s32 >> 12);
+    data_u8a[4] = (uint8_t)(vector_p->adcT_s32 >> 4);
+    data_u8a[5] = (uint8_t)(vector_p->adcT_s32 << 4);
+    data_u8a[6] = (uint8_t)(vector_p->adcH_s32 >> 8);
+    data_u8a[7] = (uint8_t)vector_p->adcH_s32;
+
+    host_SetI2cDevice(BME280READER_ADDRESS);
+    host_SetI2cRegisters(REG_CHIP_ID, &chipId_u8, 1u);
+    host_SetI2cRegisters(REG_CALIB_TP, tp_u8a, sizeof(tp_u8a));
+    host_SetI2cRegisters(REG_CALIB_H, h_u8a, sizeof(h_u8a));
+    host_SetI2cRegisters(REG_DATA, data_u8a, sizeof(data_u8a));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Double precision compensation of chapter 8.1 of the datasheet
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     vector_p        vector
+ * @param     temperature_pf  returns the temperature in degC
+ * @param     pressure_pf     returns the pressure in Pa
+ * @param     humidity_pf     returns the humidity in %RH
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void Reference(const vector_t *vector_p, double *temperature_pf, double *pressure_pf,
+                        double *humidity_pf)
+{
+    const bme280Calib_t *c_p = &vector_p->calib_st;
+    double adcT = vector_p->adcT_s32;
+    double adcP = vector_p->adcP_s32;
+    double adcH = vector_p->adcH_s32;
+    double var1;
+    double var2;
+    double tFine;
+    double p;
+    double h;
+
+    var1 = (adcT / 16384.0 - c_p->t1_u16 / 1024.0) * c_p->t2_s16;
+    var2 = (adcT / 131072.0 - c_p->t1_u16 / 8192.0) 
+            * (adcT / 131072.0 - c_p->t1_u16 / 8192.0) * c_p->t3_s16;
+    tFine = (double)(int32_t)(var1 + var2);
+    *temperature_pf = (var1 + var2) / 5120.0;
+
+    var1 = (tFine / 2.0) - 64000.0;
+    var2 = var1 * var1 * c_p->p6_s16 / 32768.0;
+    var2 = var2 + var1 * c_p->p5_s16 * 2.0;
+    var2 = (var2 / 4.0) + (c_p->p4_s16 * 65536.0);
+    var1 = (c_p->p3_s16 * var1 * var1 / 524288.0 + c_p->p2_s16 * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * c_p->p1_u16;
+    p = 1048576.0 - adcP;
+    p = (p - (var2 / 4096.0)) * 6250.0 / var1;
+    var1 = c_p->p9_s16 * p * p / 2147483648.0;
+    var2 = p * c_p->p8_s16 / 32768.0;
+    *pressure_pf = p + (var1 + var2 + c_p->p7_s16) / 16.0;
+
+    h = tFine - 76800.0;
+    h = (adcH - (c_p->h4_s16 * 64.0 + c_p->h5_s16 / 16384.0 * h)) 
+        * (c_p->h2_s16 / 65536.0 * (1.0 + c_p->h6_s8 / 67108864.0 * h 
+        * (1.0 + c_p->h3_u8 / 67108864.0 * h)));
+    h = h * (1.0 - c_p->h1_u8 * h / 524288.0);
+    *humidity_pf = (h > 100.0) ? 100.0 : ((h < 0.0) ? 0.0 : h);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Runs one vector through the reader like one report of the Bme280Sensor
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     vector_p    vector
+ * @return    true, if the sample matches
+*//*-----------------------------------------------------------------------------------*/
+static bool RunVector(const vector_t *vector_p)
+{
+    Bme280Reader reader(BME280READER_ADDRESS);
+    bme280Sample_t sample_st;
+    double temperature_f;
+    double pressure_f;
+    double humidity_f;
+    uint32_t transactions_u32;
+    bool pass_bol;
+
+    LoadRegisters(vector_p);
+    Reference(vector_p, &temperature_f, &pressure_f, &humidity_f);
+
+    pass_bol = reader.Begin_bol();
+    transactions_u32 = host_GetI2cTransactions();
+    pass_bol = pass_bol && reader.StartMeasurement_bol();
+    pass_bol = pass_bol && (0x01u == host_GetI2cRegister(REG_CTRL_HUM)) 
+                        && (0x25u == host_GetI2cRegister(REG_CTRL_MEAS));
+    host_AdvanceMillis(BME280READER_MEAS_TIME);
+    pass_bol = pass_bol && reader.ReadSample_bol(&sample_st);
+    transactions_u32 = host_GetI2cTransactions() - transactions_u32;
+    pass_bol = pass_bol && (SAMPLE_TRANSACTIONS == transactions_u32);
+
+    if((true == pass_bol) && (NOT_CHECKED != vector_p->temperature_s32))
+    {
+        pass_bol = (vector_p->temperature_s32 == sample_st.temperature_s32)
+                    && (vector_p->pressure_s64 == (int64_t)sample_st.pressure_u32);
+    }
+    pass_bol = pass_bol 
+        && (fabs((sample_st.temperature_s32 / 100.0) - temperature_f) <= TOLERANCE_TEMPERATURE)
+        && (fabs((sample_st.pressure_u32 / 256.0) - pressure_f) <= TOLERANCE_PRESSURE)
+        && (fabs((sample_st.humidity_u32 / 1024.0) - humidity_f) <= TOLERANCE_HUMIDITY);
+
+    printf("%s %-10s %u transactions, %.2f C %.2f Pa %.3f %%RH, "
+            "reference %.2f C %.2f Pa %.3f %%RH\n",
+            (true == pass_bol) ? "PASS" : "FAIL", vector_p->name_ccp, transactions_u32,
+            sample_st.temperature_s32 / 100.0, sample_st.pressure_u32 / 256.0, 
+            sample_st.humidity_u32 / 1024.0, temperature_f, pressure_f, humidity_f);
+    return(pass_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Checks the rejection of a missing sensor and of a skipped measurement
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    true, if both are rejected
+*//*-----------------------------------------------------------------------------------*/
+static bool RunFailures(void)
+{
+    Bme280Reader missing(BME280READER_ADDRESS);
+    Bme280Reader skipped(BME280READER_ADDRESS);
+    bme280Sample_t sample_st;
+    uint8_t skipped_u8a[3] = { 0x80u, 0x00u, 0x00u };
+    bool pass_bol;
+
+    host_SetI2cDevice(HOST_I2C_NO_DEVICE);
+    pass_bol = (false == missing.Begin_bol()) && (false == missing.ReadSample_bol(&sample_st));
+
+    LoadRegisters(&vectors_stca[0]);
+    host_SetI2cRegisters(REG_DATA + 3u, skipped_u8a, sizeof(skipped_u8a));
+    pass_bol = pass_bol && skipped.Begin_bol() && skipped.StartMeasurement_bol()
+                && (false == skipped.ReadSample_bol(&sample_st));
+
+    printf("%s failures   missing sensor and skipped temperature rejected\n", 
+            (true == pass_bol) ? "PASS" : "FAIL");
+    return(pass_bol);
+}
+
+/****************************************************************************************/
+/* Main */
+int main(void)
+{
+    int failed_s32 = 0;
+    size_t idx_u32;
+
+    for(idx_u32 = 0; idx_u32 < (sizeof(vectors_stca) / sizeof(vectors_stca[0])); idx_u32++)
+    {
+        if(false == RunVector(&vectors_stca[idx_u32]))
+        {
+            failed_s32++;
+        }
+    }
+    if(false == RunFailures())
+    {
+        failed_s32++;
+    }
+    printf("%d checks failed\n", failed_s32);
+    return((0 == failed_s32) ? 0 : 1);
+}
@@ -0,0 +1,309 @@
+/*****************************************************************************************
+* FILENAME :        dhtreader_replay.cpp
+*
+* DESCRIPTION :
+*       Host replay of DHT22 edge fixtures through the DhtReader interrupt
+*
+* NOTES :
+*       Every fixture in bench/dht holds the edges of one frame as level after the
+*       edge and the time since the previous edge in us. The replay advances the
+*       simulated clock, sets the pin level and triggers the pin interrupt, so the
+*       reader runs its real interrupt path. The decoded frame is compared with
+*       the "# expect" line of the fixture, which holds the frame bytes or the
+*       expected status (no_response, incomplete, checksum). The "# sample" line
+*       holds the expected humidity and temperature of a valid frame.
+*       Every fixture is replayed alone and a second time together with the next
+*       fixture on another pin, like the two sensors of a double DHT board that
+*       are captured in the same loop iteration.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs test/host/bench/dhtreader_replay.cpp
+*           src/DhtReader.cpp test/host/stubs/Arduino.cpp -o dhtreplay
+*       ./dhtreplay test/host/bench/dht/*.edges
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "Arduino.h"
+#include "DhtReader.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define DATA_PIN                    12u
+#define DATA_PIN_SECOND             13u
+#define LINE_SIZE                   128u
+#define FIXTURE_EDGES               128u
+#define EXPECT_TAG                  "# expect "
+#define SAMPLE_TAG                  "# sample "
+#define SAMPLE_TOLERANCE            0.05F
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct fixture_tag
+{
+    const char      *file_ccp;
+    dhtStatus_t     status_en;
+    unsigned int    frame_ua[DHTREADER_FRAME_BYTES];
+    bool            sample_bol;
+    float           humidity_f32;
+    float           temperature_f32;
+    uint16_t        edges_u16;
+    uint8_t         level_u8a[FIXTURE_EDGES];
+    // time of the edge in us since the start of the capture
+    uint32_t        time_u32a[FIXTURE_EDGES];
+}fixture_t;
+
+/****************************************************************************************/
+/* Local data definitions */
+static const char * const statusName_stccpa[] =
+{
+    "ok", "no_response", "incomplete", "checksum"
+};
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Loads the expectation and the edges of one fixture
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     file_ccp    fixture file
+ * @param     fixture_p   returns the fixture
+ * @return    true, if the fixture was loaded
+*//*-----------------------------------------------------------------------------------*/
+static bool Load(const char *file_ccp, fixture_t *fixture_p)
+{
+    FILE *file_p = fopen(file_ccp, "r");
+    char line_ca[LINE_SIZE];
+    char status_ca[LINE_SIZE];
+    unsigned int level_u32;
+    unsigned int us_u32;
+    uint32_t time_u32 = 0;
+    uint8_t idx_u8;
+
+    memset(fixture_p, 0, sizeof(fixture_t));
+    fixture_p->file_ccp = file_ccp;
+    if(NULL == file_p)
+    {
+        printf("FAIL %s: cannot open\n", file_ccp);
+        return(false);
+    }
+
+    while(NULL != fgets(line_ca, sizeof(line_ca), file_p))
+    {
+        if(0 == strncmp(line_ca, EXPECT_TAG, strlen(EXPECT_TAG)))
+        {
+            fixture_p->status_en = DHTREADER_OK;
+            if(DHTREADER_FRAME_BYTES != sscanf(&line_ca[strlen(EXPECT_TAG)], 
+                                    "%x %x %x %x %x", &fixture_p->frame_ua[0], 
+                                    &fixture_p->frame_ua[1], &fixture_p->frame_ua[2], 
+                                    &fixture_p->frame_ua[3], &fixture_p->frame_ua[4]))
+            {
+                sscanf(&line_ca[strlen(EXPECT_TAG)], "%127s", status_ca);
+                for(idx_u8 = 0; idx_u8 <= DHTREADER_CHECKSUM_ERROR; idx_u8++)
+                {
+                    if(0 == strcmp(status_ca, statusName_stccpa[idx_u8]))
+                    {
+                        fixture_p->status_en = (dhtStatus_t)idx_u8;
+                    }
+                }
+            }
+        }
+        else if(0 == strncmp(line_ca, SAMPLE_TAG, strlen(SAMPLE_TAG)))
+        {
+            fixture_p->sample_bol = (2 == sscanf(&line_ca[strlen(SAMPLE_TAG)], "%f %f",
+                                    &fixture_p->humidity_f32, 
+                                    &fixture_p->temperature_f32));
+        }
+        else if((2 == sscanf(line_ca, "%u %u", &level_u32, &us_u32)) 
+                    && (fixture_p->edges_u16 < FIXTURE_EDGES))
+        {
+            time_u32 += us_u32;
+            fixture_p->level_u8a[fixture_p->edges_u16] = (0u != level_u32) ? HIGH : LOW;
+            fixture_p->time_u32a[fixture_p->edges_u16] = time_u32;
+            fixture_p->edges_u16++;
+        }
+    }
+    fclose(file_p);
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Compares the sample of a reader with the fixture expectation
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     fixture_p   fixture of the replayed frame
+ * @param     reader_p    reader after the capture
+ * @param     mode_ccp    replay mode for the report
+ * @return    true, if the sample matches the expectation
+*//*-----------------------------------------------------------------------------------*/
+static bool Check(const fixture_t *fixture_p, const DhtReader *reader_p, 
+                    const char *mode_ccp)
+{
+    uint8_t data_u8a[DHTREADER_FRAME_BYTES];
+    dhtSample_t sample_st;
+    bool pass_bol;
+    uint8_t idx_u8;
+
+    reader_p->Decode_en(data_u8a);
+    pass_bol = (fixture_p->status_en == reader_p->Sample_en(&sample_st));
+    for(idx_u8 = 0; (true == pass_bol) && (DHTREADER_OK == sample_st.status_en) 
+                        && (idx_u8 < DHTREADER_FRAME_BYTES); idx_u8++)
+    {
+        pass_bol = (data_u8a[idx_u8] == fixture_p->frame_ua[idx_u8]);
+    }
+    if((true == pass_bol) && (true == fixture_p->sample_bol))
+    {
+        pass_bol = (fabsf(sample_st.humidity_f32 - fixture_p->humidity_f32) < SAMPLE_TOLERANCE)
+            && (fabsf(sample_st.temperature_f32 - fixture_p->temperature_f32) < SAMPLE_TOLERANCE);
+    }
+
+    printf("%s %s %s: %u edges, ", (true == pass_bol) ? "PASS" : "FAIL", mode_ccp, 
+            fixture_p->file_ccp, reader_p->GetEdges_u8());
+    if(DHTREADER_OK == sample_st.status_en)
+    {
+        printf("frame %02X %02X %02X %02X %02X, %.1f %%RH %.1f C\n", data_u8a[0], 
+                data_u8a[1], data_u8a[2], data_u8a[3], data_u8a[4], 
+                sample_st.humidity_f32, sample_st.temperature_f32);
+    }
+    else
+    {
+        printf("frame rejected, %s\n", statusName_stccpa[sample_st.status_en]);
+    }
+    return(pass_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Replays the frames of up to two fixtures at the same time, each on its own
+ *              pin and reader
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     first_p     fixture replayed on DATA_PIN
+ * @param     second_p    fixture replayed on DATA_PIN_SECOND or NULL
+ * @return    true, if all samples match the expectation
+*//*-----------------------------------------------------------------------------------*/
+static bool Replay(const fixture_t *first_p, const fixture_t *second_p)
+{
+    DhtReader first(DATA_PIN);
+    DhtReader second(DATA_PIN_SECOND);
+    const fixture_t *fixture_pa[2] = { first_p, second_p };
+    const uint8_t pin_u8a[2] = { DATA_PIN, DATA_PIN_SECOND };
+    uint16_t next_u16a[2] = { 0, 0 };
+    uint32_t now_u32 = 0;
+    uint8_t idx_u8;
+    bool pass_bol;
+
+    host_SetDigitalInput(DATA_PIN, HIGH);
+    host_SetDigitalInput(DATA_PIN_SECOND, HIGH);
+    first.Begin();
+    first.StartSignal();
+    if(NULL != second_p)
+    {
+        second.Begin();
+        second.StartSignal();
+    }
+    host_AdvanceMillis(DHTREADER_START_TIME);
+    first.StartCapture();
+    if(NULL != second_p)
+    {
+        second.StartCapture();
+    }
+
+    while(true)
+    {
+        // the earliest pending edge of both lines is next
+        uint8_t pick_u8 = 2u;
+        for(idx_u8 = 0; idx_u8 < 2u; idx_u8++)
+        {
+            if((NULL != fixture_pa[idx_u8]) 
+                && (next_u16a[idx_u8] < fixture_pa[idx_u8]->edges_u16)
+                && ((2u == pick_u8) 
+                    || (fixture_pa[idx_u8]->time_u32a[next_u16a[idx_u8]] 
+                        < fixture_pa[pick_u8]->time_u32a[next_u16a[pick_u8]])))
+            {
+                pick_u8 = idx_u8;
+            }
+        }
+        if(2u == pick_u8)
+        {
+            break;
+        }
+        host_AdvanceMicros(fixture_pa[pick_u8]->time_u32a[next_u16a[pick_u8]] - now_u32);
+        now_u32 = fixture_pa[pick_u8]->time_u32a[next_u16a[pick_u8]];
+        host_SetDigitalInput(pin_u8a[pick_u8], 
+                                fixture_pa[pick_u8]->level_u8a[next_u16a[pick_u8]]);
+        host_TriggerInterrupt(pin_u8a[pick_u8]);
+        next_u16a[pick_u8]++;
+    }
+
+    host_AdvanceMillis(DHTREADER_FRAME_TIME);
+    first.StopCapture();
+    second.StopCapture();
+
+    pass_bol = Check(first_p, &first, (NULL == second_p) ? "single" : "pair");
+    if(NULL != second_p)
+    {
+        pass_bol = Check(second_p, &second, "pair") && pass_bol;
+    }
+    return(pass_bol);
+}
+
+/****************************************************************************************/
+/* Main */
+int main(int argc, char **argv)
+{
+    static fixture_t fixtures_sta[2];
+    int failed_s32 = 0;
+    int idx_s32;
+
+    if(argc < 2)
+    {
+        printf("usage: %s fixture.edges...\n", argv[0]);
+        return(2);
+    }
+    for(idx_s32 = 1; idx_s32 < argc; idx_s32++)
+    {
+        if((false == Load(argv[idx_s32], &fixtures_sta[0]))
+            || (false == Replay(&fixtures_sta[0], NULL)))
+        {
+            failed_s32++;
+        }
+        else if((argc > 2) 
+            && ((false == Load(argv[(idx_s32 % (argc - 1)) + 1], &fixtures_sta[1]))
+                || (false == Replay(&fixtures_sta[0], &fixtures_sta[1]))))
+        {
+            failed_s32++;
+        }
+    }
+    printf("%d of %d fixtures failed\n", failed_s32, argc - 1);
+    return((0 == failed_s32) ? 0 : 1);
+}
@@ -0,0 +1,445 @@
+/*****************************************************************************************
+* FILENAME :        heapmonitor_sim.cpp
+*
+* DESCRIPTION :
+*       Host simulation of the heap monitor on a fake allocator
+*
+* NOTES :
+*       A first fit allocator on a 40 kB arena replaces the ESP heap, the 
+*       fragmentation is calculated like the umm_malloc of the ESP8266 core. The
+*       simulation runs three phases: steady String churn, a churn phase, which
+*       fills the arena with buffers and small values and then releases all
+*       buffers, so the values fragment the arena, and the release of the values. The heap monitor runs
+*       on the scheduler with the simulated clock and all publications of the
+*       monitor are printed.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs -I lib/PubSubClient/src
+*           test/host/bench/heapmonitor_sim.cpp src/HeapMonitor.cpp src/MqttDevice.cpp 
+*           src/Scheduler.cpp src/TopicPool.cpp src/TopicRouter.cpp src/Trace.cpp
+*           src/TraceRing.cpp src/TraceFormat.cpp src/MqttPayload.cpp src/Utils.cpp
+*           lib/PubSubClient/src/PubSubClient.cpp lib/PubSubClient/src/PubSubQueue.cpp
+*           lib/PubSubClient/src/PubSubSubscriber.cpp test/host/stubs/Arduino.cpp -o heapsim
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "Arduino.h"
+#include "Client.h"
+#include "PubSubClient.h"
+#include "Scheduler.h"
+#include "TopicPool.h"
+#include "Trace.h"
+#include "HeapMonitor.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define ARENA_SIZE                  40960u
+#define MAX_BLOCKS                  512u
+#define MAX_LIVING                  256u
+#define SYSTEM_USED                 8192u   // static allocations of the firmware
+#define STRING_SIZE                 64u
+#define BUFFER_SIZE                 256u    // e.g. a connection buffer
+#define VALUE_SIZE                  32u     // e.g. a configuration value
+#define STEADY_TIME                 300u    // seconds per phase
+#define CHURN_TIME                  600u
+#define RELEASE_TIME                300u
+#define TX_SIZE                     4096u
+#define INVALID_BLOCK               0xFFFFu
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct block_tag
+{
+    uint16_t    size_u16;
+    bool        used_bol;
+}block_t;
+
+// broker connection, which accepts the connect and records all publications
+class SimClient : public Client
+{
+    public:
+        int connect(IPAddress ip, uint16_t port) { (void)ip; (void)port; return(open()); }
+        int connect(const char *host, uint16_t port) { (void)host; (void)port; return(open()); }
+        size_t write(uint8_t c) { return(this->write(&c, 1u)); }
+        size_t write(const uint8_t *buf, size_t size);
+        int available() { return((int)(this->rxLength_u8 - this->rxRead_u8)); }
+        int read() { return((0 < available()) ? this->rx_au8[this->rxRead_u8++] : -1); }
+        int read(uint8_t *buf, size_t size);
+        int peek() { return((0 < available()) ? this->rx_au8[this->rxRead_u8] : -1); }
+        void flush() {}
+        void stop() { this->connected_bol = false; }
+        uint8_t connected() { return(this->connected_bol); }
+        operator bool() { return(this->connected_bol); }
+        void PrintPublications(uint32_t time_u32);
+
+    private:
+        bool        connected_bol = false;
+        uint8_t     rx_au8[4];
+        uint8_t     rxLength_u8 = 0;
+        uint8_t     rxRead_u8 = 0;
+        uint8_t     tx_au8[TX_SIZE];
+        uint16_t    txLength_u16 = 0;
+
+        int open(void);
+};
+
+/****************************************************************************************/
+/* Local data definitions */
+static block_t blocks_stsa[MAX_BLOCKS];
+static uint16_t blockCount_u16st;
+static uint16_t buffers_stau16[MAX_LIVING];
+static uint16_t values_stau16[MAX_LIVING];
+static uint16_t livingCount_u16st;
+static bool buffersReleased_bolst;
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Resets the arena to one free block
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void ArenaInit(void)
+{
+    blocks_stsa[0].size_u16 = ARENA_SIZE;
+    blocks_stsa[0].used_bol = false;
+    blockCount_u16st = 1u;
+    livingCount_u16st = 0;
+    buffersReleased_bolst = false;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     First fit allocation, the block is split if it is larger than requested
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     size_u16      requested size
+ * @return    start address of the block in the arena or INVALID_BLOCK
+*//*-----------------------------------------------------------------------------------*/
+static uint16_t ArenaAlloc(uint16_t size_u16)
+{
+    uint16_t idx_u16;
+    uint16_t addr_u16 = 0;
+
+    for(idx_u16 = 0; idx_u16 < blockCount_u16st; idx_u16++)
+    {
+        block_t *block_p = &blocks_stsa[idx_u16];
+
+        if((false == block_p->used_bol) && (block_p->size_u16 >= size_u16))
+        {
+            if((block_p->size_u16 > size_u16) && (MAX_BLOCKS > blockCount_u16st))
+            {
+                memmove(&blocks_stsa[idx_u16 + 1u], block_p, 
+                        (blockCount_u16st - idx_u16) * sizeof(block_t));
+                blockCount_u16st++;
+                blocks_stsa[idx_u16 + 1u].size_u16 = block_p->size_u16 - size_u16;
+                block_p->size_u16 = size_u16;
+            }
+            block_p->used_bol = true;
+            return(addr_u16);
+        }
+        addr_u16 += block_p->size_u16;
+    }
+    return(INVALID_BLOCK);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Releases a block and merges it with its free neighbours
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     addr_u16      start address of the block
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void ArenaFree(uint16_t addr_u16)
+{
+    uint16_t idx_u16 = 0;
+    uint16_t start_u16 = 0;
+
+    while((idx_u16 < blockCount_u16st) && (start_u16 != addr_u16))
+    {
+        start_u16 += blocks_stsa[idx_u16].size_u16;
+        idx_u16++;
+    }
+    if(idx_u16 >= blockCount_u16st)
+    {
+        return;
+    }
+    blocks_stsa[idx_u16].used_bol = false;
+    if((idx_u16 + 1u < blockCount_u16st) && (false == blocks_stsa[idx_u16 + 1u].used_bol))
+    {
+        blocks_stsa[idx_u16].size_u16 += blocks_stsa[idx_u16 + 1u].size_u16;
+        memmove(&blocks_stsa[idx_u16 + 1u], &blocks_stsa[idx_u16 + 2u], 
+                (blockCount_u16st - idx_u16 - 2u) * sizeof(block_t));
+        blockCount_u16st--;
+    }
+    if((0 < idx_u16) && (false == blocks_stsa[idx_u16 - 1u].used_bol))
+    {
+        blocks_stsa[idx_u16 - 1u].size_u16 += blocks_stsa[idx_u16].size_u16;
+        memmove(&blocks_stsa[idx_u16], &blocks_stsa[idx_u16 + 1u], 
+                (blockCount_u16st - idx_u16 - 1u) * sizeof(block_t));
+        blockCount_u16st--;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Heap sampler of the fake allocator, the fragmentation is calculated
+ *              as 100 - sqrt(sum of the squared free blocks) * 100 / free heap
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     sample_p      returns the sample
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void SampleArena(heapSample_t *sample_p)
+{
+    uint16_t idx_u16;
+    uint32_t free_u32 = 0;
+    uint32_t maxBlock_u32 = 0;
+    double squares_f64 = 0.0;
+
+    for(idx_u16 = 0; idx_u16 < blockCount_u16st; idx_u16++)
+    {
+        if(false == blocks_stsa[idx_u16].used_bol)
+        {
+            free_u32 += blocks_stsa[idx_u16].size_u16;
+            maxBlock_u32 = max(maxBlock_u32, (uint32_t)blocks_stsa[idx_u16].size_u16);
+            squares_f64 += (double)blocks_stsa[idx_u16].size_u16 
+                            * (double)blocks_stsa[idx_u16].size_u16;
+        }
+    }
+    sample_p->free_u32 = free_u32;
+    sample_p->maxBlock_u16 = (uint16_t)maxBlock_u32;
+    sample_p->frag_u8 = (0 == free_u32) ? 0 : 
+                            (uint8_t)(100u - (uint32_t)(sqrt(squares_f64) * 100.0 / free_u32));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     One second of allocations in the given phase
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     phase_u8      0 steady, 1 churn, 2 release
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void Allocate(uint8_t phase_u8)
+{
+    uint16_t addr_au16[4];
+    uint16_t idx_u16;
+    uint8_t idx_u8;
+
+    // Strings built and released in every loop, e.g. trace and payload conversion
+    for(idx_u8 = 0; idx_u8 < 4u; idx_u8++)
+    {
+        addr_au16[idx_u8] = ArenaAlloc(STRING_SIZE);
+    }
+    for(idx_u8 = 0; idx_u8 < 4u; idx_u8++)
+    {
+        if(INVALID_BLOCK != addr_au16[idx_u8])
+        {
+            ArenaFree(addr_au16[idx_u8]);
+        }
+    }
+
+    if((1u == phase_u8) && (false == buffersReleased_bolst))
+    {
+        // a buffer and a small value stay, until the arena is exhausted 
+        addr_au16[0] = ArenaAlloc(BUFFER_SIZE);
+        addr_au16[1] = ArenaAlloc(VALUE_SIZE);
+        if((INVALID_BLOCK != addr_au16[0]) && (INVALID_BLOCK != addr_au16[1])
+            && (MAX_LIVING > livingCount_u16st))
+        {
+            buffers_stau16[livingCount_u16st] = addr_au16[0];
+            values_stau16[livingCount_u16st] = addr_au16[1];
+            livingCount_u16st++;
+        }
+        else
+        {
+            // all buffers are released, the values keep the holes apart
+            for(idx_u8 = 0; idx_u8 < 2u; idx_u8++)
+            {
+                if(INVALID_BLOCK != addr_au16[idx_u8])
+                {
+                    ArenaFree(addr_au16[idx_u8]);
+                }
+            }
+            for(idx_u16 = 0; idx_u16 < livingCount_u16st; idx_u16++)
+            {
+                ArenaFree(buffers_stau16[idx_u16]);
+            }
+            buffersReleased_bolst = true;
+        }
+    }
+    else if((2u == phase_u8) && (0 < livingCount_u16st))
+    {
+        livingCount_u16st--;
+        ArenaFree(values_stau16[livingCount_u16st]);
+        if(false == buffersReleased_bolst)
+        {
+            ArenaFree(buffers_stau16[livingCount_u16st]);
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Accepts the connection and queues the CONNACK
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1
+*//*-----------------------------------------------------------------------------------*/
+int SimClient::open(void)
+{
+    this->connected_bol = true;
+    this->rx_au8[0] = 0x20u;
+    this->rx_au8[1] = 0x02u;
+    this->rx_au8[2] = 0x00u;
+    this->rx_au8[3] = 0x00u;
+    this->rxLength_u8 = 4u;
+    this->rxRead_u8 = 0;
+    return(1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Records the sent bytes
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     buf       sent bytes
+ * @param     size      number of bytes
+ * @return    number of accepted bytes
+*//*-----------------------------------------------------------------------------------*/
+size_t SimClient::write(const uint8_t *buf, size_t size)
+{
+    size = min(size, (size_t)(TX_SIZE - this->txLength_u16));
+    memcpy(&this->tx_au8[this->txLength_u16], buf, size);
+    this->txLength_u16 += (uint16_t)size;
+    return(size);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Reads the received bytes
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     buf       destination
+ * @param     size      size of the destination
+ * @return    number of read bytes
+*//*-----------------------------------------------------------------------------------*/
+int SimClient::read(uint8_t *buf, size_t size)
+{
+    size_t read_u32 = 0;
+
+    while((read_u32 < size) && (0 < available()))
+    {
+        buf[read_u32++] = (uint8_t)read();
+    }
+    return((int)read_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Prints and removes all recorded PUBLISH packets
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     time_u32      simulated time in seconds
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+void SimClient::PrintPublications(uint32_t time_u32)
+{
+    uint16_t pos_u16 = 0;
+
+    while(pos_u16 < this->txLength_u16)
+    {
+        uint8_t header_u8 = this->tx_au8[pos_u16++];
+        uint32_t length_u32 = 0;
+        uint32_t factor_u32 = 1u;
+        uint8_t digit_u8;
+
+        do
+        {
+            digit_u8 = this->tx_au8[pos_u16++];
+            length_u32 += (digit_u8 & 0x7Fu) * factor_u32;
+            factor_u32 <<= 7;
+        } while(0 != (digit_u8 & 0x80u));
+
+        if(0x30u == (header_u8 & 0xF0u))
+        {
+            uint16_t topic_u16 = (uint16_t)((this->tx_au8[pos_u16] << 8) 
+                                                | this->tx_au8[pos_u16 + 1u]);
+
+            printf("%5lus  %-24.*s %.*s\n", (unsigned long)time_u32, topic_u16, 
+                    (const char*)&this->tx_au8[pos_u16 + 2u],
+                    (int)(length_u32 - 2u - topic_u16), 
+                    (const char*)&this->tx_au8[pos_u16 + 2u + topic_u16]);
+        }
+        pos_u16 += (uint16_t)length_u32;
+    }
+    this->txLength_u16 = 0;
+}
+
+/****************************************************************************************/
+/* Main */
+int main(void)
+{
+    static const uint32_t phaseTimes_au32[3] = {STEADY_TIME, CHURN_TIME, RELEASE_TIME};
+    static const char * const phaseNames_accpa[3] = {"steady", "churn", "release"};
+    SimClient simClient_st;
+    PubSubClient client_st(simClient_st);
+    Scheduler scheduler_st;
+    TopicPool pool_st;
+    Trace trace_st(false);
+    HeapMonitor monitor_st(&trace_st);
+    uint32_t time_u32 = 0;
+    uint32_t second_u32;
+    uint8_t phase_u8;
+
+    ArenaInit();
+    (void)ArenaAlloc(SYSTEM_USED);
+    MqttDevice::SetScheduler(&scheduler_st);
+    MqttDevice::SetTopicPool(&pool_st);
+    client_st.setServer("broker", 1883);
+    (void)client_st.connect("heapsim");
+    simClient_st.PrintPublications(0);
+
+    monitor_st.SetSampler(SampleArena);
+    monitor_st.Initialize();
+    monitor_st.Reconnect(&client_st, "dev05");
+    for(phase_u8 = 0; phase_u8 < 3u; phase_u8++)
+    {
+        printf("-- %s phase\n", phaseNames_accpa[phase_u8]);
+        for(second_u32 = 0; second_u32 < phaseTimes_au32[phase_u8]; second_u32++)
+        {
+            Allocate(phase_u8);
+            (void)scheduler_st.Process_u8(millis());
+            (void)monitor_st.ProcessPublishRequests(&client_st);
+            simClient_st.PrintPublications(time_u32);
+            host_AdvanceMillis(1000u);
+            time_u32++;
+        }
+    }
+    printf("-- alarms tripped: %u, blocks in the arena: %u\n", monitor_st.GetTrips_u16(),
+            blockCount_u16st);
+    return(0);
+}
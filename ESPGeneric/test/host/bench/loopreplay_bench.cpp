@@ -0,0 +1,1107 @@
+/*****************************************************************************************
+* FILENAME :        loopreplay_bench.cpp
+*
+* DESCRIPTION :
+*       End to end latency benchmark of the complete firmware on the host
+*
+* NOTES :
+*       Every capability profile runs in its own child process with the real
+*       setup() and loop() of main.cpp. A broker thread inside the process
+*       accepts the MQTT connection of the firmware and replays command streams
+*       to it, so the commands take the normal path through the socket, the
+*       PubSubClient and callback(). Measured per stream are:
+*       - command to GPIO latency, from sending the command to the first
+*         digitalWrite(), analogWrite() or espShow() on the output of the stream
+*       - command to status publish latency, from sending the command to the
+*         reception of the expected status topic
+*       - heap allocations of the main loop per command
+*       - loop iterations, commands per second and CPU time per command
+*       Commands and responses are matched in order, a command without a
+*       response within the stream window counts as missing.
+*
+*       The built in streams are toggle bursts for the relays, brightness ramps
+*       for the dim lights and NeoPixels and broadcast INFO requests for every
+*       profile. Recorded streams can be replayed with --stream, one command per
+*       line as "<delay ms> <topic> <payload>", <dev> in the topic is replaced
+*       by the device name. The directives "# name <name>", "# status <topic>"
+*       and "# gpio" set the stream name, the expected status topic and if the
+*       commands switch an output.
+*
+*       The results are printed as JSON to stdout or written to --out. With
+*       --max-allocs the bench fails, if a stream switching an output allocates
+*       more than the given number per command, the limit is not applied to the
+*       streams without output like the INFO requests.
+*
+*       loopreplay_bench [--cap n] [--stream file] [--out file] [--max-allocs n]
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "gensettings.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define BENCH_DEV               "bench"
+#define CONNECT_TIMEOUT_MS      10000u  // connection and subscriptions of the firmware
+#define SUBSCRIBE_SETTLE_MS     500u    // quiet time after the last SUBSCRIBE
+#define STREAM_SETTLE_MS        300u    // window for the responses after the last command
+#define STREAM_GAP_MS           200u    // pause between two streams
+#define MAX_OUTPUT_EVENTS       65536u
+#define RECEIVE_CHUNK           1024u
+
+#define BURST_COMMANDS          20u
+#define RAMP_STEP               3u
+#define RAMP_DELAY_MS           10u
+#define INFO_COMMANDS           10u
+#define INFO_DELAY_MS           50u
+
+#define MQTT_CONNECT            0x10
+#define MQTT_CONNACK            0x20
+#define MQTT_PUBLISH            0x30
+#define MQTT_PUBACK             0x40
+#define MQTT_SUBSCRIBE          0x80
+#define MQTT_SUBACK             0x90
+#define MQTT_UNSUBSCRIBE        0xA0
+#define MQTT_UNSUBACK           0xB0
+#define MQTT_PINGREQ            0xC0
+#define MQTT_PINGRESP           0xD0
+
+#define NO_STREAM               (-1)
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct command_tag
+{
+    uint32_t        delay_u32;
+    std::string     topic_str;
+    std::string     payload_str;
+}command_t;
+
+typedef struct stream_tag
+{
+    std::string             name_str;
+    std::string             status_str;     // expected status topic, empty for none
+    bool                    gpio_bol;       // every command changes an output
+    std::vector<command_t>  commands_vec;
+}stream_t;
+
+typedef struct profile_tag
+{
+    uint8_t         cap_u8;
+    const char      *name_ccp;
+    const char      *channels_ccp;  // "relay:<chan>", "mcp:<chan>", "dim:<chan>",
+                                    // "neo:<chan>" and "sonoff", blank separated
+}profile_t;
+
+typedef struct event_tag
+{
+    uint64_t        time_u64;
+    int32_t         stream_s32;
+    std::string     topic_str;      // received publish only
+    uint8_t         pin_u8;         // output event only
+}event_t;
+
+typedef struct streamStat_tag
+{
+    std::vector<uint64_t>   sent_vec;
+    uint64_t                start_u64;
+    uint64_t                end_u64;
+    uint64_t                loops_u64;
+    uint64_t                allocs_u64;
+    uint64_t                allocBytes_u64;
+    uint64_t                cpu_u64;
+}streamStat_t;
+
+/****************************************************************************************/
+/* Local function prototypes */
+void setup(void);
+void loop(void);
+
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+extern "C" void __libc_free(void *ptr);
+
+/****************************************************************************************/
+/* Local data definitions */
+static const profile_t profiles_stcsta[] =
+{
+    {0x00u, "single_relay",         "relay:relay_one"},
+    {0x01u, "dht_sensor",           ""},
+    {0x02u, "sonoff_basic",         "sonoff"},
+    {0x03u, "pir",                  ""},
+    {0x04u, "dht_sensor_bat",       ""},
+    {0x05u, "pir_relay",            "relay:relay_one"},
+    {0x08u, "four_relay",           "relay:relay_one relay:relay_two relay:relay_three "
+                                    "relay:relay_four"},
+    {0x09u, "four_relay_mcp",       "mcp:relay_one mcp:relay_two mcp:relay_three "
+                                    "mcp:relay_four"},
+    {0x0Au, "bme_sensor",           ""},
+    {0x0Bu, "double_dht",           ""},
+    {0x0Cu, "eight_relay_esp",      "relay:relay_one relay:relay_two relay:relay_three "
+                                    "relay:relay_four relay:relay_five relay:relay_six "
+                                    "relay:relay_seven relay:relay_eight"},
+    {0x0Du, "sonoff_pir",           "sonoff"},
+    {0x0Eu, "moisture_only",        ""},
+    {0x0Fu, "multi_sense",          "neo:light_one"},
+    {0x10u, "dim_light",            "dim:light_one"},
+    {0x11u, "h801",                 "dim:light_one dim:light_two dim:light_three "
+                                    "dim:light_four dim:light_five dim:light_six "
+                                    "dim:light_seven"},
+    {0x12u, "neopixels",            "neo:light_one"},
+    {0x13u, "3d_printer",           "dim:light_one dim:light_two relay:relay_one "
+                                    "relay:relay_two"},
+    {0x14u, "multi_sense_relay",    "neo:light_one relay:relay_one"},
+    {0x15u, "test_device",          "neo:light_one"},
+    {0x16u, "single_rel_pir",       "relay:relay_one"},
+};
+
+// allocation limit per command for the output streams, negative for no limit
+static double maxAllocs_f64st = -1.0;
+
+// allocation counters of the main loop, only the firmware thread counts
+static __thread bool countAllocs_bolst = false;
+static __thread uint64_t allocs_u64st = 0;
+static __thread uint64_t allocBytes_u64st = 0;
+
+// shared between the broker thread and the firmware thread
+static std::atomic<int32_t> activeStream_s32st(NO_STREAM);
+static std::atomic<bool> done_bolst(false);
+
+// written by the firmware thread only
+static std::vector<event_t> outputs_vecst;
+
+/****************************************************************************************/
+/* Local functions */
+extern "C" void *malloc(size_t size)
+{
+    if(true == countAllocs_bolst)
+    {
+        allocs_u64st++;
+        allocBytes_u64st += size;
+    }
+    return(__libc_malloc(size));
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    if(true == countAllocs_bolst)
+    {
+        allocs_u64st++;
+        allocBytes_u64st += count * size;
+    }
+    return(__libc_calloc(count, size));
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    if((true == countAllocs_bolst) && (0 != size))
+    {
+        allocs_u64st++;
+        allocBytes_u64st += size;
+    }
+    return(__libc_realloc(ptr, size));
+}
+
+extern "C" void free(void *ptr)
+{
+    __libc_free(ptr);
+}
+
+static uint64_t nowNs_u64(void)
+{
+    struct timespec now_st;
+
+    clock_gettime(CLOCK_MONOTONIC, &now_st);
+    return(((uint64_t)now_st.tv_sec * 1000000000ull) + (uint64_t)now_st.tv_nsec);
+}
+
+static uint64_t cpuNs_u64(void)
+{
+    struct timespec now_st;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now_st);
+    return(((uint64_t)now_st.tv_sec * 1000000000ull) + (uint64_t)now_st.tv_nsec);
+}
+
+static void outputHook(uint8_t pin, int val)
+{
+    (void)val;
+    if(outputs_vecst.size() < MAX_OUTPUT_EVENTS)
+    {
+        event_t event_st;
+
+        event_st.time_u64 = nowNs_u64();
+        event_st.stream_s32 = activeStream_s32st.load();
+        event_st.pin_u8 = pin;
+        outputs_vecst.push_back(event_st);
+    }
+}
+
+static std::string replaceDev(const std::string &topic_str)
+{
+    std::string result_str = topic_str;
+    size_t pos_u32 = result_str.find("<dev>");
+
+    if(std::string::npos != pos_u32)
+    {
+        result_str.replace(pos_u32, 5u, BENCH_DEV);
+    }
+    return(result_str);
+}
+
+static void addCommand(stream_t *stream_pst, uint32_t delay_u32, const std::string &topic_str,
+                        const std::string &payload_str)
+{
+    command_t command_st;
+
+    command_st.delay_u32 = delay_u32;
+    command_st.topic_str = replaceDev(topic_str);
+    command_st.payload_str = payload_str;
+    stream_pst->commands_vec.push_back(command_st);
+}
+
+static std::vector<stream_t> buildStreams(const profile_t *profile_cpst)
+{
+    std::vector<stream_t> streams_vec;
+    char channels_ca[256];
+    char *save_pch = NULL;
+    char *token_pch;
+    uint32_t idx_u32;
+
+    snprintf(channels_ca, sizeof(channels_ca), "%s", profile_cpst->channels_ccp);
+    for(token_pch = strtok_r(channels_ca, " ", &save_pch); NULL != token_pch;
+        token_pch = strtok_r(NULL, " ", &save_pch))
+    {
+        std::string type_str(token_pch);
+        std::string chan_str;
+        size_t colon_u32 = type_str.find(':');
+        stream_t stream_st;
+
+        if(std::string::npos != colon_u32)
+        {
+            chan_str = type_str.substr(colon_u32 + 1u);
+            type_str = type_str.substr(0, colon_u32);
+        }
+
+        if(("relay" == type_str) || ("mcp" == type_str))
+        {
+            // the mcp relays are switched over I2C, there is no GPIO event
+            stream_st.name_str = chan_str + "_toggle_burst";
+            stream_st.status_str = replaceDev("std/<dev>/s/" + chan_str + "/status");
+            stream_st.gpio_bol = ("relay" == type_str);
+            for(idx_u32 = 0; idx_u32 < BURST_COMMANDS; idx_u32++)
+            {
+                addCommand(&stream_st, 0, "std/<dev>/r/" + chan_str + "/toggle", "");
+            }
+        }
+        else if("sonoff" == type_str)
+        {
+            stream_st.name_str = "so_basic_toggle_burst";
+            stream_st.status_str = replaceDev("std/<dev>/s/so_basic/status");
+            stream_st.gpio_bol = true;
+            for(idx_u32 = 0; idx_u32 < BURST_COMMANDS; idx_u32++)
+            {
+                addCommand(&stream_st, 0, "std/<dev>/r/so_basic/toggle", "");
+            }
+        }
+        else if(("dim" == type_str) || ("neo" == type_str))
+        {
+            // the dim light publishes the brightness, the NeoPixels the status
+            stream_st.name_str = chan_str + "_brightness_ramp";
+            stream_st.status_str = replaceDev("std/<dev>/s/" + chan_str
+                                    + (("dim" == type_str) ? "/brightness" : "/status"));
+            stream_st.gpio_bol = true;
+            addCommand(&stream_st, 0, "std/<dev>/r/" + chan_str + "/switch", "ON");
+            for(idx_u32 = 0; idx_u32 < 100u; idx_u32 += RAMP_STEP)
+            {
+                addCommand(&stream_st, RAMP_DELAY_MS, "std/<dev>/r/" + chan_str + "/brightness",
+                            std::to_string(idx_u32));
+            }
+        }
+        else
+        {
+            continue;
+        }
+        streams_vec.push_back(stream_st);
+    }
+
+    stream_t info_st;
+    info_st.name_str = "bcast_info";
+    info_st.status_str = replaceDev("std/<dev>" MQTT_PUB_FW_IDENT);
+    info_st.gpio_bol = false;
+    for(idx_u32 = 0; idx_u32 < INFO_COMMANDS; idx_u32++)
+    {
+        addCommand(&info_st, INFO_DELAY_MS, MQTT_SUB_BCAST, MQTT_PAYLOAD_CMD_INFO);
+    }
+    streams_vec.push_back(info_st);
+    return(streams_vec);
+}
+
+static bool loadStream(const char *file_ccp, stream_t *stream_pst)
+{
+    FILE *file_p = fopen(file_ccp, "r");
+    char line_ca[512];
+
+    if(NULL == file_p)
+    {
+        return(false);
+    }
+    stream_pst->name_str = file_ccp;
+    stream_pst->gpio_bol = false;
+    while(NULL != fgets(line_ca, sizeof(line_ca), file_p))
+    {
+        char topic_ca[256];
+        char payload_ca[256];
+        unsigned long delay_u32;
+        int fields_s32;
+
+        line_ca[strcspn(line_ca, "\r\n")] = '\0';
+        if('#' == line_ca[0])
+        {
+            if(0 == strncmp(line_ca, "# name ", 7))
+            {
+                stream_pst->name_str = &line_ca[7];
+            }
+            else if(0 == strncmp(line_ca, "# status ", 9))
+            {
+                stream_pst->status_str = replaceDev(&line_ca[9]);
+            }
+            else if(0 == strcmp(line_ca, "# gpio"))
+            {
+                stream_pst->gpio_bol = true;
+            }
+            continue;
+        }
+        payload_ca[0] = '\0';
+        fields_s32 = sscanf(line_ca, "%lu %255s %255[^\n]", &delay_u32, topic_ca, payload_ca);
+        if(fields_s32 >= 2)
+        {
+            addCommand(stream_pst, (uint32_t)delay_u32, topic_ca, payload_ca);
+        }
+    }
+    fclose(file_p);
+    return(0 != stream_pst->commands_vec.size());
+}
+
+/*-- broker thread ---------------------------------------------------------------------*/
+static void sendPacket(int socket_s32, uint8_t header_u8, const std::vector<uint8_t> &body_vec)
+{
+    std::vector<uint8_t> packet_vec;
+    size_t length_u32 = body_vec.size();
+    size_t sent_u32 = 0;
+
+    packet_vec.push_back(header_u8);
+    do
+    {
+        uint8_t digit_u8 = (uint8_t)(length_u32 % 128u);
+
+        length_u32 /= 128u;
+        if(length_u32 > 0)
+        {
+            digit_u8 |= 0x80u;
+        }
+        packet_vec.push_back(digit_u8);
+    }while(length_u32 > 0);
+    packet_vec.insert(packet_vec.end(), body_vec.begin(), body_vec.end());
+
+    while(sent_u32 < packet_vec.size())
+    {
+        ssize_t ret_s32 = send(socket_s32, &packet_vec[sent_u32], packet_vec.size() - sent_u32,
+                                MSG_NOSIGNAL);
+        if(ret_s32 <= 0)
+        {
+            return;
+        }
+        sent_u32 += (size_t)ret_s32;
+    }
+}
+
+static void sendPublish(int socket_s32, const command_t &command_cst)
+{
+    std::vector<uint8_t> body_vec;
+
+    body_vec.push_back((uint8_t)(command_cst.topic_str.size() >> 8));
+    body_vec.push_back((uint8_t)(command_cst.topic_str.size() & 0xFFu));
+    body_vec.insert(body_vec.end(), command_cst.topic_str.begin(), command_cst.topic_str.end());
+    body_vec.insert(body_vec.end(), command_cst.payload_str.begin(),
+                    command_cst.payload_str.end());
+    sendPacket(socket_s32, MQTT_PUBLISH, body_vec);
+}
+
+class BenchBroker
+{
+    public:
+        BenchBroker(const std::vector<stream_t> &streams_cvec) : streams_cvec(streams_cvec)
+        {
+            this->listener_s32 = -1;
+            this->client_s32 = -1;
+            this->subscriptions_u32 = 0;
+            this->lastSubscribe_u64 = 0;
+            this->connected_bol = false;
+            this->stats_vec.resize(streams_cvec.size());
+        }
+
+        ~BenchBroker()
+        {
+            if(-1 != this->client_s32)
+            {
+                close(this->client_s32);
+            }
+            if(-1 != this->listener_s32)
+            {
+                close(this->listener_s32);
+            }
+        }
+
+        uint16_t Listen_u16(void)
+        {
+            struct sockaddr_in addr_st;
+            socklen_t length_u32 = sizeof(addr_st);
+
+            this->listener_s32 = socket(AF_INET, SOCK_STREAM, 0);
+            memset(&addr_st, 0, sizeof(addr_st));
+            addr_st.sin_family = AF_INET;
+            addr_st.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr_st.sin_port = 0;
+            if((this->listener_s32 < 0)
+                || (0 != bind(this->listener_s32, (struct sockaddr *)&addr_st, sizeof(addr_st)))
+                || (0 != listen(this->listener_s32, 1))
+                || (0 != getsockname(this->listener_s32, (struct sockaddr *)&addr_st,
+                                        &length_u32)))
+            {
+                return(0);
+            }
+            return(ntohs(addr_st.sin_port));
+        }
+
+        void Run(void)
+        {
+            uint64_t start_u64 = nowNs_u64();
+            size_t stream_u32;
+
+            // wait for the connection and the end of the subscriptions
+            while((false == this->connected_bol) || (0 == this->subscriptions_u32)
+                    || ((nowNs_u64() - this->lastSubscribe_u64)
+                            < (SUBSCRIBE_SETTLE_MS * 1000000ull)))
+            {
+                if((nowNs_u64() - start_u64) > (CONNECT_TIMEOUT_MS * 1000000ull))
+                {
+                    this->error_str = "no broker connection";
+                    done_bolst.store(true);
+                    return;
+                }
+                this->Poll(1);
+            }
+
+            for(stream_u32 = 0; stream_u32 < this->streams_cvec.size(); stream_u32++)
+            {
+                const stream_t *stream_cpst = &this->streams_cvec[stream_u32];
+                streamStat_t *stat_pst = &this->stats_vec[stream_u32];
+                uint64_t next_u64 = nowNs_u64();
+                uint64_t settle_u64;
+                size_t idx_u32;
+
+                activeStream_s32st.store((int32_t)stream_u32);
+                stat_pst->start_u64 = next_u64;
+                for(idx_u32 = 0; idx_u32 < stream_cpst->commands_vec.size(); idx_u32++)
+                {
+                    const command_t *command_cpst = &stream_cpst->commands_vec[idx_u32];
+
+                    next_u64 += command_cpst->delay_u32 * 1000000ull;
+                    this->PollUntil(next_u64);
+                    stat_pst->sent_vec.push_back(nowNs_u64());
+                    sendPublish(this->client_s32, *command_cpst);
+                }
+                settle_u64 = nowNs_u64() + (STREAM_SETTLE_MS * 1000000ull);
+                this->PollUntil(settle_u64);
+                stat_pst->end_u64 = nowNs_u64();
+                activeStream_s32st.store(NO_STREAM);
+                this->PollUntil(nowNs_u64() + (STREAM_GAP_MS * 1000000ull));
+            }
+            done_bolst.store(true);
+        }
+
+        const std::vector<event_t>& GetPublishes(void) const { return(this->publishes_vec); }
+        std::vector<streamStat_t>& GetStats(void) { return(this->stats_vec); }
+        const std::string& GetError(void) const { return(this->error_str); }
+
+    private:
+        const std::vector<stream_t> &streams_cvec;
+        std::vector<streamStat_t>   stats_vec;
+        std::vector<event_t>        publishes_vec;
+        std::vector<uint8_t>        rx_vec;
+        std::string                 error_str;
+        int                         listener_s32;
+        int                         client_s32;
+        uint32_t                    subscriptions_u32;
+        uint64_t                    lastSubscribe_u64;
+        bool                        connected_bol;
+
+        void PollUntil(uint64_t until_u64)
+        {
+            uint64_t now_u64 = nowNs_u64();
+
+            do
+            {
+                uint64_t wait_u64 = (until_u64 > now_u64) ? (until_u64 - now_u64) : 0;
+
+                this->Poll((int)std::min<uint64_t>(wait_u64 / 1000000ull, 1u));
+                now_u64 = nowNs_u64();
+            }while(now_u64 < until_u64);
+        }
+
+        void Poll(int timeout_s32)
+        {
+            struct pollfd fd_st;
+            uint8_t buffer_au8[RECEIVE_CHUNK];
+            ssize_t ret_s32;
+
+            fd_st.fd = (-1 == this->client_s32) ? this->listener_s32 : this->client_s32;
+            fd_st.events = POLLIN;
+            fd_st.revents = 0;
+            if(poll(&fd_st, 1, timeout_s32) <= 0)
+            {
+                return;
+            }
+            if(-1 == this->client_s32)
+            {
+                int flag_s32 = 1;
+
+                this->client_s32 = accept(this->listener_s32, NULL, NULL);
+                if(-1 != this->client_s32)
+                {
+                    setsockopt(this->client_s32, IPPROTO_TCP, TCP_NODELAY, &flag_s32,
+                                sizeof(flag_s32));
+                }
+                return;
+            }
+
+            ret_s32 = recv(this->client_s32, buffer_au8, sizeof(buffer_au8), 0);
+            if(ret_s32 > 0)
+            {
+                this->rx_vec.insert(this->rx_vec.end(), buffer_au8, buffer_au8 + ret_s32);
+                this->ProcessPackets();
+            }
+            else if((0 == ret_s32) || (EINTR != errno))
+            {
+                // the firmware reconnects, the next connection is accepted
+                close(this->client_s32);
+                this->client_s32 = -1;
+                this->rx_vec.clear();
+            }
+        }
+
+        void ProcessPackets(void)
+        {
+            while(this->rx_vec.size() >= 2u)
+            {
+                size_t length_u32 = 0;
+                size_t multiplier_u32 = 1;
+                size_t pos_u32 = 1;
+                uint8_t header_u8 = this->rx_vec[0];
+                uint8_t digit_u8;
+
+                do
+                {
+                    if(pos_u32 >= this->rx_vec.size())
+                    {
+                        return;
+                    }
+                    digit_u8 = this->rx_vec[pos_u32++];
+                    length_u32 += (digit_u8 & 0x7Fu) * multiplier_u32;
+                    multiplier_u32 *= 128u;
+                }while(0 != (digit_u8 & 0x80u));
+                if((pos_u32 + length_u32) > this->rx_vec.size())
+                {
+                    return;
+                }
+
+                std::vector<uint8_t> body_vec(this->rx_vec.begin() + pos_u32,
+                                                this->rx_vec.begin() + pos_u32 + length_u32);
+                this->rx_vec.erase(this->rx_vec.begin(),
+                                    this->rx_vec.begin() + pos_u32 + length_u32);
+                this->HandlePacket(header_u8, body_vec);
+            }
+        }
+
+        void HandlePacket(uint8_t header_u8, const std::vector<uint8_t> &body_vec)
+        {
+            std::vector<uint8_t> ack_vec;
+
+            switch(header_u8 & 0xF0u)
+            {
+                case MQTT_CONNECT:
+                    this->connected_bol = true;
+                    ack_vec.push_back(0x00);
+                    ack_vec.push_back(0x00);
+                    sendPacket(this->client_s32, MQTT_CONNACK, ack_vec);
+                    break;
+                case MQTT_SUBSCRIBE:
+                case MQTT_UNSUBSCRIBE:
+                    if(body_vec.size() >= 2u)
+                    {
+                        size_t pos_u32 = 2u;
+
+                        ack_vec.push_back(body_vec[0]);
+                        ack_vec.push_back(body_vec[1]);
+                        while((pos_u32 + 2u) <= body_vec.size())
+                        {
+                            pos_u32 += 2u + (((size_t)body_vec[pos_u32] << 8)
+                                                | body_vec[pos_u32 + 1u]);
+                            if(MQTT_SUBSCRIBE == (header_u8 & 0xF0u))
+                            {
+                                pos_u32++;
+                                ack_vec.push_back(0x00);
+                                this->subscriptions_u32++;
+                            }
+                        }
+                        this->lastSubscribe_u64 = nowNs_u64();
+                        sendPacket(this->client_s32, ((MQTT_SUBSCRIBE == (header_u8 & 0xF0u))
+                                                        ? MQTT_SUBACK : MQTT_UNSUBACK), ack_vec);
+                    }
+                    break;
+                case MQTT_PUBLISH:
+                    this->HandlePublish(header_u8, body_vec);
+                    break;
+                case MQTT_PINGREQ:
+                    sendPacket(this->client_s32, MQTT_PINGRESP, ack_vec);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void HandlePublish(uint8_t header_u8, const std::vector<uint8_t> &body_vec)
+        {
+            event_t event_st;
+            size_t length_u32;
+
+            if(body_vec.size() < 2u)
+            {
+                return;
+            }
+            length_u32 = ((size_t)body_vec[0] << 8) | body_vec[1];
+            if((length_u32 + 2u) > body_vec.size())
+            {
+                return;
+            }
+            event_st.time_u64 = nowNs_u64();
+            event_st.stream_s32 = activeStream_s32st.load();
+            event_st.topic_str.assign((const char *)&body_vec[2], length_u32);
+            event_st.pin_u8 = 0;
+            this->publishes_vec.push_back(event_st);
+
+            if((0 != (header_u8 & 0x06u)) && ((length_u32 + 4u) <= body_vec.size()))
+            {
+                std::vector<uint8_t> ack_vec;
+
+                ack_vec.push_back(body_vec[length_u32 + 2u]);
+                ack_vec.push_back(body_vec[length_u32 + 3u]);
+                sendPacket(this->client_s32, MQTT_PUBACK, ack_vec);
+            }
+        }
+};
+
+/*-- evaluation ------------------------------------------------------------------------*/
+static void printLatency(FILE *out_p, const char *name_ccp, std::vector<uint64_t> latency_vec)
+{
+    uint64_t sum_u64 = 0;
+    size_t idx_u32;
+
+    if(0 == latency_vec.size())
+    {
+        fprintf(out_p, "\"%s\": null", name_ccp);
+        return;
+    }
+    std::sort(latency_vec.begin(), latency_vec.end());
+    for(idx_u32 = 0; idx_u32 < latency_vec.size(); idx_u32++)
+    {
+        sum_u64 += latency_vec[idx_u32];
+    }
+    fprintf(out_p, "\"%s\": {\"count\": %u, \"min\": %.1f, \"avg\": %.1f, \"p50\": %.1f, "
+                    "\"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f}",
+            name_ccp, (unsigned)latency_vec.size(),
+            latency_vec.front() / 1000.0, (sum_u64 / (double)latency_vec.size()) / 1000.0,
+            latency_vec[latency_vec.size() / 2u] / 1000.0,
+            latency_vec[(latency_vec.size() * 9u) / 10u] / 1000.0,
+            latency_vec[(latency_vec.size() * 99u) / 100u] / 1000.0,
+            latency_vec.back() / 1000.0);
+}
+
+// matches the commands in order to the first following event, returns the missing ones
+static uint32_t matchEvents(const std::vector<uint64_t> &sent_cvec,
+                            const std::vector<uint64_t> &events_cvec,
+                            std::vector<uint64_t> *latency_pvec)
+{
+    size_t cursor_u32 = 0;
+    uint32_t missing_u32 = 0;
+    size_t idx_u32;
+
+    for(idx_u32 = 0; idx_u32 < sent_cvec.size(); idx_u32++)
+    {
+        while((cursor_u32 < events_cvec.size()) && (events_cvec[cursor_u32] < sent_cvec[idx_u32]))
+        {
+            cursor_u32++;
+        }
+        if(cursor_u32 < events_cvec.size())
+        {
+            latency_pvec->push_back(events_cvec[cursor_u32] - sent_cvec[idx_u32]);
+            cursor_u32++;
+        }
+        else
+        {
+            missing_u32++;
+        }
+    }
+    return(missing_u32);
+}
+
+static void printStream(FILE *out_p, const stream_t &stream_cst, const streamStat_t &stat_cst,
+                        const std::vector<event_t> &publishes_cvec, int32_t index_s32)
+{
+    std::vector<uint64_t> status_vec;
+    std::vector<uint64_t> gpio_vec;
+    std::vector<uint64_t> latency_vec;
+    uint32_t statusMissing_u32 = 0;
+    uint32_t gpioMissing_u32 = 0;
+    double messages_f64 = (double)stat_cst.sent_vec.size();
+    double duration_f64 = (stat_cst.end_u64 - stat_cst.start_u64) / 1e9;
+    uint64_t lastResponse_u64 = stat_cst.start_u64;
+    size_t idx_u32;
+    int pin_s32 = -1;
+
+    fprintf(out_p, "        {\"name\": \"%s\", \"messages\": %u, \"status_topic\": \"%s\", ",
+            stream_cst.name_str.c_str(), (unsigned)stat_cst.sent_vec.size(),
+            stream_cst.status_str.c_str());
+
+    if(0 != stream_cst.status_str.size())
+    {
+        for(idx_u32 = 0; idx_u32 < publishes_cvec.size(); idx_u32++)
+        {
+            if((index_s32 == publishes_cvec[idx_u32].stream_s32)
+                && (stream_cst.status_str == publishes_cvec[idx_u32].topic_str))
+            {
+                status_vec.push_back(publishes_cvec[idx_u32].time_u64);
+            }
+        }
+        statusMissing_u32 = matchEvents(stat_cst.sent_vec, status_vec, &latency_vec);
+        if(0 != status_vec.size())
+        {
+            lastResponse_u64 = std::max(lastResponse_u64, status_vec.back());
+        }
+    }
+    printLatency(out_p, "status_latency_us", latency_vec);
+    fprintf(out_p, ", \"status_missing\": %u, ", statusMissing_u32);
+
+    latency_vec.clear();
+    if((true == stream_cst.gpio_bol) && (0 != stat_cst.sent_vec.size()))
+    {
+        // the output of the stream is the first one switched after the first command
+        for(idx_u32 = 0; idx_u32 < outputs_vecst.size(); idx_u32++)
+        {
+            const event_t *event_cpst = &outputs_vecst[idx_u32];
+
+            if((index_s32 == event_cpst->stream_s32)
+                && (event_cpst->time_u64 >= stat_cst.sent_vec[0])
+                && ((-1 == pin_s32) || (pin_s32 == event_cpst->pin_u8)))
+            {
+                pin_s32 = event_cpst->pin_u8;
+                gpio_vec.push_back(event_cpst->time_u64);
+            }
+        }
+        gpioMissing_u32 = matchEvents(stat_cst.sent_vec, gpio_vec, &latency_vec);
+        if(0 != gpio_vec.size())
+        {
+            lastResponse_u64 = std::max(lastResponse_u64, gpio_vec.back());
+        }
+    }
+    printLatency(out_p, "gpio_latency_us", latency_vec);
+    fprintf(out_p, ", \"gpio_pin\": %d, \"gpio_missing\": %u, ", pin_s32, gpioMissing_u32);
+
+    fprintf(out_p, "\"allocs_per_msg\": %.2f, \"alloc_bytes_per_msg\": %.1f, "
+                    "\"loops\": %llu, \"loops_per_s\": %.1f, \"msgs_per_s\": %.1f, "
+                    "\"cpu_us_per_msg\": %.1f}",
+            stat_cst.allocs_u64 / messages_f64, stat_cst.allocBytes_u64 / messages_f64,
+            (unsigned long long)stat_cst.loops_u64, stat_cst.loops_u64 / duration_f64,
+            messages_f64 / ((lastResponse_u64 > stat_cst.start_u64)
+                                ? ((lastResponse_u64 - stat_cst.start_u64) / 1e9)
+                                : duration_f64),
+            (stat_cst.cpu_u64 / 1000.0) / messages_f64);
+}
+
+/*-- profile run -----------------------------------------------------------------------*/
+static void seedEeprom(uint8_t cap_u8, uint16_t port_u16)
+{
+    mqttData_t data_st;
+    const uint8_t *data_cpu8 = (const uint8_t *)&data_st;
+    size_t idx_u32;
+
+    memset(&data_st, 0, sizeof(data_st));
+    snprintf(data_st.server_ip, sizeof(data_st.server_ip), "127.0.0.1");
+    snprintf(data_st.server_port, sizeof(data_st.server_port), "%u", port_u16);
+    snprintf(data_st.dev_short, sizeof(data_st.dev_short), BENCH_DEV);
+    snprintf(data_st.room, sizeof(data_st.room), "bench");
+    snprintf(data_st.cap, sizeof(data_st.cap), "%u", cap_u8);
+    snprintf(data_st.chan, sizeof(data_st.chan), "0");
+    for(idx_u32 = 0; idx_u32 < sizeof(mqttData_t); idx_u32++)
+    {
+        EEPROM.write((int)idx_u32, data_cpu8[idx_u32]);
+    }
+}
+
+// runs in the child process, the firmware state can only be set up once
+static int runProfile(const profile_t *profile_cpst, const std::vector<stream_t> &streams_cvec,
+                        FILE *out_p)
+{
+    BenchBroker broker(streams_cvec);
+    std::vector<streamStat_t> *stats_pvec = &broker.GetStats();
+    uint16_t port_u16 = broker.Listen_u16();
+    int status_s32 = 0;
+    size_t idx_u32;
+
+    if(0 == port_u16)
+    {
+        fprintf(out_p, "    {\"cap\": %u, \"profile\": \"%s\", \"error\": \"no listener\"}",
+                profile_cpst->cap_u8, profile_cpst->name_ccp);
+        return(1);
+    }
+
+    outputs_vecst.reserve(MAX_OUTPUT_EVENTS);
+    seedEeprom(profile_cpst->cap_u8, port_u16);
+    host_UseRealTime(true);
+    host_SetOutputHook(outputHook);
+
+    std::thread brokerThread(&BenchBroker::Run, &broker);
+    setup();
+    while(false == done_bolst.load())
+    {
+        int32_t stream_s32 = activeStream_s32st.load();
+        uint64_t allocs_u64 = allocs_u64st;
+        uint64_t allocBytes_u64 = allocBytes_u64st;
+        uint64_t cpu_u64 = cpuNs_u64();
+
+        countAllocs_bolst = true;
+        loop();
+        countAllocs_bolst = false;
+        if(NO_STREAM != stream_s32)
+        {
+            streamStat_t *stat_pst = &(*stats_pvec)[(size_t)stream_s32];
+
+            stat_pst->loops_u64++;
+            stat_pst->allocs_u64 += allocs_u64st - allocs_u64;
+            stat_pst->allocBytes_u64 += allocBytes_u64st - allocBytes_u64;
+            stat_pst->cpu_u64 += cpuNs_u64() - cpu_u64;
+        }
+    }
+    brokerThread.join();
+    host_SetOutputHook(NULL);
+
+    fprintf(out_p, "    {\"cap\": %u, \"profile\": \"%s\", ",
+            profile_cpst->cap_u8, profile_cpst->name_ccp);
+    if(0 != broker.GetError().size())
+    {
+        fprintf(out_p, "\"error\": \"%s\"}", broker.GetError().c_str());
+        return(1);
+    }
+    fprintf(out_p, "\"streams\": [\n");
+    for(idx_u32 = 0; idx_u32 < streams_cvec.size(); idx_u32++)
+    {
+        const streamStat_t *stat_cpst = &(*stats_pvec)[idx_u32];
+        double allocs_f64 = stat_cpst->allocs_u64 / (double)stat_cpst->sent_vec.size();
+
+        printStream(out_p, streams_cvec[idx_u32], *stat_cpst, broker.GetPublishes(), 
+                    (int32_t)idx_u32);
+        fprintf(out_p, "%s\n", ((idx_u32 + 1u) < streams_cvec.size()) ? "," : "");
+        if((maxAllocs_f64st >= 0.0) && (true == streams_cvec[idx_u32].gpio_bol)
+            && ((0 == stat_cpst->sent_vec.size()) || (allocs_f64 > maxAllocs_f64st)))
+        {
+            fprintf(stderr, "<<bench>> %s: %.2f allocations per command, limit %.2f\n",
+                    streams_cvec[idx_u32].name_str.c_str(), allocs_f64, maxAllocs_f64st);
+            status_s32 = 1;
+        }
+    }
+    fprintf(out_p, "    ]}");
+    return(status_s32);
+}
+
+static bool forkProfile(const profile_t *profile_cpst, const std::vector<stream_t> &streams_cvec,
+                        std::string *result_pstr)
+{
+    int pipe_as32[2];
+    pid_t pid_s32;
+    char buffer_ca[4096];
+    ssize_t ret_s32;
+    int status_s32 = 0;
+
+    if(0 != pipe(pipe_as32))
+    {
+        return(false);
+    }
+    fflush(stdout);
+    pid_s32 = fork();
+    if(0 == pid_s32)
+    {
+        FILE *out_p;
+        int null_s32 = open("/dev/null", O_WRONLY);
+
+        // the stubs print to stdout, only the JSON goes through the pipe
+        close(pipe_as32[0]);
+        dup2(null_s32, STDOUT_FILENO);
+        out_p = fdopen(pipe_as32[1], "w");
+        status_s32 = runProfile(profile_cpst, streams_cvec, out_p);
+        fclose(out_p);
+        _exit(status_s32);
+    }
+    close(pipe_as32[1]);
+    if(pid_s32 < 0)
+    {
+        close(pipe_as32[0]);
+        return(false);
+    }
+    while((ret_s32 = read(pipe_as32[0], buffer_ca, sizeof(buffer_ca))) > 0)
+    {
+        result_pstr->append(buffer_ca, (size_t)ret_s32);
+    }
+    close(pipe_as32[0]);
+    waitpid(pid_s32, &status_s32, 0);
+    if(!WIFEXITED(status_s32) || (0 == result_pstr->size()))
+    {
+        char error_ca[128];
+
+        snprintf(error_ca, sizeof(error_ca),
+                    "    {\"cap\": %u, \"profile\": \"%s\", \"error\": \"child status %d\"}",
+                    profile_cpst->cap_u8, profile_cpst->name_ccp, status_s32);
+        *result_pstr = error_ca;
+        return(false);
+    }
+    return(0 == WEXITSTATUS(status_s32));
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+int main(int argc, char *argv[])
+{
+    const char *out_ccp = NULL;
+    const char *stream_ccp = NULL;
+    int cap_s32 = -1;
+    stream_t recorded_st;
+    FILE *out_p = stdout;
+    bool first_bol = true;
+    bool ok_bol = true;
+    size_t idx_u32;
+    int arg_s32;
+
+    for(arg_s32 = 1; arg_s32 < argc; arg_s32++)
+    {
+        if((0 == strcmp(argv[arg_s32], "--cap")) && ((arg_s32 + 1) < argc))
+        {
+            cap_s32 = (int)strtol(argv[++arg_s32], NULL, 0);
+        }
+        else if((0 == strcmp(argv[arg_s32], "--stream")) && ((arg_s32 + 1) < argc))
+        {
+            stream_ccp = argv[++arg_s32];
+        }
+        else if((0 == strcmp(argv[arg_s32], "--out")) && ((arg_s32 + 1) < argc))
+        {
+            out_ccp = argv[++arg_s32];
+        }
+        else if((0 == strcmp(argv[arg_s32], "--max-allocs")) && ((arg_s32 + 1) < argc))
+        {
+            maxAllocs_f64st = strtod(argv[++arg_s32], NULL);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--cap n] [--stream file] [--out file] "
+                            "[--max-allocs n]\n", argv[0]);
+            return(1);
+        }
+    }
+    if((NULL != stream_ccp) && (false == loadStream(stream_ccp, &recorded_st)))
+    {
+        fprintf(stderr, "unable to load stream %s\n", stream_ccp);
+        return(1);
+    }
+    if((NULL != out_ccp) && (NULL == (out_p = fopen(out_ccp, "w"))))
+    {
+        fprintf(stderr, "unable to open %s\n", out_ccp);
+        return(1);
+    }
+
+    fprintf(out_p, "{\n  \"bench\": \"loopreplay\", \"fwident\": \"%s\", \"version\": \"%s\",\n"
+                    "  \"results\": [\n", FWIDENT_STR, VERSION_STR);
+    for(idx_u32 = 0; idx_u32 < (sizeof(profiles_stcsta) / sizeof(profile_t)); idx_u32++)
+    {
+        const profile_t *profile_cpst = &profiles_stcsta[idx_u32];
+        std::vector<stream_t> streams_vec;
+        std::string result_str;
+
+        if((-1 != cap_s32) && (cap_s32 != profile_cpst->cap_u8))
+        {
+            continue;
+        }
+        if(NULL != stream_ccp)
+        {
+            streams_vec.push_back(recorded_st);
+        }
+        else
+        {
+            streams_vec = buildStreams(profile_cpst);
+        }
+        fprintf(stderr, "<<bench>> cap 0x%02X %s\n", profile_cpst->cap_u8,
+                profile_cpst->name_ccp);
+        ok_bol = forkProfile(profile_cpst, streams_vec, &result_str) && ok_bol;
+        fprintf(out_p, "%s%s", (true == first_bol) ? "" : ",\n", result_str.c_str());
+        first_bol = false;
+    }
+    fprintf(out_p, "\n  ]\n}\n");
+    if(stdout != out_p)
+    {
+        fclose(out_p);
+    }
+    return((true == ok_bol) ? 0 : 1);
+}
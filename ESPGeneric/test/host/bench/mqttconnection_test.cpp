@@ -0,0 +1,448 @@
+/*****************************************************************************************
+* FILENAME :        mqttconnection_test.cpp
+*
+* DESCRIPTION :
+*       Host test of the non blocking MQTT connection state machine
+*
+* NOTES :
+*       The PubSubClient runs on a shim client instead of a socket. The shim 
+*       refuses the TCP connect, accepts it and answers the CONNECT with a 
+*       CONNACK, accepts it without any answer or drops an open connection.
+*       The fake millis() of the host stubs is advanced in steps of 1 ms and 
+*       every connect attempt is recorded with its time stamp. Checked are the
+*       growing and capped backoff, the jitter of the retry time, the reset of
+*       the backoff after a successful connect, the portal request and the
+*       duration of an attempt without CONNACK.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs -I lib/PubSubClient/src 
+*           test/host/bench/mqttconnection_test.cpp src/MqttConnection.cpp 
+*           lib/PubSubClient/src/PubSubClient.cpp test/host/stubs/Arduino.cpp -o mqttconn
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include "Arduino.h"
+#include "Client.h"
+#include "PubSubClient.h"
+#include "MqttConnection.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define MAX_ATTEMPTS                32u
+#define START_TIME                  5000ul
+#define PORTAL_RETRIES              3u
+
+// behaviour of the shim broker
+#define SHIM_REFUSE                 0u      // TCP connect fails
+#define SHIM_ACCEPT                 1u      // TCP connect and CONNACK
+#define SHIM_SILENT                 2u      // TCP connect without CONNACK
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Class definition: */
+class ShimBroker : public Client
+{
+    public:
+        ShimBroker() : mode_u8(SHIM_REFUSE), open_bol(false), rxIdx_u8(0), rxLen_u8(0),
+                        attempts_u8(0) {}
+        int connect(IPAddress ip, uint16_t port) 
+        { 
+            (void)ip; 
+            return(this->connect("", port)); 
+        }
+        int connect(const char *host, uint16_t port)
+        {
+            (void)host;
+            (void)port;
+            if(this->attempts_u8 < MAX_ATTEMPTS)
+            {
+                this->times_u32a[this->attempts_u8] = millis();
+            }
+            this->attempts_u8++;
+            if(SHIM_REFUSE == this->mode_u8)
+            {
+                return(0);
+            }
+            this->open_bol = true;
+            this->rxIdx_u8 = 0;
+            this->rxLen_u8 = 0;
+            return(1);
+        }
+        size_t write(uint8_t c) { return(this->write(&c, 1u)); }
+        size_t write(const uint8_t *buf, size_t size)
+        {
+            // answer the CONNECT packet with an accepted CONNACK
+            if((SHIM_ACCEPT == this->mode_u8) && (0 != size) 
+                && (0x10u == (buf[0] & 0xF0u)))
+            {
+                static const uint8_t connack_cu8a[4] = {0x20u, 0x02u, 0x00u, 0x00u};
+
+                memcpy(this->rx_u8a, connack_cu8a, sizeof(connack_cu8a));
+                this->rxIdx_u8 = 0;
+                this->rxLen_u8 = sizeof(connack_cu8a);
+            }
+            return(size);
+        }
+        int available()
+        {
+            if(this->rxIdx_u8 == this->rxLen_u8)
+            {
+                // the client polls until its socket timeout, time goes on meanwhile
+                host_AdvanceMillis(1u);
+            }
+            return(this->rxLen_u8 - this->rxIdx_u8);
+        }
+        int read() 
+        { 
+            return((this->rxIdx_u8 < this->rxLen_u8) ? this->rx_u8a[this->rxIdx_u8++] : -1); 
+        }
+        int read(uint8_t *buf, size_t size) 
+        { 
+            size_t idx_u32;
+
+            for(idx_u32 = 0; idx_u32 < size; idx_u32++)
+            {
+                if(this->rxIdx_u8 == this->rxLen_u8)
+                {
+                    break;
+                }
+                buf[idx_u32] = this->rx_u8a[this->rxIdx_u8++];
+            }
+            return((int)idx_u32);
+        }
+        int peek() 
+        { 
+            return((this->rxIdx_u8 < this->rxLen_u8) ? this->rx_u8a[this->rxIdx_u8] : -1); 
+        }
+        void flush() {}
+        void stop() { this->open_bol = false; }
+        uint8_t connected() { return(this->open_bol ? 1u : 0u); }
+        operator bool() { return(this->open_bol); }
+
+        uint8_t         mode_u8;
+        bool            open_bol;
+        uint8_t         rx_u8a[8];
+        uint8_t         rxIdx_u8;
+        uint8_t         rxLen_u8;
+        uint8_t         attempts_u8;
+        uint32_t        times_u32a[MAX_ATTEMPTS];
+};
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Runs the state machine like the main loop until the given number of
+ *              attempts is made or the time is over
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     connection_p  connection under test
+ * @param     shim_p        shim broker of the connection
+ * @param     attempts_u8   number of attempts to wait for
+ * @param     events_pu8a   returns the event of every attempt, may be NULL
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void RunAttempts(MqttConnection *connection_p, ShimBroker *shim_p, 
+                        uint8_t attempts_u8, uint8_t *events_pu8a)
+{
+    uint32_t start_u32 = millis();
+    uint8_t before_u8;
+    uint8_t event_u8;
+
+    while((shim_p->attempts_u8 < attempts_u8) && ((millis() - start_u32) < 3600000ul))
+    {
+        before_u8 = shim_p->attempts_u8;
+        event_u8 = connection_p->Process_u8(millis());
+        if((NULL != events_pu8a) && (before_u8 != shim_p->attempts_u8)
+            && (shim_p->attempts_u8 <= MAX_ATTEMPTS))
+        {
+            events_pu8a[shim_p->attempts_u8 - 1u] = event_u8;
+        }
+        if(shim_p->attempts_u8 < attempts_u8)
+        {
+            host_AdvanceMillis(1u);
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Prints the result of a test case
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     name_ccp      name of the test case
+ * @param     pass_bol      result of the test case
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Report(const char *name_ccp, bool pass_bol)
+{
+    printf("%s %s\n", pass_bol ? "PASS" : "FAIL", name_ccp);
+    return(pass_bol ? 0 : 1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     The backoff doubles with every failed attempt up to the maximum, the 
+ *              retry is made between half and the full backoff after the failure
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Backoff(void)
+{
+    static const uint32_t backoff_cu32a[] = {1000u, 2000u, 4000u, 8000u, 16000u, 32000u, 
+                                             60000u, 60000u, 60000u};
+    const uint8_t steps_u8 = sizeof(backoff_cu32a) / sizeof(backoff_cu32a[0]);
+    ShimBroker shim;
+    PubSubClient client(shim);
+    MqttConnection connection(&client, 0);
+    uint32_t delay_u32;
+    uint8_t idx_u8;
+    bool pass_bol = true;
+
+    client.setServer("broker", 1883);
+    connection.Configure("dev99", NULL, NULL);
+    host_SetMillis(START_TIME);
+    for(idx_u8 = 0; idx_u8 < steps_u8; idx_u8++)
+    {
+        RunAttempts(&connection, &shim, idx_u8 + 1u, NULL);
+        if(backoff_cu32a[idx_u8] != connection.GetBackoff_u32())
+        {
+            printf("     failure %u backoff %lu, expected %lu\n", idx_u8 + 1u, 
+                    (unsigned long)connection.GetBackoff_u32(), 
+                    (unsigned long)backoff_cu32a[idx_u8]);
+            pass_bol = false;
+        }
+    }
+    RunAttempts(&connection, &shim, steps_u8 + 1u, NULL);
+    pass_bol = pass_bol && ((steps_u8 + 1u) == shim.attempts_u8) 
+                && (MQTTCONN_BACKOFF_MAX == connection.GetBackoff_u32())
+                && ((steps_u8 + 1u) == connection.GetFailures_u16());
+    for(idx_u8 = 1; (true == pass_bol) && (idx_u8 <= steps_u8); idx_u8++)
+    {
+        delay_u32 = shim.times_u32a[idx_u8] - shim.times_u32a[idx_u8 - 1u];
+        if((delay_u32 < (backoff_cu32a[idx_u8 - 1u] / 2u)) 
+            || (delay_u32 > backoff_cu32a[idx_u8 - 1u]))
+        {
+            printf("     retry %u after %lu ms, backoff %lu\n", idx_u8, 
+                    (unsigned long)delay_u32, (unsigned long)backoff_cu32a[idx_u8 - 1u]);
+            pass_bol = false;
+        }
+    }
+    return(Report("backoff grows and is capped", pass_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     The retry time is jittered, different seeds give different retry times
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Jitter(void)
+{
+    ShimBroker shimA;
+    ShimBroker shimB;
+    PubSubClient clientA(shimA);
+    PubSubClient clientB(shimB);
+    MqttConnection connectionA(&clientA, 0);
+    MqttConnection connectionB(&clientB, 0);
+    uint32_t delayA_u32;
+    uint32_t delayB_u32;
+    uint32_t prevA_u32;
+    uint8_t different_u8 = 0;
+    uint8_t distinct_u8 = 0;
+    uint8_t idx_u8;
+
+    clientA.setServer("broker", 1883);
+    connectionA.Configure("dev99", NULL, NULL);
+    clientB.setServer("broker", 1883);
+    connectionB.Configure("dev99", NULL, NULL);
+    connectionA.SetSeed(0x00A1B2C3u);
+    connectionB.SetSeed(0x00D4E5F6u);
+    host_SetMillis(START_TIME);
+    RunAttempts(&connectionA, &shimA, 12u, NULL);
+    host_SetMillis(START_TIME);
+    RunAttempts(&connectionB, &shimB, 12u, NULL);
+    for(idx_u8 = 1; idx_u8 < 12u; idx_u8++)
+    {
+        delayA_u32 = shimA.times_u32a[idx_u8] - shimA.times_u32a[idx_u8 - 1u];
+        delayB_u32 = shimB.times_u32a[idx_u8] - shimB.times_u32a[idx_u8 - 1u];
+        different_u8 += (delayA_u32 != delayB_u32) ? 1u : 0;
+        // from the 8th retry on the backoff stays at the maximum
+        if(idx_u8 > 7u)
+        {
+            prevA_u32 = shimA.times_u32a[idx_u8 - 1u] - shimA.times_u32a[idx_u8 - 2u];
+            distinct_u8 += (delayA_u32 != prevA_u32) ? 1u : 0;
+        }
+    }
+    printf("     %u of 11 retry times differ between two seeds\n", different_u8);
+    return(Report("retry time is jittered", (different_u8 >= 9u) && (0 != distinct_u8)));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     A successful connect resets the backoff, a lost connection is retried
+ *              with the next call and restarts with the minimum backoff
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Reset(void)
+{
+    ShimBroker shim;
+    PubSubClient client(shim);
+    MqttConnection connection(&client, 0);
+    uint8_t events_u8a[MAX_ATTEMPTS];
+    uint32_t lost_u32;
+    uint8_t event_u8;
+    bool pass_bol;
+
+    memset(events_u8a, MQTTCONN_EVENT_NONE, sizeof(events_u8a));
+    client.setServer("broker", 1883);
+    connection.Configure("dev99", NULL, NULL);
+    host_SetMillis(START_TIME);
+    RunAttempts(&connection, &shim, 5u, events_u8a);
+    shim.mode_u8 = SHIM_ACCEPT;
+    RunAttempts(&connection, &shim, 6u, events_u8a);
+    pass_bol =    (MQTTCONN_EVENT_FAILED == events_u8a[4]) 
+               && (MQTTCONN_EVENT_CONNECTED == events_u8a[5])
+               && (MQTTCONN_STATE_CONNECTED == connection.GetState_u8())
+               && (0 == connection.GetBackoff_u32()) && (5u == connection.GetFailures_u16())
+               && (connection.GetLatency_u32() == (shim.times_u32a[5] - START_TIME))
+               && (0 == connection.GetReconnects_u16());
+
+    // the broker drops the connection and refuses the next attempt
+    host_AdvanceMillis(10000u);
+    shim.open_bol = false;
+    shim.mode_u8 = SHIM_REFUSE;
+    lost_u32 = millis();
+    event_u8 = connection.Process_u8(millis());
+    pass_bol = pass_bol && (MQTTCONN_EVENT_LOST == event_u8) 
+                && (0 == connection.GetFailures_u16());
+    event_u8 = connection.Process_u8(millis());
+    pass_bol = pass_bol && (MQTTCONN_EVENT_FAILED == event_u8) && (7u == shim.attempts_u8)
+                && (lost_u32 == shim.times_u32a[6])
+                && (MQTTCONN_BACKOFF_MIN == connection.GetBackoff_u32());
+
+    // the first retry after the outage uses the minimum backoff again
+    shim.mode_u8 = SHIM_ACCEPT;
+    RunAttempts(&connection, &shim, 8u, NULL);
+    pass_bol = pass_bol && (MQTTCONN_STATE_CONNECTED == connection.GetState_u8())
+                && ((shim.times_u32a[7] - shim.times_u32a[6]) <= MQTTCONN_BACKOFF_MIN)
+                && (1u == connection.GetReconnects_u16());
+    return(Report("backoff resets after a connect", pass_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     The portal is requested every PORTAL_RETRIES failures, until the broker
+ *              was reached once
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Portal(void)
+{
+    ShimBroker shim;
+    PubSubClient client(shim);
+    MqttConnection connection(&client, PORTAL_RETRIES);
+    uint8_t events_u8a[MAX_ATTEMPTS];
+    bool pass_bol;
+
+    memset(events_u8a, MQTTCONN_EVENT_NONE, sizeof(events_u8a));
+    client.setServer("broker", 1883);
+    connection.Configure("dev99", NULL, NULL);
+    host_SetMillis(START_TIME);
+    RunAttempts(&connection, &shim, 6u, events_u8a);
+    shim.mode_u8 = SHIM_ACCEPT;
+    RunAttempts(&connection, &shim, 7u, events_u8a);
+    shim.open_bol = false;
+    shim.mode_u8 = SHIM_REFUSE;
+    RunAttempts(&connection, &shim, 13u, events_u8a);
+    pass_bol =    (MQTTCONN_EVENT_FAILED == events_u8a[0])
+               && (MQTTCONN_EVENT_PORTAL == events_u8a[2])
+               && (MQTTCONN_EVENT_PORTAL == events_u8a[5])
+               && (MQTTCONN_EVENT_CONNECTED == events_u8a[6])
+               && (MQTTCONN_EVENT_FAILED == events_u8a[9])
+               && (MQTTCONN_EVENT_FAILED == events_u8a[12]);
+    return(Report("portal only before the first connect", pass_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     An accepted TCP connect without CONNACK blocks for the socket timeout,
+ *              the retry is scheduled after the end of the attempt
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Silent(void)
+{
+    ShimBroker shim;
+    PubSubClient client(shim);
+    MqttConnection connection(&client, 0);
+    uint32_t end_u32;
+    uint8_t event_u8;
+    bool pass_bol;
+
+    client.setServer("broker", 1883);
+    connection.Configure("dev99", NULL, NULL);
+    host_SetMillis(START_TIME);
+    shim.mode_u8 = SHIM_SILENT;
+    event_u8 = connection.Process_u8(millis());
+    end_u32 = millis();
+    printf("     attempt without CONNACK blocked %lu ms\n", 
+            (unsigned long)connection.GetAttemptTime_u32());
+    pass_bol =    (MQTTCONN_EVENT_FAILED == event_u8) && (false == shim.open_bol)
+               && ((MQTT_SOCKET_TIMEOUT * 1000ul) == connection.GetAttemptTime_u32())
+               && (connection.GetIdleTime_u32(end_u32, MQTTCONN_BACKOFF_MAX) 
+                    >= (MQTTCONN_BACKOFF_MIN / 2u));
+    return(Report("attempt without CONNACK", pass_bol));
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Test entry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of failed test cases
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    int failed_s32 = 0;
+
+    failed_s32 += Backoff();
+    failed_s32 += Jitter();
+    failed_s32 += Reset();
+    failed_s32 += Portal();
+    failed_s32 += Silent();
+    return(failed_s32);
+}
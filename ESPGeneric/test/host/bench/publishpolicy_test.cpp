@@ -0,0 +1,291 @@
+/*****************************************************************************************
+* FILENAME :        publishpolicy_test.cpp
+*
+* DESCRIPTION :
+*       Host test of the report on change publish policy
+*
+* NOTES :
+*       Feeds measurement sequences with explicit time stamps into the policy and
+*       checks which of them are published. Covers the absolute and relative
+*       delta, the minimum interval, the heartbeat, the millis() overflow and the
+*       parsing of the MQTT configuration payload.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs test/host/bench/publishpolicy_test.cpp
+*           src/PublishPolicy.cpp src/MqttPayload.cpp test/host/stubs/Arduino.cpp -o policy
+*       ./policy
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "Arduino.h"
+#include "PublishPolicy.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define MINUTE                      60000ul
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct step_tag
+{
+    uint32_t            time_u32;
+    float               value_f32;
+    bool                due_bol;
+}step_t;
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Runs a measurement sequence, every published value becomes the reference
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     name_ccp    name of the sequence
+ * @param     policy_p    policy under test
+ * @param     steps_pst   measurements with the expected decision
+ * @param     count_u8    number of measurements
+ * @return    1 for a failed sequence, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Run(const char *name_ccp, const publishPolicy_t *policy_p, 
+                const step_t *steps_pst, uint8_t count_u8)
+{
+    PublishPolicy policy_st;
+    uint8_t idx_u8;
+    uint8_t published_u8 = 0;
+    bool pass_bol = true;
+
+    policy_st.Configure(policy_p);
+    for(idx_u8 = 0; idx_u8 < count_u8; idx_u8++)
+    {
+        bool due_bol = policy_st.IsDue_bol(steps_pst[idx_u8].value_f32, 
+                                            steps_pst[idx_u8].time_u32);
+
+        if(due_bol != steps_pst[idx_u8].due_bol)
+        {
+            printf("     step %u: %.2f at %lu expected %d\n", idx_u8, 
+                    steps_pst[idx_u8].value_f32, (unsigned long)steps_pst[idx_u8].time_u32,
+                    steps_pst[idx_u8].due_bol);
+            pass_bol = false;
+        }
+        if(true == due_bol)
+        {
+            policy_st.SetPublished(steps_pst[idx_u8].value_f32, steps_pst[idx_u8].time_u32);
+            published_u8++;
+        }
+    }
+    printf("%s %-22s %u of %u published\n", pass_bol ? "PASS" : "FAIL", name_ccp, 
+            published_u8, count_u8);
+    return(pass_bol ? 0 : 1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Parses one configuration payload
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     payload_ccp     configuration payload
+ * @param     valid_bol       expected result
+ * @param     expected_p      expected policy of a valid payload
+ * @param     index_u8        expected value index of a valid payload
+ * @return    1 for a failed check, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Parse(const char *payload_ccp, bool valid_bol, const publishPolicy_t *expected_p, 
+                    uint8_t index_u8)
+{
+    MqttPayload payload((const uint8_t *)payload_ccp, (uint16_t)strlen(payload_ccp));
+    publishPolicy_t policy_st;
+    uint8_t parsed_u8 = 0xFFu;
+    bool pass_bol;
+
+    memset(&policy_st, 0, sizeof(policy_st));
+    pass_bol = (valid_bol == PublishPolicy::Parse_bol(payload, &parsed_u8, &policy_st));
+    if((true == pass_bol) && (true == valid_bol))
+    {
+        pass_bol =     (index_u8 == parsed_u8)
+                    && (fabsf(expected_p->delta_f32 - policy_st.delta_f32) < 0.0001F)
+                    && (expected_p->relative_bol == policy_st.relative_bol)
+                    && (expected_p->minInterval_u32 == policy_st.minInterval_u32)
+                    && (expected_p->heartbeat_u32 == policy_st.heartbeat_u32);
+    }
+    printf("%s parse %-24s %s\n", pass_bol ? "PASS" : "FAIL", payload_ccp, 
+            valid_bol ? "accepted" : "rejected");
+    return(pass_bol ? 0 : 1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Saves two policies before a simulated deep sleep and restores them in new
+ *              objects, as after the wake up of a battery capability
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     heartbeat_p     policy of the published value
+ * @param     relative_p      policy of the value not published yet
+ * @return    1 for a failed check, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int DeepSleep(const publishPolicy_t *heartbeat_p, const publishPolicy_t *relative_p)
+{
+    uint32_t wake_u32 = 500u;
+    uint32_t age_u32 = 2u * MINUTE;
+    bool pass_bol;
+
+    {
+        PublishPolicy before_sta[2];
+
+        before_sta[0].Configure(heartbeat_p);
+        before_sta[1].Configure(relative_p);
+        before_sta[0].SetPublished(20.0F, 10000u);
+        // one minute awake after the publication, one minute deep sleep
+        host_SetMillis(10000u + MINUTE);
+        PublishPolicy::SaveToRtc(MINUTE);
+    }
+
+    host_SetMillis(wake_u32);
+    {
+        PublishPolicy after_sta[2];
+
+        pass_bol =     (true == PublishPolicy::RestoreFromRtc_bol())
+                    && (heartbeat_p->heartbeat_u32 
+                            == after_sta[0].GetPolicy_cp()->heartbeat_u32)
+                    && (true == after_sta[1].GetPolicy_cp()->relative_bol)
+                    // the delta still refers to the value published before the sleep
+                    && (false == after_sta[0].IsDue_bol(20.1F, wake_u32))
+                    && (true == after_sta[0].IsDue_bol(20.5F, wake_u32))
+                    // the heartbeat counts the awake and the sleep time
+                    && (false == after_sta[0].IsDue_bol(20.1F, 
+                                    wake_u32 + heartbeat_p->heartbeat_u32 - age_u32 - 1u))
+                    && (true == after_sta[0].IsDue_bol(20.1F, 
+                                    wake_u32 + heartbeat_p->heartbeat_u32 - age_u32))
+                    && (true == after_sta[1].IsDue_bol(100.0F, wake_u32))
+                    // the image is used once, a later reset starts without reference
+                    && (false == PublishPolicy::RestoreFromRtc_bol());
+    }
+    printf("%s deep sleep restore\n", pass_bol ? "PASS" : "FAIL");
+    if(false == pass_bol)
+    {
+        return(1);
+    }
+
+    // the RTC memory after a power on and an image of other policies are not restored
+    host_FillRtcMemory(0xA5u);
+    pass_bol = (false == PublishPolicy::RestoreFromRtc_bol());
+    {
+        PublishPolicy before_sta[2];
+
+        PublishPolicy::SaveToRtc(MINUTE);
+    }
+    {
+        PublishPolicy after_sta[3];
+
+        pass_bol = pass_bol && (false == PublishPolicy::RestoreFromRtc_bol());
+    }
+    printf("%s deep sleep invalid image\n", pass_bol ? "PASS" : "FAIL");
+    return(pass_bol ? 0 : 1);
+}
+
+/****************************************************************************************/
+/* Main */
+int main(void)
+{
+    const publishPolicy_t every_st = {0.0F, false, 0u, 0u};
+    const publishPolicy_t absolute_st = {0.5F, false, 0u, 0u};
+    const publishPolicy_t relative_st = {10.0F, true, 0u, 0u};
+    const publishPolicy_t rate_st = {0.5F, false, MINUTE, 0u};
+    const publishPolicy_t heartbeat_st = {0.5F, false, 0u, 15u * MINUTE};
+    const publishPolicy_t parsed0_st = {0.5F, false, 0u, 900000u};
+    const publishPolicy_t parsed1_st = {2.0F, true, 60000u, 1800000u};
+    const publishPolicy_t parsedMax_st = {1.0F, false, 4294967000u, 4294967000u};
+    // default policy publishes every measurement, as before the policies
+    const step_t every_sta[] = {{0u, 20.0F, true}, {30000u, 20.0F, true}, 
+                                {60000u, 20.1F, true}, {90000u, NAN, false}};
+    // small steps add up against the last published value
+    const step_t absolute_sta[] = {{0u, 20.0F, true}, {1000u, 20.2F, false}, 
+                                   {2000u, 20.4F, false}, {3000u, 20.5F, true}, 
+                                   {4000u, 20.1F, false}, {5000u, 19.9F, true}};
+    const step_t relative_sta[] = {{0u, 100.0F, true}, {1000u, 109.0F, false}, 
+                                   {2000u, 110.0F, true}, {3000u, 100.0F, false},
+                                   {4000u, 99.0F, true}, {5000u, 0.0F, true}};
+    const step_t rate_sta[] = {{0u, 20.0F, true}, {30000u, 25.0F, false}, 
+                               {59999u, 25.0F, false}, {60000u, 25.0F, true},
+                               {90000u, 25.0F, false}};
+    const step_t heartbeat_sta[] = {{0u, 20.0F, true}, {MINUTE, 20.1F, false}, 
+                                    {15u * MINUTE - 1u, 20.1F, false}, 
+                                    {15u * MINUTE, 20.1F, true}, 
+                                    {16u * MINUTE, 20.1F, false}};
+    // the silence is calculated across the millis() overflow
+    const step_t overflow_sta[] = {{0xFFFFF000u, 20.0F, true}, {0x00001000u, 25.0F, false},
+                                   {MINUTE - 0x1001u, 25.0F, false}, 
+                                   {MINUTE - 0x1000u, 25.0F, true}};
+    PublishPolicy policies_sta[2];
+    MqttPayload config((const uint8_t *)"1,5%,0,60", 9u);
+    MqttPayload outOfRange((const uint8_t *)"2,5,0,60", 8u);
+    bool apply_bol;
+    int failed_s32 = 0;
+
+    failed_s32 += Run("every measurement", &every_st, every_sta, 4u);
+    failed_s32 += Run("absolute delta", &absolute_st, absolute_sta, 6u);
+    failed_s32 += Run("relative delta", &relative_st, relative_sta, 6u);
+    failed_s32 += Run("minimum interval", &rate_st, rate_sta, 5u);
+    failed_s32 += Run("heartbeat", &heartbeat_st, heartbeat_sta, 5u);
+    failed_s32 += Run("millis overflow", &rate_st, overflow_sta, 4u);
+
+    failed_s32 += Parse("0,0.5,0,900", true, &parsed0_st, 0u);
+    failed_s32 += Parse("1,2%,60,1800", true, &parsed1_st, 1u);
+    failed_s32 += Parse("0,0.5,0", false, NULL, 0u);
+    failed_s32 += Parse("0,0.5,0,900,1", false, NULL, 0u);
+    failed_s32 += Parse("0,x,0,900", false, NULL, 0u);
+    failed_s32 += Parse("0,-1,0,900", false, NULL, 0u);
+    failed_s32 += Parse("0,1%%,0,900", false, NULL, 0u);
+    failed_s32 += Parse("a,1,0,900", false, NULL, 0u);
+    failed_s32 += Parse("0,1,-5,900", false, NULL, 0u);
+    failed_s32 += Parse("0,1,0,900 ", false, NULL, 0u);
+    failed_s32 += Parse("0,1.000000000000000000000000000,0,9", false, NULL, 0u);
+    // non finite deltas and seconds beyond the 32 bit milliseconds are rejected
+    failed_s32 += Parse("1,inf,0,60", false, NULL, 0u);
+    failed_s32 += Parse("1,INFINITY,0,60", false, NULL, 0u);
+    failed_s32 += Parse("1,nan,0,60", false, NULL, 0u);
+    failed_s32 += Parse("0,1,4294967,4294967", true, &parsedMax_st, 0u);
+    failed_s32 += Parse("0,1,4294968,0", false, NULL, 0u);
+    failed_s32 += Parse("0,1,0,4294968", false, NULL, 0u);
+    failed_s32 += Parse("0,1,0,99999999999999999999", false, NULL, 0u);
+
+    // a device applies a configuration to the addressed value only
+    apply_bol =    (true == PublishPolicy::Apply_bol(policies_sta, 2u, config))
+                && (true == policies_sta[1].GetPolicy_cp()->relative_bol)
+                && (false == policies_sta[0].GetPolicy_cp()->relative_bol)
+                && (false == PublishPolicy::Apply_bol(policies_sta, 2u, outOfRange));
+    printf("%s apply to value index\n", apply_bol ? "PASS" : "FAIL");
+    failed_s32 += apply_bol ? 0 : 1;
+
+    failed_s32 += DeepSleep(&heartbeat_st, &relative_st);
+
+    printf("%d checks failed\n", failed_s32);
+    return((0 == failed_s32) ? 0 : 1);
+}
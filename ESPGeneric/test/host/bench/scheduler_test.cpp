@@ -0,0 +1,418 @@
+/*****************************************************************************************
+* FILENAME :        scheduler_test.cpp
+*
+* DESCRIPTION :
+*       Host test of the cooperative timer scheduler
+*
+* NOTES :
+*       A fake millis() is advanced in fixed steps and passed to Process() like
+*       the main loop does. Every expiry is recorded with its time stamp and
+*       compared with the expected times. Covered are the expiry on time with a
+*       fast and a slow loop, one shot and periodic timers, skipped periods,
+*       stopping and restarting, timers sharing a wheel slot, the wraparound of
+*       millis() at 2^32 and the idle time.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs test/host/bench/scheduler_test.cpp
+*           src/Scheduler.cpp test/host/stubs/Arduino.cpp -o scheduler
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include "Arduino.h"
+#include "Scheduler.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define USERS                       6u
+#define MAX_FIRES                   32u
+// time span of one wheel revolution, deadlines this far apart share a slot
+#define WHEEL_SPAN                  (SCHEDULER_SLOTS << SCHEDULER_TICK_SHIFT)
+#define START_TIME                  1000ul
+#define WRAP_TIME                   (0xFFFFFFFFul - 150ul)
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct fired_tag
+{
+    uint32_t            time_u32a[MAX_FIRES];
+    uint8_t             count_u8;
+}fired_t;
+
+/****************************************************************************************/
+/* Local data definitions */
+static uint32_t millis_u32st;
+static fired_t fired_sta[USERS];
+static Scheduler *scheduler_pst;
+static uint8_t stopInCallback_u8st;
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Timer function, records the expiry and optionally stops another timer
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     context_p     not used
+ * @param     userId_u8     index of the record
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void OnTimer(void *context_p, uint8_t userId_u8)
+{
+    fired_t *fired_p = &fired_sta[userId_u8];
+
+    (void)context_p;
+    if(fired_p->count_u8 < MAX_FIRES)
+    {
+        fired_p->time_u32a[fired_p->count_u8] = millis_u32st;
+    }
+    fired_p->count_u8++;
+    if(SCHEDULER_INVALID != stopInCallback_u8st)
+    {
+        scheduler_pst->Stop(stopInCallback_u8st);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Prepares a scheduler with one timer per user at the given time
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     scheduler_p   scheduler under test
+ * @param     now_u32       start time of the fake millis()
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void Setup(Scheduler *scheduler_p, uint32_t now_u32)
+{
+    uint8_t idx_u8;
+
+    memset(fired_sta, 0, sizeof(fired_sta));
+    scheduler_pst = scheduler_p;
+    stopInCallback_u8st = SCHEDULER_INVALID;
+    for(idx_u8 = 0; idx_u8 < USERS; idx_u8++)
+    {
+        (void)scheduler_p->Create_u8(OnTimer, NULL, idx_u8);
+    }
+    millis_u32st = now_u32;
+    (void)scheduler_p->Process_u8(millis_u32st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Advances the fake millis() and runs the scheduler like the main loop
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     scheduler_p   scheduler under test
+ * @param     duration_u32  time to advance in milliseconds
+ * @param     step_u32      loop time in milliseconds
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void Advance(Scheduler *scheduler_p, uint32_t duration_u32, uint32_t step_u32)
+{
+    uint32_t elapsed_u32;
+
+    for(elapsed_u32 = 0; elapsed_u32 < duration_u32; elapsed_u32 += step_u32)
+    {
+        millis_u32st += step_u32;
+        (void)scheduler_p->Process_u8(millis_u32st);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Compares the recorded expiries of a user with the expected times
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     user_u8       index of the record
+ * @param     times_cpu32   expected expiry times
+ * @param     count_u8      number of expected expiries
+ * @return    true, if all expiries match
+*//*-----------------------------------------------------------------------------------*/
+static bool Expect_bol(uint8_t user_u8, const uint32_t *times_cpu32, uint8_t count_u8)
+{
+    const fired_t *fired_cp = &fired_sta[user_u8];
+    uint8_t idx_u8;
+
+    if(count_u8 != fired_cp->count_u8)
+    {
+        printf("     timer %u fired %u times, expected %u\n", user_u8, fired_cp->count_u8,
+                count_u8);
+        return(false);
+    }
+    for(idx_u8 = 0; idx_u8 < count_u8; idx_u8++)
+    {
+        if(times_cpu32[idx_u8] != fired_cp->time_u32a[idx_u8])
+        {
+            printf("     timer %u fired at %lu, expected %lu\n", user_u8, 
+                    (unsigned long)fired_cp->time_u32a[idx_u8], 
+                    (unsigned long)times_cpu32[idx_u8]);
+            return(false);
+        }
+    }
+    return(true);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Prints the result of a test case
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     name_ccp      name of the test case
+ * @param     pass_bol      result of the test case
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Report(const char *name_ccp, bool pass_bol)
+{
+    printf("%s %s\n", pass_bol ? "PASS" : "FAIL", name_ccp);
+    return(pass_bol ? 0 : 1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     One shot timers expire on time and only once, with a fast and a slow loop
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int OneShot(void)
+{
+    Scheduler scheduler;
+    const uint32_t fast_u32a[1] = {START_TIME + 100u};
+    // the slow loop runs every 7 ms, the first loop after the deadline executes it
+    const uint32_t slow_u32a[1] = {START_TIME + 105u};
+    const uint32_t now_u32a[1] = {START_TIME + 1u};
+    bool pass_bol;
+
+    Setup(&scheduler, START_TIME);
+    (void)scheduler.Start(0, millis_u32st, 100u, 0);
+    (void)scheduler.Start(2, millis_u32st, 0, 0);
+    Advance(&scheduler, 400u, 1u);
+    pass_bol =    Expect_bol(0, fast_u32a, 1u) && Expect_bol(2, now_u32a, 1u)
+               && (false == scheduler.IsActive_bol(0));
+
+    Setup(&scheduler, START_TIME);
+    (void)scheduler.Start(1, millis_u32st, 100u, 0);
+    Advance(&scheduler, 400u, 7u);
+    pass_bol = pass_bol && Expect_bol(1, slow_u32a, 1u);
+    return(Report("one shot on time", pass_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Periodic timers keep their period and skip periods missed by a slow loop
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Periodic(void)
+{
+    Scheduler scheduler;
+    uint32_t times_u32a[MAX_FIRES];
+    uint8_t idx_u8;
+    bool pass_bol;
+
+    Setup(&scheduler, START_TIME);
+    (void)scheduler.Start(0, millis_u32st, 50u, 50u);
+    Advance(&scheduler, 1000u, 1u);
+    for(idx_u8 = 0; idx_u8 < 20u; idx_u8++)
+    {
+        times_u32a[idx_u8] = START_TIME + ((idx_u8 + 1u) * 50u);
+    }
+    pass_bol = Expect_bol(0, times_u32a, 20u) && (true == scheduler.IsActive_bol(0));
+
+    // a loop of 130 ms misses periods of 50 ms, they are not fired as burst
+    Setup(&scheduler, START_TIME);
+    (void)scheduler.Start(1, millis_u32st, 50u, 50u);
+    Advance(&scheduler, 1300u, 130u);
+    for(idx_u8 = 0; idx_u8 < 10u; idx_u8++)
+    {
+        times_u32a[idx_u8] = START_TIME + ((idx_u8 + 1u) * 130u);
+    }
+    pass_bol = pass_bol && Expect_bol(1, times_u32a, 10u);
+    return(Report("periodic and skipped periods", pass_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Stopped timers do not expire, a restart moves the deadline, a timer 
+ *              function may stop a timer of the same slot
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Cancel(void)
+{
+    Scheduler scheduler;
+    const uint32_t restart_u32a[1] = {START_TIME + 150u};
+    const uint32_t periodic_u32a[3] = {START_TIME + 40u, START_TIME + 80u, START_TIME + 120u};
+    const uint32_t first_u32a[1] = {START_TIME + 200u};
+    bool pass_bol;
+
+    Setup(&scheduler, START_TIME);
+    (void)scheduler.Start(0, millis_u32st, 100u, 0);
+    (void)scheduler.Start(1, millis_u32st, 100u, 0);
+    (void)scheduler.Start(2, millis_u32st, 40u, 40u);
+    Advance(&scheduler, 50u, 1u);
+    scheduler.Stop(0);
+    (void)scheduler.Start(1, millis_u32st, 100u, 0);
+    Advance(&scheduler, 70u, 1u);
+    scheduler.Stop(2);
+    scheduler.Stop(2);
+    Advance(&scheduler, 300u, 1u);
+    pass_bol =    Expect_bol(0, NULL, 0) && Expect_bol(1, restart_u32a, 1u)
+               && Expect_bol(2, periodic_u32a, 3u) && (false == scheduler.IsActive_bol(0))
+               && (false == scheduler.IsActive_bol(2));
+
+    // timer 4 is started last and runs first, it stops timer 3 of the same deadline
+    Setup(&scheduler, START_TIME);
+    (void)scheduler.Start(3, millis_u32st, 200u, 0);
+    (void)scheduler.Start(4, millis_u32st, 200u, 0);
+    stopInCallback_u8st = 3;
+    Advance(&scheduler, 300u, 1u);
+    pass_bol = pass_bol && Expect_bol(4, first_u32a, 1u) && Expect_bol(3, NULL, 0);
+    return(Report("stop and restart", pass_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Timers in the same wheel slot expire at their own deadline only
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Collision(void)
+{
+    Scheduler scheduler;
+    const uint32_t slot0_u32a[1] = {START_TIME + 100u};
+    const uint32_t slot1_u32a[1] = {START_TIME + 100u + WHEEL_SPAN};
+    const uint32_t slot2_u32a[1] = {START_TIME + 100u + (2u * WHEEL_SPAN)};
+    const uint32_t tick_u32a[1] = {START_TIME + 100u + WHEEL_SPAN + 1u};
+    const uint32_t slow0_u32a[1] = {START_TIME + 120u};
+    const uint32_t slow1_u32a[1] = {START_TIME + 360u};
+    uint8_t idx_u8;
+    bool pass_bol;
+
+    Setup(&scheduler, START_TIME);
+    (void)scheduler.Start(0, millis_u32st, 100u, 0);
+    (void)scheduler.Start(1, millis_u32st, 100u + WHEEL_SPAN, 0);
+    (void)scheduler.Start(2, millis_u32st, 100u + (2u * WHEEL_SPAN), 0);
+    (void)scheduler.Start(3, millis_u32st, 100u, 0);
+    (void)scheduler.Start(4, millis_u32st, 100u + WHEEL_SPAN + 1u, 0);
+    Advance(&scheduler, 4u * WHEEL_SPAN, 1u);
+    pass_bol =    Expect_bol(0, slot0_u32a, 1u) && Expect_bol(1, slot1_u32a, 1u)
+               && Expect_bol(2, slot2_u32a, 1u) && Expect_bol(3, slot0_u32a, 1u)
+               && Expect_bol(4, tick_u32a, 1u);
+
+    // a slow loop passes several slots at once
+    Setup(&scheduler, START_TIME);
+    (void)scheduler.Start(0, millis_u32st, 100u, 0);
+    (void)scheduler.Start(1, millis_u32st, 100u + WHEEL_SPAN, 0);
+    Advance(&scheduler, 4u * WHEEL_SPAN, 120u);
+    pass_bol = pass_bol && Expect_bol(0, slow0_u32a, 1u) && Expect_bol(1, slow1_u32a, 1u);
+    for(idx_u8 = 0; idx_u8 < USERS; idx_u8++)
+    {
+        pass_bol = pass_bol && (false == scheduler.IsActive_bol(idx_u8));
+    }
+    return(Report("wheel slot collision", pass_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Deadlines and periods across the millis() wraparound at 2^32
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Wraparound(void)
+{
+    Scheduler scheduler;
+    const uint32_t oneShot_u32a[1] = {(uint32_t)(WRAP_TIME + 300ul)};
+    uint32_t times_u32a[MAX_FIRES];
+    uint32_t idle_u32;
+    uint8_t idx_u8;
+    bool pass_bol;
+
+    Setup(&scheduler, WRAP_TIME);
+    (void)scheduler.Start(0, millis_u32st, 300u, 0);
+    (void)scheduler.Start(1, millis_u32st, 64u, 64u);
+    Advance(&scheduler, 100u, 1u);
+    idle_u32 = scheduler.GetIdleTime_u32(millis_u32st, 1000u);
+    Advance(&scheduler, 540u, 1u);
+    for(idx_u8 = 0; idx_u8 < 10u; idx_u8++)
+    {
+        times_u32a[idx_u8] = (uint32_t)(WRAP_TIME + ((idx_u8 + 1u) * 64ul));
+    }
+    pass_bol =    Expect_bol(0, oneShot_u32a, 1u) && Expect_bol(1, times_u32a, 10u)
+               && (28u == idle_u32);
+    if(28u != idle_u32)
+    {
+        printf("     idle time %lu, expected 28\n", (unsigned long)idle_u32);
+    }
+    return(Report("millis wraparound", pass_bol));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     The idle time ends at the next deadline, an expired timer or a wakeup
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    1 for a failed test case, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int IdleTime(void)
+{
+    Scheduler scheduler;
+    bool pass_bol;
+
+    Setup(&scheduler, START_TIME);
+    pass_bol = (50u == scheduler.GetIdleTime_u32(millis_u32st, 50u));
+    (void)scheduler.Start(0, millis_u32st, 30u, 0);
+    (void)scheduler.Start(1, millis_u32st, 20u, 0);
+    pass_bol = pass_bol && (20u == scheduler.GetIdleTime_u32(millis_u32st, 50u));
+    pass_bol = pass_bol && (10u == scheduler.GetIdleTime_u32(millis_u32st, 10u));
+    pass_bol = pass_bol && (0 == scheduler.GetIdleTime_u32(millis_u32st + 20u, 50u));
+    scheduler.Wakeup();
+    pass_bol = pass_bol && (0 == scheduler.GetIdleTime_u32(millis_u32st, 50u));
+    pass_bol = pass_bol && (true == scheduler.TakeWakeup_bol());
+    pass_bol = pass_bol && (20u == scheduler.GetIdleTime_u32(millis_u32st, 50u));
+    return(Report("idle time", pass_bol));
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Test entry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of failed test cases
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    int failed_s32 = 0;
+
+    failed_s32 += OneShot();
+    failed_s32 += Periodic();
+    failed_s32 += Cancel();
+    failed_s32 += Collision();
+    failed_s32 += Wraparound();
+    failed_s32 += IdleTime();
+    return(failed_s32);
+}
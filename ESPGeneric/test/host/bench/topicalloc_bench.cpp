@@ -0,0 +1,312 @@
+/*****************************************************************************************
+* FILENAME :        topicalloc_bench.cpp
+*
+* DESCRIPTION :
+*       Host benchmark of the heap allocations per received MQTT message
+*
+* NOTES :
+*       Compares the legacy broadcast callback with the routed callback for 1, 4
+*       and 8 dim light channels with toggle, switch and brightness topic each.
+*       The legacy path copies the payload into a String, compares the generic
+*       topics as String and passes the payload by value to the CallbackMqtt of
+*       every device, which builds a String for each of its receive topics. The
+*       routed path compares the generic topics with strcmp, looks the topic up
+*       in the topic router and passes the payload as MqttPayload view.
+*       malloc, calloc and realloc are counted while a path runs. The benchmark
+*       fails, if the routed path allocates.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs 
+*           test/host/bench/topicalloc_bench.cpp src/TopicRouter.cpp src/MqttPayload.cpp 
+*           test/host/stubs/Arduino.cpp -o topicalloc
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include "Arduino.h"
+#include "MqttPayload.h"
+#include "TopicRouter.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define MAX_CHANNELS                8u
+#define COMMANDS                    3u
+#define TOPIC_LENGTH                48u
+#define MESSAGES                    10000u
+#define PREFIX                      "std/dev05/r/"
+#define COMMAND_TOPIC               "std/dev05/r/cmd"
+#define BCAST_TOPIC                 "std/bcast/r/cmd"
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Local function prototypes */
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+/****************************************************************************************/
+/* Local data definitions */
+static const char *commands_stccpa[COMMANDS] = {"toggle", "switch", "brightness"};
+static const char *payloads_stccpa[COMMANDS] = {"", "ON", "128"};
+static char topics_stca[MAX_CHANNELS * COMMANDS][TOPIC_LENGTH];
+static TopicRouter router_st;
+static volatile uint32_t sink_u32;
+
+static bool countAllocs_bolst = false;
+static uint64_t allocs_u64st = 0;
+static uint64_t allocBytes_u64st = 0;
+
+/****************************************************************************************/
+/* Local functions */
+extern "C" void *malloc(size_t size)
+{
+    if(true == countAllocs_bolst)
+    {
+        allocs_u64st++;
+        allocBytes_u64st += size;
+    }
+    return(__libc_malloc(size));
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    if(true == countAllocs_bolst)
+    {
+        allocs_u64st++;
+        allocBytes_u64st += count * size;
+    }
+    return(__libc_calloc(count, size));
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    if((true == countAllocs_bolst) && (0 != size))
+    {
+        allocs_u64st++;
+        allocBytes_u64st += size;
+    }
+    return(__libc_realloc(ptr, size));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Builds the receive topics and registers them at the router
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     channels_u8   number of channels
+ * @return    number of topics
+*//*-----------------------------------------------------------------------------------*/
+static uint16_t Setup_u16(uint8_t channels_u8)
+{
+    uint16_t count_u16 = 0;
+    uint8_t chan_u8;
+    uint8_t cmd_u8;
+
+    router_st.Clear();
+    for(chan_u8 = 0; chan_u8 < channels_u8; chan_u8++)
+    {
+        for(cmd_u8 = 0; cmd_u8 < COMMANDS; cmd_u8++)
+        {
+            snprintf(topics_stca[count_u16], TOPIC_LENGTH, "%schan%u/%s", PREFIX, 
+                        chan_u8, commands_stccpa[cmd_u8]);
+            // the device pointer is only compared, any unique value will do
+            (void)router_st.Register(topics_stca[count_u16], 
+                                        (MqttDevice *)(size_t)(0x1000u + chan_u8), cmd_u8);
+            count_u16++;
+        }
+    }
+    return(count_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     CallbackMqtt of a legacy device, one String per compared receive topic
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     chan_u8       channel of the device
+ * @param     topic_ccp     received topic
+ * @param     payload_str   payload, passed by value like the legacy interface
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void LegacyDevice(uint8_t chan_u8, const char *topic_ccp, String payload_str)
+{
+    uint8_t cmd_u8;
+
+    for(cmd_u8 = 0; cmd_u8 < COMMANDS; cmd_u8++)
+    {
+        if(String(topics_stca[(chan_u8 * COMMANDS) + cmd_u8]).equals(topic_ccp))
+        {
+            sink_u32 += cmd_u8 + payload_str.length();
+            return;
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Legacy callback, the payload is copied and broadcast to all devices
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp     received topic
+ * @param     payload_pu8   received payload
+ * @param     length_u16    payload length
+ * @param     channels_u8   number of devices
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void Legacy(const char *topic_ccp, const uint8_t *payload_pu8, uint16_t length_u16,
+                    uint8_t channels_u8)
+{
+    String payload;
+    uint16_t idx_u16;
+    uint8_t chan_u8;
+
+    for(idx_u16 = 0; idx_u16 < length_u16; idx_u16++)
+    {
+        payload.concat((char)payload_pu8[idx_u16]);
+    }
+    if(String(COMMAND_TOPIC).equals(topic_ccp))
+    {
+        sink_u32++;
+    }
+    else if(String(BCAST_TOPIC).equals(topic_ccp))
+    {
+        sink_u32++;
+    }
+    else
+    {
+        for(chan_u8 = 0; chan_u8 < channels_u8; chan_u8++)
+        {
+            LegacyDevice(chan_u8, topic_ccp, payload);
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Routed callback, the payload is only viewed
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp     received topic
+ * @param     payload_pu8   received payload
+ * @param     length_u16    payload length
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void Routed(const char *topic_ccp, const uint8_t *payload_pu8, uint16_t length_u16)
+{
+    MqttPayload payload(payload_pu8, length_u16);
+    const topicRoute_t *route_p;
+
+    if(0 == strcmp(COMMAND_TOPIC, topic_ccp))
+    {
+        sink_u32++;
+    }
+    else if(0 == strcmp(BCAST_TOPIC, topic_ccp))
+    {
+        sink_u32++;
+    }
+    else if(NULL != (route_p = router_st.Lookup(topic_ccp)))
+    {
+        sink_u32 += route_p->handlerId_u8 + payload.GetLength_u16();
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Runs both paths for one channel count
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     channels_u8   number of channels
+ * @return    1, if the routed path allocated, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Run(uint8_t channels_u8)
+{
+    uint16_t count_u16 = Setup_u16(channels_u8);
+    uint32_t msg_u32;
+    uint16_t idx_u16;
+    const char *payload_ccp;
+    double legacy_f64;
+    double legacyBytes_f64;
+    double routed_f64;
+    double routedBytes_f64;
+
+    allocs_u64st = 0;
+    allocBytes_u64st = 0;
+    countAllocs_bolst = true;
+    for(msg_u32 = 0; msg_u32 < MESSAGES; msg_u32++)
+    {
+        idx_u16 = msg_u32 % count_u16;
+        payload_ccp = payloads_stccpa[idx_u16 % COMMANDS];
+        Legacy(topics_stca[idx_u16], (const uint8_t *)payload_ccp, strlen(payload_ccp), 
+                channels_u8);
+    }
+    countAllocs_bolst = false;
+    legacy_f64 = (double)allocs_u64st / MESSAGES;
+    legacyBytes_f64 = (double)allocBytes_u64st / MESSAGES;
+
+    allocs_u64st = 0;
+    allocBytes_u64st = 0;
+    countAllocs_bolst = true;
+    for(msg_u32 = 0; msg_u32 < MESSAGES; msg_u32++)
+    {
+        idx_u16 = msg_u32 % count_u16;
+        payload_ccp = payloads_stccpa[idx_u16 % COMMANDS];
+        Routed(topics_stca[idx_u16], (const uint8_t *)payload_ccp, strlen(payload_ccp));
+    }
+    countAllocs_bolst = false;
+    routed_f64 = (double)allocs_u64st / MESSAGES;
+    routedBytes_f64 = (double)allocBytes_u64st / MESSAGES;
+
+    printf("%8u %7u %13.2f %13.1f %13.2f %13.1f\n", channels_u8, count_u16, 
+            legacy_f64, legacyBytes_f64, routed_f64, routedBytes_f64);
+    return((0 == allocs_u64st) ? 0 : 1);
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Benchmark entry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    0, if the routed path is free of allocations
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    int failed_s32 = 0;
+
+    printf("heap allocations per received message\n");
+    printf("channels  topics legacy allocs  legacy bytes routed allocs  routed bytes\n");
+    failed_s32 += Run(1);
+    failed_s32 += Run(4);
+    failed_s32 += Run(8);
+    if(0 != failed_s32)
+    {
+        printf("FAILED: routed dispatch allocates\n");
+    }
+    return(failed_s32);
+}
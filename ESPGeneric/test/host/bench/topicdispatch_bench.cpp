@@ -0,0 +1,298 @@
+/*****************************************************************************************
+* FILENAME :        topicdispatch_bench.cpp
+*
+* DESCRIPTION :
+*       Host benchmark of the receive topic dispatch for 8, 16 and 32 channels
+*
+* NOTES :
+*       Every channel has the toggle, switch and brightness receive topic of a
+*       dim light. Compared are the linear strcmp scan over all topics, the topic
+*       router lookup and the wildcard path, which checks the std/<dev>/r/ prefix
+*       before the router lookup. Also the number of subscribed filters and
+*       SUBSCRIBE packets with and without wildcard is printed.
+*       32 channels need more than the 32 default router slots, the bench is built
+*       with TOPICROUTER_SLOTS=128u. It fails if a topic is not registered or a
+*       dispatch misses its topic, so a too small router is not measured silently.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -DTOPICROUTER_SLOTS=128u -I include 
+*           test/host/bench/topicdispatch_bench.cpp src/TopicRouter.cpp -o topicbench
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "TopicRouter.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define MAX_CHANNELS                32u
+#define COMMANDS                    3u
+#define TOPIC_LENGTH                48u
+#define ITERATIONS                  200000u
+#define PACKET_SIZE                 128u
+#define PREFIX                      "std/dev05/r/"
+#define WILDCARD                    "std/dev05/r/#"
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Local data definitions */
+static const char *commands_stccpa[COMMANDS] = {"toggle", "switch", "brightness"};
+static char topics_stca[MAX_CHANNELS * COMMANDS][TOPIC_LENGTH];
+static TopicRouter router_st;
+static volatile uint32_t sink_u32;
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Monotonic time in nanoseconds
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    time stamp
+*//*-----------------------------------------------------------------------------------*/
+static double Now_f64(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((double)ts.tv_sec * 1e9 + (double)ts.tv_nsec);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Builds the receive topics and registers them at the router
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     channels_u8   number of channels
+ * @return    number of topics
+*//*-----------------------------------------------------------------------------------*/
+static uint16_t Setup_u16(uint8_t channels_u8)
+{
+    uint16_t count_u16 = 0;
+    uint8_t chan_u8;
+    uint8_t cmd_u8;
+
+    router_st.Clear();
+    for(chan_u8 = 0; chan_u8 < channels_u8; chan_u8++)
+    {
+        for(cmd_u8 = 0; cmd_u8 < COMMANDS; cmd_u8++)
+        {
+            snprintf(topics_stca[count_u16], TOPIC_LENGTH, "%schan%u/%s", PREFIX, 
+                        chan_u8, commands_stccpa[cmd_u8]);
+            // the device pointer is only compared, any unique value will do
+            (void)router_st.Register(topics_stca[count_u16], 
+                                        (MqttDevice *)(size_t)(0x1000u + chan_u8), cmd_u8);
+            count_u16++;
+        }
+    }
+    return(count_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Number of SUBSCRIBE packets needed for the given topics
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     count_u16     number of topics
+ * @return    number of packets
+*//*-----------------------------------------------------------------------------------*/
+static uint16_t Packets_u16(uint16_t count_u16)
+{
+    uint16_t packets_u16 = 0;
+    uint32_t length_u32 = PACKET_SIZE;
+    uint32_t entry_u32;
+    uint16_t idx_u16;
+
+    for(idx_u16 = 0; idx_u16 < count_u16; idx_u16++)
+    {
+        entry_u32 = 2u + strlen(topics_stca[idx_u16]) + 1u;
+        if(length_u32 + entry_u32 > PACKET_SIZE)
+        {
+            packets_u16++;
+            length_u32 = 5u + 2u;
+        }
+        length_u32 += entry_u32;
+    }
+    return(packets_u16);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Linear dispatch, every topic is compared until the match is found
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp     received topic
+ * @param     count_u16     number of topics
+ * @return    index of the topic
+*//*-----------------------------------------------------------------------------------*/
+static uint32_t DispatchLinear_u32(const char *topic_ccp, uint16_t count_u16)
+{
+    uint16_t idx_u16;
+
+    for(idx_u16 = 0; idx_u16 < count_u16; idx_u16++)
+    {
+        if(0 == strcmp(topics_stca[idx_u16], topic_ccp))
+        {
+            return(idx_u16);
+        }
+    }
+    return(0xFFFFu);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Dispatch through the topic router
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp     received topic
+ * @return    handler id of the route
+*//*-----------------------------------------------------------------------------------*/
+static uint32_t DispatchRouter_u32(const char *topic_ccp)
+{
+    const topicRoute_t *route_p = router_st.Lookup(topic_ccp);
+
+    return((NULL == route_p) ? 0xFFFFu : route_p->handlerId_u8);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Dispatch of a topic received by the wildcard subscription
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     topic_ccp     received topic
+ * @return    handler id of the route
+*//*-----------------------------------------------------------------------------------*/
+static uint32_t DispatchWildcard_u32(const char *topic_ccp)
+{
+    if(0 != strncmp(topic_ccp, PREFIX, sizeof(PREFIX) - 1u))
+    {
+        return(0xFFFFu);
+    }
+    return(DispatchRouter_u32(topic_ccp));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Checks that every topic is registered and dispatched to its own handler
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     channels_u8   number of channels
+ * @param     count_u16     number of topics
+ * @return    0 if all topics are routed, else 1
+*//*-----------------------------------------------------------------------------------*/
+static int Check_s32(uint8_t channels_u8, uint16_t count_u16)
+{
+    uint16_t idx_u16;
+
+    if(0 != router_st.GetFailures_u8())
+    {
+        fprintf(stderr, "<<bench>> %u channels: %u topics not registered, "
+                "router slots %u\n", channels_u8, router_st.GetFailures_u8(), 
+                TOPICROUTER_SLOTS);
+        return(1);
+    }
+    for(idx_u16 = 0; idx_u16 < count_u16; idx_u16++)
+    {
+        if(((idx_u16 % COMMANDS) != DispatchRouter_u32(topics_stca[idx_u16]))
+            || ((idx_u16 % COMMANDS) != DispatchWildcard_u32(topics_stca[idx_u16])))
+        {
+            fprintf(stderr, "<<bench>> %u channels: %s not dispatched\n", channels_u8, 
+                    topics_stca[idx_u16]);
+            return(1);
+        }
+    }
+    return(0);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Runs all dispatch variants for one channel count
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     channels_u8   number of channels
+ * @return    0 if all topics are routed, else 1
+*//*-----------------------------------------------------------------------------------*/
+static int Run_s32(uint8_t channels_u8)
+{
+    uint16_t count_u16 = Setup_u16(channels_u8);
+    uint32_t iter_u32;
+    double start_f64;
+    double linear_f64;
+    double router_f64;
+    double wildcard_f64;
+
+    if(0 != Check_s32(channels_u8, count_u16))
+    {
+        return(1);
+    }
+
+    start_f64 = Now_f64();
+    for(iter_u32 = 0; iter_u32 < ITERATIONS; iter_u32++)
+    {
+        sink_u32 += DispatchLinear_u32(topics_stca[iter_u32 % count_u16], count_u16);
+    }
+    linear_f64 = (Now_f64() - start_f64) / ITERATIONS;
+
+    start_f64 = Now_f64();
+    for(iter_u32 = 0; iter_u32 < ITERATIONS; iter_u32++)
+    {
+        sink_u32 += DispatchRouter_u32(topics_stca[iter_u32 % count_u16]);
+    }
+    router_f64 = (Now_f64() - start_f64) / ITERATIONS;
+
+    start_f64 = Now_f64();
+    for(iter_u32 = 0; iter_u32 < ITERATIONS; iter_u32++)
+    {
+        sink_u32 += DispatchWildcard_u32(topics_stca[iter_u32 % count_u16]);
+    }
+    wildcard_f64 = (Now_f64() - start_f64) / ITERATIONS;
+
+    printf("%8u %7u %10.1f %10.1f %10.1f %9u %8u %9u\n", channels_u8, count_u16, 
+            linear_f64, router_f64, wildcard_f64, count_u16, Packets_u16(count_u16), 1u);
+    return(0);
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Benchmark entry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    number of channel counts with unrouted topics
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    int failed_s32 = 0;
+
+    printf("dispatch cost in ns per received topic, router slots %u\n", TOPICROUTER_SLOTS);
+    printf("channels  topics     linear     router   wildcard  filters  packets  wc-filter\n");
+    failed_s32 += Run_s32(8);
+    failed_s32 += Run_s32(16);
+    failed_s32 += Run_s32(32);
+    return(failed_s32);
+}
@@ -0,0 +1,378 @@
+/*****************************************************************************************
+* FILENAME :        tracebatch_test.cpp
+*
+* DESCRIPTION :
+*       Host test of the batched and rate limited MQTT trace channel
+*
+* NOTES :
+*       The trace publishes through a PubSubClient on a capture broker. The broker
+*       answers the CONNECT with a CONNACK and decodes every PUBLISH written to it.
+*       The fake millis() of the host stubs drives the token buckets. Checked
+*       are the error lines during an info flood, the info burst and refill rate,
+*       the batch size limit, the retain flag and the records kept in the buffer
+*       while the broker is not connected.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs -I lib/PubSubClient/src
+*           test/host/bench/tracebatch_test.cpp src/Trace.cpp src/TraceRing.cpp
+*           src/TraceFormat.cpp src/MqttPayload.cpp lib/PubSubClient/src/*.cpp
+*           test/host/stubs/*.cpp -o tracebatch
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include "Arduino.h"
+#include "Client.h"
+#include "PubSubClient.h"
+#include "Trace.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define CAPTURE_SIZE                16384u
+#define START_TIME                  100000ul
+#define DEVICE                      "dev99"
+#define ERR_TOPIC                   "err/" DEVICE "/s/trace/"
+#define INF_TOPIC                   "inf/" DEVICE "/s/trace/"
+#define LONG_LINE                   100u
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct capture_tag
+{
+    uint16_t            errLines_u16;       // text lines on the error topic
+    uint16_t            infLines_u16;       // text lines on the info topic
+    uint16_t            publishes_u16;
+    uint16_t            maxPayload_u16;     // largest batch
+    uint16_t            retained_u16;       // publishes with the retain flag
+    uint16_t            unknown_u16;        // publishes on other topics
+}capture_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class CaptureBroker : public Client
+{
+    public:
+        CaptureBroker() : open_bol(false), rxIdx_u8(0), rxLen_u8(0), used_u16(0) {}
+        int connect(IPAddress ip, uint16_t port)
+        {
+            (void)ip;
+            return(this->connect("", port));
+        }
+        int connect(const char *host, uint16_t port)
+        {
+            (void)host;
+            (void)port;
+            this->open_bol = true;
+            this->rxIdx_u8 = 0;
+            this->rxLen_u8 = 0;
+            return(1);
+        }
+        size_t write(uint8_t c) { return(this->write(&c, 1u)); }
+        size_t write(const uint8_t *buf, size_t size)
+        {
+            static const uint8_t connack_cu8a[4] = {0x20u, 0x02u, 0x00u, 0x00u};
+
+            if(false == this->open_bol)
+            {
+                return(0);
+            }
+            if((0 != size) && (0x10u == (buf[0] & 0xF0u)))
+            {
+                // answer the CONNECT packet, it is not captured
+                memcpy(this->rx_u8a, connack_cu8a, sizeof(connack_cu8a));
+                this->rxIdx_u8 = 0;
+                this->rxLen_u8 = sizeof(connack_cu8a);
+                return(size);
+            }
+            if((this->used_u16 + size) > CAPTURE_SIZE)
+            {
+                return(0);
+            }
+            memcpy(&this->capture_u8a[this->used_u16], buf, size);
+            this->used_u16 += (uint16_t)size;
+            return(size);
+        }
+        int available() { return(this->rxLen_u8 - this->rxIdx_u8); }
+        int read()
+        {
+            return((this->rxIdx_u8 < this->rxLen_u8) ? this->rx_u8a[this->rxIdx_u8++] : -1);
+        }
+        int read(uint8_t *buf, size_t size)
+        {
+            size_t idx_u32;
+
+            for(idx_u32 = 0; (idx_u32 < size) && (this->rxIdx_u8 < this->rxLen_u8); idx_u32++)
+            {
+                buf[idx_u32] = this->rx_u8a[this->rxIdx_u8++];
+            }
+            return((int)idx_u32);
+        }
+        int peek()
+        {
+            return((this->rxIdx_u8 < this->rxLen_u8) ? this->rx_u8a[this->rxIdx_u8] : -1);
+        }
+        void flush() {}
+        void stop() { this->open_bol = false; }
+        uint8_t connected() { return(this->open_bol ? 1u : 0u); }
+        operator bool() { return(this->open_bol); }
+
+        /**-------------------------------------------------------------------------------
+         * @brief     Decodes the captured PUBLISH packets and clears the capture
+         * @author    winkste
+         * @date      17 Okt. 2026
+         * @param     result_p      returns the decoded packets
+         * @return    true, if the capture holds only complete PUBLISH packets
+        *//*---------------------------------------------------------------------------*/
+        bool Decode_bol(capture_t *result_p)
+        {
+            uint16_t idx_u16 = 0;
+            uint16_t payload_u16;
+            uint16_t topic_u16;
+            uint32_t remaining_u32;
+            uint8_t shift_u8;
+            const uint8_t *packet_pu8;
+            const char *payload_pch;
+            bool valid_bol = true;
+
+            memset(result_p, 0, sizeof(capture_t));
+            while((true == valid_bol) && (idx_u16 < this->used_u16))
+            {
+                packet_pu8 = &this->capture_u8a[idx_u16++];
+                remaining_u32 = 0;
+                shift_u8 = 0;
+                do
+                {
+                    remaining_u32 |= 
+                        (uint32_t)(this->capture_u8a[idx_u16] & 0x7Fu) << shift_u8;
+                    shift_u8 += 7u;
+                } while((0 != (this->capture_u8a[idx_u16++] & 0x80u)) && (shift_u8 < 28u));
+
+                topic_u16 = (uint16_t)((this->capture_u8a[idx_u16] << 8)
+                                        | this->capture_u8a[idx_u16 + 1u]);
+                valid_bol =    (0x30u == (packet_pu8[0] & 0xF0u))
+                            && ((idx_u16 + remaining_u32) <= this->used_u16)
+                            && ((2u + topic_u16) <= remaining_u32);
+                if(false == valid_bol)
+                {
+                    break;
+                }
+                payload_pch = (const char *)&this->capture_u8a[idx_u16 + 2u + topic_u16];
+                payload_u16 = (uint16_t)(remaining_u32 - 2u - topic_u16);
+                result_p->publishes_u16++;
+                result_p->retained_u16 += (0 != (packet_pu8[0] & 0x01u)) ? 1u : 0u;
+                if(payload_u16 > result_p->maxPayload_u16)
+                {
+                    result_p->maxPayload_u16 = payload_u16;
+                }
+                if(    (sizeof(ERR_TOPIC) - 1u == topic_u16)
+                    && (0 == memcmp(&this->capture_u8a[idx_u16 + 2u], ERR_TOPIC, topic_u16)))
+                {
+                    result_p->errLines_u16 += Lines_u16(payload_pch, payload_u16);
+                }
+                else if(    (sizeof(INF_TOPIC) - 1u == topic_u16)
+                         && (0 == memcmp(&this->capture_u8a[idx_u16 + 2u], INF_TOPIC,
+                                            topic_u16)))
+                {
+                    result_p->infLines_u16 += Lines_u16(payload_pch, payload_u16);
+                }
+                else
+                {
+                    result_p->unknown_u16++;
+                }
+                idx_u16 += (uint16_t)remaining_u32;
+            }
+            this->used_u16 = 0;
+            return(valid_bol);
+        }
+
+        bool            open_bol;
+
+    private:
+        /**-------------------------------------------------------------------------------
+         * @brief     Counts the text lines of a batch, they are separated by a line feed
+         * @author    winkste
+         * @date      17 Okt. 2026
+         * @param     payload_pch   batch
+         * @param     length_u16    batch length
+         * @return    number of lines
+        *//*---------------------------------------------------------------------------*/
+        static uint16_t Lines_u16(const char *payload_pch, uint16_t length_u16)
+        {
+            uint16_t lines_u16 = (0u == length_u16) ? 0u : 1u;
+            uint16_t idx_u16;
+
+            for(idx_u16 = 0; idx_u16 < length_u16; idx_u16++)
+            {
+                lines_u16 += ('\n' == payload_pch[idx_u16]) ? 1u : 0u;
+            }
+            return(lines_u16);
+        }
+
+        uint8_t         rx_u8a[8];
+        uint8_t         rxIdx_u8;
+        uint8_t         rxLen_u8;
+        uint8_t         capture_u8a[CAPTURE_SIZE];
+        uint16_t        used_u16;
+};
+
+/****************************************************************************************/
+/* Local data definitions */
+static CaptureBroker broker_st;
+static PubSubClient client_st(broker_st);
+static Trace trace_st(true);
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Traces numbered lines of one message type
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     type_u8       trace message type
+ * @param     count_u16     number of lines
+ * @param     length_u8     length of every line
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void TraceLines(uint8_t type_u8, uint16_t count_u16, uint8_t length_u8)
+{
+    char line_ca[TRACERING_MAX_TEXT + 1u];
+    uint16_t idx_u16;
+
+    memset(line_ca, '.', sizeof(line_ca));
+    for(idx_u16 = 0; idx_u16 < count_u16; idx_u16++)
+    {
+        snprintf(line_ca, sizeof(line_ca), "%s %03u",
+                    (trace_ERROR_MSG == type_u8) ? "err" : "inf", idx_u16);
+        line_ca[strlen(line_ca)] = '.';
+        line_ca[length_u8] = '\0';
+        trace_st.println(type_u8, line_ca);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Pushes the trace records and compares the published lines
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     name_ccp      name of the check
+ * @param     errLines_u16  expected error lines
+ * @param     infLines_u16  expected info lines
+ * @param     result_p      returns the decoded publishes, may be NULL
+ * @return    1 for a failed check, else 0
+*//*-----------------------------------------------------------------------------------*/
+static int Push(const char *name_ccp, uint16_t errLines_u16, uint16_t infLines_u16,
+                capture_t *result_p)
+{
+    capture_t capture_st;
+    bool pass_bol;
+
+    trace_st.PushToChannel();
+    pass_bol =    (true == broker_st.Decode_bol(&capture_st))
+               && (errLines_u16 == capture_st.errLines_u16)
+               && (infLines_u16 == capture_st.infLines_u16)
+               && (0u == capture_st.retained_u16)
+               && (0u == capture_st.unknown_u16)
+               && (trace_BATCH_SIZE >= capture_st.maxPayload_u16);
+    printf("%s %-34s err %2u inf %2u in %2u publishes, max %3u bytes\n",
+            pass_bol ? "PASS" : "FAIL", name_ccp, capture_st.errLines_u16,
+            capture_st.infLines_u16, capture_st.publishes_u16, capture_st.maxPayload_u16);
+    if(NULL != result_p)
+    {
+        *result_p = capture_st;
+    }
+    return(pass_bol ? 0 : 1);
+}
+
+/****************************************************************************************/
+/* Main */
+int main(void)
+{
+    capture_t capture_st;
+    int failed_s32 = 0;
+
+    host_SetMillis(START_TIME);
+    client_st.setServer("broker", 1883);
+    (void)client_st.connect(DEVICE);
+    trace_st.InitializeMqtt(&client_st, DEVICE);
+    trace_st.SwitchToMqtt();
+
+    // an info flood with interleaved errors, the info burst is used up
+    TraceLines(trace_INFO_MSG, 20u, 10u);
+    TraceLines(trace_ERROR_MSG, 3u, 10u);
+    TraceLines(trace_INFO_MSG, 20u, 10u);
+    TraceLines(trace_ERROR_MSG, 2u, 10u);
+    failed_s32 += Push("flood burst", 5u, trace_INFO_BURST, NULL);
+
+    // the info bucket is empty, errors still go out with their own bucket
+    TraceLines(trace_INFO_MSG, 20u, 10u);
+    TraceLines(trace_ERROR_MSG, 4u, 10u);
+    failed_s32 += Push("errors with empty info bucket", 4u, 0u, NULL);
+
+    // 30 info lines are waiting, they are refilled with 10 lines per second
+    host_AdvanceMillis(1000u);
+    failed_s32 += Push("info refill after 1 s", 0u, trace_INFO_RATE, NULL);
+    host_AdvanceMillis(500u);
+    failed_s32 += Push("info refill after 0.5 s", 0u, trace_INFO_RATE / 2u, NULL);
+    host_AdvanceMillis(99u);
+    failed_s32 += Push("info refill after 99 ms", 0u, 0u, NULL);
+    host_AdvanceMillis(1u);
+    failed_s32 += Push("info refill after 100 ms", 0u, 1u, NULL);
+    host_AdvanceMillis(1400u);
+    failed_s32 += Push("info rest", 0u, 14u, NULL);
+
+    // long lines are split into several batches below the size limit
+    host_AdvanceMillis(trace_INFO_BURST * 1000u);
+    TraceLines(trace_INFO_MSG, 9u, LONG_LINE);
+    failed_s32 += Push("batches of long lines", 0u, 9u, &capture_st);
+    if(capture_st.publishes_u16 < ((9u * LONG_LINE) / trace_BATCH_SIZE + 1u))
+    {
+        printf("FAIL long lines in %u publishes\n", capture_st.publishes_u16);
+        failed_s32++;
+    }
+
+    // without broker connection the records stay in the buffer until the reconnect
+    host_AdvanceMillis(trace_INFO_BURST * 1000u);
+    broker_st.stop();
+    TraceLines(trace_INFO_MSG, 6u, 10u);
+    TraceLines(trace_ERROR_MSG, 3u, 10u);
+    failed_s32 += Push("disconnected", 0u, 0u, NULL);
+    host_AdvanceMillis(1000u);
+    failed_s32 += Push("still disconnected", 0u, 0u, NULL);
+    (void)client_st.connect(DEVICE);
+    failed_s32 += Push("reconnected", 3u, 6u, NULL);
+    if(0u != trace_st.GetDropped_u32())
+    {
+        printf("FAIL %lu records dropped\n", (unsigned long)trace_st.GetDropped_u32());
+        failed_s32++;
+    }
+
+    printf("%d checks failed\n", failed_s32);
+    return((0 == failed_s32) ? 0 : 1);
+}
@@ -0,0 +1,195 @@
+/*****************************************************************************************
+* FILENAME :        tracering_bench.cpp
+*
+* DESCRIPTION :
+*       Host benchmark of the trace record buffer
+*
+* NOTES :
+*       Compared are the former queue, where every trace line was a heap allocated
+*       message with a String in a LinkedList, and the fixed size record ring. The
+*       burst run writes ten times the ring capacity without draining and shows
+*       the overwrite of the oldest records, the steady run drains every record
+*       after it was written.
+*
+*       Build and run from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs -I lib/LinkedList
+*           test/host/bench/tracering_bench.cpp src/TraceRing.cpp 
+*           test/host/stubs/Arduino.cpp -o tracebench
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <Arduino.h>
+#include <LinkedList.h>
+#include "TraceRing.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define ITERATIONS                  200000u
+#define RING_SIZE                   1024u
+#define LENGTHS                     3u
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+class Message
+{
+    public:
+        String msg;
+        uint8_t type_u8;
+};
+
+/****************************************************************************************/
+/* Local data definitions */
+static const uint8_t lengths_stau8[LENGTHS] = {16u, 48u, 120u};
+static char text_stca[TRACERING_MAX_TEXT + 1u];
+static uint8_t buffer_stau8[RING_SIZE];
+static TraceRing ring_st(buffer_stau8, sizeof(buffer_stau8));
+static volatile uint32_t sink_u32;
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Monotonic time in nanoseconds
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    time stamp
+*//*-----------------------------------------------------------------------------------*/
+static double Now_f64(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((double)ts.tv_sec * 1e9 + (double)ts.tv_nsec);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Former trace queue, allocation, copy and release of one line
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     list_p        message list
+ * @param     length_u8     text length
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void LegacyLine(LinkedList<Message*> *list_p, uint8_t length_u8)
+{
+    Message *msg_p = new Message();
+    String buffer_str = "";
+
+    msg_p->type_u8 = 1u;
+    buffer_str = buffer_str + String(text_stca).substring(0, length_u8);
+    msg_p->msg = String(buffer_str + "\n");
+    list_p->add(msg_p);
+
+    msg_p = list_p->shift();
+    sink_u32 += msg_p->msg.length();
+    delete msg_p;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Runs all buffer variants for one text length
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     length_u8     text length
+ * @return    n/a
+*//*-----------------------------------------------------------------------------------*/
+static void Run(uint8_t length_u8)
+{
+    LinkedList<Message*> list_st;
+    char record_ca[TRACERING_MAX_TEXT + 1u];
+    uint32_t iter_u32;
+    uint32_t burst_u32;
+    uint32_t dropped_u32;
+    uint8_t type_u8;
+    uint8_t read_u8;
+    double start_f64;
+    double legacy_f64;
+    double steady_f64;
+    double burst_f64;
+
+    start_f64 = Now_f64();
+    for(iter_u32 = 0; iter_u32 < ITERATIONS; iter_u32++)
+    {
+        LegacyLine(&list_st, length_u8);
+    }
+    legacy_f64 = (Now_f64() - start_f64) / ITERATIONS;
+
+    ring_st.Clear();
+    start_f64 = Now_f64();
+    for(iter_u32 = 0; iter_u32 < ITERATIONS; iter_u32++)
+    {
+        (void)ring_st.Write_bol(1u, text_stca, length_u8);
+        (void)ring_st.Read_bol(&type_u8, record_ca, sizeof(record_ca), &read_u8);
+        sink_u32 += read_u8;
+    }
+    steady_f64 = (Now_f64() - start_f64) / ITERATIONS;
+
+    // ten times the capacity without draining, the oldest records are overwritten
+    burst_u32 = 10u * (RING_SIZE / (length_u8 + TRACERING_HEADER_SIZE));
+    ring_st.Clear();
+    dropped_u32 = ring_st.GetDropped_u32();
+    start_f64 = Now_f64();
+    for(iter_u32 = 0; iter_u32 < burst_u32; iter_u32++)
+    {
+        (void)ring_st.Write_bol(1u, text_stca, length_u8);
+    }
+    burst_f64 = (Now_f64() - start_f64) / burst_u32;
+    dropped_u32 = ring_st.GetDropped_u32() - dropped_u32;
+
+    printf("%6u %10.1f %10.1f %10.1f %8u %8u %8u\n", length_u8, legacy_f64, steady_f64,
+            burst_f64, burst_u32, ring_st.GetRecords_u16(), dropped_u32);
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Benchmark entry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    0
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    uint8_t idx_u8;
+
+    memset(text_stca, 'x', TRACERING_MAX_TEXT);
+    text_stca[TRACERING_MAX_TEXT] = '\0';
+
+    printf("trace cost in ns per record, ring size %u bytes\n", RING_SIZE);
+    printf("length     legacy     steady      burst  written   stored  dropped\n");
+    for(idx_u8 = 0; idx_u8 < LENGTHS; idx_u8++)
+    {
+        Run(lengths_stau8[idx_u8]);
+    }
+    return(0);
+}
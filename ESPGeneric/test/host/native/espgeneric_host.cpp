@@ -0,0 +1,209 @@
+/*****************************************************************************************
+* FILENAME :        espgeneric_host.cpp
+*
+* DESCRIPTION :
+*       Host runner for the complete firmware, calls setup() and loop() of main.cpp
+*
+* NOTES :
+*       The EEPROM stub is seeded with the MQTT configuration before setup() is
+*       called, so the firmware starts with the given capability and connects
+*       through the socket backed WiFiClient to the broker, e.g. the stand-in
+*       broker of test/host/tools or a local mosquitto. The clock runs in real
+*       time, the socket timeouts of the PubSubClient busy wait on millis().
+*       SIGINT ends the loop regularly, so valgrind reports the heap of a
+*       completed run.
+*
+*       espgeneric [--host ip] [--port n] [--dev name] [--cap n] [--chan n]
+*                  [--seconds n] [--loops n] [--quiet]
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "gensettings.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define DEFAULT_HOST            "127.0.0.1"
+#define DEFAULT_PORT            "1883"
+#define DEFAULT_DEV             "dev99"
+#define DEFAULT_CAP             "21"        // CAPABILITY_TEST_DEVICE
+#define DEFAULT_CHAN            "1"         // trace_CHANNEL_SERIAL
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Local function prototypes */
+void setup(void);
+void loop(void);
+
+/****************************************************************************************/
+/* Local data definitions */
+static volatile sig_atomic_t stop_s32st = 0;
+
+/****************************************************************************************/
+/* Local functions */
+static void stopHandler(int signal_s32)
+{
+    (void)signal_s32;
+    stop_s32st = 1;
+}
+
+static void copyField(char *field_pch, size_t size_u32, const char *value_ccp)
+{
+    strncpy(field_pch, value_ccp, size_u32 - 1u);
+    field_pch[size_u32 - 1u] = '\0';
+}
+
+static void seedEeprom(const mqttData_t *data_cpst)
+{
+    const uint8_t *data_cpu8 = (const uint8_t *)data_cpst;
+    size_t idx_u32;
+
+    for(idx_u32 = 0; idx_u32 < sizeof(mqttData_t); idx_u32++)
+    {
+        EEPROM.write((int)idx_u32, data_cpu8[idx_u32]);
+    }
+}
+
+static double wallSeconds(void)
+{
+    struct timespec now_st;
+
+    clock_gettime(CLOCK_MONOTONIC, &now_st);
+    return((double)now_st.tv_sec + ((double)now_st.tv_nsec / 1e9));
+}
+
+static void usage(const char *name_ccp)
+{
+    fprintf(stderr, "usage: %s [--host ip] [--port n] [--dev name] [--cap n] [--chan n]\n"
+                    "          [--seconds n] [--loops n] [--quiet]\n", name_ccp);
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+int main(int argc, char *argv[])
+{
+    mqttData_t data_st;
+    unsigned long seconds_u32 = 0;
+    unsigned long loops_u32 = 0;
+    unsigned long count_u32 = 0;
+    bool quiet_bol = false;
+    double start_f64;
+    int idx_s32;
+
+    memset(&data_st, 0, sizeof(data_st));
+    copyField(data_st.server_ip, sizeof(data_st.server_ip), DEFAULT_HOST);
+    copyField(data_st.server_port, sizeof(data_st.server_port), DEFAULT_PORT);
+    copyField(data_st.dev_short, sizeof(data_st.dev_short), DEFAULT_DEV);
+    copyField(data_st.room, sizeof(data_st.room), "host");
+    copyField(data_st.cap, sizeof(data_st.cap), DEFAULT_CAP);
+    copyField(data_st.chan, sizeof(data_st.chan), DEFAULT_CHAN);
+
+    for(idx_s32 = 1; idx_s32 < argc; idx_s32++)
+    {
+        const char *arg_ccp = argv[idx_s32];
+        const char *value_ccp = (idx_s32 + 1 < argc) ? argv[idx_s32 + 1] : NULL;
+
+        if(0 == strcmp(arg_ccp, "--quiet"))
+        {
+            quiet_bol = true;
+            continue;
+        }
+        else if(NULL == value_ccp)
+        {
+            usage(argv[0]);
+            return(1);
+        }
+
+        if(0 == strcmp(arg_ccp, "--host"))
+        {
+            copyField(data_st.server_ip, sizeof(data_st.server_ip), value_ccp);
+        }
+        else if(0 == strcmp(arg_ccp, "--port"))
+        {
+            copyField(data_st.server_port, sizeof(data_st.server_port), value_ccp);
+        }
+        else if(0 == strcmp(arg_ccp, "--dev"))
+        {
+            copyField(data_st.dev_short, sizeof(data_st.dev_short), value_ccp);
+        }
+        else if(0 == strcmp(arg_ccp, "--cap"))
+        {
+            copyField(data_st.cap, sizeof(data_st.cap), value_ccp);
+        }
+        else if(0 == strcmp(arg_ccp, "--chan"))
+        {
+            copyField(data_st.chan, sizeof(data_st.chan), value_ccp);
+        }
+        else if(0 == strcmp(arg_ccp, "--seconds"))
+        {
+            seconds_u32 = strtoul(value_ccp, NULL, 10);
+        }
+        else if(0 == strcmp(arg_ccp, "--loops"))
+        {
+            loops_u32 = strtoul(value_ccp, NULL, 10);
+        }
+        else
+        {
+            usage(argv[0]);
+            return(1);
+        }
+        idx_s32++;
+    }
+
+    signal(SIGINT, stopHandler);
+    signal(SIGTERM, stopHandler);
+
+    seedEeprom(&data_st);
+    host_UseRealTime(true);
+    Serial.setEnabled(!quiet_bol);
+
+    start_f64 = wallSeconds();
+    setup();
+    while(0 == stop_s32st)
+    {
+        loop();
+        count_u32++;
+        if((0 != loops_u32) && (count_u32 >= loops_u32))
+        {
+            break;
+        }
+        if((0 != seconds_u32) && ((wallSeconds() - start_f64) >= (double)seconds_u32))
+        {
+            break;
+        }
+    }
+
+    fprintf(stderr, "<<host>> %lu loops in %.3f s\n", count_u32, wallSeconds() - start_f64);
+    return(0);
+}
@@ -0,0 +1,33 @@
+#!/bin/sh
+# Smoke test of the native firmware build, started by ctest.
+#
+#   smoke_test.sh <standin_broker> <espgeneric> <port>
+#
+# Runs the firmware against the stand-in broker and checks that it connected
+# and published the generic device information.
+BROKER=$1
+FIRMWARE=$2
+PORT=$3
+LOG=${TMPDIR:-/tmp}/espgeneric_smoke_$$.log
+
+"$BROKER" --port "$PORT" --seconds 6 --verbose > "$LOG" &
+BROKER_PID=$!
+sleep 1
+"$FIRMWARE" --port "$PORT" --dev smoke --seconds 3 --quiet
+FW_RESULT=$?
+wait $BROKER_PID
+
+RESULT=0
+if [ 0 -ne $FW_RESULT ]; then
+    echo "firmware exited with $FW_RESULT"
+    RESULT=1
+fi
+for TOPIC in std/smoke/s/gen/fwident std/smoke/s/gen/fwversion std/smoke/s/gen/ip; do
+    if ! grep -q "^$TOPIC " "$LOG"; then
+        echo "missing publish on $TOPIC"
+        RESULT=1
+    fi
+done
+cat "$LOG"
+rm -f "$LOG"
+exit $RESULT
@@ -0,0 +1,878 @@
+/*****************************************************************************************
+* FILENAME :        Arduino.cpp
+*
+* DESCRIPTION :
+*       Host stub of the Arduino core used by the native build
+*
+* NOTES :
+*       The time base is simulated, delay() advances the simulated clock instead
+*       of sleeping. With host_UseRealTime() the clock follows the monotonic clock
+*       of the host and delay() sleeps, as needed to run against a real broker.
+*       The String implementation allocates every non empty content on the heap,
+*       so allocation counts are an upper bound of the ESP8266 core. Output
+*       changes of digitalWrite(), analogWrite() and the NeoPixel espShow() are
+*       reported to the hook set with host_SetOutputHook().
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "Wire.h"
+#include "SPI.h"
+#include "ArduinoOTA.h"
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************************************************/
+/* Local constant defines */
+#define HOST_FREE_HEAP          40000u
+#define HOST_RTC_USER_MEMORY    512u
+
+/****************************************************************************************/
+/* Local data definitions */
+static uint64_t     hostMicros_u64st = 0;
+static bool         realTime_bolst = false;
+static int          digitalState_sta[HOST_PIN_COUNT];
+static int          analogState_sta[HOST_PIN_COUNT];
+static hostIsr_t    isr_sta[HOST_PIN_COUNT];
+static uint32_t     deepSleepCount_u32st = 0;
+static uint8_t      rtcMemory_u8ast[HOST_RTC_USER_MEMORY];
+static hostOutputHook_t outputHook_st = NULL;
+static hostAnalogHook_t analogHook_st = NULL;
+static uint8_t      i2cDevice_u8st = HOST_I2C_NO_DEVICE;
+static uint8_t      i2cRegisters_u8ast[256];
+static uint8_t      i2cPointer_u8st = 0;
+static uint8_t      i2cTxAddress_u8st = HOST_I2C_NO_DEVICE;
+static uint16_t     i2cTxBytes_u16st = 0;
+static uint8_t      i2cRx_u8ast[256];
+static uint16_t     i2cRxLength_u16st = 0;
+static uint16_t     i2cRxPos_u16st = 0;
+static uint32_t     i2cTransactions_u32st = 0;
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+TwoWire Wire;
+SPIClass SPI;
+ArduinoOTAClass ArduinoOTA;
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/*-- time ------------------------------------------------------------------------------*/
+// current time in us, the simulated time or the monotonic clock plus the offset
+static uint64_t hostNow_u64(void)
+{
+    struct timespec ts;
+
+    if(false == realTime_bolst)
+    {
+        return(hostMicros_u64st);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return(((uint64_t)ts.tv_sec * 1000000u) + ((uint64_t)ts.tv_nsec / 1000u) 
+            + hostMicros_u64st);
+}
+
+unsigned long millis(void)
+{
+    return((unsigned long)(uint32_t)(hostNow_u64() / 1000u));
+}
+
+unsigned long micros(void)
+{
+    return((unsigned long)(uint32_t)hostNow_u64());
+}
+
+void delay(unsigned long ms)
+{
+    if(true == realTime_bolst)
+    {
+        usleep((useconds_t)ms * 1000u);
+    }
+    else
+    {
+        hostMicros_u64st += (uint64_t)ms * 1000u;
+    }
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    if(true == realTime_bolst)
+    {
+        usleep(us);
+    }
+    else
+    {
+        hostMicros_u64st += us;
+    }
+}
+
+void yield(void)
+{
+}
+
+void host_UseRealTime(bool realTime_bol)
+{
+    uint64_t now_u64 = hostNow_u64();
+
+    // the clock continues from the current time
+    realTime_bolst = realTime_bol;
+    hostMicros_u64st = 0;
+    hostMicros_u64st = now_u64 - hostNow_u64();
+}
+
+void host_SetMillis(unsigned long ms)
+{
+    hostMicros_u64st += ((uint64_t)(uint32_t)ms * 1000u) - hostNow_u64();
+}
+
+void host_AdvanceMillis(unsigned long ms)
+{
+    hostMicros_u64st += (uint64_t)ms * 1000u;
+}
+
+void host_AdvanceMicros(unsigned long us)
+{
+    hostMicros_u64st += (uint64_t)us;
+}
+
+/*-- gpio ------------------------------------------------------------------------------*/
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if((pin < HOST_PIN_COUNT) && (INPUT_PULLUP == mode))
+    {
+        digitalState_sta[pin] = HIGH;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    if(pin < HOST_PIN_COUNT)
+    {
+        digitalState_sta[pin] = val;
+    }
+    host_NotifyOutput(pin, val);
+}
+
+int digitalRead(uint8_t pin)
+{
+    return((pin < HOST_PIN_COUNT) ? digitalState_sta[pin] : LOW);
+}
+
+int analogRead(uint8_t pin)
+{
+    if(NULL != analogHook_st)
+    {
+        return(analogHook_st(pin));
+    }
+    return((pin < HOST_PIN_COUNT) ? analogState_sta[pin] : 0);
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+    if(pin < HOST_PIN_COUNT)
+    {
+        analogState_sta[pin] = val;
+    }
+    host_NotifyOutput(pin, val);
+}
+
+void analogWriteRange(uint32_t range)
+{
+    (void)range;
+}
+
+void attachInterrupt(uint8_t pin, hostIsr_t isr, int mode)
+{
+    (void)mode;
+    if(pin < HOST_PIN_COUNT)
+    {
+        isr_sta[pin] = isr;
+    }
+}
+
+void detachInterrupt(uint8_t pin)
+{
+    if(pin < HOST_PIN_COUNT)
+    {
+        isr_sta[pin] = NULL;
+    }
+}
+
+void host_SetDigitalInput(uint8_t pin, int val)
+{
+    if(pin < HOST_PIN_COUNT)
+    {
+        digitalState_sta[pin] = val;
+    }
+}
+
+int host_GetDigitalOutput(uint8_t pin)
+{
+    return(digitalRead(pin));
+}
+
+void host_SetAnalogInput(uint8_t pin, int val)
+{
+    if(pin < HOST_PIN_COUNT)
+    {
+        analogState_sta[pin] = val;
+    }
+}
+
+// the hook replaces the static input, e.g. for a noisy signal per conversion
+void host_SetAnalogHook(hostAnalogHook_t hook)
+{
+    analogHook_st = hook;
+}
+
+int host_GetAnalogOutput(uint8_t pin)
+{
+    return((pin < HOST_PIN_COUNT) ? analogState_sta[pin] : 0);
+}
+
+void host_TriggerInterrupt(uint8_t pin)
+{
+    if((pin < HOST_PIN_COUNT) && (NULL != isr_sta[pin]))
+    {
+        isr_sta[pin]();
+    }
+}
+
+uint32_t host_GetDeepSleepCount(void)
+{
+    return(deepSleepCount_u32st);
+}
+
+void host_FillRtcMemory(uint8_t val)
+{
+    memset(rtcMemory_u8ast, val, sizeof(rtcMemory_u8ast));
+}
+
+void host_SetOutputHook(hostOutputHook_t hook)
+{
+    outputHook_st = hook;
+}
+
+void host_NotifyOutput(uint8_t pin, int val)
+{
+    if(NULL != outputHook_st)
+    {
+        outputHook_st(pin, val);
+    }
+}
+
+/*-- i2c -------------------------------------------------------------------------------*/
+void TwoWire::beginTransmission(uint8_t address)
+{
+    i2cTxAddress_u8st = address;
+    i2cTxBytes_u16st = 0;
+}
+
+uint8_t TwoWire::endTransmission(void)
+{
+    i2cTransactions_u32st++;
+    return(0);
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity)
+{
+    uint16_t idx_u16;
+
+    i2cTransactions_u32st++;
+    for(idx_u16 = 0; idx_u16 < quantity; idx_u16++)
+    {
+        i2cRx_u8ast[idx_u16] = (address == i2cDevice_u8st) 
+                                    ? i2cRegisters_u8ast[i2cPointer_u8st++] : 0u;
+    }
+    i2cRxLength_u16st = quantity;
+    i2cRxPos_u16st = 0;
+    return(quantity);
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+    if(i2cTxAddress_u8st == i2cDevice_u8st)
+    {
+        // the first byte sets the register pointer, the following bytes are written
+        if(0u == i2cTxBytes_u16st)
+        {
+            i2cPointer_u8st = data;
+        }
+        else
+        {
+            i2cRegisters_u8ast[i2cPointer_u8st++] = data;
+        }
+    }
+    i2cTxBytes_u16st++;
+    return(1);
+}
+
+int TwoWire::available(void)
+{
+    return(i2cRxLength_u16st - i2cRxPos_u16st);
+}
+
+int TwoWire::read(void)
+{
+    return((i2cRxPos_u16st < i2cRxLength_u16st) ? i2cRx_u8ast[i2cRxPos_u16st++] : 0);
+}
+
+void host_SetI2cDevice(uint8_t address)
+{
+    i2cDevice_u8st = address;
+    memset(i2cRegisters_u8ast, 0, sizeof(i2cRegisters_u8ast));
+    i2cPointer_u8st = 0;
+}
+
+void host_SetI2cRegisters(uint8_t reg, const uint8_t *data, uint16_t length)
+{
+    uint16_t idx_u16;
+
+    for(idx_u16 = 0; idx_u16 < length; idx_u16++)
+    {
+        i2cRegisters_u8ast[(uint8_t)(reg + idx_u16)] = data[idx_u16];
+    }
+}
+
+uint8_t host_GetI2cRegister(uint8_t reg)
+{
+    return(i2cRegisters_u8ast[reg]);
+}
+
+uint32_t host_GetI2cTransactions(void)
+{
+    return(i2cTransactions_u32st);
+}
+
+/*-- random ----------------------------------------------------------------------------*/
+long random(long max)
+{
+    return((max > 0) ? (rand() % max) : 0);
+}
+
+long random(long min, long max)
+{
+    return((max > min) ? (min + random(max - min)) : min);
+}
+
+void randomSeed(unsigned long seed)
+{
+    srand((unsigned int)seed);
+}
+
+/*-- conversion ------------------------------------------------------------------------*/
+char* dtostrf(double value, signed char width, unsigned char prec, char *buffer_pch)
+{
+    sprintf(buffer_pch, "%*.*f", (int)width, (int)prec, value);
+    return(buffer_pch);
+}
+
+char* itoa(int value, char *buffer_pch, int base)
+{
+    if(16 == base)
+    {
+        sprintf(buffer_pch, "%x", (unsigned int)value);
+    }
+    else
+    {
+        sprintf(buffer_pch, "%d", value);
+    }
+    return(buffer_pch);
+}
+
+/*-- serial ----------------------------------------------------------------------------*/
+void HardwareSerial::begin(unsigned long baud)
+{
+    (void)baud;
+}
+
+void HardwareSerial::setEnabled(bool enabled_bol)
+{
+    this->enabled_bol = enabled_bol;
+}
+
+size_t HardwareSerial::print(const String &str)
+{
+    return(this->print(str.c_str()));
+}
+
+size_t HardwareSerial::print(const char *str)
+{
+    if(true == this->enabled_bol)
+    {
+        fputs(str, stdout);
+    }
+    return(strlen(str));
+}
+
+size_t HardwareSerial::print(int value)
+{
+    return(this->print(String(value)));
+}
+
+size_t HardwareSerial::println(const String &str)
+{
+    return(this->print(str) + this->println());
+}
+
+size_t HardwareSerial::println(const char *str)
+{
+    return(this->print(str) + this->println());
+}
+
+size_t HardwareSerial::println(int value)
+{
+    return(this->print(value) + this->println());
+}
+
+size_t HardwareSerial::println(void)
+{
+    return(this->print("\n"));
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    if(true == this->enabled_bol)
+    {
+        fputc(c, stdout);
+    }
+    return(1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t size)
+{
+    if(true == this->enabled_bol)
+    {
+        fwrite(buf, 1, size, stdout);
+    }
+    return(size);
+}
+
+int HardwareSerial::printf(const char *format, ...)
+{
+    int ret_s32 = 0;
+    va_list args;
+
+    if(true == this->enabled_bol)
+    {
+        va_start(args, format);
+        ret_s32 = vprintf(format, args);
+        va_end(args);
+    }
+    return(ret_s32);
+}
+
+/*-- esp -------------------------------------------------------------------------------*/
+void EspClass::wdtEnable(uint32_t timeout_ms) { (void)timeout_ms; }
+void EspClass::wdtDisable(void) {}
+void EspClass::wdtFeed(void) {}
+void EspClass::deepSleep(uint64_t time_us) { (void)time_us; deepSleepCount_u32st++; }
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size)
+{
+    // the memory survives the simulated deep sleep like the RTC of the ESP8266
+    if(((size_t)offset * 4u + size) > HOST_RTC_USER_MEMORY)
+    {
+        return(false);
+    }
+    memcpy(data, &rtcMemory_u8ast[offset * 4u], size);
+    return(true);
+}
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size)
+{
+    if(((size_t)offset * 4u + size) > HOST_RTC_USER_MEMORY)
+    {
+        return(false);
+    }
+    memcpy(&rtcMemory_u8ast[offset * 4u], data, size);
+    return(true);
+}
+void EspClass::reset(void) {}
+void EspClass::restart(void) {}
+uint32_t EspClass::getFreeHeap(void) { return(HOST_FREE_HEAP); }
+uint16_t EspClass::getMaxFreeBlockSize(void) { return((uint16_t)HOST_FREE_HEAP); }
+uint8_t EspClass::getHeapFragmentation(void) { return(0); }
+uint32_t EspClass::getChipId(void) { return(0x00E5B001u); }
+uint32_t EspClass::getCycleCount(void) { return((uint32_t)(hostMicros_u64st * 80u)); }
+
+/*-- string ----------------------------------------------------------------------------*/
+void String::init(void)
+{
+    this->buffer_pch = NULL;
+    this->capacity_u32 = 0;
+    this->length_u32 = 0;
+}
+
+bool String::ensure(unsigned int size)
+{
+    char *new_pch;
+
+    if(size <= this->capacity_u32)
+    {
+        return(true);
+    }
+    new_pch = new char[size + 1];
+    if(NULL != this->buffer_pch)
+    {
+        memcpy(new_pch, this->buffer_pch, this->length_u32 + 1);
+        delete[] this->buffer_pch;
+    }
+    else
+    {
+        new_pch[0] = '\0';
+    }
+    this->buffer_pch = new_pch;
+    this->capacity_u32 = size;
+    return(true);
+}
+
+void String::copy(const char *cstr, unsigned int length)
+{
+    if(0 == length)
+    {
+        this->length_u32 = 0;
+        if(NULL != this->buffer_pch)
+        {
+            this->buffer_pch[0] = '\0';
+        }
+        return;
+    }
+    this->ensure(length);
+    memmove(this->buffer_pch, cstr, length);
+    this->buffer_pch[length] = '\0';
+    this->length_u32 = length;
+}
+
+void String::append(const char *cstr, unsigned int length)
+{
+    if(0 == length)
+    {
+        return;
+    }
+    this->ensure(this->length_u32 + length);
+    memmove(&this->buffer_pch[this->length_u32], cstr, length);
+    this->length_u32 += length;
+    this->buffer_pch[this->length_u32] = '\0';
+}
+
+String::String(const char *cstr)
+{
+    this->init();
+    if(NULL != cstr)
+    {
+        this->copy(cstr, (unsigned int)strlen(cstr));
+    }
+}
+
+String::String(const String &str)
+{
+    this->init();
+    this->copy(str.c_str(), str.length());
+}
+
+String::String(char c)
+{
+    this->init();
+    this->copy(&c, 1);
+}
+
+String::String(unsigned char value, unsigned char base)
+{
+    this->init();
+    *this = String((unsigned long)value, base);
+}
+
+String::String(int value, unsigned char base)
+{
+    this->init();
+    *this = String((long)value, base);
+}
+
+String::String(unsigned int value, unsigned char base)
+{
+    this->init();
+    *this = String((unsigned long)value, base);
+}
+
+String::String(long value, unsigned char base)
+{
+    char buf_ca[34];
+
+    this->init();
+    if(10 == base)
+    {
+        snprintf(buf_ca, sizeof(buf_ca), "%ld", value);
+    }
+    else
+    {
+        snprintf(buf_ca, sizeof(buf_ca), "%lx", (unsigned long)value);
+    }
+    this->copy(buf_ca, (unsigned int)strlen(buf_ca));
+}
+
+String::String(unsigned long value, unsigned char base)
+{
+    char buf_ca[34];
+
+    this->init();
+    snprintf(buf_ca, sizeof(buf_ca), (16 == base) ? "%lx" : "%lu", value);
+    this->copy(buf_ca, (unsigned int)strlen(buf_ca));
+}
+
+String::String(float value, unsigned char decimalPlaces)
+{
+    char buf_ca[34];
+
+    this->init();
+    snprintf(buf_ca, sizeof(buf_ca), "%.*f", decimalPlaces, (double)value);
+    this->copy(buf_ca, (unsigned int)strlen(buf_ca));
+}
+
+String::String(double value, unsigned char decimalPlaces)
+{
+    char buf_ca[34];
+
+    this->init();
+    snprintf(buf_ca, sizeof(buf_ca), "%.*f", decimalPlaces, value);
+    this->copy(buf_ca, (unsigned int)strlen(buf_ca));
+}
+
+String::~String()
+{
+    delete[] this->buffer_pch;
+}
+
+String& String::operator=(const String &rhs)
+{
+    if(this != &rhs)
+    {
+        this->copy(rhs.c_str(), rhs.length());
+    }
+    return(*this);
+}
+
+String& String::operator=(const char *cstr)
+{
+    this->copy(cstr, (NULL == cstr) ? 0 : (unsigned int)strlen(cstr));
+    return(*this);
+}
+
+String& String::operator+=(const String &rhs)
+{
+    this->concat(rhs);
+    return(*this);
+}
+
+String& String::operator+=(const char *cstr)
+{
+    this->concat(cstr);
+    return(*this);
+}
+
+String& String::operator+=(char c)
+{
+    this->concat(c);
+    return(*this);
+}
+
+String operator+(const String &lhs, const String &rhs)
+{
+    String ret(lhs);
+    ret.concat(rhs);
+    return(ret);
+}
+
+String operator+(const String &lhs, const char *rhs)
+{
+    String ret(lhs);
+    ret.concat(rhs);
+    return(ret);
+}
+
+bool String::operator==(const String &rhs) const { return(this->equals(rhs)); }
+bool String::operator==(const char *cstr) const { return(this->equals(cstr)); }
+bool String::operator!=(const String &rhs) const { return(!this->equals(rhs)); }
+
+char String::operator[](unsigned int index) const
+{
+    return((index < this->length_u32) ? this->buffer_pch[index] : '\0');
+}
+
+bool String::reserve(unsigned int size)
+{
+    return(this->ensure(size));
+}
+
+unsigned int String::length(void) const
+{
+    return(this->length_u32);
+}
+
+const char* String::c_str(void) const
+{
+    return((NULL == this->buffer_pch) ? "" : this->buffer_pch);
+}
+
+bool String::concat(const String &str)
+{
+    this->append(str.c_str(), str.length());
+    return(true);
+}
+
+bool String::concat(const char *cstr)
+{
+    if(NULL != cstr)
+    {
+        this->append(cstr, (unsigned int)strlen(cstr));
+    }
+    return(true);
+}
+
+bool String::concat(char c)
+{
+    this->append(&c, 1);
+    return(true);
+}
+
+bool String::concat(int value)
+{
+    return(this->concat(String(value)));
+}
+
+bool String::equals(const String &str) const
+{
+    return(0 == strcmp(this->c_str(), str.c_str()));
+}
+
+bool String::equals(const char *cstr) const
+{
+    return(0 == strcmp(this->c_str(), (NULL == cstr) ? "" : cstr));
+}
+
+bool String::startsWith(const String &prefix) const
+{
+    return((prefix.length() <= this->length_u32)
+            && (0 == strncmp(this->c_str(), prefix.c_str(), prefix.length())));
+}
+
+int String::indexOf(char c) const
+{
+    return(this->indexOf(c, 0));
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+    const char *found_pch;
+
+    if(from >= this->length_u32)
+    {
+        return(-1);
+    }
+    found_pch = strchr(&this->c_str()[from], c);
+    return((NULL == found_pch) ? -1 : (int)(found_pch - this->c_str()));
+}
+
+int String::indexOf(const String &str) const
+{
+    const char *found_pch = strstr(this->c_str(), str.c_str());
+    return((NULL == found_pch) ? -1 : (int)(found_pch - this->c_str()));
+}
+
+int String::lastIndexOf(char c) const
+{
+    const char *found_pch = strrchr(this->c_str(), c);
+    return((NULL == found_pch) ? -1 : (int)(found_pch - this->c_str()));
+}
+
+String String::substring(unsigned int from) const
+{
+    return(this->substring(from, this->length_u32));
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+    String ret;
+
+    if(from > to)
+    {
+        std::swap(from, to);
+    }
+    if(to > this->length_u32)
+    {
+        to = this->length_u32;
+    }
+    if(from < to)
+    {
+        ret.copy(&this->c_str()[from], to - from);
+    }
+    return(ret);
+}
+
+long String::toInt(void) const
+{
+    return(atol(this->c_str()));
+}
+
+float String::toFloat(void) const
+{
+    return((float)atof(this->c_str()));
+}
+
+void String::toCharArray(char *buf, unsigned int size, unsigned int index) const
+{
+    unsigned int len_u32;
+
+    if((NULL == buf) || (0 == size))
+    {
+        return;
+    }
+    len_u32 = (index < this->length_u32) ? (this->length_u32 - index) : 0;
+    if(len_u32 > (size - 1))
+    {
+        len_u32 = size - 1;
+    }
+    memcpy(buf, &this->c_str()[index < this->length_u32 ? index : 0], len_u32);
+    buf[len_u32] = '\0';
+}
+
+void String::trim(void)
+{
+    unsigned int start_u32 = 0;
+    unsigned int end_u32 = this->length_u32;
+
+    while((start_u32 < end_u32) && (' ' == this->buffer_pch[start_u32]))
+    {
+        start_u32++;
+    }
+    while((end_u32 > start_u32) && (' ' == this->buffer_pch[end_u32 - 1]))
+    {
+        end_u32--;
+    }
+    if((0 != start_u32) || (end_u32 != this->length_u32))
+    {
+        this->copy(&this->buffer_pch[start_u32], end_u32 - start_u32);
+    }
+}
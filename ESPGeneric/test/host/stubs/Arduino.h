@@ -0,0 +1,246 @@
+/*****************************************************************************************
+* FILENAME :        Arduino.h
+*
+* DESCRIPTION :
+*       Host stub of the Arduino core used by the native build
+*
+* NOTES :
+*       Only the parts of the ESP8266 Arduino core used by the firmware are
+*       provided. Time and GPIO are simulated and can be controlled by the tests
+*       through the host_ functions.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef ARDUINO_H_
+#define ARDUINO_H_
+#define Arduino_h
+
+/****************************************************************************************/
+/* Imported header files: */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+
+/****************************************************************************************/
+/* Global constant defines: */
+#define ARDUINO                 10800
+#define ESP8266                 1
+
+#define HIGH                    0x1
+#define LOW                     0x0
+#define LSBFIRST                0
+#define MSBFIRST                1
+#define INPUT                   0x00
+#define OUTPUT                  0x01
+#define INPUT_PULLUP            0x02
+#define RISING                  0x01
+#define FALLING                 0x02
+#define CHANGE                  0x03
+
+#define A0                      17
+#define HOST_PIN_COUNT          32
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define ICACHE_FLASH_ATTR
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+#define F(str)                  (str)
+#define PSTR(str)               (str)
+#define FPSTR(str)              (str)
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *)(addr))
+#define strcpy_P                strcpy
+#define snprintf_P              snprintf
+#define strlen_P                strlen
+#define memcpy_P                memcpy
+#define digitalPinToInterrupt(pin) (pin)
+#define bitRead(value, bit)     (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)      ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)    ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define clockCyclesPerMicrosecond() (80L)
+#define microsecondsToClockCycles(a) ((a) * clockCyclesPerMicrosecond())
+#define constrain(x, lo, hi)    ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+#define interrupts()
+#define noInterrupts()
+
+using std::min;
+using std::max;
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef uint8_t byte;
+typedef bool boolean;
+typedef void (*hostIsr_t)(void);
+typedef void (*hostOutputHook_t)(uint8_t pin, int val);
+typedef int (*hostAnalogHook_t)(uint8_t pin);
+
+/****************************************************************************************/
+/* Class definition: */
+class __FlashStringHelper;
+
+class String
+{
+    public:
+        String(const char *cstr = "");
+        String(const String &str);
+        String(char c);
+        String(unsigned char value, unsigned char base = 10);
+        String(int value, unsigned char base = 10);
+        String(unsigned int value, unsigned char base = 10);
+        String(long value, unsigned char base = 10);
+        String(unsigned long value, unsigned char base = 10);
+        String(float value, unsigned char decimalPlaces = 2);
+        String(double value, unsigned char decimalPlaces = 2);
+        ~String();
+
+        String& operator=(const String &rhs);
+        String& operator=(const char *cstr);
+        String& operator+=(const String &rhs);
+        String& operator+=(const char *cstr);
+        String& operator+=(char c);
+        friend String operator+(const String &lhs, const String &rhs);
+        friend String operator+(const String &lhs, const char *rhs);
+        bool operator==(const String &rhs) const;
+        bool operator==(const char *cstr) const;
+        bool operator!=(const String &rhs) const;
+        char operator[](unsigned int index) const;
+
+        bool reserve(unsigned int size);
+        unsigned int length(void) const;
+        const char* c_str(void) const;
+        bool concat(const String &str);
+        bool concat(const char *cstr);
+        bool concat(char c);
+        bool concat(int value);
+        bool equals(const String &str) const;
+        bool equals(const char *cstr) const;
+        bool startsWith(const String &prefix) const;
+        int indexOf(char c) const;
+        int indexOf(char c, unsigned int from) const;
+        int indexOf(const String &str) const;
+        int lastIndexOf(char c) const;
+        String substring(unsigned int from) const;
+        String substring(unsigned int from, unsigned int to) const;
+        long toInt(void) const;
+        float toFloat(void) const;
+        void toCharArray(char *buf, unsigned int size, unsigned int index = 0) const;
+        void trim(void);
+
+    private:
+        char            *buffer_pch;
+        unsigned int    capacity_u32;
+        unsigned int    length_u32;
+
+        void init(void);
+        bool ensure(unsigned int size);
+        void copy(const char *cstr, unsigned int length);
+        void append(const char *cstr, unsigned int length);
+};
+
+class HardwareSerial
+{
+    public:
+        void begin(unsigned long baud);
+        size_t print(const String &str);
+        size_t print(const char *str);
+        size_t print(int value);
+        size_t println(const String &str);
+        size_t println(const char *str);
+        size_t println(int value);
+        size_t println(void);
+        size_t write(uint8_t c);
+        size_t write(const uint8_t *buf, size_t size);
+        int printf(const char *format, ...);
+        void setEnabled(bool enabled_bol);
+
+    private:
+        bool enabled_bol = false;
+};
+
+class EspClass
+{
+    public:
+        void wdtEnable(uint32_t timeout_ms);
+        void wdtDisable(void);
+        void wdtFeed(void);
+        void deepSleep(uint64_t time_us);
+        bool rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size);
+        bool rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size);
+        void reset(void);
+        void restart(void);
+        uint32_t getFreeHeap(void);
+        uint16_t getMaxFreeBlockSize(void);
+        uint8_t getHeapFragmentation(void);
+        uint32_t getChipId(void);
+        uint32_t getCycleCount(void);
+};
+
+extern HardwareSerial Serial;
+extern EspClass ESP;
+
+/****************************************************************************************/
+/* Global function prototypes: */
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+void analogWriteRange(uint32_t range);
+void attachInterrupt(uint8_t pin, hostIsr_t isr, int mode);
+void detachInterrupt(uint8_t pin);
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+char* dtostrf(double value, signed char width, unsigned char prec, char *buffer_pch);
+char* itoa(int value, char *buffer_pch, int base);
+
+// host control of the simulated environment
+void host_UseRealTime(bool realTime_bol);
+void host_SetMillis(unsigned long ms);
+void host_AdvanceMillis(unsigned long ms);
+void host_AdvanceMicros(unsigned long us);
+void host_SetDigitalInput(uint8_t pin, int val);
+int host_GetDigitalOutput(uint8_t pin);
+void host_SetAnalogInput(uint8_t pin, int val);
+void host_SetAnalogHook(hostAnalogHook_t hook);
+int host_GetAnalogOutput(uint8_t pin);
+void host_TriggerInterrupt(uint8_t pin);
+uint32_t host_GetDeepSleepCount(void);
+void host_FillRtcMemory(uint8_t val);
+void host_SetOutputHook(hostOutputHook_t hook);
+void host_NotifyOutput(uint8_t pin, int val);
+
+#endif /* ARDUINO_H_ */
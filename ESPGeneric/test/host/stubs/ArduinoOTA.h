@@ -0,0 +1,66 @@
+/*****************************************************************************************
+* FILENAME :        ArduinoOTA.h
+*
+* DESCRIPTION :
+*       Host stub of the ESP8266 ArduinoOTA library
+*
+* NOTES :
+*       Only the interface used by the firmware is provided, all functions do nothing.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef ARDUINOOTA_H_
+#define ARDUINOOTA_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include "Arduino.h"
+#include <functional>
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef enum
+{
+    OTA_AUTH_ERROR,
+    OTA_BEGIN_ERROR,
+    OTA_CONNECT_ERROR,
+    OTA_RECEIVE_ERROR,
+    OTA_END_ERROR
+} ota_error_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class ArduinoOTAClass
+{
+    public:
+        void setHostname(const char *hostname) { (void)hostname; }
+        void setPassword(const char *password) { (void)password; }
+        void onStart(std::function<void(void)> fn) { (void)fn; }
+        void onEnd(std::function<void(void)> fn) { (void)fn; }
+        void onProgress(std::function<void(unsigned int, unsigned int)> fn) { (void)fn; }
+        void onError(std::function<void(ota_error_t)> fn) { (void)fn; }
+        void begin(void) {}
+        void handle(void) {}
+};
+
+extern ArduinoOTAClass ArduinoOTA;
+
+#endif /* ARDUINOOTA_H_ */
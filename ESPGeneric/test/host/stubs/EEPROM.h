@@ -0,0 +1,57 @@
+/*****************************************************************************************
+* FILENAME :        EEPROM.h
+*
+* DESCRIPTION :
+*       Host stub of the ESP8266 EEPROM emulation
+*
+* NOTES :
+*       Only the interface used by the firmware is provided, all functions do nothing.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include "Arduino.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+#define HOST_EEPROM_SIZE        4096
+
+/****************************************************************************************/
+/* Class definition: */
+class EEPROMClass
+{
+    public:
+        void begin(size_t size) { (void)size; }
+        uint8_t read(int address) { return(data_au8[address % HOST_EEPROM_SIZE]); }
+        void write(int address, uint8_t value) { data_au8[address % HOST_EEPROM_SIZE] = value; }
+        bool commit(void) { return(true); }
+
+    private:
+        uint8_t data_au8[HOST_EEPROM_SIZE] = {0};
+};
+
+extern EEPROMClass EEPROM;
+
+#endif /* EEPROM_H_ */
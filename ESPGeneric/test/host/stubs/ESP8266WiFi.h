@@ -0,0 +1,103 @@
+/*****************************************************************************************
+* FILENAME :        ESP8266WiFi.h
+*
+* DESCRIPTION :
+*       Host stub of the ESP8266 WiFi library
+*
+* NOTES :
+*       Part of the native host build, see test/host/README.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef ESP8266WIFI_H_
+#define ESP8266WIFI_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "Client.h"
+#include "Stream.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+#define WL_IDLE_STATUS          0
+#define WL_NO_SSID_AVAIL        1
+#define WL_CONNECTED            3
+#define WL_CONNECT_FAILED       4
+#define WL_DISCONNECTED         6
+
+/****************************************************************************************/
+/* Global type definitions (enum, struct, union): */
+typedef enum
+{
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+}WiFiMode_t;
+
+/****************************************************************************************/
+/* Class definition: */
+class WiFiClient : public Client
+{
+    public:
+        WiFiClient();
+        virtual ~WiFiClient();
+        int connect(IPAddress ip, uint16_t port);
+        int connect(const char *host, uint16_t port);
+        size_t write(uint8_t c);
+        size_t write(const uint8_t *buf, size_t size);
+        int available();
+        int read();
+        int read(uint8_t *buf, size_t size);
+        int peek();
+        void flush();
+        void stop();
+        uint8_t connected();
+        operator bool();
+        void setTimeout(unsigned long timeout);
+
+    private:
+        int socket_s32;
+        int peek_s32;
+        unsigned long timeout_u32;
+};
+
+class ESP8266WiFiClass
+{
+    public:
+        bool mode(WiFiMode_t mode_en) { this->mode_en = mode_en; return(true); }
+        WiFiMode_t getMode(void) { return(this->mode_en); }
+        int status(void) { return(WL_CONNECTED); }
+        bool isConnected(void) { return(true); }
+        IPAddress localIP(void) { return(IPAddress(127, 0, 0, 1)); }
+        String SSID(void) { return(String("host")); }
+        int32_t RSSI(void) { return(-50); }
+        String macAddress(void) { return(String("00:00:00:00:00:00")); }
+
+    private:
+        WiFiMode_t mode_en = WIFI_STA;
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif /* ESP8266WIFI_H_ */
@@ -0,0 +1,75 @@
+/*****************************************************************************************
+* FILENAME :        IPAddress.h
+*
+* DESCRIPTION :
+*       Host stub of the Arduino IPAddress class
+*
+* NOTES :
+*       Part of the native host build, see test/host/README.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef IPADDRESS_H_
+#define IPADDRESS_H_
+#define IPAddress_h
+
+/****************************************************************************************/
+/* Imported header files: */
+#include "Arduino.h"
+
+/****************************************************************************************/
+/* Class definition: */
+class IPAddress
+{
+    public:
+        IPAddress() { this->address_u32 = 0; }
+        IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        {
+            this->address_u32 = (uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16)
+                                | ((uint32_t)d << 24);
+        }
+        IPAddress(uint32_t address_u32) { this->address_u32 = address_u32; }
+        IPAddress(const uint8_t *address_pu8) { memcpy(&this->address_u32, address_pu8, 4); }
+        operator uint32_t() const { return(this->address_u32); }
+        uint8_t operator[](int index) const { return((uint8_t)(this->address_u32 >> (8 * index))); }
+        bool fromString(const char *address_pc)
+        {
+            unsigned int a, b, c, d;
+            if(4 != sscanf(address_pc, "%u.%u.%u.%u", &a, &b, &c, &d))
+            {
+                return(false);
+            }
+            *this = IPAddress((uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d);
+            return(true);
+        }
+        String toString() const
+        {
+            char buf_ca[16];
+            snprintf(buf_ca, sizeof(buf_ca), "%u.%u.%u.%u", (*this)[0], (*this)[1], 
+                        (*this)[2], (*this)[3]);
+            return(String(buf_ca));
+        }
+
+    private:
+        uint32_t address_u32;
+};
+
+#endif /* IPADDRESS_H_ */
@@ -0,0 +1,63 @@
+/*****************************************************************************************
+* FILENAME :        SPI.h
+*
+* DESCRIPTION :
+*       Host stub of the Arduino SPI interface
+*
+* NOTES :
+*       Part of the native host build, see test/host/README.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef SPI_H_
+#define SPI_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include "Arduino.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+#define SPI_MODE0               0x00
+
+/****************************************************************************************/
+/* Class definition: */
+class SPISettings
+{
+    public:
+        SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) 
+        { 
+            (void)clock; (void)bitOrder; (void)dataMode; 
+        }
+};
+
+class SPIClass
+{
+    public:
+        void begin(void) {}
+        void beginTransaction(SPISettings settings) { (void)settings; }
+        void endTransaction(void) {}
+        uint8_t transfer(uint8_t data) { (void)data; return(0); }
+};
+
+extern SPIClass SPI;
+
+#endif /* SPI_H_ */
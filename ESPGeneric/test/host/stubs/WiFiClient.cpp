@@ -0,0 +1,229 @@
+/*****************************************************************************************
+* FILENAME :        WiFiClient.cpp
+*
+* DESCRIPTION :
+*       Host implementation of the WiFi client based on POSIX sockets
+*
+* NOTES :
+*       Part of the native host build, see test/host/README.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "ESP8266WiFi.h"
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+/****************************************************************************************/
+/* Local constant defines */
+#define NO_SOCKET               (-1)
+#define NO_PEEK                 (-1)
+
+/****************************************************************************************/
+/* Local data definitions */
+ESP8266WiFiClass WiFi;
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+WiFiClient::WiFiClient()
+{
+    this->socket_s32 = NO_SOCKET;
+    this->peek_s32 = NO_PEEK;
+    this->timeout_u32 = 0;
+}
+
+WiFiClient::~WiFiClient()
+{
+    this->stop();
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port)
+{
+    return(this->connect(ip.toString().c_str(), port));
+}
+
+int WiFiClient::connect(const char *host, uint16_t port)
+{
+    struct addrinfo hints;
+    struct addrinfo *result_p = NULL;
+    char port_ca[8];
+    int flag_s32 = 1;
+
+    this->stop();
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    snprintf(port_ca, sizeof(port_ca), "%u", port);
+    if((0 != getaddrinfo(host, port_ca, &hints, &result_p)) || (NULL == result_p))
+    {
+        return(0);
+    }
+    this->socket_s32 = socket(result_p->ai_family, result_p->ai_socktype, 
+                                result_p->ai_protocol);
+    if((NO_SOCKET != this->socket_s32) && (0 != this->timeout_u32))
+    {
+        // the blocking connect ends after the send timeout like on the target
+        struct timeval timeout_st;
+
+        timeout_st.tv_sec = (time_t)(this->timeout_u32 / 1000u);
+        timeout_st.tv_usec = (suseconds_t)((this->timeout_u32 % 1000u) * 1000u);
+        setsockopt(this->socket_s32, SOL_SOCKET, SO_SNDTIMEO, &timeout_st, 
+                    sizeof(timeout_st));
+    }
+    if((NO_SOCKET == this->socket_s32)
+        || (0 != ::connect(this->socket_s32, result_p->ai_addr, result_p->ai_addrlen)))
+    {
+        freeaddrinfo(result_p);
+        this->stop();
+        return(0);
+    }
+    freeaddrinfo(result_p);
+    setsockopt(this->socket_s32, IPPROTO_TCP, TCP_NODELAY, &flag_s32, sizeof(flag_s32));
+    fcntl(this->socket_s32, F_SETFL, fcntl(this->socket_s32, F_GETFL) | O_NONBLOCK);
+    return(1);
+}
+
+size_t WiFiClient::write(uint8_t c)
+{
+    return(this->write(&c, 1));
+}
+
+size_t WiFiClient::write(const uint8_t *buf, size_t size)
+{
+    size_t sent_u32 = 0;
+    ssize_t ret_s32;
+
+    while((NO_SOCKET != this->socket_s32) && (sent_u32 < size))
+    {
+        ret_s32 = send(this->socket_s32, &buf[sent_u32], size - sent_u32, MSG_NOSIGNAL);
+        if(ret_s32 > 0)
+        {
+            sent_u32 += (size_t)ret_s32;
+        }
+        else if((ret_s32 < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)))
+        {
+            usleep(100);
+        }
+        else
+        {
+            this->stop();
+        }
+    }
+    return(sent_u32);
+}
+
+int WiFiClient::available()
+{
+    uint8_t data_u8;
+    ssize_t ret_s32;
+
+    if(NO_PEEK != this->peek_s32)
+    {
+        return(1);
+    }
+    if(NO_SOCKET == this->socket_s32)
+    {
+        return(0);
+    }
+    ret_s32 = recv(this->socket_s32, &data_u8, 1, 0);
+    if(1 == ret_s32)
+    {
+        this->peek_s32 = data_u8;
+        return(1);
+    }
+    else if((0 == ret_s32) || ((EAGAIN != errno) && (EWOULDBLOCK != errno)))
+    {
+        // connection closed by the peer
+        this->stop();
+    }
+    return(0);
+}
+
+int WiFiClient::read()
+{
+    int data_s32 = NO_PEEK;
+
+    if(0 != this->available())
+    {
+        data_s32 = this->peek_s32;
+        this->peek_s32 = NO_PEEK;
+    }
+    return(data_s32);
+}
+
+int WiFiClient::read(uint8_t *buf, size_t size)
+{
+    size_t idx_u32 = 0;
+
+    while((idx_u32 < size) && (0 != this->available()))
+    {
+        buf[idx_u32++] = (uint8_t)this->read();
+    }
+    return((int)idx_u32);
+}
+
+int WiFiClient::peek()
+{
+    return((0 != this->available()) ? this->peek_s32 : NO_PEEK);
+}
+
+void WiFiClient::flush()
+{
+}
+
+void WiFiClient::stop()
+{
+    if(NO_SOCKET != this->socket_s32)
+    {
+        close(this->socket_s32);
+    }
+    this->socket_s32 = NO_SOCKET;
+    this->peek_s32 = NO_PEEK;
+}
+
+uint8_t WiFiClient::connected()
+{
+    if(NO_SOCKET != this->socket_s32)
+    {
+        (void)this->available();
+    }
+    return((NO_SOCKET != this->socket_s32) || (NO_PEEK != this->peek_s32));
+}
+
+WiFiClient::operator bool()
+{
+    return(0 != this->connected());
+}
+
+void WiFiClient::setTimeout(unsigned long timeout)
+{
+    this->timeout_u32 = timeout;
+}
@@ -0,0 +1,185 @@
+/*****************************************************************************************
+* FILENAME :        WiFiManager.cpp
+*
+* DESCRIPTION :
+*       Host implementation of the local WiFiManager
+*
+* NOTES :
+*       Replaces src/WiFiManager.cpp in the native host build. The station is
+*       always connected, the configuration portal is not available on the host
+*       and returns without a new configuration. Part of the native host build,
+*       see test/host/README.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include "WiFiManager.h"
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/*-- parameter -------------------------------------------------------------------------*/
+WiFiManagerParameter::WiFiManagerParameter(const char *custom)
+{
+    this->_id = NULL;
+    this->_placeholder = NULL;
+    this->_length = 0;
+    this->_value = NULL;
+    this->_customHTML = custom;
+}
+
+WiFiManagerParameter::WiFiManagerParameter(const char *id, const char *placeholder, 
+                                            const char *defaultValue, int length)
+{
+    this->init(id, placeholder, defaultValue, length, "");
+}
+
+WiFiManagerParameter::WiFiManagerParameter(const char *id, const char *placeholder, 
+                                            const char *defaultValue, int length, 
+                                            const char *custom)
+{
+    this->init(id, placeholder, defaultValue, length, custom);
+}
+
+WiFiManagerParameter::~WiFiManagerParameter()
+{
+    delete[] this->_value;
+}
+
+void WiFiManagerParameter::setDefaultValue(const char *defaultValue, int length)
+{
+    delete[] this->_value;
+    this->_value = new char[length + 1];
+    memset(this->_value, 0, length + 1);
+    if(NULL != defaultValue)
+    {
+        strncpy(this->_value, defaultValue, length);
+    }
+}
+
+const char* WiFiManagerParameter::getID() { return(this->_id); }
+const char* WiFiManagerParameter::getValue() { return(this->_value); }
+const char* WiFiManagerParameter::getPlaceholder() { return(this->_placeholder); }
+int WiFiManagerParameter::getValueLength() { return(this->_length); }
+const char* WiFiManagerParameter::getCustomHTML() { return(this->_customHTML); }
+
+void WiFiManagerParameter::init(const char *id, const char *placeholder, 
+                                const char *defaultValue, int length, const char *custom)
+{
+    this->_id = id;
+    this->_placeholder = placeholder;
+    this->_length = length;
+    this->_value = NULL;
+    this->_customHTML = custom;
+    this->setDefaultValue(defaultValue, length);
+}
+
+/*-- manager ---------------------------------------------------------------------------*/
+WiFiManager::WiFiManager()
+{
+    this->_max_params = WIFI_MANAGER_MAX_PARAMS;
+    this->_params = new WiFiManagerParameter*[WIFI_MANAGER_MAX_PARAMS];
+}
+
+WiFiManager::~WiFiManager()
+{
+    delete[] this->_params;
+}
+
+boolean WiFiManager::autoConnect()
+{
+    return(this->autoConnect("host", NULL));
+}
+
+boolean WiFiManager::autoConnect(char const *apName, char const *apPassword)
+{
+    (void)apName;
+    (void)apPassword;
+    return(WL_CONNECTED == WiFi.status());
+}
+
+boolean WiFiManager::startConfigPortal()
+{
+    return(this->startConfigPortal("host", NULL));
+}
+
+boolean WiFiManager::startConfigPortal(char const *apName, char const *apPassword)
+{
+    this->_apName = apName;
+    this->_apPassword = apPassword;
+    if(NULL != this->_apcallback)
+    {
+        this->_apcallback(this);
+    }
+    printf("<<host>> config portal %s not available, keeping the configuration\n", apName);
+    return(false);
+}
+
+void WiFiManager::resetSettings() {}
+void WiFiManager::setConfigPortalTimeout(unsigned long seconds) 
+{ 
+    this->_configPortalTimeout = seconds * 1000u; 
+}
+void WiFiManager::setTimeout(unsigned long seconds) { this->setConfigPortalTimeout(seconds); }
+void WiFiManager::setConnectTimeout(unsigned long seconds) 
+{ 
+    this->_connectTimeout = seconds * 1000u; 
+}
+void WiFiManager::setDebugOutput(boolean debug) { this->_debug = debug; }
+void WiFiManager::setMinimumSignalQuality(int quality) { this->_minimumQuality = quality; }
+void WiFiManager::setAPStaticIPConfig(IPAddress ip, IPAddress gw, IPAddress sn)
+{
+    this->_ap_static_ip = ip;
+    this->_ap_static_gw = gw;
+    this->_ap_static_sn = sn;
+}
+void WiFiManager::setSTAStaticIPConfig(IPAddress ip, IPAddress gw, IPAddress sn)
+{
+    this->_sta_static_ip = ip;
+    this->_sta_static_gw = gw;
+    this->_sta_static_sn = sn;
+}
+void WiFiManager::setAPCallback(void (*func)(WiFiManager*)) { this->_apcallback = func; }
+void WiFiManager::setSaveConfigCallback(void (*func)(void)) { this->_savecallback = func; }
+void WiFiManager::setBreakAfterConfig(boolean shouldBreak) 
+{ 
+    this->_shouldBreakAfterConfig = shouldBreak; 
+}
+void WiFiManager::setCustomHeadElement(const char* element) 
+{ 
+    this->_customHeadElement = element; 
+}
+void WiFiManager::setRemoveDuplicateAPs(boolean removeDuplicates) 
+{ 
+    this->_removeDuplicateAPs = removeDuplicates; 
+}
+
+bool WiFiManager::addParameter(WiFiManagerParameter *p)
+{
+    if(this->_paramsCount >= this->_max_params)
+    {
+        return(false);
+    }
+    this->_params[this->_paramsCount++] = p;
+    return(true);
+}
@@ -0,0 +1,68 @@
+/*****************************************************************************************
+* FILENAME :        Wire.h
+*
+* DESCRIPTION :
+*       Host stub of the Arduino I2C interface
+*
+* NOTES :
+*       Part of the native host build, see test/host/README.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WIRE_H_
+#define WIRE_H_
+
+/****************************************************************************************/
+/* Imported header files: */
+#include "Arduino.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+#define HOST_I2C_NO_DEVICE      0xFFu
+
+/****************************************************************************************/
+/* Class definition: */
+class TwoWire
+{
+    public:
+        void begin(void) {}
+        void begin(int sda, int scl) { (void)sda; (void)scl; }
+        void beginTransmission(uint8_t address);
+        uint8_t endTransmission(void);
+        uint8_t requestFrom(uint8_t address, uint8_t quantity);
+        size_t write(uint8_t data);
+        int available(void);
+        int read(void);
+};
+
+extern TwoWire Wire;
+
+/****************************************************************************************/
+/* Global function prototypes: */
+
+// host control of the simulated I2C device, one address with 256 registers and an auto 
+// incremented register pointer, other addresses read as 0
+void host_SetI2cDevice(uint8_t address);
+void host_SetI2cRegisters(uint8_t reg, const uint8_t *data, uint16_t length);
+uint8_t host_GetI2cRegister(uint8_t reg);
+uint32_t host_GetI2cTransactions(void);
+
+#endif /* WIRE_H_ */
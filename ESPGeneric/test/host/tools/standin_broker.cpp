@@ -0,0 +1,608 @@
+/*****************************************************************************************
+* FILENAME :        standin_broker.cpp
+*
+* DESCRIPTION :
+*       Minimal MQTT 3.1.1 broker for the host build of the firmware
+*
+* NOTES :
+*       Stand-in for mosquitto in the native test runs, single threaded with
+*       poll(). Supported are CONNECT, PUBLISH with QoS 0 and 1, retained
+*       messages, SUBSCRIBE and UNSUBSCRIBE with the + and # wildcards, PINGREQ
+*       and DISCONNECT. Messages are forwarded with QoS 0, wills and sessions
+*       are not supported. Standard MQTT clients like mosquitto_pub can be used
+*       to send commands to the firmware.
+*
+*       standin_broker [--port n] [--seconds n] [--verbose]
+*
+*       With --verbose every received PUBLISH is printed as "topic payload".
+*       On exit the statistics are printed to stderr.
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <string>
+#include <vector>
+#include <map>
+
+/****************************************************************************************/
+/* Local constant defines */
+#define DEFAULT_PORT            1883
+#define RECEIVE_CHUNK           1024
+#define MAX_PACKET_SIZE         (256u * 1024u)
+
+#define MQTT_CONNECT            0x10
+#define MQTT_CONNACK            0x20
+#define MQTT_PUBLISH            0x30
+#define MQTT_PUBACK             0x40
+#define MQTT_SUBSCRIBE          0x80
+#define MQTT_SUBACK             0x90
+#define MQTT_UNSUBSCRIBE        0xA0
+#define MQTT_UNSUBACK           0xB0
+#define MQTT_PINGREQ            0xC0
+#define MQTT_PINGRESP           0xD0
+#define MQTT_DISCONNECT         0xE0
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+typedef struct client_tag
+{
+    int                         socket_s32;
+    bool                        connected_bol;
+    std::string                 id_str;
+    std::vector<uint8_t>        rx_vec;
+    std::vector<std::string>    filters_vec;
+}client_t;
+
+typedef struct stats_tag
+{
+    uint32_t    clients_u32;
+    uint32_t    connects_u32;
+    uint32_t    publishes_u32;
+    uint32_t    forwarded_u32;
+    uint32_t    subscriptions_u32;
+    uint32_t    pings_u32;
+    uint64_t    bytesIn_u64;
+}stats_t;
+
+/****************************************************************************************/
+/* Local data definitions */
+static volatile sig_atomic_t stop_s32st = 0;
+static std::vector<client_t> clients_vecst;
+static std::map<std::string, std::string> retained_mapst;
+static stats_t stats_st;
+static bool verbose_bolst = false;
+
+/****************************************************************************************/
+/* Local functions */
+static void stopHandler(int signal_s32)
+{
+    (void)signal_s32;
+    stop_s32st = 1;
+}
+
+static double wallSeconds(void)
+{
+    struct timespec now_st;
+
+    clock_gettime(CLOCK_MONOTONIC, &now_st);
+    return((double)now_st.tv_sec + ((double)now_st.tv_nsec / 1e9));
+}
+
+static void sendAll(client_t *client_pst, const uint8_t *data_cpu8, size_t size_u32)
+{
+    size_t sent_u32 = 0;
+    ssize_t ret_s32;
+
+    while((sent_u32 < size_u32) && (-1 != client_pst->socket_s32))
+    {
+        ret_s32 = send(client_pst->socket_s32, &data_cpu8[sent_u32], size_u32 - sent_u32,
+                        MSG_NOSIGNAL);
+        if(ret_s32 > 0)
+        {
+            sent_u32 += (size_t)ret_s32;
+        }
+        else if((ret_s32 < 0) && (EINTR == errno))
+        {
+            continue;
+        }
+        else
+        {
+            close(client_pst->socket_s32);
+            client_pst->socket_s32 = -1;
+        }
+    }
+}
+
+static void sendPacket(client_t *client_pst, uint8_t header_u8, 
+                        const std::vector<uint8_t> &body_vec)
+{
+    std::vector<uint8_t> packet_vec;
+    size_t length_u32 = body_vec.size();
+
+    packet_vec.push_back(header_u8);
+    do
+    {
+        uint8_t digit_u8 = (uint8_t)(length_u32 % 128u);
+
+        length_u32 /= 128u;
+        if(length_u32 > 0)
+        {
+            digit_u8 |= 0x80u;
+        }
+        packet_vec.push_back(digit_u8);
+    }while(length_u32 > 0);
+    packet_vec.insert(packet_vec.end(), body_vec.begin(), body_vec.end());
+    sendAll(client_pst, packet_vec.data(), packet_vec.size());
+}
+
+static void sendPublish(client_t *client_pst, const std::string &topic_str,
+                        const std::string &payload_str, bool retain_bol)
+{
+    std::vector<uint8_t> body_vec;
+
+    body_vec.push_back((uint8_t)(topic_str.size() >> 8));
+    body_vec.push_back((uint8_t)(topic_str.size() & 0xFFu));
+    body_vec.insert(body_vec.end(), topic_str.begin(), topic_str.end());
+    body_vec.insert(body_vec.end(), payload_str.begin(), payload_str.end());
+    sendPacket(client_pst, (uint8_t)(MQTT_PUBLISH | (retain_bol ? 0x01u : 0x00u)), body_vec);
+    stats_st.forwarded_u32++;
+}
+
+static bool topicMatches(const std::string &filter_str, const std::string &topic_str)
+{
+    size_t f_u32 = 0;
+    size_t t_u32 = 0;
+
+    while(f_u32 < filter_str.size())
+    {
+        if('#' == filter_str[f_u32])
+        {
+            return(true);
+        }
+        else if('+' == filter_str[f_u32])
+        {
+            while((t_u32 < topic_str.size()) && ('/' != topic_str[t_u32]))
+            {
+                t_u32++;
+            }
+            f_u32++;
+        }
+        else
+        {
+            if((t_u32 >= topic_str.size()) || (filter_str[f_u32] != topic_str[t_u32]))
+            {
+                // "a/#" also matches the parent level "a"
+                return((t_u32 >= topic_str.size()) 
+                        && (0 == filter_str.compare(f_u32, std::string::npos, "/#")));
+            }
+            f_u32++;
+            t_u32++;
+        }
+    }
+    return(t_u32 == topic_str.size());
+}
+
+static std::string readString(const std::vector<uint8_t> &body_vec, size_t *pos_pu32)
+{
+    size_t length_u32;
+    std::string str;
+
+    if((*pos_pu32 + 2u) > body_vec.size())
+    {
+        *pos_pu32 = body_vec.size();
+        return(str);
+    }
+    length_u32 = ((size_t)body_vec[*pos_pu32] << 8) | body_vec[*pos_pu32 + 1u];
+    *pos_pu32 += 2u;
+    if((*pos_pu32 + length_u32) > body_vec.size())
+    {
+        length_u32 = body_vec.size() - *pos_pu32;
+    }
+    str.assign((const char *)&body_vec[*pos_pu32], length_u32);
+    *pos_pu32 += length_u32;
+    return(str);
+}
+
+static void handleConnect(client_t *client_pst, const std::vector<uint8_t> &body_vec)
+{
+    size_t pos_u32 = 0;
+    std::vector<uint8_t> ack_vec;
+
+    (void)readString(body_vec, &pos_u32);   // protocol name
+    pos_u32 += 4u;                          // level, flags, keep alive
+    client_pst->id_str = readString(body_vec, &pos_u32);
+    client_pst->connected_bol = true;
+    stats_st.connects_u32++;
+    ack_vec.push_back(0x00);
+    ack_vec.push_back(0x00);
+    sendPacket(client_pst, MQTT_CONNACK, ack_vec);
+    fprintf(stderr, "<<broker>> connect %s\n", client_pst->id_str.c_str());
+}
+
+static void handlePublish(client_t *client_pst, uint8_t header_u8, 
+                            const std::vector<uint8_t> &body_vec)
+{
+    size_t pos_u32 = 0;
+    uint8_t qos_u8 = (uint8_t)((header_u8 >> 1) & 0x03u);
+    bool retain_bol = (0 != (header_u8 & 0x01u));
+    std::string topic_str = readString(body_vec, &pos_u32);
+    std::string payload_str;
+    size_t idx_u32;
+
+    if(qos_u8 > 0)
+    {
+        std::vector<uint8_t> ack_vec;
+
+        if((pos_u32 + 2u) > body_vec.size())
+        {
+            return;
+        }
+        ack_vec.push_back(body_vec[pos_u32]);
+        ack_vec.push_back(body_vec[pos_u32 + 1u]);
+        pos_u32 += 2u;
+        if(1 == qos_u8)
+        {
+            sendPacket(client_pst, MQTT_PUBACK, ack_vec);
+        }
+    }
+    if(pos_u32 < body_vec.size())
+    {
+        payload_str.assign((const char *)&body_vec[pos_u32], body_vec.size() - pos_u32);
+    }
+    stats_st.publishes_u32++;
+    if(true == verbose_bolst)
+    {
+        printf("%s %s\n", topic_str.c_str(), payload_str.c_str());
+        fflush(stdout);
+    }
+
+    if(true == retain_bol)
+    {
+        if(0 == payload_str.size())
+        {
+            retained_mapst.erase(topic_str);
+        }
+        else
+        {
+            retained_mapst[topic_str] = payload_str;
+        }
+    }
+
+    for(idx_u32 = 0; idx_u32 < clients_vecst.size(); idx_u32++)
+    {
+        client_t *dest_pst = &clients_vecst[idx_u32];
+        size_t filter_u32;
+
+        for(filter_u32 = 0; filter_u32 < dest_pst->filters_vec.size(); filter_u32++)
+        {
+            if(true == topicMatches(dest_pst->filters_vec[filter_u32], topic_str))
+            {
+                sendPublish(dest_pst, topic_str, payload_str, false);
+                break;
+            }
+        }
+    }
+}
+
+static void handleSubscribe(client_t *client_pst, const std::vector<uint8_t> &body_vec,
+                            bool subscribe_bol)
+{
+    size_t pos_u32 = 2u;
+    std::vector<uint8_t> ack_vec;
+    std::vector<std::string> new_vec;
+    size_t idx_u32;
+
+    if(body_vec.size() < 2u)
+    {
+        return;
+    }
+    ack_vec.push_back(body_vec[0]);
+    ack_vec.push_back(body_vec[1]);
+    while(pos_u32 < body_vec.size())
+    {
+        std::string filter_str = readString(body_vec, &pos_u32);
+        std::vector<std::string> *filters_pvec = &client_pst->filters_vec;
+
+        for(idx_u32 = 0; idx_u32 < filters_pvec->size(); idx_u32++)
+        {
+            if(filter_str == (*filters_pvec)[idx_u32])
+            {
+                filters_pvec->erase(filters_pvec->begin() + idx_u32);
+                break;
+            }
+        }
+        if(true == subscribe_bol)
+        {
+            pos_u32++;                      // requested qos, granted is 0
+            filters_pvec->push_back(filter_str);
+            new_vec.push_back(filter_str);
+            ack_vec.push_back(0x00);
+            stats_st.subscriptions_u32++;
+        }
+    }
+    sendPacket(client_pst, subscribe_bol ? MQTT_SUBACK : MQTT_UNSUBACK, ack_vec);
+
+    // retained messages are delivered after the SUBACK
+    for(idx_u32 = 0; idx_u32 < new_vec.size(); idx_u32++)
+    {
+        std::map<std::string, std::string>::const_iterator it;
+
+        for(it = retained_mapst.begin(); it != retained_mapst.end(); ++it)
+        {
+            if(true == topicMatches(new_vec[idx_u32], it->first))
+            {
+                sendPublish(client_pst, it->first, it->second, true);
+            }
+        }
+    }
+}
+
+static bool processPackets(client_t *client_pst)
+{
+    std::vector<uint8_t> *rx_pvec = &client_pst->rx_vec;
+
+    while(rx_pvec->size() >= 2u)
+    {
+        size_t length_u32 = 0;
+        size_t multiplier_u32 = 1;
+        size_t pos_u32 = 1;
+        uint8_t header_u8 = (*rx_pvec)[0];
+        uint8_t digit_u8;
+
+        do
+        {
+            if(pos_u32 >= rx_pvec->size())
+            {
+                return(true);               // length not complete
+            }
+            digit_u8 = (*rx_pvec)[pos_u32++];
+            length_u32 += (digit_u8 & 0x7Fu) * multiplier_u32;
+            multiplier_u32 *= 128u;
+        }while((0 != (digit_u8 & 0x80u)) && (pos_u32 < 5u));
+
+        if(length_u32 > MAX_PACKET_SIZE)
+        {
+            return(false);
+        }
+        if((pos_u32 + length_u32) > rx_pvec->size())
+        {
+            return(true);                   // body not complete
+        }
+
+        std::vector<uint8_t> body_vec(rx_pvec->begin() + pos_u32, 
+                                        rx_pvec->begin() + pos_u32 + length_u32);
+        rx_pvec->erase(rx_pvec->begin(), rx_pvec->begin() + pos_u32 + length_u32);
+
+        switch(header_u8 & 0xF0u)
+        {
+            case MQTT_CONNECT:
+                handleConnect(client_pst, body_vec);
+                break;
+            case MQTT_PUBLISH:
+                handlePublish(client_pst, header_u8, body_vec);
+                break;
+            case MQTT_SUBSCRIBE:
+                handleSubscribe(client_pst, body_vec, true);
+                break;
+            case MQTT_UNSUBSCRIBE:
+                handleSubscribe(client_pst, body_vec, false);
+                break;
+            case MQTT_PINGREQ:
+                stats_st.pings_u32++;
+                sendPacket(client_pst, MQTT_PINGRESP, std::vector<uint8_t>());
+                break;
+            case MQTT_DISCONNECT:
+                return(false);
+            default:
+                // PUBACK of QoS 1 forwards is not expected, everything else is ignored
+                break;
+        }
+        if((false == client_pst->connected_bol) || (-1 == client_pst->socket_s32))
+        {
+            return(false);
+        }
+    }
+    return(true);
+}
+
+static int openListener(uint16_t port_u16)
+{
+    struct sockaddr_in addr_st;
+    int socket_s32;
+    int flag_s32 = 1;
+
+    socket_s32 = socket(AF_INET, SOCK_STREAM, 0);
+    if(socket_s32 < 0)
+    {
+        return(-1);
+    }
+    setsockopt(socket_s32, SOL_SOCKET, SO_REUSEADDR, &flag_s32, sizeof(flag_s32));
+    memset(&addr_st, 0, sizeof(addr_st));
+    addr_st.sin_family = AF_INET;
+    addr_st.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr_st.sin_port = htons(port_u16);
+    if((0 != bind(socket_s32, (struct sockaddr *)&addr_st, sizeof(addr_st)))
+        || (0 != listen(socket_s32, 8)))
+    {
+        close(socket_s32);
+        return(-1);
+    }
+    return(socket_s32);
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+int main(int argc, char *argv[])
+{
+    uint16_t port_u16 = DEFAULT_PORT;
+    unsigned long seconds_u32 = 0;
+    int listener_s32;
+    double start_f64;
+    int idx_s32;
+
+    for(idx_s32 = 1; idx_s32 < argc; idx_s32++)
+    {
+        if(0 == strcmp(argv[idx_s32], "--verbose"))
+        {
+            verbose_bolst = true;
+        }
+        else if((0 == strcmp(argv[idx_s32], "--port")) && (idx_s32 + 1 < argc))
+        {
+            port_u16 = (uint16_t)atoi(argv[++idx_s32]);
+        }
+        else if((0 == strcmp(argv[idx_s32], "--seconds")) && (idx_s32 + 1 < argc))
+        {
+            seconds_u32 = strtoul(argv[++idx_s32], NULL, 10);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--port n] [--seconds n] [--verbose]\n", argv[0]);
+            return(1);
+        }
+    }
+
+    listener_s32 = openListener(port_u16);
+    if(listener_s32 < 0)
+    {
+        fprintf(stderr, "<<broker>> unable to listen on port %u: %s\n", port_u16, 
+                strerror(errno));
+        return(1);
+    }
+    signal(SIGINT, stopHandler);
+    signal(SIGTERM, stopHandler);
+    memset(&stats_st, 0, sizeof(stats_st));
+    fprintf(stderr, "<<broker>> listening on 127.0.0.1:%u\n", port_u16);
+
+    start_f64 = wallSeconds();
+    while((0 == stop_s32st)
+            && ((0 == seconds_u32) || ((wallSeconds() - start_f64) < (double)seconds_u32)))
+    {
+        std::vector<struct pollfd> fds_vec;
+        size_t idx_u32;
+        struct pollfd fd_st;
+
+        fd_st.fd = listener_s32;
+        fd_st.events = POLLIN;
+        fd_st.revents = 0;
+        fds_vec.push_back(fd_st);
+        for(idx_u32 = 0; idx_u32 < clients_vecst.size(); idx_u32++)
+        {
+            fd_st.fd = clients_vecst[idx_u32].socket_s32;
+            fds_vec.push_back(fd_st);
+        }
+
+        if(poll(fds_vec.data(), fds_vec.size(), 100) <= 0)
+        {
+            continue;
+        }
+
+        // handle the clients first, accepting a new one changes the client vector
+        for(idx_u32 = 0; idx_u32 < clients_vecst.size(); idx_u32++)
+        {
+            client_t *client_pst = &clients_vecst[idx_u32];
+            uint8_t buffer_au8[RECEIVE_CHUNK];
+            ssize_t ret_s32;
+
+            if(0 == (fds_vec[idx_u32 + 1u].revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                continue;
+            }
+            ret_s32 = recv(client_pst->socket_s32, buffer_au8, sizeof(buffer_au8), 0);
+            if(ret_s32 > 0)
+            {
+                stats_st.bytesIn_u64 += (uint64_t)ret_s32;
+                client_pst->rx_vec.insert(client_pst->rx_vec.end(), buffer_au8, 
+                                            buffer_au8 + ret_s32);
+                if(true == processPackets(client_pst))
+                {
+                    continue;
+                }
+            }
+            else if((ret_s32 < 0) && (EINTR == errno))
+            {
+                continue;
+            }
+            fprintf(stderr, "<<broker>> disconnect %s\n", client_pst->id_str.c_str());
+            if(-1 != client_pst->socket_s32)
+            {
+                close(client_pst->socket_s32);
+                client_pst->socket_s32 = -1;
+            }
+        }
+
+        // remove closed clients, also the ones closed by a failed forward
+        for(idx_u32 = clients_vecst.size(); idx_u32 > 0; idx_u32--)
+        {
+            if(-1 == clients_vecst[idx_u32 - 1u].socket_s32)
+            {
+                clients_vecst.erase(clients_vecst.begin() + (idx_u32 - 1u));
+            }
+        }
+
+        if(0 != (fds_vec[0].revents & POLLIN))
+        {
+            int socket_s32 = accept(listener_s32, NULL, NULL);
+            int flag_s32 = 1;
+
+            if(socket_s32 >= 0)
+            {
+                client_t client_st;
+
+                setsockopt(socket_s32, IPPROTO_TCP, TCP_NODELAY, &flag_s32, 
+                            sizeof(flag_s32));
+                client_st.socket_s32 = socket_s32;
+                client_st.connected_bol = false;
+                clients_vecst.push_back(client_st);
+                stats_st.clients_u32++;
+            }
+        }
+    }
+
+    for(size_t idx_u32 = 0; idx_u32 < clients_vecst.size(); idx_u32++)
+    {
+        close(clients_vecst[idx_u32].socket_s32);
+    }
+    close(listener_s32);
+    fprintf(stderr, "<<broker>> clients=%u connects=%u publishes=%u forwarded=%u "
+                    "subscriptions=%u pings=%u bytes=%llu\n",
+            stats_st.clients_u32, stats_st.connects_u32, stats_st.publishes_u32,
+            stats_st.forwarded_u32, stats_st.subscriptions_u32, stats_st.pings_u32,
+            (unsigned long long)stats_st.bytesIn_u64);
+    return(0);
+}
@@ -0,0 +1,207 @@
+/*****************************************************************************************
+* FILENAME :        tracedecode.cpp
+*
+* DESCRIPTION :
+*       Host decoder for the binary trace records published on s/tracebin/
+*
+* NOTES :
+*       Reads one MQTT payload per line as hex string from stdin, as printed by
+*       mosquitto_sub -v -F '%t %x' -t 'inf/+/s/tracebin/', a leading topic is
+*       printed as prefix. Every payload can hold a sequence of records, each
+*       record is the length byte, the type byte and the record body. The format
+*       table is compiled from the firmware sources, so the decoder has to be
+*       built from the same revision as the firmware.
+*
+*       Build from the ESPGeneric directory:
+*       g++ -O2 -std=gnu++11 -I include -I test/host/stubs 
+*           test/host/tools/tracedecode.cpp src/TraceFormat.cpp -o tracedecode
+*
+* Copyright (c) [2017] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* AUTHOR :    Stephan Wink        START DATE :    17.10.2026
+*
+*****************************************************************************************/
+
+/****************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include "TraceFormat.h"
+
+/****************************************************************************************/
+/* Local constant defines */
+#define LINE_LENGTH                 4096u
+#define TEXT_LENGTH                 256u
+#define HEADER_SIZE                 2u
+#define TYPE_MASK                   0x7Fu
+
+/****************************************************************************************/
+/* Local function like makros */
+
+/****************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/****************************************************************************************/
+/* Local data definitions */
+static const char *types_stccpa[] = {"   ", "INF", "WRN", "ERR"};
+
+/****************************************************************************************/
+/* Local functions */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Converts one hex digit
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     digit_c       hex digit
+ * @return    value of the digit, -1 for an invalid digit
+*//*-----------------------------------------------------------------------------------*/
+static int HexValue_s32(char digit_c)
+{
+    if(('0' <= digit_c) && ('9' >= digit_c))
+    {
+        return(digit_c - '0');
+    }
+    digit_c = (char)tolower((unsigned char)digit_c);
+    if(('a' <= digit_c) && ('f' >= digit_c))
+    {
+        return(digit_c - 'a' + 10);
+    }
+    return(-1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Converts a hex string into bytes, white spaces are skipped
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     hex_ccp       hex string
+ * @param     data_pu8      destination buffer
+ * @param     size_u32      size of the destination buffer
+ * @return    number of bytes, 0 for an invalid string
+*//*-----------------------------------------------------------------------------------*/
+static uint32_t HexToBytes_u32(const char *hex_ccp, uint8_t *data_pu8, uint32_t size_u32)
+{
+    uint32_t length_u32 = 0;
+    int high_s32;
+    int low_s32;
+
+    while('\0' != *hex_ccp)
+    {
+        if(0 != isspace((unsigned char)*hex_ccp))
+        {
+            hex_ccp++;
+            continue;
+        }
+        high_s32 = HexValue_s32(hex_ccp[0]);
+        low_s32 = ('\0' == hex_ccp[1]) ? -1 : HexValue_s32(hex_ccp[1]);
+        if((0 > high_s32) || (0 > low_s32) || (length_u32 >= size_u32))
+        {
+            return(0);
+        }
+        data_pu8[length_u32++] = (uint8_t)((high_s32 << 4) | low_s32);
+        hex_ccp += 2;
+    }
+    return(length_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Decodes and prints all records of one payload
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @param     prefix_ccp    text in front of every record, e.g. the topic
+ * @param     data_pu8      payload
+ * @param     length_u32    payload length
+ * @return    number of invalid records
+*//*-----------------------------------------------------------------------------------*/
+static uint32_t PrintRecords_u32(const char *prefix_ccp, const uint8_t *data_pu8, 
+                                    uint32_t length_u32)
+{
+    char text_ca[TEXT_LENGTH];
+    uint32_t args_au32[TRACEFORMAT_MAX_ARGS];
+    uint32_t idx_u32 = 0;
+    uint32_t time_u32;
+    uint16_t format_u16;
+    uint8_t count_u8;
+    uint8_t body_u8;
+    uint8_t type_u8;
+
+    while(idx_u32 + HEADER_SIZE <= length_u32)
+    {
+        body_u8 = data_pu8[idx_u32];
+        type_u8 = data_pu8[idx_u32 + 1u] & TYPE_MASK;
+        if((idx_u32 + HEADER_SIZE + body_u8 > length_u32)
+            || (false == TraceFormat::Decode_bol(&data_pu8[idx_u32 + HEADER_SIZE], body_u8,
+                                                    &format_u16, &time_u32, args_au32, 
+                                                    &count_u8)))
+        {
+            printf("%sinvalid record at offset %u\n", prefix_ccp, idx_u32);
+            return(1);
+        }
+        (void)TraceFormat::Format_u16(text_ca, sizeof(text_ca), 
+                                        &data_pu8[idx_u32 + HEADER_SIZE], body_u8);
+        printf("%s%10u ms %s %s\n", prefix_ccp, time_u32, 
+                (type_u8 < 4u) ? types_stccpa[type_u8] : "???", text_ca);
+        idx_u32 += HEADER_SIZE + body_u8;
+    }
+    return((idx_u32 == length_u32) ? 0 : 1);
+}
+
+/****************************************************************************************/
+/* Public functions (unlimited visibility) */
+
+/**---------------------------------------------------------------------------------------
+ * @brief     Decoder entry
+ * @author    winkste
+ * @date      17 Okt. 2026
+ * @return    0, if all records were valid
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    static char line_ca[LINE_LENGTH];
+    static uint8_t data_au8[LINE_LENGTH / 2u];
+    char prefix_ca[LINE_LENGTH];
+    const char *hex_ccp;
+    const char *space_ccp;
+    uint32_t length_u32;
+    uint32_t errors_u32 = 0;
+
+    while(NULL != fgets(line_ca, sizeof(line_ca), stdin))
+    {
+        line_ca[strcspn(line_ca, "\r\n")] = '\0';
+        // optional topic in front of the payload
+        hex_ccp = line_ca;
+        prefix_ca[0] = '\0';
+        space_ccp = strrchr(line_ca, ' ');
+        if(NULL != space_ccp)
+        {
+            snprintf(prefix_ca, sizeof(prefix_ca), "%.*s ", (int)(space_ccp - line_ca), 
+                        line_ca);
+            hex_ccp = space_ccp + 1;
+        }
+        length_u32 = HexToBytes_u32(hex_ccp, data_au8, sizeof(data_au8));
+        if(0 == length_u32)
+        {
+            continue;
+        }
+        errors_u32 += PrintRecords_u32(prefix_ca, data_au8, length_u32);
+    }
+    return((0 == errors_u32) ? 0 : 1);
+}